@@ -0,0 +1,79 @@
+// Benchmark: BM25SearchTransform::do_search over large tool catalogs.
+//
+// Reports the one-off cost of indexing a catalog and the per-query latency once
+// the index is built. Queries walk only the postings of their own terms, so the
+// latency should stay well under a millisecond at 10k tools.
+
+#include "fastmcpp/providers/transforms/search/bm25.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace fastmcpp;
+using namespace fastmcpp::providers::transforms::search;
+
+namespace
+{
+constexpr int kQueries = 2000;
+
+const char* kVerbs[] = {"read", "write", "list", "delete", "query", "fetch", "update", "sync"};
+const char* kNouns[] = {"file", "record", "user", "invoice", "ticket", "message", "image", "log"};
+
+std::vector<tools::Tool> make_catalog(int size)
+{
+    std::vector<tools::Tool> catalog;
+    catalog.reserve(size);
+    for (int i = 0; i < size; ++i)
+    {
+        std::string verb = kVerbs[i % 8];
+        std::string noun = kNouns[(i / 8) % 8];
+        Json schema = {{"type", "object"},
+                       {"properties",
+                        {{"id", {{"type", "string"}, {"description", "The " + noun + " id"}}},
+                         {"limit", {{"type", "integer"}, {"description", "Maximum results"}}}}}};
+        tools::Tool tool(verb + "_" + noun + "_" + std::to_string(i), std::move(schema),
+                         Json::object(), [](const Json& in) { return in; });
+        tool.set_description("Tool that will " + verb + " a " + noun + " in shard" +
+                             std::to_string(i % 97));
+        catalog.push_back(std::move(tool));
+    }
+    return catalog;
+}
+
+double ms_since(std::chrono::steady_clock::time_point start)
+{
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::milli>(elapsed).count();
+}
+
+void run(int size)
+{
+    auto catalog = make_catalog(size);
+    BM25SearchTransform transform;
+
+    auto start = std::chrono::steady_clock::now();
+    transform.do_search(catalog, "warm up");
+    double index_ms = ms_since(start);
+
+    const std::string queries[] = {"read file", "delete user shard42", "fetch invoice limit",
+                                   "sync message id"};
+    size_t hits = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kQueries; ++i)
+        hits += transform.do_search(catalog, queries[i % 4]).size();
+    double query_us = ms_since(start) * 1000.0 / kQueries;
+
+    std::printf("%8d %12.2f %12.1f %8zu\n", size, index_ms, query_us, hits / kQueries);
+}
+} // namespace
+
+int main()
+{
+    std::printf("BM25 search (%d queries per catalog)\n\n", kQueries);
+    std::printf("%8s %12s %12s %8s\n", "tools", "index ms", "query us", "hits");
+    for (int size : {100, 1000, 10000})
+        run(size);
+    return 0;
+}
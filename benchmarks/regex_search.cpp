@@ -0,0 +1,78 @@
+// Benchmark: RegexSearchTransform::do_search over large tool catalogs.
+//
+// Reports per-query latency for a literal pattern, regexes with required
+// fragments (narrowed by the trigram index) and one the index cannot narrow.
+
+#include "fastmcpp/providers/transforms/search/regex.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace fastmcpp;
+using namespace fastmcpp::providers::transforms::search;
+
+namespace
+{
+constexpr int kQueries = 200;
+
+const char* kVerbs[] = {"read", "write", "list", "delete", "query", "fetch", "update", "sync"};
+const char* kNouns[] = {"file", "record", "user", "invoice", "ticket", "message", "image", "log"};
+
+std::vector<tools::Tool> make_catalog(int size)
+{
+    std::vector<tools::Tool> catalog;
+    catalog.reserve(size);
+    for (int i = 0; i < size; ++i)
+    {
+        std::string verb = kVerbs[i % 8];
+        std::string noun = kNouns[(i / 8) % 8];
+        Json schema = {{"type", "object"},
+                       {"properties",
+                        {{"id", {{"type", "string"}, {"description", "The " + noun + " id"}}},
+                         {"limit", {{"type", "integer"}, {"description", "Maximum results"}}}}}};
+        tools::Tool tool(verb + "_" + noun + "_" + std::to_string(i), std::move(schema),
+                         Json::object(), [](const Json& in) { return in; });
+        tool.set_description("Tool that will " + verb + " a " + noun + " in shard" +
+                             std::to_string(i % 97));
+        catalog.push_back(std::move(tool));
+    }
+    return catalog;
+}
+
+double us_per_query(const RegexSearchTransform& transform, const std::vector<tools::Tool>& catalog,
+                    const std::string& pattern)
+{
+    transform.do_search(catalog, pattern); // Warm-up (indexes the catalog)
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kQueries; ++i)
+        transform.do_search(catalog, pattern);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count() / kQueries;
+}
+} // namespace
+
+int main()
+{
+    RegexSearchTransform::Options opts;
+    opts.max_results = 10;
+    const std::string patterns[] = {"shard42", "delete_invoice_\\d+", "^sync.*message", "[xz]{2}"};
+
+    std::printf("Regex search, us per query (%d queries, max_results %d)\n\n", kQueries,
+                opts.max_results);
+    std::printf("%8s", "tools");
+    for (const auto& pattern : patterns)
+        std::printf(" %20s", pattern.c_str());
+    std::printf("\n");
+    for (int size : {100, 1000, 10000})
+    {
+        auto catalog = make_catalog(size);
+        RegexSearchTransform transform(opts);
+        std::printf("%8d", size);
+        for (const auto& pattern : patterns)
+            std::printf(" %20.1f", us_per_query(transform, catalog, pattern));
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+// Benchmark: resolving a URI against many resource templates.
+//
+// "regex scan" tries each template's build_regex_pattern() regex in order, as
+// template matching used to; "router" is one UriTemplateRouter built over all
+// templates. Hits target the last registered template; misses match none.
+
+#include "fastmcpp/resources/uri_router.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <regex>
+#include <string>
+#include <vector>
+
+using namespace fastmcpp;
+using namespace fastmcpp::resources;
+
+namespace
+{
+constexpr int kLookups = 2000;
+
+template <typename Fn>
+double us_per_call(int iterations, Fn&& fn)
+{
+    fn(); // Warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        fn();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+}
+
+void run(int count)
+{
+    std::vector<std::regex> regexes;
+    UriTemplateRouter router;
+    for (int i = 0; i < count; ++i)
+    {
+        ResourceTemplate templ;
+        templ.uri_template = "svc" + std::to_string(i) + "://{tenant}/items/{id}{?fields}";
+        templ.parse();
+        regexes.emplace_back(build_regex_pattern(templ.uri_template));
+        router.add(templ);
+    }
+
+    auto regex_scan = [&](const std::string& uri)
+    {
+        std::smatch match;
+        for (const auto& regex : regexes)
+            if (std::regex_match(uri, match, regex))
+                return true;
+        return false;
+    };
+
+    const std::string hit = "svc" + std::to_string(count - 1) + "://acme/items/42?fields=name";
+    const std::string miss = "svc" + std::to_string(count) + "://acme/items/42";
+    int iterations = std::max(20, kLookups * 10 / count);
+    double scan_hit = us_per_call(
+        iterations, [&]() { regex_scan(hit); });
+    double scan_miss = us_per_call(
+        iterations, [&]() { regex_scan(miss); });
+    double router_hit = us_per_call(
+        kLookups, [&]() { router.match(hit); });
+    double router_miss = us_per_call(kLookups, [&]() { router.match(miss); });
+    std::printf("%10d %12.1f %12.1f %12.2f %12.2f\n", count, scan_hit, scan_miss, router_hit,
+                router_miss);
+}
+} // namespace
+
+int main()
+{
+    std::printf("URI template resolution, us per lookup\n\n");
+    std::printf("%10s %12s %12s %12s %12s\n", "templates", "scan hit", "scan miss", "router hit",
+                "router miss");
+    for (int count : {10, 100, 1000, 5000})
+        run(count);
+    return 0;
+}
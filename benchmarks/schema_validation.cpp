@@ -0,0 +1,100 @@
+// Benchmark: util::schema::validate (interprets the schema on every call) against a
+// CompiledSchema built once, as the client does for tool output schemas.
+//
+// The interpreter walks every schema property and re-reads "type" strings on each
+// call; the compiled validator only does work for keys the instance actually has,
+// so its cost should track the instance rather than the schema.
+
+#include "fastmcpp/util/json_schema.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using namespace fastmcpp;
+
+namespace
+{
+constexpr int kIterations = 20000;
+
+Json make_schema(int properties)
+{
+    static const char* kTypes[] = {"string", "integer", "number", "boolean", "array", "object"};
+    Json props = Json::object();
+    Json required = Json::array();
+    for (int i = 0; i < properties; ++i)
+    {
+        auto name = "field_" + std::to_string(i);
+        props[name] = {{"type", kTypes[i % 6]}, {"description", "Field " + std::to_string(i)}};
+        if (i < 2)
+            required.push_back(name);
+    }
+    return {{"type", "object"}, {"properties", props}, {"required", required}};
+}
+
+Json make_instance(int properties)
+{
+    Json instance = Json::object();
+    for (int i = 0; i < properties; ++i)
+    {
+        auto name = "field_" + std::to_string(i);
+        switch (i % 6)
+        {
+        case 0:
+            instance[name] = "value";
+            break;
+        case 1:
+            instance[name] = i;
+            break;
+        case 2:
+            instance[name] = i * 0.5;
+            break;
+        case 3:
+            instance[name] = true;
+            break;
+        case 4:
+            instance[name] = Json::array({1, 2});
+            break;
+        default:
+            instance[name] = Json::object();
+        }
+    }
+    return instance;
+}
+
+template <typename Fn>
+double ns_per_call(Fn&& fn)
+{
+    fn(); // Warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i)
+        fn();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / kIterations;
+}
+
+void run(int schema_properties, int instance_properties)
+{
+    auto schema = make_schema(schema_properties);
+    auto instance = make_instance(instance_properties);
+    util::schema::CompiledSchema compiled(schema);
+
+    double interpreted = ns_per_call([&]() { util::schema::validate(schema, instance); });
+    double precompiled = ns_per_call([&]() { compiled.validate(instance); });
+    std::printf("%8d %10d %14.0f %12.0f %8.1fx\n", schema_properties, instance_properties,
+                interpreted, precompiled, interpreted / precompiled);
+}
+} // namespace
+
+int main()
+{
+    std::printf("Schema validation, ns per call (%d iterations)\n\n", kIterations);
+    std::printf("%8s %10s %14s %12s %9s\n", "schema", "instance", "interpreted", "compiled",
+                "speedup");
+    for (int properties : {4, 16, 64, 256})
+        run(properties, properties);
+    // Large schemas with small payloads: compiled cost follows the instance
+    for (int properties : {64, 256, 1024})
+        run(properties, 4);
+    return 0;
+}
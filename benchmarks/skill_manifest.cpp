@@ -0,0 +1,89 @@
+// Benchmark: reading a skill's _manifest resource, and raw SHA-256 throughput.
+//
+// The first manifest read hashes every file (in parallel); later reads only
+// stat() each file and reuse the cached hashes and description. Throughput is
+// shown for the portable compression function and, where the CPU has them,
+// the SHA-NI instructions.
+
+#include "fastmcpp/providers/skills_provider.hpp"
+#include "fastmcpp/util/sha256.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace fastmcpp;
+
+namespace
+{
+double ms_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+std::string read_manifest(const providers::SkillProvider& provider, const std::string& uri)
+{
+    auto content = provider.get_resource(uri)->provider(Json::object());
+    return std::get<std::string>(content.data);
+}
+
+void run_manifest(int files, size_t file_size)
+{
+    const auto skill = std::filesystem::temp_directory_path() / "fastmcpp_bench_skill" / "assets";
+    std::filesystem::remove_all(skill.parent_path());
+    std::filesystem::create_directories(skill / "data");
+    std::ofstream(skill / "SKILL.md") << "# Assets\nBenchmark skill.";
+    const std::string payload(file_size, 'x');
+    for (int i = 0; i < files; ++i)
+        std::ofstream(skill / "data" / ("file_" + std::to_string(i) + ".bin"), std::ios::binary)
+            << payload << i;
+
+    providers::SkillProvider provider(skill);
+    const std::string uri = "skill://assets/_manifest";
+
+    auto start = std::chrono::steady_clock::now();
+    read_manifest(provider, uri);
+    const double cold = ms_since(start);
+
+    constexpr int kWarmReads = 20;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kWarmReads; ++i)
+        read_manifest(provider, uri);
+    const double warm = ms_since(start) / kWarmReads;
+
+    std::printf("%8d %10zu %12.2f %12.3f\n", files, file_size / 1024, cold, warm);
+    std::filesystem::remove_all(skill.parent_path());
+}
+
+void run_throughput(bool allow_hardware)
+{
+    const std::vector<char> data(64 << 20, 'x');
+    util::Sha256 sha(allow_hardware);
+    auto start = std::chrono::steady_clock::now();
+    sha.update(data.data(), data.size());
+    sha.finish();
+    const double ms = ms_since(start);
+    std::printf("%-10s %8.0f MB/s\n", allow_hardware ? "hardware" : "portable",
+                (data.size() / 1048576.0) / (ms / 1000.0));
+}
+} // namespace
+
+int main()
+{
+    std::printf("Skill manifest reads, ms\n\n");
+    std::printf("%8s %10s %12s %12s\n", "files", "KiB each", "first read", "cached read");
+    run_manifest(100, 4 * 1024);
+    run_manifest(200, 256 * 1024);
+    run_manifest(50, 4 * 1024 * 1024);
+
+    std::printf("\nSHA-256 throughput (hardware %s)\n",
+                util::Sha256::hardware_available() ? "available" : "unavailable");
+    run_throughput(false);
+    if (util::Sha256::hardware_available())
+        run_throughput(true);
+    return 0;
+}
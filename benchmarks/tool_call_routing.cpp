@@ -0,0 +1,100 @@
+// Benchmark: tools/call latency through make_mcp_handler as the catalog grows.
+//
+// Routing goes through the catalog's tool route index, so per-call latency
+// should stay flat from 10 to 10,000 tools - for local tools, provider tools
+// and tools reached through nested mounts alike.
+
+#include "fastmcpp/app.hpp"
+#include "fastmcpp/mcp/handler.hpp"
+#include "fastmcpp/providers/local_provider.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fastmcpp;
+
+namespace
+{
+constexpr int kIterations = 20000;
+
+tools::Tool make_tool(const std::string& name)
+{
+    return tools::Tool{name, Json{{"type", "object"}, {"properties", Json::object()}}, Json(),
+                       [](const Json&) { return Json(1); }};
+}
+
+double ns_per_call(const FastMCP& app, const std::string& tool_name)
+{
+    auto handler = mcp::make_mcp_handler(app);
+    Json request = {{"jsonrpc", "2.0"},
+                    {"id", 1},
+                    {"method", "tools/call"},
+                    {"params", {{"name", tool_name}, {"arguments", Json::object()}}}};
+
+    // Warm-up builds the catalog snapshot once
+    auto warm = handler(request);
+    if (!warm.contains("result"))
+    {
+        std::fprintf(stderr, "tools/call %s failed: %s\n", tool_name.c_str(), warm.dump().c_str());
+        return -1.0;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i)
+        handler(request);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / kIterations;
+}
+
+double bench_local(int count)
+{
+    FastMCP app("bench", "1.0.0");
+    for (int i = 0; i < count; ++i)
+        app.tools().register_tool(make_tool("tool_" + std::to_string(i)));
+    return ns_per_call(app, "tool_" + std::to_string(count - 1));
+}
+
+double bench_provider(int count)
+{
+    FastMCP app("bench", "1.0.0");
+    auto provider = std::make_shared<providers::LocalProvider>();
+    for (int i = 0; i < count; ++i)
+        provider->add_tool(make_tool("tool_" + std::to_string(i)));
+    app.add_provider(provider);
+    return ns_per_call(app, "tool_" + std::to_string(count - 1));
+}
+
+double bench_nested_mount(int count)
+{
+    // Spread tools over several mounted children, two levels deep
+    constexpr int kChildren = 4;
+    FastMCP root("root", "1.0.0");
+    FastMCP middle("middle", "1.0.0");
+    std::vector<std::unique_ptr<FastMCP>> leaves;
+    for (int c = 0; c < kChildren; ++c)
+    {
+        leaves.push_back(std::make_unique<FastMCP>("leaf" + std::to_string(c), "1.0.0"));
+        for (int i = c; i < count; i += kChildren)
+            leaves.back()->tools().register_tool(make_tool("tool_" + std::to_string(i)));
+        middle.mount(*leaves.back(), "leaf" + std::to_string(c));
+    }
+    root.mount(middle, "mid");
+
+    int last = count - 1;
+    return ns_per_call(root, "mid_leaf" + std::to_string(last % kChildren) + "_tool_" +
+                                 std::to_string(last));
+}
+} // namespace
+
+int main()
+{
+    std::printf("tools/call latency (ns/call, %d calls each)\n", kIterations);
+    std::printf("%8s %12s %12s %14s\n", "tools", "local", "provider", "nested mount");
+    for (int count : {10, 100, 1000, 10000})
+        std::printf("%8d %12.0f %12.0f %14.0f\n", count, bench_local(count), bench_provider(count),
+                    bench_nested_mount(count));
+    return 0;
+}
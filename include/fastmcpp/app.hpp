@@ -6,12 +6,16 @@
 #include "fastmcpp/resources/manager.hpp"
 #include "fastmcpp/server/server.hpp"
 #include "fastmcpp/tools/manager.hpp"
+#include "fastmcpp/util/generation.hpp"
 
 #include <chrono>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <initializer_list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -25,6 +29,11 @@ namespace providers
 class Provider;
 } // namespace providers
 
+namespace mcp::tasks
+{
+class TaskExecutor;
+} // namespace mcp::tasks
+
 /// HTTP request snapshot passed to a custom-route handler.
 /// Kept transport-agnostic so HttpServerWrapper can populate it from
 /// cpp-httplib without leaking that dependency into app.hpp.
@@ -75,6 +84,51 @@ struct ProxyMountedApp
         tool_names; // Optional tool name overrides
 };
 
+/// Resolved tools/call target for one exposed tool name.
+///
+/// Direct mounts are resolved through to the leaf tool, so invoking a route
+/// costs one hash lookup regardless of mount depth.
+struct ToolRoute
+{
+    /// Tool to invoke (local, provider or mounted-app tool); null for tools
+    /// reached through a proxy mount, which invoke_tool() forwards by name.
+    const tools::Tool* tool{nullptr};
+    bool has_output_schema{false};
+    bool wrap_result{false};
+    /// Task support of the target; std::nullopt when `tool` is null.
+    std::optional<TaskSupport> task_support;
+};
+
+/// Aggregated catalog of a FastMCP app (local + providers + mounts) at one
+/// catalog generation. Immutable once built, so concurrent list requests can
+/// share it without re-walking providers, transforms and mounted apps.
+struct CatalogSnapshot
+{
+    /// Generation this snapshot was built for; std::nullopt when the app has
+    /// untracked sources and the snapshot is single-use.
+    std::optional<uint64_t> generation;
+    std::vector<client::ToolInfo> tools;
+    std::vector<resources::Resource> resources;
+    std::vector<resources::ResourceTemplate> templates;
+    /// Exposed prompt names; the prompt is absent for proxy-mounted prompts.
+    std::vector<std::pair<std::string, std::optional<prompts::Prompt>>> prompts;
+    /// True when any tool, resource or prompt opts into task execution.
+    bool supports_tasks{false};
+
+    /// Exposed tool name -> call route, for every tool in `tools`.
+    std::unordered_map<std::string, ToolRoute> tool_routes;
+    /// Storage backing ToolRoute::tool for provider tools, plus the mounted
+    /// apps' snapshots whose routes were imported.
+    std::deque<tools::Tool> owned_tools;
+    std::vector<std::shared_ptr<const CatalogSnapshot>> mounted_catalogs;
+
+    const ToolRoute* find_tool_route(const std::string& name) const
+    {
+        auto it = tool_routes.find(name);
+        return it == tool_routes.end() ? nullptr : &it->second;
+    }
+};
+
 /// MCP Application - bundles server metadata with managers
 ///
 /// Equivalent to Python's FastMCP class. Provides:
@@ -210,6 +264,17 @@ class FastMCP
         experimental_capabilities_ = std::move(caps);
     }
 
+    /// Executor for SEP-1686 background tasks, shared by every MCP handler built
+    /// from this app. When unset, each handler starts its own with default options.
+    const std::shared_ptr<mcp::tasks::TaskExecutor>& task_executor() const
+    {
+        return task_executor_;
+    }
+    void set_task_executor(std::shared_ptr<mcp::tasks::TaskExecutor> executor)
+    {
+        task_executor_ = std::move(executor);
+    }
+
     // Manager accessors
     tools::ToolManager& tools()
     {
@@ -366,11 +431,40 @@ class FastMCP
     /// List all prompts including from mounted apps
     std::vector<std::pair<std::string, const prompts::Prompt*>> list_all_prompts() const;
 
+    // =========================================================================
+    // Catalog Snapshot
+    // =========================================================================
+
+    /// Catalog generation: changes whenever local registrations, providers
+    /// (content, transforms, visibility), mounts or mounted apps change.
+    /// std::nullopt when some source cannot report changes (proxy mounts,
+    /// providers without change tracking); such catalogs are never cached.
+    std::optional<uint64_t> catalog_generation() const;
+
+    /// Aggregated catalog for the current generation. Rebuilt from the
+    /// list_all_*() walks only when catalog_generation() changed since the
+    /// last call; otherwise the cached snapshot is returned. Thread-safe; the
+    /// build runs without holding any lock. For untracked catalogs every call
+    /// builds a single-use snapshot, so prefer cached_catalog() there.
+    std::shared_ptr<const CatalogSnapshot> catalog() const;
+
+    /// catalog() when catalog_generation() is tracked, nullptr otherwise. Callers
+    /// needing one kind of component then walk just that list_all_*() instead.
+    std::shared_ptr<const CatalogSnapshot> cached_catalog() const;
+
+    /// Call metadata (output schema, wrapping, task support) of an exposed tool.
+    /// Read from the cached snapshot when the catalog is tracked; otherwise from
+    /// one tools-only walk, as other components are not needed. `tool` is always
+    /// null in the result, since the snapshot owning it is not retained.
+    std::optional<ToolRoute> find_tool_route(const std::string& name) const;
+
     // =========================================================================
     // Routing (dispatches to correct app based on prefix)
     // =========================================================================
 
-    /// Invoke a tool by name (handles prefixed routing)
+    /// Invoke a tool by name (handles prefixed routing). Exposed names resolve
+    /// through the catalog's route index; other names accepted by the mounts
+    /// (e.g. "prefix_original" for an overridden tool) take the slower walk.
     Json invoke_tool(const std::string& name, const Json& args, bool enforce_timeout = true) const;
 
     /// Read a resource by URI (handles prefixed routing)
@@ -398,6 +492,21 @@ class FastMCP
     int list_page_size_{0};
     bool dereference_schemas_{true};
     std::optional<Json> experimental_capabilities_;
+    std::shared_ptr<mcp::tasks::TaskExecutor> task_executor_;
+
+    // Bumped by mount()/add_provider(); manager and provider stamps cover the rest.
+    util::GenerationStamp structure_generation_;
+    struct CatalogCache
+    {
+        std::mutex mutex;
+        std::shared_ptr<const CatalogSnapshot> snapshot;
+    };
+    std::unique_ptr<CatalogCache> catalog_cache_{std::make_unique<CatalogCache>()};
+
+    void collect_tools(CatalogSnapshot& out) const;
+    std::shared_ptr<const CatalogSnapshot> catalog(std::optional<uint64_t> generation) const;
+    Json invoke_tool_uncached(const std::string& name, const Json& args,
+                              bool enforce_timeout) const;
 
     // Prefix utilities
     static std::string add_prefix(const std::string& name, const std::string& prefix);
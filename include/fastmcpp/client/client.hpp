@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <future>
 #include <memory>
@@ -23,6 +24,7 @@
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace fastmcpp::client
 {
@@ -83,6 +85,82 @@ class ISessionTransport
     virtual bool has_session() const = 0;
 };
 
+/// Optional transport interface: some transports deliver server notifications that arrive
+/// outside of a response (e.g. notifications/tools/list_changed).
+class INotificationTransport
+{
+  public:
+    virtual ~INotificationTransport() = default;
+    virtual void set_notification_callback(std::function<void(const fastmcpp::Json&)> callback) = 0;
+
+    /// The callback currently installed, so a new one can chain to it. Transports
+    /// that do not keep it return an empty function.
+    virtual std::function<void(const fastmcpp::Json&)> notification_callback() const
+    {
+        return {};
+    }
+};
+
+/// One request of a JSON-RPC batch sent through Client::call_batch.
+struct BatchCall
+{
+    std::string method;
+    fastmcpp::Json params = fastmcpp::Json::object();
+};
+
+/// Optional transport interface: some transports can send several requests as a single
+/// JSON-RPC batch.
+class IBatchTransport
+{
+  public:
+    virtual ~IBatchTransport() = default;
+
+    /// Send `calls` as one batch.
+    /// @return The raw JSON-RPC response of each call, in the order of `calls`
+    virtual std::vector<fastmcpp::Json> request_batch(const std::vector<BatchCall>& calls) = 0;
+};
+
+namespace detail
+{
+/// Pair the reply to a batch with the request ids it was sent with. Responses may
+/// arrive in any order; a call left unanswered gets an error response, and a single
+/// error object (the server rejected the whole batch) is reported for every call.
+inline std::vector<fastmcpp::Json> match_batch_responses(const fastmcpp::Json& reply,
+                                                         const std::vector<int64_t>& ids)
+{
+    std::vector<fastmcpp::Json> out(ids.size());
+    if (reply.is_object() && reply.contains("error"))
+    {
+        for (auto& response : out)
+            response = reply;
+        return out;
+    }
+
+    std::unordered_map<int64_t, size_t> index;
+    for (size_t i = 0; i < ids.size(); ++i)
+        index.emplace(ids[i], i);
+    if (reply.is_array())
+    {
+        for (const auto& response : reply)
+        {
+            if (!response.is_object() || !response.contains("id") ||
+                !response["id"].is_number_integer())
+                continue;
+            auto it = index.find(response["id"].get<int64_t>());
+            if (it != index.end())
+                out[it->second] = response;
+        }
+    }
+    for (size_t i = 0; i < ids.size(); ++i)
+        if (out[i].is_null())
+            out[i] = fastmcpp::Json{
+                {"jsonrpc", "2.0"},
+                {"id", ids[i]},
+                {"error", {{"code", -32603}, {"message", "No response for batch entry"}}}};
+    return out;
+}
+} // namespace detail
+
 /// Loopback transport for in-process server testing
 class LoopbackTransport : public ITransport
 {
@@ -104,7 +182,7 @@ class LoopbackTransport : public ITransport
 /// In-process transport that uses an MCP handler function
 /// This is useful for proxy mode mounting where we want to communicate
 /// with a mounted app via its MCP handler
-class InProcessMcpTransport : public ITransport
+class InProcessMcpTransport : public ITransport, public IBatchTransport
 {
   public:
     using HandlerFn = std::function<fastmcpp::Json(const fastmcpp::Json&)>;
@@ -114,9 +192,8 @@ class InProcessMcpTransport : public ITransport
     fastmcpp::Json request(const std::string& route, const fastmcpp::Json& payload) override
     {
         // Build JSON-RPC request
-        static int request_id = 0;
         fastmcpp::Json jsonrpc_request = {
-            {"jsonrpc", "2.0"}, {"id", ++request_id}, {"method", route}, {"params", payload}};
+            {"jsonrpc", "2.0"}, {"id", ++next_id()}, {"method", route}, {"params", payload}};
 
         // Call handler
         fastmcpp::Json response = handler_(jsonrpc_request);
@@ -128,7 +205,29 @@ class InProcessMcpTransport : public ITransport
         return response.value("result", fastmcpp::Json::object());
     }
 
+    std::vector<fastmcpp::Json> request_batch(const std::vector<BatchCall>& calls) override
+    {
+        fastmcpp::Json batch = fastmcpp::Json::array();
+        std::vector<int64_t> ids;
+        ids.reserve(calls.size());
+        for (const auto& call : calls)
+        {
+            ids.push_back(++next_id());
+            batch.push_back({{"jsonrpc", "2.0"},
+                             {"id", ids.back()},
+                             {"method", call.method},
+                             {"params", call.params}});
+        }
+        return detail::match_batch_responses(handler_(batch), ids);
+    }
+
   private:
+    static std::atomic<int64_t>& next_id()
+    {
+        static std::atomic<int64_t> id{0};
+        return id;
+    }
+
     HandlerFn handler_;
 };
 
@@ -224,6 +323,39 @@ class Client
         return transport_->request(route, payload);
     }
 
+    /// Send several raw requests as one JSON-RPC batch, saving a round trip per call
+    /// on transports that support batching. Transports that do not are sent the
+    /// calls one by one; their responses carry the call's index in `calls` as id.
+    /// @return One JSON-RPC response per call, in order, each holding either
+    ///         "result" or "error"; a failed call does not throw
+    std::vector<fastmcpp::Json> call_batch(const std::vector<BatchCall>& calls)
+    {
+        if (calls.empty())
+            return {};
+        if (auto* batch_transport = dynamic_cast<IBatchTransport*>(transport_.get()))
+            return batch_transport->request_batch(calls);
+
+        std::vector<fastmcpp::Json> responses;
+        responses.reserve(calls.size());
+        for (size_t i = 0; i < calls.size(); ++i)
+        {
+            const auto& c = calls[i];
+            try
+            {
+                responses.push_back(fastmcpp::Json{
+                    {"jsonrpc", "2.0"}, {"id", i}, {"result", call(c.method, c.params)}});
+            }
+            catch (const std::exception& e)
+            {
+                responses.push_back(
+                    fastmcpp::Json{{"jsonrpc", "2.0"},
+                                   {"id", i},
+                                   {"error", {{"code", -32603}, {"message", e.what()}}}});
+            }
+        }
+        return responses;
+    }
+
     // ==========================================================================
     // Tool Operations
     // ==========================================================================
@@ -234,10 +366,11 @@ class Client
     {
         auto response = call("tools/list", fastmcpp::Json::object());
         auto parsed = parse_list_tools_result(response);
-        tool_output_schemas_.clear();
+        std::unordered_map<std::string, ToolOutputSchema> listed;
         for (const auto& t : parsed.tools)
             if (t.outputSchema)
-                tool_output_schemas_[t.name] = *t.outputSchema;
+                remember_output_schema(listed, t.name, *t.outputSchema);
+        tool_output_schemas_ = std::move(listed);
         return parsed;
     }
 
@@ -258,7 +391,7 @@ class Client
             for (auto& t : parsed.tools)
             {
                 if (t.outputSchema)
-                    tool_output_schemas_[t.name] = *t.outputSchema;
+                    remember_output_schema(tool_output_schemas_, t.name, *t.outputSchema);
                 all.push_back(std::move(t));
             }
             if (!parsed.nextCursor)
@@ -748,6 +881,26 @@ class Client
         throw fastmcpp::Error("Unsupported notification method: " + method);
     }
 
+    /// Receive server notifications through `handler` when the transport can deliver them.
+    /// Clones made with new_() share the transport and therefore the handler.
+    /// @return false if the transport has no notification channel
+    bool set_notification_handler(std::function<void(const fastmcpp::Json&)> handler)
+    {
+        auto* notifying = dynamic_cast<INotificationTransport*>(transport_.get());
+        if (!notifying)
+            return false;
+        notifying->set_notification_callback(std::move(handler));
+        return true;
+    }
+
+    /// The handler the transport currently delivers notifications to, if any; a
+    /// handler installed later can call it to keep earlier listeners working.
+    std::function<void(const fastmcpp::Json&)> notification_handler() const
+    {
+        auto* notifying = dynamic_cast<INotificationTransport*>(transport_.get());
+        return notifying ? notifying->notification_callback() : nullptr;
+    }
+
     /// Create a new client that reuses the same transport
     Client new_client() const
     {
@@ -815,7 +968,28 @@ class Client
     };
 
     std::shared_ptr<CallbackState> callbacks_;
-    std::unordered_map<std::string, fastmcpp::Json> tool_output_schemas_;
+    /// Output schema of a listed tool, compiled once for validating its results.
+    struct ToolOutputSchema
+    {
+        fastmcpp::Json schema;
+        fastmcpp::util::schema::CompiledSchema validator;
+    };
+    std::unordered_map<std::string, ToolOutputSchema> tool_output_schemas_;
+
+    /// Store `schema` for `name` in `into`, reusing the compiled validator already
+    /// held for an identical schema.
+    void remember_output_schema(std::unordered_map<std::string, ToolOutputSchema>& into,
+                                const std::string& name, const fastmcpp::Json& schema) const
+    {
+        auto known = tool_output_schemas_.find(name);
+        if (known != tool_output_schemas_.end() && known->second.schema == schema)
+        {
+            if (&into != &tool_output_schemas_)
+                into[name] = known->second;
+            return;
+        }
+        into[name] = ToolOutputSchema{schema, fastmcpp::util::schema::CompiledSchema(schema)};
+    }
 
     std::function<fastmcpp::Json()> get_roots_callback() const
     {
@@ -1067,12 +1241,13 @@ class Client
             {
                 try
                 {
-                    fastmcpp::util::schema::validate(it->second, structured);
-                    wrap_result = it->second.value("x-fastmcp-wrap-result", false);
-                    target_schema = wrap_result && it->second.contains("properties") &&
-                                            it->second["properties"].contains("result")
-                                        ? it->second["properties"]["result"]
-                                        : it->second;
+                    const auto& schema = it->second.schema;
+                    it->second.validator.validate(structured);
+                    wrap_result = schema.value("x-fastmcp-wrap-result", false);
+                    target_schema = wrap_result && schema.contains("properties") &&
+                                            schema["properties"].contains("result")
+                                        ? schema["properties"]["result"]
+                                        : schema;
                     has_schema = true;
                 }
                 catch (const std::exception& e)
@@ -1083,16 +1258,16 @@ class Client
             }
             if (wrap_result && structured.contains("result"))
             {
-                result.data =
-                    coerce_to_schema(it->second["properties"]["result"], structured["result"]);
+                result.data = coerce_to_schema(it->second.schema["properties"]["result"],
+                                               structured["result"]);
             }
             else if (structured.contains("result"))
             {
-                if (it != tool_output_schemas_.end() && it->second.contains("properties") &&
-                    it->second["properties"].contains("result"))
+                if (it != tool_output_schemas_.end() && it->second.schema.contains("properties") &&
+                    it->second.schema["properties"].contains("result"))
                 {
-                    result.data =
-                        coerce_to_schema(it->second["properties"]["result"], structured["result"]);
+                    result.data = coerce_to_schema(it->second.schema["properties"]["result"],
+                                                   structured["result"]);
                 }
                 else
                 {
@@ -1102,7 +1277,7 @@ class Client
             else
             {
                 if (it != tool_output_schemas_.end())
-                    result.data = coerce_to_schema(it->second, structured);
+                    result.data = coerce_to_schema(it->second.schema, structured);
                 else
                     result.data = structured;
             }
@@ -5,6 +5,7 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <filesystem>
 #include <future>
 #include <memory>
@@ -21,6 +22,28 @@ namespace fastmcpp::client
 
 class ITransport;
 
+/// Connection reuse counters of an HTTP-based transport.
+struct HttpConnectionStats
+{
+    uint64_t requests{0};    ///< Requests sent over pooled keep-alive clients
+    uint64_t connections{0}; ///< TCP (and TLS) connections opened to serve them
+    size_t idle_clients{0};  ///< Clients parked for reuse right now
+
+    /// Requests that went out on an already-open connection
+    uint64_t reused() const
+    {
+        return requests > connections ? requests - connections : 0;
+    }
+};
+
+namespace detail
+{
+/// Thread-safe pool of keep-alive HTTP clients, keyed by origin (see transports.cpp).
+class HttpConnectionPool;
+std::shared_ptr<HttpConnectionPool> make_http_connection_pool();
+HttpConnectionStats http_connection_stats(const HttpConnectionPool& pool);
+} // namespace detail
+
 class HttpTransport : public ITransport
 {
   public:
@@ -46,17 +69,33 @@ class HttpTransport : public ITransport
         return timeout_;
     }
 
+    /// Reuse counters of this transport's pooled keep-alive connections
+    HttpConnectionStats connection_stats() const
+    {
+        return detail::http_connection_stats(*pool_);
+    }
+
   private:
     std::string base_url_;
     std::chrono::seconds timeout_;
     std::unordered_map<std::string, std::string> headers_;
     bool verify_ssl_{true};
+    std::shared_ptr<detail::HttpConnectionPool> pool_{detail::make_http_connection_pool()};
 };
 
 // Launches an MCP stdio server as a subprocess and performs JSON-RPC requests
 // over its stdin/stdout. By default, the subprocess is kept alive between calls
 // to better match Python fastmcp behavior; pass keep_alive=false to spawn per call.
-class StdioTransport : public ITransport
+//
+// In keep-alive mode a reader thread matches responses to requests by id, so
+// several threads may have requests in flight over the same subprocess. Server
+// notifications go to the notification callback, which runs on the reader
+// thread. Server-initiated requests go to the server request handler on a
+// thread of their own, so a slow handler does not hold up responses.
+class StdioTransport : public ITransport,
+                       public IServerRequestTransport,
+                       public IBatchTransport,
+                       public INotificationTransport
 {
   public:
     /// Construct a StdioTransport with optional stderr logging (v2.13.0+)
@@ -88,21 +127,39 @@ class StdioTransport : public ITransport
 
     fastmcpp::Json request(const std::string& route, const fastmcpp::Json& payload) override;
 
+    /// Send `calls` as one JSON-RPC batch line (keep-alive mode; one-shot mode
+    /// sends them one process at a time)
+    std::vector<fastmcpp::Json> request_batch(const std::vector<BatchCall>& calls) override;
+
+    void set_server_request_handler(ServerRequestHandler handler) override;
+
+    /// Set callback for server notifications (keep-alive mode)
+    void set_notification_callback(std::function<void(const fastmcpp::Json&)> callback) override;
+    std::function<void(const fastmcpp::Json&)> notification_callback() const override;
+
     bool keep_alive() const noexcept
     {
         return keep_alive_;
     }
 
   private:
+    struct State;
+
+    /// The running subprocess, spawning it (again) if needed
+    std::shared_ptr<State> live_state();
+    fastmcpp::Json request_one_shot(const std::string& route, const fastmcpp::Json& payload);
+
     std::string command_;
     std::vector<std::string> args_;
     std::optional<std::filesystem::path> log_file_;
     std::ostream* log_stream_ = nullptr;
     bool keep_alive_{true};
-    int64_t next_id_{1};
 
-    struct State;
-    std::unique_ptr<State> state_;
+    // Guards state_ and the callbacks; heap-allocated so the transport stays movable
+    std::unique_ptr<std::mutex> state_mutex_ = std::make_unique<std::mutex>();
+    std::shared_ptr<State> state_;
+    std::function<void(const fastmcpp::Json&)> notification_callback_;
+    ServerRequestHandler server_request_handler_;
 };
 
 /// SSE client transport for connecting to MCP servers using Server-Sent Events protocol.
@@ -144,6 +201,12 @@ class SseClientTransport : public ITransport,
 
     void reset(bool full = false) override;
 
+    /// Reuse counters of the connections carrying POSTed messages
+    HttpConnectionStats connection_stats() const
+    {
+        return detail::http_connection_stats(*pool_);
+    }
+
   private:
     void start_sse_listener();
     void stop_sse_listener();
@@ -170,6 +233,8 @@ class SseClientTransport : public ITransport,
 
     std::mutex request_handler_mutex_;
     ServerRequestHandler server_request_handler_;
+
+    std::shared_ptr<detail::HttpConnectionPool> pool_{detail::make_http_connection_pool()};
 };
 
 /// Streamable HTTP client transport for connecting to MCP servers using the
@@ -183,7 +248,9 @@ class SseClientTransport : public ITransport,
 /// Reference: https://spec.modelcontextprotocol.io/specification/2025-03-26/basic/transports/
 class StreamableHttpTransport : public ITransport,
                                 public IResettableTransport,
-                                public ISessionTransport
+                                public ISessionTransport,
+                                public IBatchTransport,
+                                public INotificationTransport
 {
   public:
     /// Construct a Streamable HTTP client transport
@@ -199,6 +266,9 @@ class StreamableHttpTransport : public ITransport,
     /// Send a JSON-RPC request and wait for response
     fastmcpp::Json request(const std::string& route, const fastmcpp::Json& payload) override;
 
+    /// Send several requests in one POST as a JSON-RPC batch
+    std::vector<fastmcpp::Json> request_batch(const std::vector<BatchCall>& calls) override;
+
     /// Get the session ID (set after successful initialize)
     std::string session_id() const override;
 
@@ -206,7 +276,8 @@ class StreamableHttpTransport : public ITransport,
     bool has_session() const override;
 
     /// Set callback for handling server-initiated notifications during streaming responses
-    void set_notification_callback(std::function<void(const fastmcpp::Json&)> callback);
+    void set_notification_callback(std::function<void(const fastmcpp::Json&)> callback) override;
+    std::function<void(const fastmcpp::Json&)> notification_callback() const override;
 
     /// Clear session state so subsequent requests behave as a fresh client.
     void reset_session()
@@ -216,9 +287,18 @@ class StreamableHttpTransport : public ITransport,
 
     void reset(bool /*full*/ = false) override;
 
+    /// Reuse counters of the pooled connections carrying MCP requests
+    HttpConnectionStats connection_stats() const
+    {
+        return detail::http_connection_stats(*pool_);
+    }
+
   private:
     void parse_session_id_from_response(const std::string& headers);
-    fastmcpp::Json parse_response(const std::string& body, const std::string& content_type);
+    /// POST a JSON-RPC message (or batch) and return the parsed reply
+    fastmcpp::Json post_message(const fastmcpp::Json& message, bool batch);
+    fastmcpp::Json parse_response(const std::string& body, const std::string& content_type,
+                                  bool batch = false);
     void process_sse_line(const std::string& line, std::vector<fastmcpp::Json>& messages);
 
     std::string base_url_;
@@ -230,11 +310,14 @@ class StreamableHttpTransport : public ITransport,
     mutable std::mutex session_mutex_;
     std::string session_id_;
 
-    // Notification handling
+    // Notification handling; the callback may be replaced while a request is running
+    mutable std::mutex notification_mutex_;
     std::function<void(const fastmcpp::Json&)> notification_callback_;
 
     // Request ID generation
     std::atomic<int64_t> next_id_{1};
+
+    std::shared_ptr<detail::HttpConnectionPool> pool_{detail::make_http_connection_pool()};
 };
 
 } // namespace fastmcpp::client
@@ -1,6 +1,17 @@
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace fastmcpp::mcp::tasks
 {
@@ -17,6 +28,77 @@ static constexpr int kDefaultMinimumCheckIntervalMs = 500;
 /// No-op if called outside a background task context.
 void report_status_message(const std::string& message);
 
+/// Sizing for a TaskExecutor.
+struct TaskExecutorOptions
+{
+    /// Most worker threads, started on demand; 0 picks std::thread::hardware_concurrency().
+    size_t workers{0};
+    /// Tasks allowed to wait for a worker before submit() starts rejecting.
+    size_t max_queued{1024};
+};
+
+/// Point-in-time counters of a TaskExecutor.
+struct TaskExecutorStats
+{
+    size_t workers{0}; ///< Threads started so far (never above TaskExecutorOptions::workers)
+    size_t running{0};
+    size_t queue_depth{0};
+    size_t waiting_owners{0}; ///< Distinct owners with queued work
+    uint64_t submitted{0};
+    uint64_t rejected{0};
+    uint64_t completed{0};
+    std::chrono::microseconds total_wait{0}; ///< Summed queue wait of started tasks
+    std::chrono::microseconds max_wait{0};
+};
+
+/// Worker pool behind SEP-1686 background tasks.
+///
+/// Queued work is ordered by priority (higher first). Within a priority, owners -
+/// normally the requesting session - take turns, so one client queuing many
+/// tasks cannot hold back everyone else. Each owner's tasks start in FIFO order.
+/// The destructor runs whatever is still queued and joins the workers.
+class TaskExecutor
+{
+  public:
+    explicit TaskExecutor(TaskExecutorOptions options = {});
+    ~TaskExecutor();
+
+    TaskExecutor(const TaskExecutor&) = delete;
+    TaskExecutor& operator=(const TaskExecutor&) = delete;
+
+    /// Queue `work`. Returns false, without queuing, when `max_queued` tasks are
+    /// already waiting or the executor is shutting down.
+    bool submit(const std::string& owner, int priority, std::function<void()> work);
+
+    TaskExecutorStats stats() const;
+
+  private:
+    struct Job
+    {
+        std::function<void()> work;
+        std::chrono::steady_clock::time_point queued_at;
+    };
+
+    /// Owners with pending work at one priority, served round-robin.
+    struct PriorityLevel
+    {
+        std::deque<std::string> turns;
+        std::unordered_map<std::string, std::deque<Job>> pending;
+    };
+
+    void worker_loop();
+    Job pop_next_locked();
+
+    TaskExecutorOptions options_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::map<int, PriorityLevel, std::greater<int>> levels_;
+    std::vector<std::thread> workers_;
+    size_t idle_workers_{0};
+    TaskExecutorStats stats_;
+    bool stopping_{false};
+};
+
 namespace detail
 {
 using StatusMessageFn = void (*)(void* ctx, const std::string& task_id, const std::string& message);
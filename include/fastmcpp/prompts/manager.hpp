@@ -1,6 +1,7 @@
 #pragma once
 #include "fastmcpp/exceptions.hpp"
 #include "fastmcpp/prompts/prompt.hpp"
+#include "fastmcpp/util/generation.hpp"
 
 #include <string>
 #include <unordered_map>
@@ -18,11 +19,13 @@ class PromptManager
         Prompt stored = p;
         stored.name = name;
         prompts_[name] = stored;
+        generation_.bump();
     }
 
     void register_prompt(const Prompt& p)
     {
         prompts_[p.name] = p;
+        generation_.bump();
     }
 
     const Prompt& get(const std::string& name) const
@@ -66,8 +69,15 @@ class PromptManager
         return {{{"user", prompt.template_string()}}};
     }
 
+    /// Change stamp; differs after every registration (see util::GenerationStamp).
+    uint64_t generation() const
+    {
+        return generation_.value();
+    }
+
   private:
     std::unordered_map<std::string, Prompt> prompts_;
+    util::GenerationStamp generation_;
 };
 
 } // namespace fastmcpp::prompts
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "fastmcpp/providers/local_provider.hpp"
+#include "fastmcpp/util/file_watcher.hpp"
 
 #include <filesystem>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -11,6 +14,15 @@
 namespace fastmcpp::providers
 {
 
+/// Serves the components registered by the shared libraries found under root().
+///
+/// With reload enabled, a util::FileWatcher tracks the libraries: only those
+/// added, rebuilt or removed are (re)loaded, and the catalog is then replaced in
+/// one step, bumping generation(). Until something changes, listing does no
+/// filesystem work at all. Replaced libraries stay loaded until the provider is
+/// destroyed, since components copied out earlier may still run their code.
+/// Components are read from the catalog; the storage inherited from
+/// LocalProvider is not used.
 class FileSystemProvider : public LocalProvider
 {
   public:
@@ -40,18 +52,32 @@ class FileSystemProvider : public LocalProvider
     std::vector<prompts::Prompt> list_prompts() const override;
     std::optional<prompts::Prompt> get_prompt(const std::string& name) const override;
 
+  protected:
+    /// Changes only when a reload swaps in a new catalog
+    std::optional<uint64_t> content_generation() const override;
+
   private:
-    void ensure_loaded() const;
-    void load_components();
+    struct SharedLibrary;
+    struct Plugin;
+    struct Catalog;
+
+    /// Applies pending watcher changes, if any, and returns the current catalog
+    std::shared_ptr<const Catalog> catalog() const;
+    void reload_paths(const std::vector<std::filesystem::path>& changed);
+    std::shared_ptr<const Plugin> load_plugin(const std::filesystem::path& path, bool shadow_copy);
+    void warn_once(const std::filesystem::path& path, const std::string& message);
+    void publish_catalog();
 
     std::filesystem::path root_;
     bool reload_{false};
-    mutable bool loaded_{false};
     mutable std::mutex reload_mutex_;
-    mutable std::unordered_map<std::string, std::filesystem::file_time_type> warned_files_;
+    std::unordered_map<std::string, std::filesystem::file_time_type> warned_files_;
 
-    struct SharedLibrary;
-    mutable std::vector<SharedLibrary> libraries_;
+    std::map<std::string, std::shared_ptr<const Plugin>> plugins_; // By path, in load order
+    std::shared_ptr<const Catalog> catalog_;                       // Atomically replaced
+    std::vector<std::shared_ptr<const Plugin>> retired_plugins_;   // Kept loaded until destruction
+    util::GenerationStamp catalog_generation_;
+    std::unique_ptr<util::FileWatcher> watcher_; // Reload mode only
 };
 
 } // namespace fastmcpp::providers
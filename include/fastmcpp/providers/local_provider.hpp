@@ -4,6 +4,7 @@
 #include "fastmcpp/prompts/manager.hpp"
 #include "fastmcpp/providers/provider.hpp"
 #include "fastmcpp/resources/manager.hpp"
+#include "fastmcpp/resources/uri_router.hpp"
 #include "fastmcpp/tools/manager.hpp"
 
 #include <iostream>
@@ -65,12 +66,18 @@ class LocalProvider : public Provider
                 return;
             resource_template.parse();
             templates_[it->second] = std::move(resource_template);
+            template_router_.clear();
+            for (const auto& templ : templates_)
+                template_router_.add(templ);
+            templates_generation_.bump();
             return;
         }
 
         resource_template.parse();
         template_index_[uri_template] = templates_.size();
         templates_.push_back(std::move(resource_template));
+        template_router_.add(templates_.back());
+        templates_generation_.bump();
     }
 
     const prompts::Prompt* add_prompt(prompts::Prompt prompt)
@@ -92,6 +99,8 @@ class LocalProvider : public Provider
         prompts_ = prompts::PromptManager{};
         templates_.clear();
         template_index_.clear();
+        template_router_.clear();
+        templates_generation_.bump();
     }
 
     std::vector<tools::Tool> list_tools() const override
@@ -139,9 +148,8 @@ class LocalProvider : public Provider
     std::optional<resources::ResourceTemplate>
     get_resource_template(const std::string& uri) const override
     {
-        for (const auto& templ : templates_)
-            if (templ.match(uri))
-                return templ;
+        if (auto match = template_router_.match(uri))
+            return templates_[match->index];
         return std::nullopt;
     }
 
@@ -166,6 +174,12 @@ class LocalProvider : public Provider
     }
 
   protected:
+    std::optional<uint64_t> content_generation() const override
+    {
+        return tools_.generation() + resources_.generation() + prompts_.generation() +
+               templates_generation_.value();
+    }
+
     DuplicateBehavior on_duplicate_;
     tools::ToolManager tools_;
     resources::ResourceManager resources_;
@@ -191,6 +205,8 @@ class LocalProvider : public Provider
 
     std::vector<resources::ResourceTemplate> templates_;
     std::unordered_map<std::string, size_t> template_index_;
+    resources::UriTemplateRouter template_router_; // Over templates_, in order
+    util::GenerationStamp templates_generation_;
 };
 
 } // namespace fastmcpp::providers
@@ -30,6 +30,13 @@ class OpenAPIProvider : public Provider
     std::vector<tools::Tool> list_tools() const override;
     std::optional<tools::Tool> get_tool(const std::string& name) const override;
 
+  protected:
+    std::optional<uint64_t> content_generation() const override
+    {
+        // Routes are parsed once at construction.
+        return 0;
+    }
+
   private:
     struct RouteDefinition
     {
@@ -7,8 +7,10 @@
 #include "fastmcpp/resources/resource.hpp"
 #include "fastmcpp/resources/template.hpp"
 #include "fastmcpp/tools/tool.hpp"
+#include "fastmcpp/util/generation.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -32,6 +34,7 @@ class Provider
         if (!transform)
             throw ValidationError("transform cannot be null");
         transforms_.push_back(std::move(transform));
+        generation_.bump();
     }
 
     void enable(const std::vector<std::string>& keys = {}, bool only = false)
@@ -49,6 +52,20 @@ class Provider
         visibility_->reset();
     }
 
+    /// Change stamp for the transformed catalog, or std::nullopt when this provider
+    /// cannot track changes (its listings may differ between calls and must not be
+    /// cached). Combines content_generation() with the transform chain's state.
+    std::optional<uint64_t> generation() const
+    {
+        auto content = content_generation();
+        if (!content)
+            return std::nullopt;
+        uint64_t gen = *content + generation_.value();
+        for (const auto& transform : transforms_)
+            gen += transform->generation();
+        return gen;
+    }
+
     std::vector<tools::Tool> list_tools_transformed() const
     {
         transforms::ListToolsNext chain = [this]() { return list_tools(); };
@@ -204,9 +221,25 @@ class Provider
         return std::nullopt;
     }
 
+  protected:
+    /// Stamp that changes whenever list_*() output may change. Providers whose
+    /// content only changes through tracked mutations override this; the default
+    /// marks the provider as untracked.
+    virtual std::optional<uint64_t> content_generation() const
+    {
+        return std::nullopt;
+    }
+
+    /// Mark the catalog as changed (e.g. after a reload).
+    void bump_generation()
+    {
+        generation_.bump();
+    }
+
   private:
     std::shared_ptr<transforms::Visibility> visibility_;
     std::vector<std::shared_ptr<transforms::Transform>> transforms_;
+    util::GenerationStamp generation_;
 };
 
 } // namespace fastmcpp::providers
@@ -3,7 +3,9 @@
 #include "fastmcpp/providers/provider.hpp"
 
 #include <filesystem>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -41,7 +43,10 @@ class SkillProvider : public Provider
     }
 
   private:
+    /// Description of the skill, cached while its main file is unchanged
     std::string build_description() const;
+    std::string read_description(const std::filesystem::path& main_path) const;
+    /// File listing with hashes, cached per file while its stat() is unchanged
     std::string build_manifest_json() const;
     std::vector<std::filesystem::path> list_files() const;
 
@@ -51,9 +56,21 @@ class SkillProvider : public Provider
     SkillSupportingFiles supporting_files_;
 };
 
+/// Serves every skill found directly under one or more root directories. Where
+/// two roots hold a skill of the same name, the earlier root wins.
+///
+/// Each root is read through an index shared by every provider in the process
+/// that uses the same root and settings, so mounting several vendor providers
+/// over overlapping directories scans each directory once. An index caches the
+/// resource and template lists of its skills; listing does no filesystem work.
+/// With reload enabled, the index watches its root (util::FileWatcher) and
+/// rebuilds only the skills whose files changed.
 class SkillsDirectoryProvider : public Provider
 {
   public:
+    /// Receives a notification method and its params, like server::Context's callback
+    using NotificationCallback = std::function<void(const std::string&, const Json&)>;
+
     explicit SkillsDirectoryProvider(
         std::filesystem::path root, bool reload = false, std::string main_file_name = "SKILL.md",
         SkillSupportingFiles supporting_files = SkillSupportingFiles::Template);
@@ -63,6 +80,8 @@ class SkillsDirectoryProvider : public Provider
         std::string main_file_name = "SKILL.md",
         SkillSupportingFiles supporting_files = SkillSupportingFiles::Template);
 
+    ~SkillsDirectoryProvider() override;
+
     std::vector<resources::Resource> list_resources() const override;
     std::optional<resources::Resource> get_resource(const std::string& uri) const override;
 
@@ -70,16 +89,37 @@ class SkillsDirectoryProvider : public Provider
     std::optional<resources::ResourceTemplate>
     get_resource_template(const std::string& uri) const override;
 
+    /// Called with "notifications/resources/list_changed" whenever a reload
+    /// changes the listed resources or templates. Runs on a watcher thread.
+    void set_notification_callback(NotificationCallback callback);
+
+  protected:
+    /// Changes only when one of the roots' indexes changes
+    std::optional<uint64_t> content_generation() const override;
+
   private:
-    void ensure_discovered() const;
-    void discover_skills() const;
+    struct Skill;
+    class Index;
+    struct Listing;
+
+    static std::shared_ptr<Index> acquire_index(const std::filesystem::path& root, bool reload,
+                                                const std::string& main_file_name,
+                                                SkillSupportingFiles supporting_files);
+
+    /// The merged view of every root's index, rebuilt when any of them changed
+    std::shared_ptr<const Listing> listing() const;
+    void notify_list_changed();
 
     std::vector<std::filesystem::path> roots_;
     bool reload_{false};
     std::string main_file_name_;
     SkillSupportingFiles supporting_files_{SkillSupportingFiles::Template};
-    mutable bool discovered_{false};
-    mutable std::vector<std::shared_ptr<SkillProvider>> providers_;
+    std::vector<std::shared_ptr<Index>> indexes_;
+    std::vector<uint64_t> subscriptions_;            // One per index
+    mutable std::shared_ptr<const Listing> listing_; // Atomically replaced
+    mutable std::mutex listing_mutex_;               // Serializes rebuilds
+    std::mutex callback_mutex_;
+    NotificationCallback notification_callback_;
 };
 
 class ClaudeSkillsProvider : public SkillsDirectoryProvider
@@ -4,7 +4,10 @@
 #include "fastmcpp/types.hpp"
 
 #include <functional>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -20,7 +23,7 @@ inline std::string extract_searchable_text(const tools::Tool& tool)
         text += ' ';
         text += *tool.description();
     }
-    auto schema = tool.input_schema();
+    const auto& schema = tool.input_schema();
     if (schema.is_object() && schema.contains("properties"))
     {
         for (auto& [param_name, param_info] : schema["properties"].items())
@@ -41,6 +44,39 @@ inline std::string extract_searchable_text(const tools::Tool& tool)
     return text;
 }
 
+/// Whether two tools produce the same searchable text. Copies of a tool share their
+/// input schema, so comparing its address stands in for comparing the schema.
+inline bool same_searchable_text(const tools::Tool& a, const tools::Tool& b)
+{
+    return &a.input_schema() == &b.input_schema() && a.name() == b.name() &&
+           a.description() == b.description();
+}
+
+/// Per-tool search documents for `tools`, reusing the document built for a tool of
+/// `previous_tools` whose searchable text is unchanged and calling `make_doc` otherwise.
+template <typename Doc, typename MakeDoc>
+std::vector<std::shared_ptr<const Doc>>
+derive_documents(const std::vector<tools::Tool>& tools,
+                 const std::vector<tools::Tool>& previous_tools,
+                 const std::vector<std::shared_ptr<const Doc>>& previous_docs, MakeDoc&& make_doc)
+{
+    std::unordered_map<std::string_view, size_t> previous_by_name;
+    for (size_t i = 0; i < previous_tools.size(); ++i)
+        previous_by_name.emplace(previous_tools[i].name(), i);
+
+    std::vector<std::shared_ptr<const Doc>> docs;
+    docs.reserve(tools.size());
+    for (const auto& tool : tools)
+    {
+        auto it = previous_by_name.find(tool.name());
+        if (it != previous_by_name.end() && same_searchable_text(tool, previous_tools[it->second]))
+            docs.push_back(previous_docs[it->second]);
+        else
+            docs.push_back(std::make_shared<const Doc>(make_doc(tool)));
+    }
+    return docs;
+}
+
 /// Serialize tools to JSON array (same format as list_tools output).
 inline Json serialize_tools_for_output_json(const std::vector<tools::Tool>& tools)
 {
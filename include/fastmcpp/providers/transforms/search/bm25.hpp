@@ -5,10 +5,10 @@
 #include <algorithm>
 #include <cctype>
 #include <cmath>
-#include <numeric>
-#include <sstream>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
-#include <unordered_set>
 
 namespace fastmcpp::providers::transforms::search
 {
@@ -39,7 +39,15 @@ inline std::vector<std::string> tokenize(const std::string& text)
     return tokens;
 }
 
+using Tokens = std::vector<std::string>;
+
 /// Self-contained BM25 Okapi index.
+///
+/// Terms map to postings lists of (document, term frequency), stored back to
+/// back in one array, with each term's IDF and each document's length norm
+/// precomputed. A query only visits the postings of its own terms, so its cost
+/// follows how many documents match rather than the size of the corpus.
+/// Immutable once built; concurrent queries need no locking.
 class BM25Index
 {
   public:
@@ -47,72 +55,133 @@ class BM25Index
 
     void build(const std::vector<std::string>& documents)
     {
-        n_ = static_cast<int>(documents.size());
-        doc_tokens_.clear();
-        doc_lengths_.clear();
-        tf_.clear();
-        df_.clear();
+        std::vector<std::shared_ptr<const Tokens>> tokenized;
+        tokenized.reserve(documents.size());
+        for (const auto& doc : documents)
+            tokenized.push_back(std::make_shared<const Tokens>(tokenize(doc)));
+        build(tokenized);
+    }
+
+    /// Build from documents already split by tokenize().
+    void build(const std::vector<std::shared_ptr<const Tokens>>& documents)
+    {
+        n_ = static_cast<uint32_t>(documents.size());
+        term_ids_.clear();
+        offsets_.clear();
+        postings_.clear();
+        idf_.clear();
+        norms_.assign(n_, 0.0);
 
+        // Count (term, doc) pairs per term first so postings can be laid out in place
+        std::vector<std::vector<std::pair<uint32_t, uint32_t>>> doc_terms(n_);
+        std::vector<uint32_t> df;
         double total_length = 0;
-        for (const auto& doc : documents)
+        for (uint32_t doc = 0; doc < n_; ++doc)
         {
-            auto tokens = tokenize(doc);
-            doc_lengths_.push_back(static_cast<int>(tokens.size()));
-            total_length += tokens.size();
-
-            std::unordered_map<std::string, int> tf;
-            std::unordered_set<std::string> seen;
+            const auto& tokens = *documents[doc];
+            total_length += static_cast<double>(tokens.size());
+            auto& terms = doc_terms[doc];
             for (const auto& token : tokens)
             {
-                tf[token]++;
-                if (seen.insert(token).second)
-                    df_[token]++;
+                auto [it, inserted] =
+                    term_ids_.try_emplace(token, static_cast<uint32_t>(term_ids_.size()));
+                if (inserted)
+                    df.push_back(0);
+                terms.emplace_back(it->second, 0);
+            }
+            // Collapse repeated terms of this document into frequencies
+            std::sort(terms.begin(), terms.end());
+            size_t unique = 0;
+            for (size_t i = 0; i < terms.size(); ++i)
+            {
+                if (unique > 0 && terms[unique - 1].first == terms[i].first)
+                {
+                    ++terms[unique - 1].second;
+                    continue;
+                }
+                terms[unique++] = {terms[i].first, 1};
+                ++df[terms[i].first];
             }
-            tf_.push_back(std::move(tf));
-            doc_tokens_.push_back(std::move(tokens));
+            terms.resize(unique);
         }
         avg_dl_ = n_ > 0 ? total_length / n_ : 0.0;
+
+        offsets_.assign(df.size() + 1, 0);
+        for (size_t term = 0; term < df.size(); ++term)
+            offsets_[term + 1] = offsets_[term] + df[term];
+        postings_.resize(offsets_.back());
+        std::vector<uint32_t> fill(offsets_.begin(), offsets_.end() - 1);
+        for (uint32_t doc = 0; doc < n_; ++doc)
+            for (auto [term, tf] : doc_terms[doc])
+                postings_[fill[term]++] = Posting{doc, tf};
+
+        idf_.resize(df.size());
+        for (size_t term = 0; term < df.size(); ++term)
+            idf_[term] = std::log((n_ - df[term] + 0.5) / (df[term] + 0.5) + 1.0);
+        for (uint32_t doc = 0; doc < n_; ++doc)
+        {
+            double dl = static_cast<double>(documents[doc]->size());
+            norms_[doc] = k1_ * (1 - b_ + (avg_dl_ > 0 ? b_ * dl / avg_dl_ : 0.0));
+        }
     }
 
-    /// Return indices of top_k documents sorted by BM25 score.
+    /// Return indices of top_k documents sorted by BM25 score. Equal scores keep
+    /// document order.
     std::vector<int> query(const std::string& text, int top_k) const
     {
         auto query_tokens = tokenize(text);
-        if (query_tokens.empty() || n_ == 0)
+        if (query_tokens.empty() || n_ == 0 || top_k <= 0)
             return {};
 
         std::vector<double> scores(n_, 0.0);
+        std::vector<uint32_t> matched;
         for (const auto& token : query_tokens)
         {
-            auto df_it = df_.find(token);
-            if (df_it == df_.end())
+            auto term_it = term_ids_.find(token);
+            if (term_it == term_ids_.end())
                 continue;
-            double idf = std::log((n_ - df_it->second + 0.5) / (df_it->second + 0.5) + 1.0);
-            for (int i = 0; i < n_; ++i)
+            const uint32_t term = term_it->second;
+            const double idf = idf_[term];
+            for (uint32_t p = offsets_[term]; p < offsets_[term + 1]; ++p)
             {
-                auto tf_it = tf_[i].find(token);
-                if (tf_it == tf_[i].end())
-                    continue;
-                double tf = tf_it->second;
-                double dl = doc_lengths_[i];
-                double numerator = tf * (k1_ + 1);
-                double denominator = tf + k1_ * (1 - b_ + b_ * dl / avg_dl_);
-                scores[i] += idf * numerator / denominator;
+                const auto& posting = postings_[p];
+                double tf = posting.tf;
+                if (scores[posting.doc] == 0.0)
+                    matched.push_back(posting.doc);
+                scores[posting.doc] += idf * tf * (k1_ + 1) / (tf + norms_[posting.doc]);
             }
         }
 
-        std::vector<int> indices(n_);
-        std::iota(indices.begin(), indices.end(), 0);
-        std::partial_sort(indices.begin(), indices.begin() + std::min(top_k, n_), indices.end(),
-                          [&](int a, int b_idx) { return scores[a] > scores[b_idx]; });
-
-        std::vector<int> result;
-        for (int i = 0; i < std::min(top_k, n_); ++i)
-            if (scores[indices[i]] > 0)
-                result.push_back(indices[i]);
-        return result;
+        // Bounded heap holding the best top_k; its front is the weakest kept document
+        auto better = [&scores](uint32_t a, uint32_t b_doc)
+        { return scores[a] > scores[b_doc] || (scores[a] == scores[b_doc] && a < b_doc); };
+        const size_t k = static_cast<size_t>(top_k);
+        std::vector<uint32_t> heap;
+        heap.reserve(std::min(k, matched.size()));
+        for (uint32_t doc : matched)
+        {
+            if (scores[doc] <= 0)
+                continue;
+            if (heap.size() < k)
+            {
+                heap.push_back(doc);
+                std::push_heap(heap.begin(), heap.end(), better);
+            }
+            else if (better(doc, heap.front()))
+            {
+                std::pop_heap(heap.begin(), heap.end(), better);
+                heap.back() = doc;
+                std::push_heap(heap.begin(), heap.end(), better);
+            }
+        }
+        std::sort_heap(heap.begin(), heap.end(), better);
+        return std::vector<int>(heap.begin(), heap.end());
     }
 
+    size_t size() const
+    {
+        return n_;
+    }
     double k1() const
     {
         return k1_;
@@ -123,22 +192,32 @@ class BM25Index
     }
 
   private:
+    struct Posting
+    {
+        uint32_t doc;
+        uint32_t tf;
+    };
+
     double k1_;
     double b_;
-    std::vector<std::vector<std::string>> doc_tokens_;
-    std::vector<int> doc_lengths_;
+    uint32_t n_ = 0;
     double avg_dl_ = 0.0;
-    std::unordered_map<std::string, int> df_;
-    std::vector<std::unordered_map<std::string, int>> tf_;
-    int n_ = 0;
+    std::unordered_map<std::string, uint32_t> term_ids_;
+    std::vector<uint32_t> offsets_; // Term t owns postings_[offsets_[t], offsets_[t + 1])
+    std::vector<Posting> postings_;
+    std::vector<double> idf_;
+    std::vector<double> norms_; // k1 * (1 - b + b * dl / avgdl) per document
 };
 
 } // namespace detail
 
 /// Search transform using BM25 Okapi relevance ranking.
 ///
-/// Maintains an in-memory index that is lazily rebuilt when the tool
-/// catalog changes (detected via hash of tool searchable text).
+/// Maintains an in-memory index that is rebuilt when the tool catalog changes.
+/// The index is an immutable snapshot published through an atomic shared_ptr:
+/// searches over an unchanged catalog take no lock. A changed catalog is
+/// re-indexed by one caller at a time, re-tokenizing only the tools that are new
+/// or differ from the previous snapshot.
 ///
 /// Parity with Python fastmcp BM25SearchTransform (commit c96c0400).
 class BM25SearchTransform : public BaseSearchTransform
@@ -149,28 +228,25 @@ class BM25SearchTransform : public BaseSearchTransform
     std::vector<tools::Tool> do_search(const std::vector<tools::Tool>& tools,
                                        const std::string& query) const override
     {
-        // Rebuild index if catalog changed
-        auto hash = catalog_hash(tools);
-        if (hash != last_hash_)
-        {
-            std::vector<std::string> documents;
-            documents.reserve(tools.size());
-            for (const auto& t : tools)
-                documents.push_back(extract_searchable_text(t));
-            index_ = detail::BM25Index(index_.k1(), index_.b());
-            index_.build(documents);
-            indexed_tools_ = tools;
-            last_hash_ = std::move(hash);
-        }
+        auto snapshot = std::atomic_load(&snapshot_);
+        if (!snapshot || !snapshot->indexes(tools))
+            snapshot = reindex(tools);
 
-        auto indices = index_.query(query, max_results());
+        auto indices = snapshot->index.query(query, max_results());
         std::vector<tools::Tool> result;
         result.reserve(indices.size());
         for (int i : indices)
-            result.push_back(indexed_tools_[i]);
+            result.push_back(snapshot->tools[i]);
         return result;
     }
 
+    /// Number of times the index has been (re)built; bumps whenever the catalog changes.
+    uint64_t index_generation() const
+    {
+        auto snapshot = std::atomic_load(&snapshot_);
+        return snapshot ? snapshot->generation : 0;
+    }
+
   protected:
     tools::Tool make_search_tool() const override
     {
@@ -193,33 +269,46 @@ class BM25SearchTransform : public BaseSearchTransform
     }
 
   private:
-    static std::string catalog_hash(const std::vector<tools::Tool>& tools)
+    struct Snapshot
     {
-        // Simple hash based on sorted tool names and descriptions
-        std::vector<std::string> texts;
-        texts.reserve(tools.size());
-        for (const auto& t : tools)
-            texts.push_back(extract_searchable_text(t));
-        std::sort(texts.begin(), texts.end());
-        std::string combined;
-        for (const auto& t : texts)
-        {
-            combined += t;
-            combined += '|';
-        }
-        // Simple hash — FNV-1a
-        uint64_t hash = 14695981039346656037ULL;
-        for (char c : combined)
+        uint64_t generation = 0;
+        std::vector<tools::Tool> tools;
+        std::vector<std::shared_ptr<const detail::Tokens>> documents;
+        detail::BM25Index index;
+
+        /// Whether `catalog` is exactly the indexed catalog, in the same order.
+        bool indexes(const std::vector<tools::Tool>& catalog) const
         {
-            hash ^= static_cast<uint64_t>(static_cast<unsigned char>(c));
-            hash *= 1099511628211ULL;
+            return std::equal(catalog.begin(), catalog.end(), tools.begin(), tools.end(),
+                              same_searchable_text);
         }
-        return std::to_string(hash);
+    };
+
+    std::shared_ptr<const Snapshot> reindex(const std::vector<tools::Tool>& tools) const
+    {
+        std::lock_guard<std::mutex> lock(reindex_mutex_);
+        auto previous = std::atomic_load(&snapshot_);
+        if (previous && previous->indexes(tools))
+            return previous; // Another caller re-indexed this catalog meanwhile
+
+        static const Snapshot empty;
+        const Snapshot& prior = previous ? *previous : empty;
+        auto next = std::make_shared<Snapshot>();
+        next->generation = prior.generation + 1;
+        next->tools = tools;
+        next->documents = derive_documents<detail::Tokens>(
+            tools, prior.tools, prior.documents,
+            [](const tools::Tool& tool)
+            { return detail::tokenize(extract_searchable_text(tool)); });
+        next->index.build(next->documents);
+
+        std::shared_ptr<const Snapshot> published = std::move(next);
+        std::atomic_store(&snapshot_, published);
+        return published;
     }
 
-    mutable detail::BM25Index index_;
-    mutable std::vector<tools::Tool> indexed_tools_;
-    mutable std::string last_hash_;
+    mutable std::shared_ptr<const Snapshot> snapshot_; // Accessed only via std::atomic_*
+    mutable std::mutex reindex_mutex_;
 };
 
 } // namespace fastmcpp::providers::transforms::search
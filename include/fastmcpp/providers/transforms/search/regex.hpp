@@ -2,42 +2,346 @@
 
 #include "fastmcpp/providers/transforms/search/base.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <regex>
+#include <unordered_map>
 
 namespace fastmcpp::providers::transforms::search
 {
 
+/// Tests one tool's searchable text against a compiled pattern. Called concurrently.
+using PatternMatcher = std::function<bool(const std::string& text)>;
+
+/// Compiles a search pattern (case-insensitive) into a matcher; throws on an invalid
+/// pattern. Lets a linear-time engine such as RE2 replace std::regex.
+using PatternCompiler = std::function<PatternMatcher(const std::string& pattern)>;
+
+namespace detail
+{
+
+inline std::string ascii_lower(std::string text)
+{
+    for (auto& c : text)
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return text;
+}
+
+/// Whether `pattern` has no ECMAScript metacharacters, i.e. matches itself.
+inline bool is_literal_pattern(const std::string& pattern)
+{
+    return pattern.find_first_of("\\^$.|?*+()[]{}") == std::string::npos;
+}
+
+/// Lowercased literal strings that any match of an ECMAScript `pattern` must contain.
+///
+/// Conservative: anything optional, alternated, repeated or not a plain character
+/// ends the current literal, so the result may miss requirements but never adds one.
+/// Only literals of at least three characters are returned (shorter ones have no
+/// trigram). Assumes the pattern is valid.
+class RequiredLiterals
+{
+  public:
+    static std::vector<std::string> of(const std::string& pattern)
+    {
+        RequiredLiterals parser(pattern);
+        std::vector<std::string> literals;
+        parser.sequence(literals);
+        return literals;
+    }
+
+  private:
+    explicit RequiredLiterals(const std::string& pattern) : p_(pattern) {}
+
+    /// Parse up to the closing ')' of the current group (or the end). Returns false,
+    /// adding nothing, if the sequence contains a top-level alternation.
+    bool sequence(std::vector<std::string>& out)
+    {
+        std::vector<std::string> found;
+        std::string run;
+        bool alternation = false;
+        auto flush = [&]()
+        {
+            if (run.size() >= 3)
+                found.push_back(run);
+            run.clear();
+        };
+
+        while (i_ < p_.size() && p_[i_] != ')')
+        {
+            if (p_[i_] == '|')
+            {
+                alternation = true;
+                ++i_;
+                flush();
+                continue;
+            }
+
+            std::optional<char> literal;
+            std::vector<std::string> group;
+            bool group_required = false;
+            atom(literal, group, group_required);
+
+            bool optional = false;
+            bool repeated = false;
+            quantifier(optional, repeated);
+
+            if (literal && !optional)
+            {
+                run.push_back(
+                    static_cast<char>(std::tolower(static_cast<unsigned char>(*literal))));
+                if (repeated)
+                    flush();
+                continue;
+            }
+            flush();
+            if (group_required && !optional)
+                found.insert(found.end(), group.begin(), group.end());
+        }
+        flush();
+        if (alternation)
+            return false;
+        out.insert(out.end(), found.begin(), found.end());
+        return true;
+    }
+
+    void atom(std::optional<char>& literal, std::vector<std::string>& group, bool& group_required)
+    {
+        char c = p_[i_++];
+        switch (c)
+        {
+        case '\\':
+            escape(literal);
+            return;
+        case '[':
+            skip_class();
+            return;
+        case '(':
+        {
+            bool lookaround = false;
+            if (i_ + 1 < p_.size() && p_[i_] == '?')
+            {
+                lookaround = p_[i_ + 1] != ':';
+                i_ += 2;
+            }
+            group_required = sequence(group) && !lookaround;
+            if (i_ < p_.size())
+                ++i_; // ')'
+            return;
+        }
+        case '.':
+        case '^':
+        case '$':
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+        case '}':
+        case ']':
+            return;
+        default:
+            literal = c;
+        }
+    }
+
+    void escape(std::optional<char>& literal)
+    {
+        if (i_ >= p_.size())
+            return;
+        char e = p_[i_++];
+        if (!std::isalnum(static_cast<unsigned char>(e)))
+        {
+            literal = e;
+            return;
+        }
+        // Character escapes with operands; everything else is a class, an assertion
+        // or a control character
+        if (e == 'x')
+            i_ = std::min(p_.size(), i_ + 2);
+        else if (e == 'u')
+            i_ = std::min(p_.size(), i_ + 4);
+        else if (e == 'c')
+            i_ = std::min(p_.size(), i_ + 1);
+        else if (std::isdigit(static_cast<unsigned char>(e)))
+            while (i_ < p_.size() && std::isdigit(static_cast<unsigned char>(p_[i_])))
+                ++i_;
+    }
+
+    void skip_class()
+    {
+        if (i_ < p_.size() && p_[i_] == '^')
+            ++i_;
+        if (i_ < p_.size() && p_[i_] == ']')
+            ++i_;
+        while (i_ < p_.size() && p_[i_] != ']')
+            i_ += p_[i_] == '\\' ? 2 : 1;
+        if (i_ < p_.size())
+            ++i_;
+    }
+
+    void quantifier(bool& optional, bool& repeated)
+    {
+        if (i_ >= p_.size())
+            return;
+        char q = p_[i_];
+        if (q == '*' || q == '?')
+            optional = true;
+        else if (q == '+')
+            repeated = true;
+        else if (q == '{' && i_ + 1 < p_.size() &&
+                 std::isdigit(static_cast<unsigned char>(p_[i_ + 1])))
+        {
+            size_t close = p_.find('}', i_);
+            if (close == std::string::npos)
+                return;
+            // {0}, {0,} and {0,n} may match nothing
+            optional = p_[i_ + 1] == '0' && (i_ + 2 >= p_.size() ||
+                                             !std::isdigit(static_cast<unsigned char>(p_[i_ + 2])));
+            repeated = !optional;
+            i_ = close;
+        }
+        else
+            return;
+        ++i_;
+        if (i_ < p_.size() && p_[i_] == '?')
+            ++i_; // Lazy
+    }
+
+    const std::string& p_;
+    size_t i_ = 0;
+};
+
+/// Trigram postings over lowercased documents. A document containing a string
+/// contains all of its trigrams, so intersecting their postings gives a superset
+/// of the documents that can match.
+class TrigramIndex
+{
+  public:
+    void build(const std::vector<const std::string*>& documents)
+    {
+        postings_.clear();
+        size_ = static_cast<uint32_t>(documents.size());
+        std::vector<uint32_t> trigrams;
+        for (uint32_t doc = 0; doc < size_; ++doc)
+        {
+            trigrams.clear();
+            const auto& text = *documents[doc];
+            for (size_t i = 0; i + 3 <= text.size(); ++i)
+                trigrams.push_back(key(text, i));
+            std::sort(trigrams.begin(), trigrams.end());
+            trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+            for (uint32_t trigram : trigrams)
+                postings_[trigram].push_back(doc); // Ascending, as docs are visited in order
+        }
+    }
+
+    /// Documents that may contain every string of `literals` (each at least three
+    /// characters), in ascending order. With no literals, every document.
+    std::vector<uint32_t> candidates(const std::vector<std::string>& literals) const
+    {
+        std::vector<const std::vector<uint32_t>*> lists;
+        for (const auto& literal : literals)
+        {
+            for (size_t i = 0; i + 3 <= literal.size(); ++i)
+            {
+                auto it = postings_.find(key(literal, i));
+                if (it == postings_.end())
+                    return {};
+                lists.push_back(&it->second);
+            }
+        }
+
+        std::vector<uint32_t> result;
+        if (lists.empty())
+        {
+            result.resize(size_);
+            for (uint32_t doc = 0; doc < size_; ++doc)
+                result[doc] = doc;
+            return result;
+        }
+        // Intersect from the shortest list, which bounds the result
+        std::sort(lists.begin(), lists.end(),
+                  [](const auto* a, const auto* b) { return a->size() < b->size(); });
+        result = *lists.front();
+        std::vector<uint32_t> narrowed;
+        for (size_t l = 1; l < lists.size() && !result.empty(); ++l)
+        {
+            narrowed.clear();
+            std::set_intersection(result.begin(), result.end(), lists[l]->begin(), lists[l]->end(),
+                                  std::back_inserter(narrowed));
+            result.swap(narrowed);
+        }
+        return result;
+    }
+
+  private:
+    static uint32_t key(const std::string& text, size_t i)
+    {
+        return static_cast<uint32_t>(static_cast<unsigned char>(text[i])) << 16 |
+               static_cast<uint32_t>(static_cast<unsigned char>(text[i + 1])) << 8 |
+               static_cast<uint32_t>(static_cast<unsigned char>(text[i + 2]));
+    }
+
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings_;
+    uint32_t size_ = 0;
+};
+
+} // namespace detail
+
 /// Search transform using regex pattern matching.
 ///
 /// Tools are matched against their name, description, and parameter
-/// information using std::regex_search with case-insensitive matching.
+/// information with case-insensitive ECMAScript regexes (or the engine supplied
+/// as a PatternCompiler).
+///
+/// The searchable text of the catalog is extracted once and indexed by trigram
+/// in an immutable snapshot, rebuilt only when the catalog changes (see
+/// BM25SearchTransform). A search narrows the catalog to the tools containing
+/// every literal fragment the pattern requires and runs the regex on those only.
+/// Patterns without metacharacters skip the regex engine and are matched as
+/// substrings. Compiled patterns are cached.
 ///
 /// Parity with Python fastmcp RegexSearchTransform (commit c96c0400).
 class RegexSearchTransform : public BaseSearchTransform
 {
   public:
-    explicit RegexSearchTransform(Options opts = {}) : BaseSearchTransform(std::move(opts)) {}
+    explicit RegexSearchTransform(Options opts = {}, PatternCompiler compiler = {})
+        : BaseSearchTransform(std::move(opts)), compiler_(std::move(compiler))
+    {
+        if (!compiler_)
+            compiler_ = [](const std::string& pattern) -> PatternMatcher
+            {
+                auto regex = std::make_shared<const std::regex>(
+                    pattern, std::regex_constants::ECMAScript | std::regex_constants::icase);
+                return [regex](const std::string& text) { return std::regex_search(text, *regex); };
+            };
+    }
 
     std::vector<tools::Tool> do_search(const std::vector<tools::Tool>& tools,
                                        const std::string& query) const override
     {
-        std::regex pattern;
-        try
-        {
-            pattern = std::regex(query, std::regex_constants::icase);
-        }
-        catch (const std::regex_error&)
-        {
+        auto pattern = compile(query);
+        if (!pattern)
             return {};
-        }
+
+        auto snapshot = std::atomic_load(&snapshot_);
+        if (!snapshot || !snapshot->indexes(tools))
+            snapshot = reindex(tools);
 
         std::vector<tools::Tool> matches;
-        for (const auto& tool : tools)
+        for (uint32_t doc : snapshot->trigrams.candidates(pattern->literals))
         {
-            std::string text = extract_searchable_text(tool);
-            if (std::regex_search(text, pattern))
+            const auto& text = *snapshot->texts[doc];
+            bool matched = pattern->substring
+                               ? text.lowered.find(*pattern->substring) != std::string::npos
+                               : pattern->matcher(text.original);
+            if (matched)
             {
-                matches.push_back(tool);
+                matches.push_back(snapshot->tools[doc]);
                 if (static_cast<int>(matches.size()) >= max_results())
                     break;
             }
@@ -66,6 +370,113 @@ class RegexSearchTransform : public BaseSearchTransform
         return tools::Tool(search_tool_name(), std::move(input_schema), Json::object(),
                            std::move(fn));
     }
+
+  private:
+    static constexpr size_t kMaxCachedPatterns = 256;
+
+    struct CompiledPattern
+    {
+        std::vector<std::string> literals;    // Prefilter: lowercased required fragments
+        std::optional<std::string> substring; // Set for metacharacter-free patterns
+        PatternMatcher matcher;
+    };
+
+    struct SearchText
+    {
+        std::string original;
+        std::string lowered;
+    };
+
+    struct Snapshot
+    {
+        std::vector<tools::Tool> tools;
+        std::vector<std::shared_ptr<const SearchText>> texts;
+        detail::TrigramIndex trigrams;
+
+        bool indexes(const std::vector<tools::Tool>& catalog) const
+        {
+            return std::equal(catalog.begin(), catalog.end(), tools.begin(), tools.end(),
+                              same_searchable_text);
+        }
+    };
+
+    /// @return nullptr if the pattern does not compile
+    std::shared_ptr<const CompiledPattern> compile(const std::string& query) const
+    {
+        {
+            std::lock_guard<std::mutex> lock(patterns_mutex_);
+            auto it = patterns_.find(query);
+            if (it != patterns_.end())
+                return it->second;
+        }
+
+        std::shared_ptr<CompiledPattern> pattern;
+        if (detail::is_literal_pattern(query))
+        {
+            pattern = std::make_shared<CompiledPattern>();
+            pattern->substring = detail::ascii_lower(query);
+            if (pattern->substring->size() >= 3)
+                pattern->literals.push_back(*pattern->substring);
+        }
+        else
+        {
+            try
+            {
+                auto matcher = compiler_(query);
+                if (matcher)
+                {
+                    pattern = std::make_shared<CompiledPattern>();
+                    pattern->matcher = std::move(matcher);
+                    pattern->literals = detail::RequiredLiterals::of(query);
+                }
+            }
+            catch (const std::exception&)
+            {
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(patterns_mutex_);
+        if (patterns_.size() >= kMaxCachedPatterns)
+            patterns_.clear();
+        patterns_.emplace(query, pattern);
+        return pattern;
+    }
+
+    std::shared_ptr<const Snapshot> reindex(const std::vector<tools::Tool>& tools) const
+    {
+        std::lock_guard<std::mutex> lock(reindex_mutex_);
+        auto previous = std::atomic_load(&snapshot_);
+        if (previous && previous->indexes(tools))
+            return previous;
+
+        static const Snapshot empty;
+        const Snapshot& prior = previous ? *previous : empty;
+        auto next = std::make_shared<Snapshot>();
+        next->tools = tools;
+        next->texts =
+            derive_documents<SearchText>(tools, prior.tools, prior.texts,
+                                         [](const tools::Tool& tool)
+                                         {
+                                             auto text = extract_searchable_text(tool);
+                                             auto lowered = detail::ascii_lower(text);
+                                             return SearchText{std::move(text), std::move(lowered)};
+                                         });
+        std::vector<const std::string*> lowered;
+        lowered.reserve(next->texts.size());
+        for (const auto& text : next->texts)
+            lowered.push_back(&text->lowered);
+        next->trigrams.build(lowered);
+
+        std::shared_ptr<const Snapshot> published = std::move(next);
+        std::atomic_store(&snapshot_, published);
+        return published;
+    }
+
+    PatternCompiler compiler_;
+    mutable std::shared_ptr<const Snapshot> snapshot_; // Accessed only via std::atomic_*
+    mutable std::mutex reindex_mutex_;
+    mutable std::mutex patterns_mutex_;
+    mutable std::unordered_map<std::string, std::shared_ptr<const CompiledPattern>> patterns_;
 };
 
 } // namespace fastmcpp::providers::transforms::search
@@ -5,6 +5,7 @@
 #include "fastmcpp/resources/template.hpp"
 #include "fastmcpp/tools/tool.hpp"
 
+#include <cstdint>
 #include <functional>
 #include <optional>
 #include <string>
@@ -31,6 +32,13 @@ class Transform
   public:
     virtual ~Transform() = default;
 
+    /// Change stamp for transforms with mutable state. Stateless transforms keep the
+    /// default; stateful ones must return a new value whenever their output could change.
+    virtual uint64_t generation() const
+    {
+        return 0;
+    }
+
     virtual std::vector<tools::Tool> list_tools(const ListToolsNext& call_next) const
     {
         return call_next();
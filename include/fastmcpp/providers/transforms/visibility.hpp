@@ -1,6 +1,7 @@
 #pragma once
 
 #include "fastmcpp/providers/transforms/transform.hpp"
+#include "fastmcpp/util/generation.hpp"
 
 #include <string>
 #include <unordered_set>
@@ -39,6 +40,11 @@ class Visibility : public Transform
 
     bool is_enabled(const std::string& key) const;
 
+    uint64_t generation() const override
+    {
+        return generation_.value();
+    }
+
     std::vector<tools::Tool> list_tools(const ListToolsNext& call_next) const override;
     std::optional<tools::Tool> get_tool(const std::string& name,
                                         const GetToolNext& call_next) const override;
@@ -64,6 +70,7 @@ class Visibility : public Transform
     std::unordered_set<std::string> disabled_keys_;
     std::unordered_set<std::string> enabled_keys_;
     bool default_enabled_{true};
+    util::GenerationStamp generation_;
 };
 
 } // namespace fastmcpp::providers::transforms
@@ -6,6 +6,8 @@
 #include "fastmcpp/server/server.hpp"
 #include "fastmcpp/tools/manager.hpp"
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -15,12 +17,35 @@
 namespace fastmcpp
 {
 
+/// Counters of a ProxyApp's remote catalog cache and client pool.
+struct ProxyCacheStats
+{
+    uint64_t hits{0};            ///< Remote lists answered from the cache
+    uint64_t misses{0};          ///< Remote lists fetched from the backend
+    uint64_t invalidations{0};   ///< Cached lists dropped by list_changed or invalidate_catalog()
+    uint64_t clients_created{0}; ///< Calls made to the client factory
+    size_t idle_clients{0};      ///< Clients parked for reuse right now
+};
+
+namespace detail
+{
+/// Client pool and catalog cache shared by a ProxyApp and its clients' notification
+/// handlers (see proxy.cpp).
+struct ProxyRemote;
+} // namespace detail
+
 /// ProxyApp - An MCP server that proxies to a backend server
 ///
 /// This class creates an MCP server that forwards requests to a backend
 /// MCP server while also supporting local tools/resources/prompts.
 /// Local items take precedence over remote items.
 ///
+/// Clients from the factory are kept in a small pool and reused across requests;
+/// a client whose call failed with a TransportError is dropped instead. Remote
+/// lists are cached for catalog_ttl() and dropped early when the backend sends
+/// `notifications/{tools,resources,prompts}/list_changed` over a transport that
+/// delivers notifications.
+///
 /// Usage:
 /// ```cpp
 /// // Create a client factory that returns connections to the backend
@@ -137,8 +162,31 @@ class ProxyApp
         return client_factory_();
     }
 
+    // =========================================================================
+    // Remote Caching
+    // =========================================================================
+
+    /// How long remote lists are served from the cache (default 30s). Zero disables
+    /// caching, so every list goes to the backend.
+    std::chrono::milliseconds catalog_ttl() const;
+    void set_catalog_ttl(std::chrono::milliseconds ttl);
+
+    /// Upper bound on idle clients kept for reuse (default 4). Zero disables pooling.
+    void set_max_idle_clients(size_t max_idle);
+
+    /// Drop every cached remote list.
+    void invalidate_catalog();
+
+    /// Drop the cached lists a `notifications/<kind>/list_changed` method refers to.
+    /// Use this to forward notifications the backend transport cannot deliver itself.
+    /// @return false if `method` is not a list_changed notification
+    bool handle_list_changed(const std::string& method);
+
+    ProxyCacheStats cache_stats() const;
+
   private:
     ClientFactory client_factory_;
+    std::shared_ptr<detail::ProxyRemote> remote_;
     std::string name_;
     std::string version_;
     std::optional<std::string> instructions_;
@@ -175,8 +223,9 @@ class ProxyApp
 /// Note: To proxy to another FastMCP server instance, use FastMCP::mount() instead.
 /// For transports, create a Client first then pass it to create_proxy().
 ///
-/// Session strategy: Always creates fresh sessions per request for safety.
-/// This differs from Python's behavior which can reuse connected client sessions.
+/// Session strategy: clients are pooled and reused across requests, like a connected
+/// Python client session; a client is replaced after a transport failure. Clients
+/// created from a Client share its transport.
 ///
 /// Args:
 ///     target: The backend to proxy to (Client or URL)
@@ -2,6 +2,8 @@
 #include "fastmcpp/exceptions.hpp"
 #include "fastmcpp/resources/resource.hpp"
 #include "fastmcpp/resources/template.hpp"
+#include "fastmcpp/resources/uri_router.hpp"
+#include "fastmcpp/util/generation.hpp"
 
 #include <optional>
 #include <unordered_map>
@@ -16,12 +18,15 @@ class ResourceManager
     void register_resource(const Resource& res)
     {
         by_uri_[res.uri] = res;
+        generation_.bump();
     }
 
     void register_template(ResourceTemplate templ)
     {
         templ.parse();
         templates_.push_back(std::move(templ));
+        router_.add(templates_.back());
+        generation_.bump();
     }
 
     const Resource& get(const std::string& uri) const
@@ -62,24 +67,21 @@ class ResourceManager
             return ResourceContent{uri, it->second.mime_type, std::string{}};
         }
 
-        // Try template matching
-        for (const auto& templ : templates_)
+        // Then the first matching template
+        if (auto match = router_.match(uri))
         {
-            auto match_params = templ.match(uri);
-            if (match_params)
-            {
-                // Merge explicit params with matched params (explicit takes precedence).
-                // Matched values are string-typed; coerce them per-param against the
-                // template's parameter schema. Parity with Python fastmcp 9ccaef2b:
-                // invalid booleans / numbers raise ValidationError.
-                Json merged_params = templ.build_typed_params(*match_params);
-                for (const auto& [key, value] : params.items())
-                    merged_params[key] = value;
-
-                if (templ.provider)
-                    return templ.provider(merged_params);
-                return ResourceContent{uri, templ.mime_type, std::string{}};
-            }
+            const auto& templ = templates_[match->index];
+            // Merge explicit params with matched params (explicit takes precedence).
+            // Matched values are string-typed; coerce them per-param against the
+            // template's parameter schema. Parity with Python fastmcp 9ccaef2b:
+            // invalid booleans / numbers raise ValidationError.
+            Json merged_params = router_.typed_params(*match);
+            for (const auto& [key, value] : params.items())
+                merged_params[key] = value;
+
+            if (templ.provider)
+                return templ.provider(merged_params);
+            return ResourceContent{uri, templ.mime_type, std::string{}};
         }
 
         throw NotFoundError("Resource not found: " + uri);
@@ -89,18 +91,23 @@ class ResourceManager
     std::optional<std::pair<const ResourceTemplate*, std::unordered_map<std::string, std::string>>>
     match_template(const std::string& uri) const
     {
-        for (const auto& templ : templates_)
-        {
-            auto params = templ.match(uri);
-            if (params)
-                return std::make_pair(&templ, *params);
-        }
-        return std::nullopt;
+        auto match = router_.match(uri);
+        if (!match)
+            return std::nullopt;
+        return std::make_pair(&templates_[match->index], std::move(match->params));
+    }
+
+    /// Change stamp; differs after every registration (see util::GenerationStamp).
+    uint64_t generation() const
+    {
+        return generation_.value();
     }
 
   private:
     std::unordered_map<std::string, Resource> by_uri_;
     std::vector<ResourceTemplate> templates_;
+    UriTemplateRouter router_; // Over templates_, in registration order
+    util::GenerationStamp generation_;
 };
 
 } // namespace fastmcpp::resources
@@ -2,22 +2,89 @@
 #include "fastmcpp/resources/types.hpp"
 #include "fastmcpp/types.hpp"
 
+#include <cstdint>
+#include <filesystem>
 #include <functional>
 #include <optional>
 #include <string>
+#include <utility>
 #include <variant>
+#include <vector>
 
 namespace fastmcpp::resources
 {
 
+/// Resource payload produced in chunks on demand rather than held in memory.
+///
+/// Each write_to() produces the whole payload from the start, so a stream can be
+/// encoded, forwarded or read again without ever being buffered in full. Copies
+/// share the producer.
+class ContentStream
+{
+  public:
+    /// Receives consecutive pieces of the payload; valid only during the call
+    using ChunkSink = std::function<void(const char* data, size_t size)>;
+    using Producer = std::function<void(const ChunkSink& sink)>;
+
+    /// @param size Payload length when known up front (lets consumers presize)
+    /// @param text Whether the payload is UTF-8 text rather than binary data
+    explicit ContentStream(Producer producer, std::optional<uint64_t> size = std::nullopt,
+                           bool text = false)
+        : producer_(std::move(producer)), size_(size), text_(text)
+    {
+    }
+
+    /// Streams `length` bytes of `path` from `offset` (the rest of the file when
+    /// unset), read through a bounded buffer and opened anew by each write_to().
+    /// Safe for files edited while they are read: a truncated file ends the stream
+    /// early. Throws NotFoundError if `path` is not a regular file.
+    static ContentStream from_file(const std::filesystem::path& path, bool text = false,
+                                   uint64_t offset = 0,
+                                   std::optional<uint64_t> length = std::nullopt);
+
+    /// Like from_file(), but memory-maps the file where supported, saving a copy per
+    /// chunk. Only for files nothing truncates while a write_to() runs: touching a
+    /// mapped page past the new end of file raises SIGBUS and kills the process.
+    static ContentStream from_mapped_file(const std::filesystem::path& path, bool text = false,
+                                          uint64_t offset = 0,
+                                          std::optional<uint64_t> length = std::nullopt);
+
+    void write_to(const ChunkSink& sink) const
+    {
+        producer_(sink);
+    }
+
+    /// The whole payload in one string
+    std::string read_all() const;
+
+    std::optional<uint64_t> size() const
+    {
+        return size_;
+    }
+    bool is_text() const
+    {
+        return text_;
+    }
+
+  private:
+    Producer producer_;
+    std::optional<uint64_t> size_;
+    bool text_;
+};
+
 /// Content returned by a resource read operation
 struct ResourceContent
 {
     std::string uri;
     std::optional<std::string> mime_type;
-    std::variant<std::string, std::vector<uint8_t>> data; // text or binary
+    std::variant<std::string, std::vector<uint8_t>, ContentStream> data; // text, binary or stream
 };
 
+/// MCP resources/read entry for `content`: {uri, mimeType?, text | blob}.
+/// Binary data and streams are base64-encoded block by block straight into the
+/// result, so only the encoded form is ever held in memory.
+Json content_to_json(ResourceContent content);
+
 /// MCP Resource definition
 struct Resource
 {
@@ -3,8 +3,8 @@
 #include "fastmcpp/types.hpp"
 
 #include <functional>
+#include <memory>
 #include <optional>
-#include <regex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -12,6 +12,8 @@
 namespace fastmcpp::resources
 {
 
+class UriTemplateRouter;
+
 /// Type annotation for a URI template parameter.
 ///
 /// When a parameter's kind is anything other than String, matched values go
@@ -58,9 +60,9 @@ struct ResourceTemplate
 
     // Parsed template info (populated by parse())
     std::vector<TemplateParameter> parsed_params;
-    std::regex uri_regex;
+    std::shared_ptr<const UriTemplateRouter> matcher; // Routes this template alone
 
-    /// Parse the URI template and build regex
+    /// Parse the URI template and compile its matcher
     void parse();
 
     /// Check if URI matches template and extract parameters
@@ -84,9 +86,13 @@ std::vector<std::string> extract_path_params(const std::string& uri_template);
 /// Extract query parameters from URI template: {?a,b,c}
 std::vector<std::string> extract_query_params(const std::string& uri_template);
 
-/// Build regex pattern from URI template
+/// Build regex pattern from URI template. Matching no longer uses it (see UriTemplateRouter),
+/// but the pattern still defines the semantics the router reproduces.
 std::string build_regex_pattern(const std::string& uri_template);
 
+/// Key under which a parameter's value is exposed: hyphens become underscores.
+std::string normalize_param_key(const std::string& name);
+
 /// URL-decode a string
 std::string url_decode(const std::string& encoded);
 
@@ -0,0 +1,107 @@
+#pragma once
+/// @file uri_router.hpp
+/// @brief Compiled matcher for a set of URI templates.
+
+#include "fastmcpp/resources/template.hpp"
+#include "fastmcpp/types.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fastmcpp::resources
+{
+
+/// Routes URIs to the first matching template of a registration-ordered set.
+///
+/// Templates are compiled into one radix tree: literal text shares common
+/// prefixes along compressed edges, while {var}, {var*} and {?query} each have a
+/// dedicated child kind. Matching walks the tree once for all templates,
+/// capturing placeholder values as it goes, instead of trying each template's
+/// std::regex in turn. Results are those of ResourceTemplate's regex semantics
+/// ({var} = [^/?#]+, {var*} = .+, both greedy; earliest template wins).
+///
+/// Immutable during match(); add() and clear() need external synchronization.
+class UriTemplateRouter
+{
+  public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    struct Match
+    {
+        size_t index; ///< Position of the template in add() order
+        /// Same as ResourceTemplate::match(): normalized name -> decoded value
+        std::unordered_map<std::string, std::string> params;
+    };
+
+    /// Add `templ` after every template added so far. Parameter kinds are taken
+    /// from `templ.parsed_params`, so parse() should have run.
+    void add(const ResourceTemplate& templ);
+
+    void clear();
+
+    size_t size() const
+    {
+        return templates_.size();
+    }
+    bool empty() const
+    {
+        return templates_.empty();
+    }
+
+    /// @return The earliest added template matching `uri` with its parameters
+    std::optional<Match> match(const std::string& uri) const;
+
+    /// Parameters of `match` coerced per the template's declared kinds, as
+    /// ResourceTemplate::build_typed_params() does. Throws ValidationError.
+    Json typed_params(const Match& match) const;
+
+  private:
+    using NodeId = uint32_t;
+    static constexpr NodeId kNoNode = std::numeric_limits<NodeId>::max();
+
+    struct Edge
+    {
+        std::string label; // Never empty; edges of a node differ in their first character
+        NodeId child;
+    };
+
+    struct Node
+    {
+        std::vector<Edge> literals; // Sorted by first character
+        NodeId param = kNoNode;     // {var}
+        NodeId wildcard = kNoNode;  // {var*}
+        NodeId query = kNoNode;     // {?a,b}
+        size_t terminal = npos;     // Earliest template ending here
+        size_t min_template = npos; // Earliest template anywhere below (for pruning)
+    };
+
+    struct CompiledTemplate
+    {
+        std::vector<std::string> path_names;  // Placeholder names, in capture order
+        std::vector<std::string> query_names; // Names listed in {?...}
+        std::unordered_map<std::string, ParamKind> kinds;
+    };
+
+    struct Span
+    {
+        size_t begin;
+        size_t end;
+    };
+
+    struct Search;
+
+    /// Position of the edge starting with `c`, or where it would be inserted
+    static size_t edge_at(const Node& node, char c);
+    NodeId new_node();
+    NodeId insert_literal(NodeId node, const std::string& text, size_t index);
+    NodeId child(NodeId node, NodeId Node::*slot, size_t index);
+
+    std::vector<Node> nodes_;
+    std::vector<CompiledTemplate> templates_;
+};
+
+} // namespace fastmcpp::resources
@@ -3,6 +3,7 @@
 #include "fastmcpp/resources/resource.hpp"
 #include "fastmcpp/server/elicitation.hpp"
 #include "fastmcpp/server/session.hpp"
+#include "fastmcpp/tools/execution_pool.hpp"
 #include "fastmcpp/types.hpp"
 
 #include <any>
@@ -237,6 +238,16 @@ class Context
         return std::nullopt;
     }
 
+    /// Cancellation token of the timed tool call running on this thread.
+    const tools::CancellationToken& cancellation_token() const
+    {
+        return tools::current_cancellation_token();
+    }
+    bool is_cancelled() const
+    {
+        return tools::current_cancellation_token().is_cancelled();
+    }
+
     std::optional<std::string> progress_token() const
     {
         if (request_meta_.has_value() && request_meta_->contains("progressToken"))
@@ -0,0 +1,301 @@
+#pragma once
+/// @file session_registry.hpp
+/// @brief Sharded session table with capacity limit and idle-TTL eviction.
+
+#include "fastmcpp/util/timer_wheel.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fastmcpp::server
+{
+
+/// Sessions of one transport, keyed by session id.
+///
+/// The table is split into shards with a reader-writer lock each, so a lookup
+/// only takes a shared lock on one shard and lookups for different sessions
+/// never contend. Every find() records the time of use with a relaxed atomic
+/// store, which is what idle eviction measures.
+///
+/// Idle eviction arms one timer per session on a util::TimerWheel. A timer that
+/// fires for a session used in the meantime re-arms itself for the remaining
+/// time, so touching a session never reschedules anything. The wheel must be
+/// destroyed (or eviction disabled and the wheel drained) before the registry.
+template <typename T>
+class SessionRegistry
+{
+  public:
+    using Ptr = std::shared_ptr<T>;
+    using EvictCallback = std::function<void(const std::string& session_id, const Ptr&)>;
+
+    static constexpr size_t kShardCount = 16;
+
+    explicit SessionRegistry(size_t capacity = 1000) : capacity_(capacity) {}
+
+    SessionRegistry(const SessionRegistry&) = delete;
+    SessionRegistry& operator=(const SessionRegistry&) = delete;
+
+    size_t capacity() const
+    {
+        return capacity_.load(std::memory_order_relaxed);
+    }
+    /// Lowering the capacity keeps existing sessions; only new inserts are refused.
+    void set_capacity(size_t capacity)
+    {
+        capacity_.store(capacity, std::memory_order_relaxed);
+    }
+
+    size_t size() const
+    {
+        return size_.load(std::memory_order_relaxed);
+    }
+    bool full() const
+    {
+        return size() >= capacity();
+    }
+
+    /// Sessions removed for being idle since construction.
+    uint64_t evicted() const
+    {
+        return evicted_.load(std::memory_order_relaxed);
+    }
+
+    /// @return false if the registry is full or `session_id` is taken
+    bool insert(const std::string& session_id, Ptr value)
+    {
+        if (size_.fetch_add(1, std::memory_order_relaxed) >= capacity())
+        {
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+        auto& shard = shard_for(session_id);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto [it, inserted] = shard.slots.try_emplace(session_id, std::move(value), now_ns());
+        if (!inserted)
+        {
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (auto* wheel = wheel_.load(std::memory_order_acquire))
+            it->second.timer = arm(*wheel, session_id, idle_timeout());
+        return true;
+    }
+
+    /// Look up a session and mark it as used.
+    /// @return nullptr if unknown
+    Ptr find(const std::string& session_id) const
+    {
+        auto& shard = shard_for(session_id);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.slots.find(session_id);
+        if (it == shard.slots.end())
+            return nullptr;
+        it->second.last_used_ns.store(now_ns(), std::memory_order_relaxed);
+        return it->second.value;
+    }
+
+    bool contains(const std::string& session_id) const
+    {
+        return find(session_id) != nullptr;
+    }
+
+    /// @return The removed session, or nullptr if it was not present
+    Ptr erase(const std::string& session_id)
+    {
+        auto& shard = shard_for(session_id);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.slots.find(session_id);
+        if (it == shard.slots.end())
+            return nullptr;
+        Ptr value = std::move(it->second.value);
+        if (auto* wheel = wheel_.load(std::memory_order_acquire); wheel && it->second.timer)
+            wheel->cancel(it->second.timer);
+        shard.slots.erase(it);
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return value;
+    }
+
+    /// Remove `session_id` only while it still maps to `value`.
+    bool erase_if_same(const std::string& session_id, const Ptr& value)
+    {
+        auto& shard = shard_for(session_id);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.slots.find(session_id);
+        if (it == shard.slots.end() || it->second.value != value)
+            return false;
+        if (auto* wheel = wheel_.load(std::memory_order_acquire); wheel && it->second.timer)
+            wheel->cancel(it->second.timer);
+        shard.slots.erase(it);
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// Copy of every session, taken one shard at a time (not an atomic snapshot).
+    std::vector<Ptr> snapshot() const
+    {
+        std::vector<Ptr> out;
+        out.reserve(size());
+        for (auto& shard : shards_)
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (const auto& [id, slot] : shard.slots)
+                out.push_back(slot.value);
+        }
+        return out;
+    }
+
+    void clear()
+    {
+        auto* wheel = wheel_.load(std::memory_order_acquire);
+        for (auto& shard : shards_)
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            if (wheel)
+                for (const auto& [id, slot] : shard.slots)
+                    if (slot.timer)
+                        wheel->cancel(slot.timer);
+            size_.fetch_sub(shard.slots.size(), std::memory_order_relaxed);
+            shard.slots.clear();
+        }
+    }
+
+    std::chrono::milliseconds idle_timeout() const
+    {
+        return std::chrono::milliseconds(idle_timeout_ms_.load(std::memory_order_relaxed));
+    }
+
+    /// Remove sessions unused for `timeout`, timed by `wheel`. `on_evict` runs on
+    /// the wheel thread after the session is removed. Sessions already present are
+    /// included. A zero timeout leaves eviction off; disable_idle_eviction() undoes it.
+    void enable_idle_eviction(util::TimerWheel& wheel, std::chrono::milliseconds timeout,
+                              EvictCallback on_evict = {})
+    {
+        if (timeout.count() <= 0)
+            return;
+        {
+            std::lock_guard<std::mutex> lock(evict_mutex_);
+            on_evict_ = std::move(on_evict);
+        }
+        idle_timeout_ms_.store(timeout.count(), std::memory_order_relaxed);
+        wheel_.store(&wheel, std::memory_order_release);
+        for (auto& shard : shards_)
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto& [id, slot] : shard.slots)
+                if (!slot.timer)
+                    slot.timer = arm(wheel, id, timeout);
+        }
+    }
+
+    /// Stop evicting. Timers already armed are cancelled.
+    void disable_idle_eviction()
+    {
+        auto* wheel = wheel_.exchange(nullptr, std::memory_order_acq_rel);
+        if (!wheel)
+            return;
+        for (auto& shard : shards_)
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto& [id, slot] : shard.slots)
+            {
+                if (slot.timer)
+                    wheel->cancel(slot.timer);
+                slot.timer = 0;
+            }
+        }
+    }
+
+  private:
+    struct Slot
+    {
+        Slot(Ptr v, int64_t now) : value(std::move(v)), last_used_ns(now) {}
+
+        Ptr value;
+        mutable std::atomic<int64_t> last_used_ns;
+        util::TimerWheel::TimerId timer{0}; // Guarded by the shard's exclusive lock
+    };
+
+    struct Shard
+    {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, Slot> slots;
+    };
+
+    static int64_t now_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    Shard& shard_for(const std::string& session_id) const
+    {
+        return shards_[std::hash<std::string>{}(session_id) % kShardCount];
+    }
+
+    util::TimerWheel::TimerId arm(util::TimerWheel& wheel, const std::string& session_id,
+                                  std::chrono::milliseconds delay)
+    {
+        return wheel.schedule(delay, [this, session_id]() { check_idle(session_id); });
+    }
+
+    /// Timer callback: evict `session_id` if it stayed idle, else re-arm.
+    void check_idle(const std::string& session_id)
+    {
+        auto* wheel = wheel_.load(std::memory_order_acquire);
+        if (!wheel)
+            return;
+        const auto timeout = idle_timeout();
+
+        Ptr evicted;
+        {
+            auto& shard = shard_for(session_id);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.slots.find(session_id);
+            if (it == shard.slots.end())
+                return;
+            auto idle = std::chrono::nanoseconds(
+                now_ns() - it->second.last_used_ns.load(std::memory_order_relaxed));
+            if (idle < timeout)
+            {
+                it->second.timer =
+                    arm(*wheel, session_id,
+                        std::chrono::ceil<std::chrono::milliseconds>(timeout - idle));
+                return;
+            }
+            evicted = std::move(it->second.value);
+            shard.slots.erase(it);
+            size_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        evicted_.fetch_add(1, std::memory_order_relaxed);
+
+        EvictCallback on_evict;
+        {
+            std::lock_guard<std::mutex> lock(evict_mutex_);
+            on_evict = on_evict_;
+        }
+        if (on_evict)
+            on_evict(session_id, evicted);
+    }
+
+    mutable std::array<Shard, kShardCount> shards_;
+    std::atomic<size_t> size_{0};
+    std::atomic<size_t> capacity_;
+    std::atomic<uint64_t> evicted_{0};
+    std::atomic<util::TimerWheel*> wheel_{nullptr};
+    std::atomic<int64_t> idle_timeout_ms_{0};
+    std::mutex evict_mutex_;
+    EvictCallback on_evict_;
+};
+
+} // namespace fastmcpp::server
@@ -0,0 +1,38 @@
+#pragma once
+/// @file sse_frame.hpp
+/// @brief Pre-encoded Server-Sent Events frames shared between streams.
+
+#include "fastmcpp/types.hpp"
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace fastmcpp::server
+{
+
+/// One complete SSE event ("data: ...\n\n"), encoded once and then shared
+/// read-only by every stream queue it is pushed to. Copying a frame only bumps a
+/// reference count, so a broadcast costs one serialization in total.
+using SseFrame = std::shared_ptr<const std::string>;
+
+/// Encode `message` as an SSE frame, optionally tagged with an `event:` name.
+inline SseFrame make_sse_frame(const fastmcpp::Json& message, std::string_view event = {})
+{
+    // dump() escapes control characters, so the payload is always a single line
+    auto payload = message.dump();
+    std::string frame;
+    frame.reserve(payload.size() + event.size() + 16);
+    if (!event.empty())
+    {
+        frame.append("event: ");
+        frame.append(event);
+        frame.push_back('\n');
+    }
+    frame.append("data: ");
+    frame.append(payload);
+    frame.append("\n\n");
+    return std::make_shared<const std::string>(std::move(frame));
+}
+
+} // namespace fastmcpp::server
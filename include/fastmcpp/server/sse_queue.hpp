@@ -0,0 +1,322 @@
+#pragma once
+/// @file sse_queue.hpp
+/// @brief Byte-bounded outgoing frame queue for one SSE stream.
+
+#include "fastmcpp/server/sse_frame.hpp"
+#include "fastmcpp/types.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace fastmcpp::server
+{
+
+/// What a stream queue does when its client reads slower than frames arrive.
+enum class SlowConsumerPolicy
+{
+    /// The producer waits for room, up to SseQueueOptions::block_timeout; a
+    /// client that stays stuck longer is disconnected. Broadcasts never wait (see
+    /// SseStreamQueue::try_push).
+    Block,
+    /// Newer progress, task status and list_changed notifications replace queued
+    /// ones with the same key, then the oldest notifications are dropped.
+    /// Responses are never dropped; a client whose responses alone overflow the
+    /// limit is disconnected.
+    Coalesce,
+    /// The first frame that does not fit disconnects the client.
+    Disconnect,
+};
+
+struct SseQueueOptions
+{
+    size_t max_bytes{4 * 1024 * 1024}; ///< Encoded bytes a stream may hold unsent
+    SlowConsumerPolicy policy{SlowConsumerPolicy::Coalesce};
+    std::chrono::milliseconds block_timeout{std::chrono::seconds(5)};
+};
+
+/// Point-in-time counters of one stream queue.
+struct SseQueueStats
+{
+    size_t queued_frames{0};
+    size_t queued_bytes{0};
+    size_t peak_bytes{0};     ///< Highest queued_bytes seen
+    uint64_t sent_frames{0};  ///< Frames handed to the writer
+    uint64_t sent_bytes{0};   ///< Bytes handed to the writer
+    uint64_t coalesced{0};    ///< Notifications replaced by a newer one with the same key
+    uint64_t dropped{0};      ///< Notifications discarded to stay within max_bytes
+    bool disconnected{false}; ///< Closed because the client fell too far behind
+};
+
+/// Outgoing frames of one SSE stream, bounded in bytes.
+///
+/// Frames carrying an id (responses, batch replies and server-initiated requests)
+/// go to a priority lane that the writer drains before notifications, so a flood
+/// of progress events cannot delay or evict the reply a client is waiting for.
+/// Producers call push() from any thread; one writer calls pop().
+class SseStreamQueue
+{
+  public:
+    enum class Kind
+    {
+        Message,      ///< Has an id: never dropped or coalesced
+        Notification, ///< Droppable; coalesced when it has a key
+        Heartbeat,    ///< Keep-alive: at most one queued, skipped when full
+    };
+
+    struct Entry
+    {
+        SseFrame frame;
+        Kind kind{Kind::Notification};
+        std::string coalesce_key; ///< Notifications with equal keys replace each other
+    };
+
+    explicit SseStreamQueue(SseQueueOptions options = {}) : options_(options) {}
+
+    /// Entry for `message` encoded as `frame`, classified by its JSON-RPC shape.
+    static Entry classify(const fastmcpp::Json& message, SseFrame frame)
+    {
+        Entry entry{std::move(frame), Kind::Notification, {}};
+        if (message.is_array() ||
+            (message.is_object() && message.contains("id") && !message["id"].is_null()))
+        {
+            entry.kind = Kind::Message;
+            return entry;
+        }
+        if (!message.is_object() || !message.contains("method") || !message["method"].is_string())
+            return entry;
+
+        const auto method = message["method"].get<std::string>();
+        const auto params = message.value("params", fastmcpp::Json::object());
+        if (method == "notifications/progress" && params.contains("progressToken"))
+            entry.coalesce_key = method + ":" + params["progressToken"].dump();
+        else if (method == "notifications/tasks/status" && params.contains("taskId"))
+            entry.coalesce_key = method + ":" + params["taskId"].dump();
+        else if (method.size() > 13 && method.compare(method.size() - 13, 13, "/list_changed") == 0)
+            entry.coalesce_key = method;
+        return entry;
+    }
+
+    /// Queue `message`, encoding it unless a shared `frame` of it is given.
+    /// @return false if the stream is closed, including closed by this push
+    bool push(const fastmcpp::Json& message, SseFrame frame = nullptr)
+    {
+        if (!frame)
+            frame = make_sse_frame(message);
+        return push(classify(message, std::move(frame)));
+    }
+
+    bool push(Entry entry)
+    {
+        return push(std::move(entry), true);
+    }
+
+    /// push() that never waits for room. Under the Block policy a notification
+    /// that does not fit is dropped and any other frame disconnects the client,
+    /// so one stalled stream cannot hold up a broadcast to the others.
+    bool try_push(Entry entry)
+    {
+        return push(std::move(entry), false);
+    }
+
+    /// Wait for the next frame, priority lane first.
+    /// @return std::nullopt once the queue is closed; unsent frames are discarded
+    std::optional<Entry> pop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_cv_.wait(lock, [this]()
+                       { return closed_ || !messages_.empty() || !notifications_.empty(); });
+        if (closed_)
+            return std::nullopt;
+
+        auto& lane = messages_.empty() ? notifications_ : messages_;
+        Entry entry = std::move(lane.front());
+        lane.pop_front();
+        bytes_ -= entry.frame->size();
+        if (entry.kind == Kind::Heartbeat)
+            heartbeat_queued_ = false;
+        ++sent_frames_;
+        sent_bytes_ += entry.frame->size();
+        last_activity_ = std::chrono::steady_clock::now();
+        lock.unlock();
+        space_cv_.notify_all();
+        return entry;
+    }
+
+    /// Wake the writer and any blocked producer; later pushes fail.
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            close_locked();
+        }
+        ready_cv_.notify_all();
+        space_cv_.notify_all();
+    }
+
+    bool closed() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return closed_;
+    }
+
+    /// Time since a frame was last queued or handed to the writer.
+    std::chrono::steady_clock::duration idle_for() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::chrono::steady_clock::now() - last_activity_;
+    }
+
+    SseQueueStats stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        SseQueueStats out;
+        out.queued_frames = messages_.size() + notifications_.size();
+        out.queued_bytes = bytes_;
+        out.peak_bytes = peak_bytes_;
+        out.sent_frames = sent_frames_;
+        out.sent_bytes = sent_bytes_;
+        out.coalesced = coalesced_;
+        out.dropped = dropped_;
+        out.disconnected = overflowed_;
+        return out;
+    }
+
+  private:
+    bool push(Entry entry, bool may_block)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (closed_)
+            return false;
+        const size_t size = entry.frame->size();
+
+        if (entry.kind == Kind::Heartbeat)
+        {
+            if (heartbeat_queued_ || !fits(size))
+                return true;
+            heartbeat_queued_ = true;
+            append(std::move(entry));
+            return true;
+        }
+
+        if (options_.policy == SlowConsumerPolicy::Coalesce && !entry.coalesce_key.empty())
+        {
+            auto it = std::find_if(notifications_.begin(), notifications_.end(),
+                                   [&](const Entry& queued)
+                                   { return queued.coalesce_key == entry.coalesce_key; });
+            if (it != notifications_.end())
+            {
+                bytes_ = bytes_ - it->frame->size() + size;
+                peak_bytes_ = std::max(peak_bytes_, bytes_);
+                it->frame = std::move(entry.frame);
+                ++coalesced_;
+                return true;
+            }
+        }
+
+        if (fits(size))
+        {
+            append(std::move(entry));
+            return true;
+        }
+
+        switch (options_.policy)
+        {
+        case SlowConsumerPolicy::Block:
+            if (!may_block)
+            {
+                if (entry.kind != Kind::Notification)
+                    break;
+                ++dropped_;
+                return true;
+            }
+            if (space_cv_.wait_for(lock, options_.block_timeout,
+                                   [&]() { return closed_ || fits(size); }) &&
+                !closed_)
+            {
+                append(std::move(entry));
+                return true;
+            }
+            break;
+        case SlowConsumerPolicy::Coalesce:
+            while (!fits(size) && !notifications_.empty())
+            {
+                bytes_ -= notifications_.front().frame->size();
+                if (notifications_.front().kind == Kind::Heartbeat)
+                    heartbeat_queued_ = false;
+                else
+                    ++dropped_;
+                notifications_.pop_front();
+            }
+            if (fits(size))
+            {
+                append(std::move(entry));
+                return true;
+            }
+            if (entry.kind == Kind::Notification)
+            {
+                ++dropped_;
+                return true;
+            }
+            break;
+        case SlowConsumerPolicy::Disconnect:
+            break;
+        }
+
+        if (!closed_)
+            overflowed_ = true;
+        close_locked();
+        lock.unlock();
+        ready_cv_.notify_all();
+        space_cv_.notify_all();
+        return false;
+    }
+
+    /// An empty queue always takes one frame, however large.
+    bool fits(size_t size) const
+    {
+        return bytes_ == 0 || bytes_ + size <= options_.max_bytes;
+    }
+
+    void append(Entry entry)
+    {
+        bytes_ += entry.frame->size();
+        peak_bytes_ = std::max(peak_bytes_, bytes_);
+        last_activity_ = std::chrono::steady_clock::now();
+        auto& lane = entry.kind == Kind::Message ? messages_ : notifications_;
+        lane.push_back(std::move(entry));
+        ready_cv_.notify_one();
+    }
+
+    void close_locked()
+    {
+        closed_ = true;
+        messages_.clear();
+        notifications_.clear();
+        bytes_ = 0;
+    }
+
+    const SseQueueOptions options_;
+    mutable std::mutex mutex_;
+    std::condition_variable ready_cv_; // Writer waits for frames
+    std::condition_variable space_cv_; // Blocked producers wait for room
+    std::deque<Entry> messages_;
+    std::deque<Entry> notifications_;
+    size_t bytes_{0};
+    size_t peak_bytes_{0};
+    bool heartbeat_queued_{false};
+    bool closed_{false};
+    bool overflowed_{false};
+    uint64_t sent_frames_{0};
+    uint64_t sent_bytes_{0};
+    uint64_t coalesced_{0};
+    uint64_t dropped_{0};
+    std::chrono::steady_clock::time_point last_activity_{std::chrono::steady_clock::now()};
+};
+
+} // namespace fastmcpp::server
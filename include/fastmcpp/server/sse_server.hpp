@@ -1,18 +1,25 @@
 #pragma once
 #include "fastmcpp/server/session.hpp"
+#include "fastmcpp/server/session_registry.hpp"
+#include "fastmcpp/server/sse_frame.hpp"
+#include "fastmcpp/server/sse_queue.hpp"
 #include "fastmcpp/types.hpp"
+#include "fastmcpp/util/timer_wheel.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <functional>
 #include <httplib.h>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace fastmcpp::server
 {
@@ -38,6 +45,14 @@ namespace fastmcpp::server
  * The handler should accept a JSON-RPC request (nlohmann::json) and return
  * a JSON-RPC response (nlohmann::json). The make_mcp_handler() factory
  * functions in fastmcpp/mcp/handler.hpp produce compatible handlers.
+ *
+ * Each open SSE stream occupies one OS thread (an HTTP worker, with its stack)
+ * for as long as the client stays connected, because cpp-httplib writes a
+ * streamed response from the thread that accepted it. The thread sleeps until
+ * it has something to write, and heartbeats for all streams come from a single
+ * timer thread, but streams are not cheap. Workers are created on demand and
+ * never exceed max_threads(), whatever max_connections() says; a few of them are
+ * kept for POST requests, so the number of streams is bounded by both.
  */
 class SseServerWrapper
 {
@@ -109,6 +124,66 @@ class SseServerWrapper
         return host_;
     }
 
+    /**
+     * Maximum number of concurrent SSE streams (default 100). Further GET requests
+     * are answered with 503. Every open stream holds its own worker thread, and
+     * streams only get the threads max_threads() leaves after POST workers, so
+     * raising this alone does not add threads. Takes effect on the next start().
+     */
+    size_t max_connections() const
+    {
+        return max_connections_;
+    }
+    void set_max_connections(size_t max_connections)
+    {
+        max_connections_ = max_connections;
+    }
+
+    /**
+     * Hard limit on HTTP worker threads, SSE streams and POST requests together
+     * (default 128). Takes effect on the next start().
+     */
+    size_t max_threads() const
+    {
+        return max_threads_;
+    }
+    void set_max_threads(size_t max_threads)
+    {
+        max_threads_ = max_threads;
+    }
+
+    /**
+     * Idle time after which a stream gets a heartbeat event (default 15s). Takes
+     * effect on the next start().
+     */
+    std::chrono::milliseconds heartbeat_interval() const
+    {
+        return heartbeat_interval_;
+    }
+    void set_heartbeat_interval(std::chrono::milliseconds interval)
+    {
+        heartbeat_interval_ = interval;
+    }
+
+    /**
+     * Byte limit and slow-consumer policy of each stream's outgoing queue (default
+     * 4 MiB, Coalesce). Takes effect for streams opened afterwards.
+     */
+    const SseQueueOptions& queue_options() const
+    {
+        return queue_options_;
+    }
+    void set_queue_options(SseQueueOptions options)
+    {
+        queue_options_ = options;
+    }
+
+    /**
+     * Queue depth and drop/coalesce counters of a session's stream, or std::nullopt
+     * if the session is not connected.
+     */
+    std::optional<SseQueueStats> queue_stats(const std::string& session_id) const;
+
     /**
      * Get the SSE endpoint path.
      */
@@ -161,11 +236,10 @@ class SseServerWrapper
      */
     std::shared_ptr<ServerSession> get_session(const std::string& session_id) const
     {
-        std::lock_guard<std::mutex> lock(conns_mutex_);
-        auto it = connections_.find(session_id);
-        if (it == connections_.end() || !it->second->alive)
+        auto conn = connections_.find(session_id);
+        if (!conn || !conn->alive)
             return nullptr;
-        return it->second->server_session;
+        return conn->server_session;
     }
 
     /**
@@ -173,7 +247,6 @@ class SseServerWrapper
      */
     size_t connection_count() const
     {
-        std::lock_guard<std::mutex> lock(conns_mutex_);
         return connections_.size();
     }
 
@@ -199,25 +272,39 @@ class SseServerWrapper
     std::atomic<bool> running_{false};
 
     // Security limits
-    static constexpr size_t MAX_CONNECTIONS = 100;
-    static constexpr size_t MAX_QUEUE_SIZE = 1000;
+    static constexpr size_t DEFAULT_MAX_CONNECTIONS = 100;
+    static constexpr size_t DEFAULT_MAX_THREADS = 128;
+
+    size_t max_connections_{DEFAULT_MAX_CONNECTIONS};
+    size_t max_threads_{DEFAULT_MAX_THREADS};
+    std::chrono::milliseconds heartbeat_interval_{std::chrono::seconds(15)};
+    SseQueueOptions queue_options_;
 
     struct ConnectionState
     {
+        explicit ConnectionState(SseQueueOptions options) : queue(options) {}
+
         std::string session_id;
-        std::deque<fastmcpp::Json> queue;
-        std::mutex m;
-        std::condition_variable cv;
-        bool alive{true};
+        SseStreamQueue queue;
+        std::atomic<bool> alive{true};
+        std::atomic<int> heartbeat_counter{0};
         std::shared_ptr<ServerSession> server_session; // For bidirectional requests
     };
 
     void handle_sse_connection(httplib::DataSink& sink, std::shared_ptr<ConnectionState> conn,
                                const std::string& session_id);
+    /// Connections still alive, all of them or just `session_id`'s; dead ones are pruned
+    std::vector<std::shared_ptr<ConnectionState>> live_connections(const std::string* session_id);
+    static void schedule_heartbeat(util::TimerWheel& wheel, std::weak_ptr<ConnectionState> conn,
+                                   std::chrono::milliseconds interval,
+                                   std::chrono::milliseconds delay);
+
+    // Drives heartbeats for every stream; lives from start() to stop()
+    std::unique_ptr<util::TimerWheel> heartbeats_;
 
     // Active SSE connections mapped by session ID
-    std::unordered_map<std::string, std::shared_ptr<ConnectionState>> connections_;
-    mutable std::mutex conns_mutex_;
+    // (no idle eviction: a session lasts exactly as long as its stream)
+    SessionRegistry<ConnectionState> connections_{DEFAULT_MAX_CONNECTIONS};
 };
 
 } // namespace fastmcpp::server
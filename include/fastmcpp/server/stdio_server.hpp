@@ -2,7 +2,10 @@
 #include "fastmcpp/types.hpp"
 
 #include <atomic>
+#include <cstddef>
 #include <functional>
+#include <memory>
+#include <string>
 #include <thread>
 
 namespace fastmcpp::server
@@ -23,12 +26,31 @@ namespace fastmcpp::server
  * The handler should accept a JSON-RPC request (nlohmann::json) and return
  * a JSON-RPC response (nlohmann::json). The make_mcp_handler() factory
  * functions in fastmcpp/mcp/handler.hpp produce compatible handlers.
+ *
+ * By default requests are handled one at a time, in arrival order. With
+ * `Options::workers` > 0 requests run on a worker pool and responses are
+ * written as they complete (MCP clients match them by id). Notifications and
+ * tools/list still run on the reading thread, so they take effect before any
+ * later request starts.
  */
 class StdioServerWrapper
 {
   public:
     using McpHandler = std::function<fastmcpp::Json(const fastmcpp::Json&)>;
 
+    struct Options
+    {
+        /// Worker threads for concurrent request handling; 0 keeps the serial loop.
+        size_t workers{0};
+        /// Requests allowed in flight before the reader stops taking new lines.
+        size_t max_in_flight{64};
+        /// Whether calls to a tool must not overlap. When unset, tools advertised
+        /// with `execution.concurrency == "sequential"` in tools/list responses
+        /// (see Tool::set_sequential) are serialized, and so are calls to tools
+        /// no tools/list response has named yet.
+        std::function<bool(const std::string& tool_name)> is_sequential;
+    };
+
     /**
      * Construct a STDIO server with an MCP handler.
      *
@@ -36,6 +58,7 @@ class StdioServerWrapper
      *                Must handle: initialize, tools/list, tools/call, etc.
      */
     explicit StdioServerWrapper(McpHandler handler);
+    StdioServerWrapper(McpHandler handler, Options options);
 
     ~StdioServerWrapper();
 
@@ -79,8 +102,10 @@ class StdioServerWrapper
 
   private:
     void run_loop();
+    void run_loop_concurrent();
 
     McpHandler handler_;
+    Options options_;
     std::atomic<bool> running_{false};
     std::atomic<bool> stop_requested_{false};
     std::thread thread_;
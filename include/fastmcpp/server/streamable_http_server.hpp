@@ -1,17 +1,23 @@
 #pragma once
 #include "fastmcpp/server/session.hpp"
+#include "fastmcpp/server/session_registry.hpp"
+#include "fastmcpp/server/sse_frame.hpp"
 #include "fastmcpp/types.hpp"
+#include "fastmcpp/util/timer_wheel.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <functional>
 #include <httplib.h>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace fastmcpp::server
 {
@@ -25,6 +31,11 @@ namespace fastmcpp::server
  * - Session ID management via Mcp-Session-Id header
  * - Responses can be JSON or SSE stream
  *
+ * A tools/call (or any request carrying a progress token) from a client that
+ * accepts text/event-stream is answered with an SSE stream: progress, log and
+ * other messages the session sends while the call runs are written as they
+ * happen, followed by the result. Other requests get a plain JSON response.
+ *
  * This is a simpler transport than SSE with a single endpoint.
  * Clients send JSON-RPC requests via POST and receive responses in the
  * same HTTP response (either as JSON or SSE stream for long-running operations).
@@ -126,11 +137,8 @@ class StreamableHttpServerWrapper
      */
     std::shared_ptr<ServerSession> get_session(const std::string& session_id) const
     {
-        std::lock_guard<std::mutex> lock(sessions_mutex_);
-        auto it = sessions_.find(session_id);
-        if (it == sessions_.end())
-            return nullptr;
-        return it->second;
+        auto state = sessions_.find(session_id);
+        return state ? state->server_session : nullptr;
     }
 
     /**
@@ -138,11 +146,83 @@ class StreamableHttpServerWrapper
      */
     size_t session_count() const
     {
-        std::lock_guard<std::mutex> lock(sessions_mutex_);
         return sessions_.size();
     }
 
+    /**
+     * Maximum number of concurrent sessions (default 1000). Further initialize
+     * requests are answered with 503. Lowering it never drops existing sessions.
+     */
+    size_t max_sessions() const
+    {
+        return sessions_.capacity();
+    }
+    void set_max_sessions(size_t max_sessions)
+    {
+        sessions_.set_capacity(max_sessions);
+    }
+
+    /**
+     * Time without requests after which a session is removed, as if the client had
+     * sent DELETE (default 1 hour, zero keeps sessions until DELETE or stop()).
+     * Takes effect on the next start().
+     */
+    std::chrono::milliseconds session_idle_timeout() const
+    {
+        return session_idle_timeout_;
+    }
+    void set_session_idle_timeout(std::chrono::milliseconds timeout)
+    {
+        session_idle_timeout_ = timeout;
+    }
+
+    /**
+     * Whether tool calls from clients accepting text/event-stream are answered with
+     * an SSE stream (default true). When false every response is plain JSON and
+     * messages sent during a call are dropped.
+     */
+    bool sse_responses() const
+    {
+        return sse_responses_.load();
+    }
+    void set_sse_responses(bool enabled)
+    {
+        sse_responses_ = enabled;
+    }
+
+    /**
+     * Number of sessions removed for being idle.
+     */
+    uint64_t evicted_session_count() const
+    {
+        return sessions_.evicted();
+    }
+
   private:
+    /// A POST being answered as an SSE stream. Messages for its request are written
+    /// straight to the connection while the handler runs.
+    struct ResponseStream
+    {
+        /// @return false if the stream has finished or the client went away
+        bool write(const SseFrame& frame);
+
+        std::mutex mutex;
+        httplib::DataSink* sink{nullptr}; // Set only while the handler runs
+        std::optional<fastmcpp::Json> progress_token;
+    };
+
+    struct SessionState
+    {
+        std::shared_ptr<ServerSession> server_session;
+        std::mutex streams_mutex;
+        std::vector<std::shared_ptr<ResponseStream>> streams; // Open streams
+    };
+
+    /// Route a message sent by a session to the response stream it belongs to.
+    static void send_to_stream(SessionState& state, const fastmcpp::Json& message);
+    void stream_response(httplib::Response& res, std::shared_ptr<SessionState> state,
+                         fastmcpp::Json message);
+
     void run_server();
     std::string generate_session_id();
     bool check_auth(const std::string& auth_header) const;
@@ -161,11 +241,15 @@ class StreamableHttpServerWrapper
     std::atomic<bool> running_{false};
 
     // Security limits
-    static constexpr size_t MAX_SESSIONS = 1000;
+    static constexpr size_t DEFAULT_MAX_SESSIONS = 1000;
+
+    std::chrono::milliseconds session_idle_timeout_{std::chrono::hours(1)};
+    std::atomic<bool> sse_responses_{true};
 
     // Active sessions mapped by session ID
-    std::unordered_map<std::string, std::shared_ptr<ServerSession>> sessions_;
-    mutable std::mutex sessions_mutex_;
+    SessionRegistry<SessionState> sessions_{DEFAULT_MAX_SESSIONS};
+    // Expires idle sessions; declared after sessions_ so it is destroyed first
+    std::unique_ptr<util::TimerWheel> session_timers_;
 };
 
 } // namespace fastmcpp::server
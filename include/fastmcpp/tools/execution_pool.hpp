@@ -0,0 +1,344 @@
+#pragma once
+/// @file execution_pool.hpp
+/// @brief Bounded worker pool that runs tool calls under a deadline.
+
+#include "fastmcpp/types.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace fastmcpp::tools
+{
+
+/// Cooperative cancellation flag shared between a timed tool call and its caller.
+///
+/// Copies observe the same flag. A default-constructed token is never cancelled.
+class CancellationToken
+{
+  public:
+    CancellationToken() = default;
+
+    static CancellationToken make()
+    {
+        CancellationToken token;
+        token.state_ = std::make_shared<std::atomic<bool>>(false);
+        return token;
+    }
+
+    bool is_cancelled() const
+    {
+        return state_ && state_->load(std::memory_order_acquire);
+    }
+
+    void cancel() const
+    {
+        if (state_)
+            state_->store(true, std::memory_order_release);
+    }
+
+  private:
+    std::shared_ptr<std::atomic<bool>> state_;
+};
+
+namespace detail
+{
+inline CancellationToken& current_cancellation_slot()
+{
+    thread_local CancellationToken token;
+    return token;
+}
+} // namespace detail
+
+/// Token of the timed tool call running on this thread. It is cancelled once the
+/// caller stops waiting, so long-running tools should poll it and return early.
+/// Outside a pooled call this is a token that is never cancelled.
+inline const CancellationToken& current_cancellation_token()
+{
+    return detail::current_cancellation_slot();
+}
+
+/// Point-in-time counters of an ExecutionPool.
+struct ExecutionPoolMetrics
+{
+    size_t max_workers{0};
+    size_t max_orphans{0};  ///< Orphaned calls that get a replacement worker
+    size_t workers{0};      ///< Live threads: up to max_workers plus replacements
+    size_t busy_workers{0}; ///< Workers currently running a call
+    size_t queue_depth{0};  ///< Calls waiting for a free worker
+    size_t orphaned{0};     ///< Timed-out calls still occupying a worker
+    uint64_t completed{0};  ///< Calls that ran to completion, in time or not
+    uint64_t timed_out{0};  ///< Calls whose caller gave up waiting
+};
+
+/// Bounded pool of worker threads for tool calls that carry a timeout.
+///
+/// Workers are spawned on demand up to `max_workers` and then reused, so a timed
+/// call costs a queue hand-off rather than a thread. When a caller times out, a
+/// call still in the queue is dropped; a call already running is cancelled
+/// through its token and counted as orphaned until it returns. An orphaned call
+/// does not count against `max_workers`: up to `max_orphans` of them get a
+/// replacement worker, so tools that ignore cancellation cannot starve the rest.
+/// A worker whose orphaned call finally returns exits if the pool has more threads
+/// than it needs. Threads are never detached: the destructor drains the queue and
+/// joins every worker.
+class ExecutionPool
+{
+  public:
+    using Fn = std::function<fastmcpp::Json(const fastmcpp::Json&)>;
+
+    explicit ExecutionPool(size_t max_workers = default_max_workers(),
+                           size_t max_orphans = default_max_orphans())
+        : max_workers_(std::max<size_t>(1, max_workers)), max_orphans_(max_orphans)
+    {
+    }
+
+    ExecutionPool(const ExecutionPool&) = delete;
+    ExecutionPool& operator=(const ExecutionPool&) = delete;
+
+    ~ExecutionPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& [id, worker] : workers_)
+            worker.join();
+        for (auto& worker : retired_)
+            worker.join();
+    }
+
+    /// Pool used by Tool::invoke unless a tool is given its own. It is never
+    /// destroyed, so an orphaned call still running at exit cannot stall shutdown.
+    static ExecutionPool& shared()
+    {
+        static ExecutionPool* pool = new ExecutionPool();
+        return *pool;
+    }
+
+    static size_t default_max_workers()
+    {
+        return std::max<size_t>(4, std::thread::hardware_concurrency());
+    }
+
+    /// Replacement workers an orphaned call may cause: one per hung call, up to
+    /// this many at once
+    static size_t default_max_orphans()
+    {
+        return 64;
+    }
+
+    size_t max_workers() const
+    {
+        return max_workers_;
+    }
+    size_t max_orphans() const
+    {
+        return max_orphans_;
+    }
+
+    /// Run `fn(input)` on a worker and wait up to `timeout` for the result.
+    /// Returns std::nullopt on timeout; exceptions thrown by `fn` propagate.
+    std::optional<fastmcpp::Json> run_for(Fn fn, fastmcpp::Json input,
+                                          std::chrono::milliseconds timeout)
+    {
+        auto job = std::make_shared<Job>();
+        job->fn = std::move(fn);
+        job->input = std::move(input);
+        auto future = job->promise.get_future();
+        enqueue(job);
+
+        if (future.wait_for(timeout) == std::future_status::ready)
+            return future.get();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (job->state == JobState::Queued)
+            {
+                queue_.erase(std::find(queue_.begin(), queue_.end(), job));
+                job->state = JobState::Abandoned;
+                ++timed_out_;
+            }
+            else if (job->state == JobState::Running &&
+                     future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                job->orphaned = true;
+                ++orphaned_;
+                ++timed_out_;
+                spawn_if_needed();
+            }
+            else
+            {
+                // Finished between the deadline and taking the lock
+                return future.get();
+            }
+        }
+        job->token.cancel();
+        return std::nullopt;
+    }
+
+    /// Queue `task` on a worker without waiting for it. Exceptions it throws are
+    /// discarded.
+    void post(std::function<void()> task)
+    {
+        auto job = std::make_shared<Job>();
+        job->fn = [task = std::move(task)](const fastmcpp::Json&)
+        {
+            task();
+            return fastmcpp::Json();
+        };
+        enqueue(job);
+    }
+
+    ExecutionPoolMetrics metrics() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ExecutionPoolMetrics out;
+        out.max_workers = max_workers_;
+        out.max_orphans = max_orphans_;
+        out.workers = workers_.size();
+        out.busy_workers = busy_workers_;
+        out.queue_depth = queue_.size();
+        out.orphaned = orphaned_;
+        out.completed = completed_;
+        out.timed_out = timed_out_;
+        return out;
+    }
+
+  private:
+    enum class JobState
+    {
+        Queued,
+        Running,
+        Finished,
+        Abandoned
+    };
+
+    struct Job
+    {
+        Fn fn;
+        fastmcpp::Json input;
+        CancellationToken token{CancellationToken::make()};
+        std::promise<fastmcpp::Json> promise;
+        JobState state{JobState::Queued}; // guarded by mutex_
+        bool orphaned{false};             // guarded by mutex_
+    };
+
+    void enqueue(const std::shared_ptr<Job>& job)
+    {
+        std::vector<std::thread> retired;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_)
+                throw std::runtime_error("ExecutionPool is shutting down");
+            queue_.push_back(job);
+            spawn_if_needed();
+            retired.swap(retired_);
+        }
+        cv_.notify_one();
+        // Retired workers only have to return once they have handed themselves over
+        for (auto& worker : retired)
+            worker.join();
+    }
+
+    /// Threads the pool may have: max_workers_ plus one per orphaned call, up to
+    /// max_orphans_. Caller holds mutex_.
+    size_t worker_limit() const
+    {
+        return max_workers_ + std::min(orphaned_, max_orphans_);
+    }
+
+    /// Start a worker if calls are waiting and the limit allows. Caller holds mutex_.
+    void spawn_if_needed()
+    {
+        if (queue_.size() <= idle_workers_ || workers_.size() >= worker_limit())
+            return;
+        // The new thread needs mutex_ before it can look itself up
+        std::thread worker([this]() { worker_loop(); });
+        const auto id = worker.get_id();
+        workers_.emplace(id, std::move(worker));
+    }
+
+    void worker_loop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;)
+        {
+            ++idle_workers_;
+            cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+            --idle_workers_;
+            if (queue_.empty())
+                return;
+
+            auto job = std::move(queue_.front());
+            queue_.pop_front();
+            job->state = JobState::Running;
+            ++busy_workers_;
+            lock.unlock();
+
+            auto& slot = detail::current_cancellation_slot();
+            slot = job->token;
+            try
+            {
+                job->promise.set_value(job->fn(job->input));
+            }
+            catch (...)
+            {
+                try
+                {
+                    job->promise.set_exception(std::current_exception());
+                }
+                catch (...)
+                {
+                }
+            }
+            slot = CancellationToken();
+
+            lock.lock();
+            job->state = JobState::Finished;
+            --busy_workers_;
+            ++completed_;
+            if (job->orphaned)
+            {
+                --orphaned_;
+                // A replacement took this worker's place; one of them has to go
+                if (!stopping_ && workers_.size() > worker_limit())
+                {
+                    auto self = workers_.find(std::this_thread::get_id());
+                    retired_.push_back(std::move(self->second));
+                    workers_.erase(self);
+                    return;
+                }
+            }
+        }
+    }
+
+    const size_t max_workers_;
+    const size_t max_orphans_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::shared_ptr<Job>> queue_;
+    std::unordered_map<std::thread::id, std::thread> workers_;
+    std::vector<std::thread> retired_; // Exited workers not yet joined
+    size_t idle_workers_{0};
+    size_t busy_workers_{0};
+    size_t orphaned_{0};
+    uint64_t completed_{0};
+    uint64_t timed_out_{0};
+    bool stopping_{false};
+};
+
+} // namespace fastmcpp::tools
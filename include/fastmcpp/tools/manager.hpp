@@ -1,6 +1,7 @@
 #pragma once
 #include "fastmcpp/exceptions.hpp"
 #include "fastmcpp/tools/tool.hpp"
+#include "fastmcpp/util/generation.hpp"
 
 #include <string>
 #include <unordered_map>
@@ -14,6 +15,7 @@ class ToolManager
     void register_tool(const Tool& t)
     {
         tools_[t.name()] = t;
+        generation_.bump();
     }
     const Tool& get(const std::string& name) const
     {
@@ -49,8 +51,15 @@ class ToolManager
         return get(name).input_schema();
     }
 
+    /// Change stamp; differs after every registration (see util::GenerationStamp).
+    uint64_t generation() const
+    {
+        return generation_.value();
+    }
+
   private:
     std::unordered_map<std::string, Tool> tools_;
+    util::GenerationStamp generation_;
 };
 
 } // namespace fastmcpp::tools
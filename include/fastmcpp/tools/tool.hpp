@@ -1,16 +1,17 @@
 #pragma once
 #include "fastmcpp/exceptions.hpp"
+#include "fastmcpp/tools/execution_pool.hpp"
 #include "fastmcpp/types.hpp"
 
 #include <algorithm>
 #include <chrono>
 #include <functional>
-#include <future>
 #include <iomanip>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <string>
-#include <thread>
 #include <vector>
 
 namespace fastmcpp::tools
@@ -29,11 +30,10 @@ class Tool
          fastmcpp::TaskSupport task_support = fastmcpp::TaskSupport::Forbidden,
          std::optional<fastmcpp::AppConfig> app = std::nullopt,
          std::optional<std::string> version = std::nullopt)
-        : name_(std::move(name)), input_schema_(std::move(input_schema)),
-          output_schema_(std::move(output_schema)), fn_(std::move(fn)),
-          exclude_args_(std::move(exclude_args)), task_support_(task_support), app_(std::move(app)),
-          version_(std::move(version))
+        : name_(std::move(name)), fn_(std::move(fn)), exclude_args_(std::move(exclude_args)),
+          task_support_(task_support), app_(std::move(app)), version_(std::move(version))
     {
+        init_schemas(std::move(input_schema), std::move(output_schema));
     }
 
     // Extended constructor with title, description, icons
@@ -45,10 +45,10 @@ class Tool
          std::optional<fastmcpp::AppConfig> app = std::nullopt,
          std::optional<std::string> version = std::nullopt)
         : name_(std::move(name)), title_(std::move(title)), description_(std::move(description)),
-          input_schema_(std::move(input_schema)), output_schema_(std::move(output_schema)),
           icons_(std::move(icons)), fn_(std::move(fn)), exclude_args_(std::move(exclude_args)),
           task_support_(task_support), app_(std::move(app)), version_(std::move(version))
     {
+        init_schemas(std::move(input_schema), std::move(output_schema));
     }
 
     const std::string& name() const
@@ -67,55 +67,35 @@ class Tool
     {
         return icons_;
     }
-    fastmcpp::Json input_schema() const
+    /// Input schema as listed: the given schema without the excluded arguments.
+    const fastmcpp::Json& input_schema() const
     {
-        if (exclude_args_.empty())
-            return input_schema_;
-        return prune_schema(input_schema_);
+        return schemas_->input;
     }
     const fastmcpp::Json& output_schema() const
     {
-        return output_schema_;
+        return schemas_->output;
     }
+    /// input_schema() with local $refs inlined (the same object when it has none).
+    /// Computed on first use and shared by every copy of the tool.
+    const fastmcpp::Json& dereferenced_input_schema() const;
+    const fastmcpp::Json& dereferenced_output_schema() const;
+    /// output_schema() as tools/list shows it, with a non-object schema wrapped as
+    /// {"result": ...} (see util::schema::wrap_output_schema). Computed with the
+    /// dereferenced forms and shared the same way.
+    const fastmcpp::Json& mcp_output_schema() const;
+    const fastmcpp::Json& mcp_dereferenced_output_schema() const;
     fastmcpp::Json invoke(const fastmcpp::Json& input, bool enforce_timeout = true) const
     {
         if (!enforce_timeout || !timeout_.has_value() || timeout_->count() <= 0)
             return fn_(input);
 
-        std::promise<fastmcpp::Json> promise;
-        auto future = promise.get_future();
-        auto timeout = *timeout_;
-
-        std::thread worker(
-            [promise = std::move(promise), input, fn = fn_]() mutable
-            {
-                try
-                {
-                    promise.set_value(fn(input));
-                }
-                catch (...)
-                {
-                    try
-                    {
-                        promise.set_exception(std::current_exception());
-                    }
-                    catch (...)
-                    {
-                    }
-                }
-            });
-
-        if (future.wait_for(timeout) == std::future_status::timeout)
-        {
-            if (worker.joinable())
-                worker.detach();
+        auto& pool = execution_pool_ ? *execution_pool_ : ExecutionPool::shared();
+        auto result = pool.run_for(fn_, input, *timeout_);
+        if (!result)
             throw fastmcpp::ToolTimeoutError("Tool '" + name_ + "' execution timed out after " +
-                                             format_timeout_seconds(timeout) + "s");
-        }
-
-        if (worker.joinable())
-            worker.join();
-        return future.get();
+                                             format_timeout_seconds(*timeout_) + "s");
+        return std::move(*result);
     }
 
     fastmcpp::TaskSupport task_support() const
@@ -171,6 +151,16 @@ class Tool
     {
         return timeout_;
     }
+    /// Pool that runs this tool's timed calls; null means ExecutionPool::shared().
+    Tool& set_execution_pool(std::shared_ptr<ExecutionPool> pool)
+    {
+        execution_pool_ = std::move(pool);
+        return *this;
+    }
+    const std::shared_ptr<ExecutionPool>& execution_pool() const
+    {
+        return execution_pool_;
+    }
     bool is_hidden() const
     {
         return hidden_;
@@ -228,12 +218,44 @@ class Tool
         return out;
     }
 
-    fastmcpp::Json prune_schema(const fastmcpp::Json& schema) const
+    /// Listed schemas, fixed at construction and shared between copies of the tool,
+    /// so copying a Tool never copies a schema. The dereferenced and MCP forms are
+    /// filled in by src/tools/tool.cpp; keeping them out of the constructor lets
+    /// provider plugins build tools from this header alone.
+    struct Schemas
+    {
+        fastmcpp::Json input;
+        fastmcpp::Json output;
+        std::once_flag dereferenced;
+        std::optional<fastmcpp::Json> dereferenced_input;  // Unset when input has no $ref
+        std::optional<fastmcpp::Json> dereferenced_output; // Unset when output has no $ref
+        // Unset when the schema is listed as is (null or already object-shaped)
+        std::optional<fastmcpp::Json> mcp_output;
+        std::optional<fastmcpp::Json> mcp_dereferenced_output;
+    };
+
+    void init_schemas(fastmcpp::Json input_schema, fastmcpp::Json output_schema)
+    {
+        if (!exclude_args_.empty())
+            prune_schema(input_schema);
+        auto schemas = std::make_shared<Schemas>();
+        schemas->input = std::move(input_schema);
+        schemas->output = std::move(output_schema);
+        schemas_ = std::move(schemas);
+    }
+
+    static const std::shared_ptr<Schemas>& null_schemas()
+    {
+        static const auto null = std::make_shared<Schemas>();
+        return null;
+    }
+
+    const Schemas& dereferenced_schemas() const;
+
+    void prune_schema(fastmcpp::Json& pruned) const
     {
-        // Work on a copy to avoid mutating shared $defs or properties
-        fastmcpp::Json pruned = schema;
         if (!pruned.is_object())
-            return pruned;
+            return;
 
         // Remove excluded properties
         if (pruned.contains("properties") && pruned["properties"].is_object())
@@ -257,20 +279,18 @@ class Tool
             }
             pruned["required"] = new_req;
         }
-
-        return pruned;
     }
 
     std::string name_;
     std::optional<std::string> title_;
     std::optional<std::string> description_;
-    fastmcpp::Json input_schema_;
-    fastmcpp::Json output_schema_;
+    std::shared_ptr<Schemas> schemas_{null_schemas()};
     std::optional<std::vector<fastmcpp::Icon>> icons_;
     Fn fn_;
     std::vector<std::string> exclude_args_;
     fastmcpp::TaskSupport task_support_{fastmcpp::TaskSupport::Forbidden};
     std::optional<std::chrono::milliseconds> timeout_;
+    std::shared_ptr<ExecutionPool> execution_pool_;
     bool hidden_{false};
     bool sequential_{false};
     std::optional<fastmcpp::Json> annotations_;
@@ -0,0 +1,112 @@
+#pragma once
+/// @file base64.hpp
+/// @brief Base64 (RFC 4648, padded) encoding, one-shot or incremental.
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+
+namespace fastmcpp::util::base64
+{
+
+inline constexpr char kAlphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/// Length of the padded encoding of `size` bytes
+constexpr size_t encoded_size(size_t size)
+{
+    return (size + 2) / 3 * 4;
+}
+
+/// Encodes bytes fed in pieces of any size, handing the output to a sink in
+/// fixed-size blocks. Memory use is independent of the total input length.
+class Encoder
+{
+  public:
+    /// Receives consecutive pieces of the encoding; valid only during the call
+    using Sink = std::function<void(const char* data, size_t size)>;
+
+    /// Output characters per sink call (except the last)
+    static constexpr size_t kBlockSize = 64 * 1024;
+
+    explicit Encoder(Sink sink) : sink_(std::move(sink))
+    {
+        block_.reserve(kBlockSize);
+    }
+
+    void update(const void* data, size_t size)
+    {
+        auto* bytes = static_cast<const uint8_t*>(data);
+        // Complete a triple left over from the previous call
+        while (pending_size_ > 0 && pending_size_ < 3 && size > 0)
+        {
+            pending_[pending_size_++] = *bytes++;
+            --size;
+        }
+        if (pending_size_ == 3)
+        {
+            put_triple(pending_);
+            pending_size_ = 0;
+        }
+
+        for (; size >= 3; bytes += 3, size -= 3)
+            put_triple(bytes);
+        for (; size > 0; --size)
+            pending_[pending_size_++] = *bytes++;
+    }
+
+    /// Pads the trailing partial triple and flushes; the encoder is then spent
+    void finish()
+    {
+        if (pending_size_ > 0)
+        {
+            uint32_t n = static_cast<uint32_t>(pending_[0]) << 16;
+            if (pending_size_ > 1)
+                n |= static_cast<uint32_t>(pending_[1]) << 8;
+            block_.push_back(kAlphabet[(n >> 18) & 0x3F]);
+            block_.push_back(kAlphabet[(n >> 12) & 0x3F]);
+            block_.push_back(pending_size_ > 1 ? kAlphabet[(n >> 6) & 0x3F] : '=');
+            block_.push_back('=');
+            pending_size_ = 0;
+        }
+        flush();
+    }
+
+  private:
+    void put_triple(const uint8_t* in)
+    {
+        const uint32_t n = (static_cast<uint32_t>(in[0]) << 16) |
+                           (static_cast<uint32_t>(in[1]) << 8) | static_cast<uint32_t>(in[2]);
+        const char quad[4] = {kAlphabet[(n >> 18) & 0x3F], kAlphabet[(n >> 12) & 0x3F],
+                              kAlphabet[(n >> 6) & 0x3F], kAlphabet[n & 0x3F]};
+        block_.append(quad, 4);
+        if (block_.size() >= kBlockSize)
+            flush();
+    }
+
+    void flush()
+    {
+        if (!block_.empty())
+            sink_(block_.data(), block_.size());
+        block_.clear();
+    }
+
+    Sink sink_;
+    std::string block_;
+    uint8_t pending_[3] = {};
+    size_t pending_size_ = 0;
+};
+
+inline std::string encode(const void* data, size_t size)
+{
+    std::string out;
+    out.reserve(encoded_size(size));
+    Encoder encoder([&out](const char* chunk, size_t n) { out.append(chunk, n); });
+    encoder.update(data, size);
+    encoder.finish();
+    return out;
+}
+
+} // namespace fastmcpp::util::base64
@@ -0,0 +1,109 @@
+#pragma once
+/// @file file_watcher.hpp
+/// @brief Background watcher reporting files changed under a path.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace fastmcpp::util
+{
+
+/// Collects the paths created, rewritten, renamed or removed under `root` (a
+/// directory tree, or a single file) on a background thread.
+///
+/// Linux uses inotify, with a watch per directory; files are reported once
+/// closed after writing or renamed into place, never half-written. Elsewhere, or
+/// when inotify is unavailable, the tree is rescanned every `poll_interval`.
+/// Either way the owner only pays for an atomic load until something changes.
+///
+/// A reported directory stands for everything beneath it: a directory renamed
+/// in or out is reported as one path, and so is the root when the kernel event
+/// queue overflows.
+class FileWatcher
+{
+  public:
+    struct Options
+    {
+        /// Rescan period of the polling fallback
+        std::chrono::milliseconds poll_interval{500};
+        /// Poll even where inotify is available
+        bool force_polling{false};
+        /// Invoked on the watcher thread each time new changes become pending
+        std::function<void()> on_change;
+    };
+
+    explicit FileWatcher(std::filesystem::path root);
+    FileWatcher(std::filesystem::path root, Options options);
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    const std::filesystem::path& root() const
+    {
+        return root_;
+    }
+
+    bool uses_inotify() const
+    {
+        return inotify_fd_ >= 0;
+    }
+
+    /// Whether take_changes() has anything to return; no system calls
+    bool has_changes() const
+    {
+        return pending_.load(std::memory_order_acquire);
+    }
+
+    /// Paths changed since the previous call, sorted and deduplicated
+    std::vector<std::filesystem::path> take_changes();
+
+    /// Blocks until changes are pending or `timeout` passes
+    bool wait_for_changes(std::chrono::milliseconds timeout);
+
+  private:
+    struct PollState;
+
+    void report(const std::filesystem::path& path);
+    void publish();
+
+    bool start_inotify();
+    void watch_tree(const std::filesystem::path& dir);
+    void forget_tree(const std::filesystem::path& dir);
+    void run_inotify();
+    void handle_inotify_events(const char* buffer, size_t length);
+
+    void run_polling();
+
+    std::filesystem::path root_;
+    Options options_;
+    bool root_is_file_{false};
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::set<std::filesystem::path> changes_;
+    std::atomic<bool> pending_{false};
+    bool unpublished_{false}; // Reported since the last publish()
+    bool stopping_{false};
+
+    int inotify_fd_{-1};
+    int wake_fds_[2]{-1, -1};
+    std::unordered_map<int, std::filesystem::path> watched_dirs_; // Watcher thread only
+    // Watches of directories moved away, by old path, until they reappear in the
+    // tree or turn out to have left it; watcher thread only
+    std::unordered_map<int, std::filesystem::path> moved_dirs_;
+
+    std::unique_ptr<PollState> poll_state_;
+    std::thread thread_;
+};
+
+} // namespace fastmcpp::util
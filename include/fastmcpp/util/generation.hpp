@@ -0,0 +1,49 @@
+#pragma once
+/// @file generation.hpp
+/// @brief Monotonic change stamps used to key cached catalog views.
+
+#include <atomic>
+#include <cstdint>
+
+namespace fastmcpp::util
+{
+
+/// Change stamp for a mutable container.
+///
+/// Every construction, copy and bump() draws a fresh value from one process-wide
+/// counter, so a stamp never repeats and never goes backwards - even when the
+/// owning container is reassigned (e.g. `tools_ = ToolManager{}`). Sums of stamps
+/// are therefore strictly increasing whenever any summand changes, which lets an
+/// aggregate fingerprint its sources without storing them individually.
+class GenerationStamp
+{
+  public:
+    GenerationStamp() : value_(next()) {}
+    GenerationStamp(const GenerationStamp&) : value_(next()) {}
+    GenerationStamp& operator=(const GenerationStamp&)
+    {
+        value_ = next();
+        return *this;
+    }
+
+    void bump()
+    {
+        value_ = next();
+    }
+
+    uint64_t value() const
+    {
+        return value_;
+    }
+
+  private:
+    static uint64_t next()
+    {
+        static std::atomic<uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    uint64_t value_;
+};
+
+} // namespace fastmcpp::util
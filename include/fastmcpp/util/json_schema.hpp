@@ -2,8 +2,11 @@
 #include "fastmcpp/exceptions.hpp"
 #include "fastmcpp/types.hpp"
 
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace fastmcpp::util::schema
@@ -18,4 +21,41 @@ void validate(const Json& schema, const Json& instance);
 bool contains_ref(const Json& schema);
 Json dereference_refs(const Json& schema);
 
+/// MCP structuredContent is always an object, so a non-object output schema is
+/// listed wrapped as {"result": <schema>} and marked "x-fastmcp-wrap-result".
+/// @return the wrapped form, or std::nullopt when `schema` is null or already
+///         object-shaped and is listed as is
+std::optional<Json> wrap_output_schema(const Json& schema);
+
+/// A schema compiled once for repeated validation.
+///
+/// Enforces the same keywords as validate(), with the schema already reduced to
+/// type bitmasks, a list of required keys and a table of typed properties, so a
+/// call only touches the instance. Beyond validate() it accepts type lists
+/// ("type": ["string", "null"]) and follows local $refs at the root and in
+/// property schemas. A lone "type": "null" accepts anything, as in validate();
+/// only within a type list does "null" match null alone. A default-constructed
+/// CompiledSchema accepts anything.
+class CompiledSchema
+{
+  public:
+    CompiledSchema() = default;
+    explicit CompiledSchema(const Json& schema);
+
+    /// @throws ValidationError with the same messages as validate()
+    void validate(const Json& instance) const;
+
+  private:
+    using TypeMask = uint8_t;
+
+    static TypeMask type_of(const Json& instance);
+    void validate_object(const Json& instance) const;
+
+    TypeMask root_types_{0xff};
+    bool check_object_{false};
+    std::vector<std::string> required_;
+    std::vector<std::pair<std::string, TypeMask>> properties_; // Typed properties, sorted
+    std::unordered_map<std::string, TypeMask> property_index_;
+};
+
 } // namespace fastmcpp::util::schema
@@ -0,0 +1,189 @@
+#pragma once
+/// @file jsonrpc.hpp
+/// @brief JSON-RPC 2.0 message helpers shared by the MCP handler and server transports.
+
+#include "fastmcpp/exceptions.hpp"
+#include "fastmcpp/tools/execution_pool.hpp"
+#include "fastmcpp/types.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fastmcpp::util::jsonrpc
+{
+
+static constexpr int kInvalidRequest = -32600;
+static constexpr int kMethodNotFound = -32601;
+static constexpr int kInvalidParams = -32602;
+static constexpr int kInternalError = -32603;
+
+/// Upper bound on batch entries dispatched at the same time.
+static constexpr size_t kDefaultBatchParallelism = 8;
+
+/// Requests without an id (or with a null id) are notifications and get no reply.
+inline bool is_notification(const Json& message)
+{
+    return !message.contains("id") || message["id"].is_null();
+}
+
+inline Json error_response(const Json& id, int code, const std::string& message)
+{
+    return Json{{"jsonrpc", "2.0"}, {"id", id}, {"error", {{"code", code}, {"message", message}}}};
+}
+
+/// Reply for a batch from its per-entry replies, in request order. Null entries
+/// (notifications) are dropped; when nothing is left the batch gets no reply, which
+/// is reported as a null Json.
+inline Json collect_batch_replies(std::vector<Json> replies)
+{
+    Json out = Json::array();
+    for (auto& reply : replies)
+        if (!reply.is_null())
+            out.push_back(std::move(reply));
+    if (out.empty())
+        return Json();
+    return out;
+}
+
+/// Pool that runs the helpers of dispatch_batch. It is kept apart from
+/// ExecutionPool::shared() so batch entries waiting on timed tool calls cannot
+/// take every worker those calls need, and is never destroyed, like that one.
+inline tools::ExecutionPool& batch_pool()
+{
+    static auto* pool = new tools::ExecutionPool();
+    return *pool;
+}
+
+/// Answer a JSON-RPC batch (a top-level array).
+///
+/// `handle_one` receives each request object and returns its response, or a null
+/// Json when it sends none (notifications). Up to `max_parallel` entries run at
+/// once: the calling thread works through the batch together with helpers from
+/// batch_pool(), and helpers that have not started by the time the caller runs out
+/// of entries are skipped. Replies keep request order. Exceptions escaping `handle_one`
+/// become Internal Error replies. Entries that are not objects get
+/// an Invalid Request error, and an empty batch is answered with a single one, as
+/// JSON-RPC 2.0 requires. A null result means nothing should be sent back.
+inline Json dispatch_batch(const Json& batch, const std::function<Json(const Json&)>& handle_one,
+                           size_t max_parallel = kDefaultBatchParallelism)
+{
+    if (!batch.is_array() || batch.empty())
+        return error_response(nullptr, kInvalidRequest, "Invalid Request: empty batch");
+
+    std::vector<Json> replies(batch.size());
+    std::atomic<size_t> next{0};
+    auto drain = [&]()
+    {
+        for (size_t i = next++; i < batch.size(); i = next++)
+        {
+            const auto& entry = batch[i];
+            if (!entry.is_object())
+            {
+                replies[i] = error_response(nullptr, kInvalidRequest, "Invalid Request");
+                continue;
+            }
+            try
+            {
+                replies[i] = handle_one(entry);
+            }
+            catch (const std::exception& e)
+            {
+                if (!is_notification(entry))
+                    replies[i] = error_response(entry["id"], kInternalError, e.what());
+            }
+        }
+    };
+
+    struct Helpers
+    {
+        std::mutex mutex;
+        std::condition_variable idle;
+        size_t active{0};
+        bool closed{false}; // set once the caller stops waiting for new helpers
+    };
+    auto helpers = std::make_shared<Helpers>();
+    size_t extra = std::min(std::max<size_t>(max_parallel, 1), batch.size()) - 1;
+    for (size_t i = 0; i < extra; ++i)
+        batch_pool().post(
+            [helpers, &drain]()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(helpers->mutex);
+                    if (helpers->closed)
+                        return;
+                    ++helpers->active;
+                }
+                drain();
+                std::lock_guard<std::mutex> lock(helpers->mutex);
+                if (--helpers->active == 0)
+                    helpers->idle.notify_all();
+            });
+    drain();
+    {
+        std::unique_lock<std::mutex> lock(helpers->mutex);
+        helpers->closed = true;
+        helpers->idle.wait(lock, [&helpers]() { return helpers->active == 0; });
+    }
+
+    return collect_batch_replies(std::move(replies));
+}
+
+/// Answer one batch entry received on the HTTP transport of session `session_id`,
+/// for use as the `handle_one` of dispatch_batch.
+///
+/// A client's reply to a server-initiated request (an id but no method) goes to
+/// `on_client_response` and gets no answer. Anything else reaches `handler` with
+/// the session id set as params._meta.session_id. Notifications run for their
+/// effect alone and their errors are swallowed; a request's NotFoundError and
+/// ValidationError become Method Not Found and Invalid Params replies.
+inline Json handle_session_batch_entry(const Json& entry, const std::string& session_id,
+                                       const std::function<Json(const Json&)>& handler,
+                                       const std::function<void(const Json&)>& on_client_response)
+{
+    if (entry.contains("id") && !entry.contains("method"))
+    {
+        on_client_response(entry);
+        return nullptr;
+    }
+
+    Json request = entry;
+    if (!request.contains("params"))
+        request["params"] = Json::object();
+    if (!request["params"].contains("_meta"))
+        request["params"]["_meta"] = Json::object();
+    request["params"]["_meta"]["session_id"] = session_id;
+
+    if (is_notification(request))
+    {
+        try
+        {
+            (void)handler(request);
+        }
+        catch (...)
+        {
+        }
+        return nullptr;
+    }
+    try
+    {
+        return handler(request);
+    }
+    catch (const NotFoundError& e)
+    {
+        return error_response(request["id"], kMethodNotFound, e.what());
+    }
+    catch (const ValidationError& e)
+    {
+        return error_response(request["id"], kInvalidParams, e.what());
+    }
+}
+
+} // namespace fastmcpp::util::jsonrpc
@@ -0,0 +1,43 @@
+#pragma once
+/// @file sha256.hpp
+/// @brief Incremental SHA-256 (FIPS 180-4), using the CPU's SHA extensions when present.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace fastmcpp::util
+{
+
+class Sha256
+{
+  public:
+    using Digest = std::array<uint8_t, 32>;
+
+    /// @param allow_hardware Use x86 SHA-NI instructions if the CPU has them;
+    ///        false forces the portable implementation (both give equal digests)
+    explicit Sha256(bool allow_hardware = true);
+
+    void update(const void* data, size_t size);
+
+    /// Digest of everything passed to update(); the hasher is then spent
+    Digest finish();
+
+    /// Whether this build and CPU can use the hardware path
+    static bool hardware_available();
+
+    /// Lowercase hexadecimal form of `digest`
+    static std::string hex(const Digest& digest);
+
+  private:
+    using BlockFn = void (*)(uint32_t* state, const uint8_t* blocks, size_t count);
+
+    BlockFn process_;
+    std::array<uint32_t, 8> state_;
+    std::array<uint8_t, 64> buffer_{};
+    size_t buffered_{0};
+    uint64_t length_{0};
+};
+
+} // namespace fastmcpp::util
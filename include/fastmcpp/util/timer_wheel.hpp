@@ -0,0 +1,185 @@
+#pragma once
+/// @file timer_wheel.hpp
+/// @brief Hashed timer wheel that serves many coarse one-shot timers from one thread.
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fastmcpp::util
+{
+
+/// One background thread running any number of one-shot timers.
+///
+/// Deadlines are rounded up to whole ticks and hashed into a ring of slots, so
+/// scheduling and cancelling are O(1) and a tick only looks at the timers filed
+/// under its slot. The thread sleeps while nothing is pending. Callbacks run on
+/// the wheel thread without its lock held and may schedule or cancel timers;
+/// they should be short, since everything due after them waits. Timers still
+/// pending at destruction never fire.
+class TimerWheel
+{
+  public:
+    using Callback = std::function<void()>;
+    using TimerId = uint64_t;
+
+    explicit TimerWheel(std::chrono::milliseconds tick = std::chrono::milliseconds(100),
+                        size_t slots = 512)
+        : tick_(std::max(tick, std::chrono::milliseconds(1))), slots_(std::max<size_t>(slots, 1)),
+          epoch_(std::chrono::steady_clock::now())
+    {
+        thread_ = std::thread([this]() { run(); });
+    }
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    ~TimerWheel()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        if (thread_.joinable())
+            thread_.join();
+    }
+
+    std::chrono::milliseconds tick() const
+    {
+        return tick_;
+    }
+
+    /// Run `callback` once, no earlier than `delay` from now.
+    /// @return Id for cancel(), or 0 when the wheel is shutting down
+    TimerId schedule(std::chrono::milliseconds delay, Callback callback)
+    {
+        auto elapsed = std::chrono::steady_clock::now() - epoch_ + delay;
+        auto due = static_cast<uint64_t>((elapsed + tick_ - std::chrono::nanoseconds(1)) / tick_);
+
+        bool was_idle;
+        TimerId id;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_)
+                return 0;
+            due = std::max(due, current_tick_ + 1);
+            id = ++next_id_;
+            was_idle = timers_.empty();
+            timers_.emplace(id, Timer{std::move(callback), due});
+            slots_[due % slots_.size()].push_back(id);
+        }
+        if (was_idle)
+            cv_.notify_one();
+        return id;
+    }
+
+    /// @return false if the timer already fired or was cancelled
+    bool cancel(TimerId id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = timers_.find(id);
+        if (it == timers_.end())
+            return false;
+        auto& slot = slots_[it->second.due_tick % slots_.size()];
+        slot.erase(std::find(slot.begin(), slot.end(), id));
+        timers_.erase(it);
+        return true;
+    }
+
+    size_t pending() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return timers_.size();
+    }
+
+  private:
+    struct Timer
+    {
+        Callback callback;
+        uint64_t due_tick;
+    };
+
+    uint64_t ticks_elapsed() const
+    {
+        return static_cast<uint64_t>((std::chrono::steady_clock::now() - epoch_) / tick_);
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_)
+        {
+            if (timers_.empty())
+            {
+                cv_.wait(lock, [this]() { return stopping_ || !timers_.empty(); });
+                continue;
+            }
+
+            // Visit each slot that came due since the last pass, at most one lap
+            uint64_t now_tick = ticks_elapsed();
+            std::vector<Callback> due;
+            uint64_t span =
+                std::min<uint64_t>(now_tick - std::min(now_tick, current_tick_), slots_.size());
+            for (uint64_t i = 1; i <= span; ++i)
+            {
+                auto& slot = slots_[(current_tick_ + i) % slots_.size()];
+                auto keep = slot.begin();
+                for (auto id : slot)
+                {
+                    auto it = timers_.find(id);
+                    if (it->second.due_tick <= now_tick)
+                    {
+                        due.push_back(std::move(it->second.callback));
+                        timers_.erase(it);
+                    }
+                    else
+                    {
+                        *keep++ = id; // Due on a later lap
+                    }
+                }
+                slot.erase(keep, slot.end());
+            }
+            current_tick_ = std::max(current_tick_, now_tick);
+
+            if (!due.empty())
+            {
+                lock.unlock();
+                for (auto& callback : due)
+                {
+                    try
+                    {
+                        callback();
+                    }
+                    catch (...)
+                    {
+                    }
+                }
+                lock.lock();
+            }
+
+            cv_.wait_until(lock, epoch_ + tick_ * static_cast<int64_t>(current_tick_ + 1),
+                           [this]() { return stopping_ || ticks_elapsed() > current_tick_; });
+        }
+    }
+
+    const std::chrono::milliseconds tick_;
+    std::vector<std::vector<TimerId>> slots_; // guarded by mutex_
+    const std::chrono::steady_clock::time_point epoch_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::unordered_map<TimerId, Timer> timers_;
+    TimerId next_id_{0};
+    uint64_t current_tick_{0};
+    bool stopping_{false};
+    std::thread thread_;
+};
+
+} // namespace fastmcpp::util
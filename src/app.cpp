@@ -268,6 +268,9 @@ void FastMCP::mount(FastMCP& app, const std::string& prefix, bool as_proxy,
 
         // Create ProxyApp wrapper
         auto proxy = std::make_unique<ProxyApp>(client_factory, app.name(), app.version());
+        // Listing an in-process app is cheap and it cannot announce list changes, so
+        // read its catalog live rather than through the TTL cache
+        proxy->set_catalog_ttl(std::chrono::milliseconds{0});
 
         proxy_mounted_.push_back({prefix, std::move(proxy), std::move(tool_names)});
     }
@@ -275,6 +278,7 @@ void FastMCP::mount(FastMCP& app, const std::string& prefix, bool as_proxy,
     {
         mounted_.push_back({prefix, &app, std::move(tool_names)});
     }
+    structure_generation_.bump();
 }
 
 void FastMCP::add_provider(std::shared_ptr<providers::Provider> provider)
@@ -282,6 +286,7 @@ void FastMCP::add_provider(std::shared_ptr<providers::Provider> provider)
     if (!provider)
         throw ValidationError("provider cannot be null");
     providers_.push_back(std::move(provider));
+    structure_generation_.bump();
 }
 
 FastMCP& FastMCP::add_custom_route(CustomRoute route)
@@ -514,36 +519,53 @@ std::vector<std::pair<std::string, const tools::Tool*>> FastMCP::list_all_tools(
 
 std::vector<client::ToolInfo> FastMCP::list_all_tools_info() const
 {
-    std::vector<client::ToolInfo> result;
-    std::unordered_set<std::string> seen;
-    auto maybe_dereference_schema = [this](const Json& schema) -> Json
+    CatalogSnapshot collected;
+    collect_tools(collected);
+    return std::move(collected.tools);
+}
+
+void FastMCP::collect_tools(CatalogSnapshot& out) const
+{
+    auto& result = out.tools;
+    auto& routes = out.tool_routes;
+    // For tools listed by other apps; schemas without refs are left untouched
+    auto normalize_tool_info_schemas = [this](client::ToolInfo& info)
     {
         if (!dereference_schemas_)
-            return schema;
-        if (!util::schema::contains_ref(schema))
-            return schema;
-        return util::schema::dereference_refs(schema);
+            return;
+        if (util::schema::contains_ref(info.inputSchema))
+            info.inputSchema = util::schema::dereference_refs(info.inputSchema);
+        if (info.outputSchema && util::schema::contains_ref(*info.outputSchema))
+            *info.outputSchema = util::schema::dereference_refs(*info.outputSchema);
     };
-    auto normalize_tool_info_schemas = [&](client::ToolInfo& info)
+
+    // The route map doubles as the seen-set, so routes follow the listing's precedence.
+    auto add_route = [&](const client::ToolInfo& info, ToolRoute route)
     {
-        info.inputSchema = maybe_dereference_schema(info.inputSchema);
-        if (info.outputSchema && !info.outputSchema->is_null())
-            *info.outputSchema = maybe_dereference_schema(*info.outputSchema);
+        route.has_output_schema = info.outputSchema && !info.outputSchema->is_null();
+        if (route.has_output_schema)
+        {
+            const auto& schema = *info.outputSchema;
+            route.wrap_result = schema.is_object() && schema.value("x-fastmcp-wrap-result", false);
+        }
+        routes.emplace(info.name, std::move(route));
     };
 
     auto append_tool_info = [&](const tools::Tool& tool, const std::string& name)
     {
-        if (!seen.insert(name).second)
+        if (routes.count(name))
             return;
         client::ToolInfo info;
         info.name = name;
         info.version = tool.version();
-        info.inputSchema = maybe_dereference_schema(tool.input_schema());
+        // The tool derived its listed schemas once; this is their only copy here
+        info.inputSchema =
+            dereference_schemas_ ? tool.dereferenced_input_schema() : tool.input_schema();
         info.title = tool.title();
         info.description = tool.description();
-        auto out_schema = tool.output_schema();
-        if (!out_schema.is_null())
-            info.outputSchema = maybe_dereference_schema(out_schema);
+        if (!tool.output_schema().is_null())
+            info.outputSchema =
+                dereference_schemas_ ? tool.dereferenced_output_schema() : tool.output_schema();
         if (tool.task_support() != TaskSupport::Forbidden || tool.sequential())
         {
             Json execution = Json::object();
@@ -563,8 +585,8 @@ std::vector<client::ToolInfo> FastMCP::list_all_tools_info() const
                 info._meta = Json::object();
             (*info._meta)["ui"] = *tool.app();
         }
-        normalize_tool_info_schemas(info);
-        result.push_back(info);
+        add_route(info, ToolRoute{&tool, false, false, tool.task_support()});
+        result.push_back(std::move(info));
     };
 
     // Add local tools first
@@ -574,19 +596,36 @@ std::vector<client::ToolInfo> FastMCP::list_all_tools_info() const
         append_tool_info(tool, name);
     }
 
-    // Add tools from providers
+    // Add tools from providers (copies are kept so routes can point at them)
     for (const auto& provider : providers_)
-        for (const auto& tool : provider->list_tools_transformed())
-            append_tool_info(tool, tool.name());
+    {
+        for (auto& tool : provider->list_tools_transformed())
+        {
+            if (routes.count(tool.name()))
+                continue;
+            out.owned_tools.push_back(std::move(tool));
+            append_tool_info(out.owned_tools.back(), out.owned_tools.back().name());
+        }
+    }
 
-    // Add tools from directly mounted apps
+    // Add tools from directly mounted apps; their routes already point at the
+    // leaf tool, so nested mounts resolve in one lookup.
     for (auto it = mounted_.rbegin(); it != mounted_.rend(); ++it)
     {
         const auto& mounted = *it;
-        auto child_tools = mounted.app->list_all_tools_info();
+        // An untracked child lists its tools alone rather than a whole snapshot
+        auto child_catalog = mounted.app->cached_catalog();
+        if (!child_catalog)
+        {
+            auto tools_only = std::make_shared<CatalogSnapshot>();
+            mounted.app->collect_tools(*tools_only);
+            child_catalog = std::move(tools_only);
+        }
+        out.mounted_catalogs.push_back(child_catalog);
 
-        for (auto& tool_info : child_tools)
+        for (auto tool_info : child_catalog->tools)
         {
+            const auto* child_route = child_catalog->find_tool_route(tool_info.name);
             if (mounted.tool_names)
             {
                 auto override_it = mounted.tool_names->find(tool_info.name);
@@ -600,8 +639,10 @@ std::vector<client::ToolInfo> FastMCP::list_all_tools_info() const
                 tool_info.name = add_prefix(tool_info.name, mounted.prefix);
             }
             normalize_tool_info_schemas(tool_info);
-            if (seen.insert(tool_info.name).second)
-                result.push_back(tool_info);
+            if (routes.count(tool_info.name))
+                continue;
+            add_route(tool_info, child_route ? *child_route : ToolRoute{});
+            result.push_back(std::move(tool_info));
         }
     }
 
@@ -626,12 +667,12 @@ std::vector<client::ToolInfo> FastMCP::list_all_tools_info() const
                 tool_info.name = add_prefix(tool_info.name, proxy_mount.prefix);
             }
             normalize_tool_info_schemas(tool_info);
-            if (seen.insert(tool_info.name).second)
-                result.push_back(tool_info);
+            if (routes.count(tool_info.name))
+                continue;
+            add_route(tool_info, ToolRoute{});
+            result.push_back(std::move(tool_info));
         }
     }
-
-    return result;
 }
 
 std::vector<resources::Resource> FastMCP::list_all_resources() const
@@ -658,9 +699,13 @@ std::vector<resources::Resource> FastMCP::list_all_resources() const
     for (auto it = mounted_.rbegin(); it != mounted_.rend(); ++it)
     {
         const auto& mounted = *it;
-        auto child_resources = mounted.app->list_all_resources();
+        auto child_catalog = mounted.app->cached_catalog();
+        std::vector<resources::Resource> walked;
+        if (!child_catalog)
+            walked = mounted.app->list_all_resources();
+        const auto& child_resources = child_catalog ? child_catalog->resources : walked;
 
-        for (auto& res : child_resources)
+        for (const auto& res : child_resources)
         {
             // Create copy with prefixed URI
             resources::Resource prefixed_res = res;
@@ -733,9 +778,13 @@ std::vector<resources::ResourceTemplate> FastMCP::list_all_templates() const
     for (auto it = mounted_.rbegin(); it != mounted_.rend(); ++it)
     {
         const auto& mounted = *it;
-        auto child_templates = mounted.app->list_all_templates();
+        auto child_catalog = mounted.app->cached_catalog();
+        std::vector<resources::ResourceTemplate> walked;
+        if (!child_catalog)
+            walked = mounted.app->list_all_templates();
+        const auto& child_templates = child_catalog ? child_catalog->templates : walked;
 
-        for (auto& templ : child_templates)
+        for (const auto& templ : child_templates)
         {
             // Create copy with prefixed URI template
             resources::ResourceTemplate prefixed_templ = templ;
@@ -839,11 +888,141 @@ std::vector<std::pair<std::string, const prompts::Prompt*>> FastMCP::list_all_pr
     return result;
 }
 
+// =========================================================================
+// Catalog Snapshot
+// =========================================================================
+
+std::optional<uint64_t> FastMCP::catalog_generation() const
+{
+    // A proxied backend can change its catalog without telling us.
+    if (!proxy_mounted_.empty())
+        return std::nullopt;
+
+    // Every summand only ever increases (util::GenerationStamp), so the sum
+    // changes whenever any source does.
+    uint64_t generation = structure_generation_.value() + tools_.generation() +
+                          resources_.generation() + prompts_.generation();
+    for (const auto& provider : providers_)
+    {
+        auto provider_generation = provider->generation();
+        if (!provider_generation)
+            return std::nullopt;
+        generation += *provider_generation;
+    }
+    for (const auto& mounted : mounted_)
+    {
+        auto child_generation = mounted.app->catalog_generation();
+        if (!child_generation)
+            return std::nullopt;
+        generation += *child_generation;
+    }
+    return generation;
+}
+
+std::shared_ptr<const CatalogSnapshot> FastMCP::catalog() const
+{
+    return catalog(catalog_generation());
+}
+
+std::shared_ptr<const CatalogSnapshot> FastMCP::cached_catalog() const
+{
+    auto generation = catalog_generation();
+    if (!generation)
+        return nullptr;
+    return catalog(generation);
+}
+
+std::shared_ptr<const CatalogSnapshot> FastMCP::catalog(std::optional<uint64_t> generation) const
+{
+    // The generation is read before building, so a change racing with the
+    // build forces a rebuild on the next call instead of being masked.
+    if (generation)
+    {
+        std::lock_guard<std::mutex> lock(catalog_cache_->mutex);
+        const auto& cached = catalog_cache_->snapshot;
+        if (cached && cached->generation == generation)
+            return cached;
+    }
+
+    // Built without the lock: providers may do I/O (e.g. remote listings), and
+    // concurrent callers must not queue behind it
+    auto snapshot = std::make_shared<CatalogSnapshot>();
+    snapshot->generation = generation;
+    collect_tools(*snapshot);
+    snapshot->resources = list_all_resources();
+    snapshot->templates = list_all_templates();
+
+    for (const auto& [name, route] : snapshot->tool_routes)
+        if (route.task_support && *route.task_support != TaskSupport::Forbidden)
+            snapshot->supports_tasks = true;
+    for (const auto& res : snapshot->resources)
+        if (res.task_support != TaskSupport::Forbidden)
+            snapshot->supports_tasks = true;
+
+    auto prompts = list_all_prompts();
+    snapshot->prompts.reserve(prompts.size());
+    for (const auto& [name, prompt] : prompts)
+    {
+        if (prompt)
+        {
+            if (prompt->task_support != TaskSupport::Forbidden)
+                snapshot->supports_tasks = true;
+            snapshot->prompts.emplace_back(name, *prompt);
+        }
+        else
+        {
+            snapshot->prompts.emplace_back(name, std::nullopt);
+        }
+    }
+
+    if (!generation)
+        return snapshot;
+
+    // Generations only grow, so keep whichever concurrent build is newest
+    std::lock_guard<std::mutex> lock(catalog_cache_->mutex);
+    auto& cached = catalog_cache_->snapshot;
+    if (cached && *cached->generation >= *generation)
+        return *cached->generation == *generation ? cached : snapshot;
+    cached = snapshot;
+    return snapshot;
+}
+
+std::optional<ToolRoute> FastMCP::find_tool_route(const std::string& name) const
+{
+    auto snapshot = cached_catalog();
+    if (!snapshot)
+    {
+        auto tools_only = std::make_shared<CatalogSnapshot>();
+        collect_tools(*tools_only);
+        snapshot = std::move(tools_only);
+    }
+    const auto* route = snapshot->find_tool_route(name);
+    if (!route)
+        return std::nullopt;
+    ToolRoute found = *route;
+    found.tool = nullptr;
+    return found;
+}
+
 // =========================================================================
 // Routing
 // =========================================================================
 
 Json FastMCP::invoke_tool(const std::string& name, const Json& args, bool enforce_timeout) const
+{
+    // Only consult the route index when the snapshot is cached; building an
+    // uncacheable one per call would cost more than the walk below.
+    if (auto snapshot = cached_catalog())
+    {
+        const auto* route = snapshot->find_tool_route(name);
+        if (route && route->tool)
+            return route->tool->invoke(args, enforce_timeout);
+    }
+    return invoke_tool_uncached(name, args, enforce_timeout);
+}
+
+Json FastMCP::invoke_tool_uncached(const std::string& name, const Json& args,
+                                   bool enforce_timeout) const
 {
     // Try local tools first
     try
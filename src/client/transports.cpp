@@ -6,10 +6,13 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
 #include <httplib.h>
 #include <mutex>
 #include <sstream>
+#include <string_view>
 #include <thread>
 #ifdef FASTMCPP_POST_STREAMING
 #include <curl/curl.h>
@@ -21,15 +24,72 @@ namespace fastmcpp::client
 struct StdioTransport::State
 {
     fastmcpp::process::Process process;
-    std::mutex request_mutex;
-    // Stderr background reader (keep-alive mode)
+    std::atomic<int64_t> next_id{1};
+    // One JSON-RPC line on stdin at a time
+    std::mutex write_mutex;
+
+    // Requests waiting for their response, keyed by JSON-RPC id. Once stdout
+    // closes, `closed` is set and everything pending fails with `closed_reason`.
+    std::mutex pending_mutex;
+    std::unordered_map<int64_t, std::promise<fastmcpp::Json>> pending;
+    bool closed{false};
+    std::string closed_reason;
+
+    std::mutex handler_mutex;
+    std::function<void(const fastmcpp::Json&)> notification_callback;
+    ServerRequestHandler server_request_handler;
+
+    // Server-initiated requests (sampling, elicitation, ...) are answered on their
+    // own thread, started with the first one, so a slow handler never holds up
+    // the responses read from stdout
+    std::mutex server_requests_mutex;
+    std::condition_variable server_requests_cv;
+    std::deque<fastmcpp::Json> server_requests;
+    bool server_requests_stopping{false};
+    std::thread server_request_thread;
+
+    std::atomic<bool> running{true};
+    std::thread stdout_thread;
+
+    // Only the stdout reader reaps the child; everyone else reads the outcome here.
+    // `exit_code` stays empty if the status could not be collected.
+    std::mutex exit_mutex;
+    std::condition_variable exit_cv;
+    bool exited{false};
+    std::optional<int> exit_code;
+
+    // Stderr background reader (keeps the pipe drained)
     std::thread stderr_thread;
-    std::atomic<bool> stderr_running{false};
     std::mutex stderr_mutex;
+    std::condition_variable stderr_cv;
+    bool stderr_done{false};
     std::string stderr_data;
     // Logging
     std::ofstream log_file_stream;
     std::ostream* stderr_target{nullptr};
+
+    ~State();
+
+    void start_readers();
+    void read_stdout();
+    void read_stderr();
+    void dispatch(const fastmcpp::Json& message);
+    void queue_server_request(const fastmcpp::Json& message);
+    void serve_server_requests();
+    void answer_server_request(const fastmcpp::Json& message);
+    void write_line(const std::string& line);
+    void fail_pending(const std::string& reason);
+    /// Reap the child if it has exited; true once it has.
+    bool reap();
+    bool has_exited();
+
+    /// Register interest in `id` before its request is written.
+    std::future<fastmcpp::Json> expect(int64_t id);
+    /// Stop waiting for `id`; false if its response (or failure) was already delivered.
+    bool forget(int64_t id);
+    /// Wait for the response to `id`, giving up after the transport timeout.
+    fastmcpp::Json await(int64_t id, std::future<fastmcpp::Json>& future);
+    std::string stderr_suffix();
 };
 
 namespace
@@ -155,31 +215,172 @@ std::pair<std::string, std::string> resolve_redirect_target(const std::string& c
 }
 } // namespace
 
+namespace detail
+{
+
+/// Keep-alive httplib clients, parked per origin between requests so that a
+/// request reuses an open TCP/TLS connection instead of dialing a new one.
+/// Concurrent requests each borrow their own client.
+class HttpConnectionPool
+{
+  public:
+    using Factory = std::function<std::unique_ptr<httplib::Client>()>;
+
+    /// Client borrowed from the pool; it is parked again when the lease ends.
+    class Lease
+    {
+      public:
+        Lease(HttpConnectionPool& pool, std::string key, std::unique_ptr<httplib::Client> client)
+            : pool_(pool), key_(std::move(key)), client_(std::move(client))
+        {
+        }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        ~Lease()
+        {
+            if (client_)
+                pool_.release(key_, std::move(client_));
+        }
+
+        httplib::Client* operator->()
+        {
+            return client_.get();
+        }
+
+        /// Drop the connection instead of parking it, e.g. after a failed request
+        void discard()
+        {
+            client_.reset();
+        }
+
+      private:
+        HttpConnectionPool& pool_;
+        std::string key_;
+        std::unique_ptr<httplib::Client> client_;
+    };
+
+    /// Borrow a parked client for `key` (scheme://host:port), or build one with `make`.
+    Lease acquire(const std::string& key, const Factory& make)
+    {
+        requests_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = idle_.find(key);
+            if (it != idle_.end() && !it->second.empty())
+            {
+                auto client = std::move(it->second.back());
+                it->second.pop_back();
+                return Lease(*this, key, std::move(client));
+            }
+        }
+
+        auto client = make();
+        client->set_keep_alive(true);
+        // Called for every socket the client opens, including silent reconnects
+        client->set_socket_options([this](httplib::socket_t)
+                                   { connections_.fetch_add(1, std::memory_order_relaxed); });
+        return Lease(*this, key, std::move(client));
+    }
+
+    HttpConnectionStats stats() const
+    {
+        HttpConnectionStats out;
+        out.requests = requests_.load(std::memory_order_relaxed);
+        out.connections = connections_.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [key, clients] : idle_)
+            out.idle_clients += clients.size();
+        return out;
+    }
+
+  private:
+    /// Parked clients per origin beyond this are closed
+    static constexpr size_t kMaxIdlePerOrigin = 4;
+
+    void release(const std::string& key, std::unique_ptr<httplib::Client> client)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& clients = idle_[key];
+        if (clients.size() < kMaxIdlePerOrigin)
+            clients.push_back(std::move(client));
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::vector<std::unique_ptr<httplib::Client>>> idle_;
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> connections_{0};
+};
+
+std::shared_ptr<HttpConnectionPool> make_http_connection_pool()
+{
+    return std::make_shared<HttpConnectionPool>();
+}
+
+HttpConnectionStats http_connection_stats(const HttpConnectionPool& pool)
+{
+    return pool.stats();
+}
+
+} // namespace detail
+
+namespace
+{
+/// Client for POSTing messages to an SSE server.
+detail::HttpConnectionPool::Lease acquire_sse_post_client(detail::HttpConnectionPool& pool,
+                                                          const std::string& base_url,
+                                                          bool verify_ssl)
+{
+    auto url = parse_url(base_url);
+    return pool.acquire(url.host + ":" + std::to_string(url.port),
+                        [&]()
+                        {
+                            // Use two-argument constructor for better Windows compatibility
+                            auto client =
+                                std::make_unique<httplib::Client>(url.host.c_str(), url.port);
+#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
+                            client->enable_server_certificate_verification(verify_ssl);
+#else
+                            (void)verify_ssl;
+#endif
+                            client->set_connection_timeout(5, 0);
+                            client->set_read_timeout(30, 0);
+                            return client;
+                        });
+}
+} // namespace
+
 fastmcpp::Json HttpTransport::request(const std::string& route, const fastmcpp::Json& payload)
 {
     auto url = parse_url(base_url_);
 
     // Security: Create client with full scheme://host:port URL for proper TLS handling
     std::string full_url = url.scheme + "://" + url.host + ":" + std::to_string(url.port);
-    httplib::Client cli(full_url.c_str());
+    auto cli = pool_->acquire(full_url,
+                              [&]()
+                              {
+                                  auto client = std::make_unique<httplib::Client>(full_url.c_str());
 #ifdef CPPHTTPLIB_OPENSSL_SUPPORT
-    cli.enable_server_certificate_verification(verify_ssl_);
+                                  client->enable_server_certificate_verification(verify_ssl_);
 #endif
-
-    cli.set_connection_timeout(5, 0);
-    cli.set_keep_alive(true);
-    cli.set_read_timeout(static_cast<int>(timeout_.count()), 0);
-
-    // Security: Disable redirects by default to prevent SSRF and TLS downgrade attacks
-    cli.set_follow_location(false);
+                                  client->set_connection_timeout(5, 0);
+                                  client->set_read_timeout(static_cast<int>(timeout_.count()), 0);
+                                  // Security: Disable redirects by default to prevent SSRF and
+                                  // TLS downgrade attacks
+                                  client->set_follow_location(false);
+                                  return client;
+                              });
 
     httplib::Headers headers = {{"Accept", "text/event-stream, application/json"}};
     for (const auto& [key, value] : headers_)
         headers.emplace(key, value);
 
-    auto res = cli.Post(("/" + route).c_str(), headers, payload.dump(), "application/json");
+    auto res = cli->Post(("/" + route).c_str(), headers, payload.dump(), "application/json");
     if (!res)
+    {
+        cli.discard();
         throw fastmcpp::TransportError("HTTP request failed: no response");
+    }
     if (res->status < 200 || res->status >= 300)
         throw fastmcpp::TransportError("HTTP error: " + std::to_string(res->status));
     return fastmcpp::util::json::parse(res->body);
@@ -451,202 +652,554 @@ void HttpTransport::request_stream_post(const std::string& route, const fastmcpp
 #endif
 }
 
-StdioTransport::StdioTransport(std::string command, std::vector<std::string> args,
-                               std::optional<std::filesystem::path> log_file, bool keep_alive)
-    : command_(std::move(command)), args_(std::move(args)), log_file_(std::move(log_file)),
-      keep_alive_(keep_alive)
+namespace
 {
-}
+/// How long a keep-alive request waits for its response.
+constexpr auto kStdioResponseTimeout = std::chrono::seconds(30);
+/// Stderr kept for error messages; older output is dropped.
+constexpr size_t kStdioStderrTail = 64 * 1024;
+} // namespace
 
-StdioTransport::StdioTransport(std::string command, std::vector<std::string> args,
-                               std::ostream* log_stream, bool keep_alive)
-    : command_(std::move(command)), args_(std::move(args)), log_stream_(log_stream),
-      keep_alive_(keep_alive)
+StdioTransport::State::~State()
 {
+    running.store(false, std::memory_order_release);
+
+    // Close stdin to signal the server to exit
+    try
+    {
+        process.stdin_pipe().close();
+    }
+    catch (...)
+    {
+    }
+
+    // Give the server a moment to exit on its own, then force kill it. The stdout
+    // reader notices the exit and reaps the child before it is joined below.
+    {
+        std::unique_lock<std::mutex> lock(exit_mutex);
+        if (!exit_cv.wait_for(lock, std::chrono::milliseconds(100), [this]() { return exited; }))
+        {
+            try
+            {
+                process.kill();
+            }
+            catch (...)
+            {
+            }
+        }
+    }
+
+    if (stdout_thread.joinable())
+        stdout_thread.join();
+    if (stderr_thread.joinable())
+        stderr_thread.join();
+
+    // Stdout is done, so no more server requests arrive; queued ones are dropped
+    {
+        std::lock_guard<std::mutex> lock(server_requests_mutex);
+        server_requests_stopping = true;
+    }
+    server_requests_cv.notify_all();
+    if (server_request_thread.joinable())
+        server_request_thread.join();
 }
 
-fastmcpp::Json StdioTransport::request(const std::string& route, const fastmcpp::Json& payload)
+void StdioTransport::State::start_readers()
 {
-    namespace proc = fastmcpp::process;
+    stderr_thread = std::thread([this]() { read_stderr(); });
+    stdout_thread = std::thread([this]() { read_stdout(); });
+}
 
-    if (keep_alive_)
+void StdioTransport::State::read_stderr()
+{
+    char buf[1024];
+    while (running.load(std::memory_order_acquire))
     {
-        // Python fastmcp commit f5804f47 (#3630): if the subprocess died between calls,
-        // reset state and respawn on the next request rather than failing forever.
-        if (state_)
+        try
         {
-            auto exit_code = state_->process.try_wait();
-            if (exit_code.has_value())
+            if (!process.stderr_pipe().is_open())
+                break;
+            if (!process.stderr_pipe().has_data(50))
+                continue;
+            size_t n = process.stderr_pipe().read(buf, sizeof(buf));
+            if (n == 0)
+                break;
+            std::lock_guard<std::mutex> lock(stderr_mutex);
+            if (stderr_target)
             {
-                // Process already exited — tear down so we respawn cleanly below.
-                state_->stderr_running.store(false, std::memory_order_release);
-                if (state_->stderr_thread.joinable())
-                    state_->stderr_thread.join();
-                state_.reset();
+                stderr_target->write(buf, static_cast<std::streamsize>(n));
+                stderr_target->flush();
             }
+            stderr_data.append(buf, n);
+            if (stderr_data.size() > kStdioStderrTail)
+                stderr_data.erase(0, stderr_data.size() - kStdioStderrTail);
+        }
+        catch (...)
+        {
+            break;
         }
+    }
+    {
+        std::lock_guard<std::mutex> lock(stderr_mutex);
+        stderr_done = true;
+    }
+    stderr_cv.notify_all();
+}
 
-        // --- Keep-alive mode: spawn once, reuse across calls ---
-        if (!state_)
+void StdioTransport::State::read_stdout()
+{
+    auto& out = process.stdout_pipe();
+    while (running.load(std::memory_order_acquire))
+    {
+        std::string_view line;
+        try
+        {
+            // Wakes as soon as output arrives; the timeout only bounds shutdown
+            if (!out.has_data(250))
+                continue;
+            // Parsed straight out of the pipe's buffer, without copying the line
+            line = out.read_line_view();
+        }
+        catch (...)
         {
-            state_ = std::make_unique<State>();
+            break;
+        }
+        if (line.empty())
+            break; // EOF
 
-            if (log_file_.has_value())
-            {
-                state_->log_file_stream.open(log_file_.value(), std::ios::app);
-                if (state_->log_file_stream.is_open())
-                    state_->stderr_target = &state_->log_file_stream;
-            }
-            else if (log_stream_ != nullptr)
-            {
-                state_->stderr_target = log_stream_;
-            }
+        // Strip trailing \r\n
+        while (!line.empty() && (line.back() == '\n' || line.back() == '\r'))
+            line.remove_suffix(1);
+        if (line.empty())
+            continue;
 
+        fastmcpp::Json message;
+        try
+        {
+            message = fastmcpp::Json::parse(line.begin(), line.end());
+        }
+        catch (...)
+        {
+            continue; // Ignore non-JSON stdout lines (e.g., server logs)
+        }
+        if (message.is_array())
+            for (const auto& entry : message)
+                dispatch(entry);
+        else
+            dispatch(message);
+    }
+
+    // Stdout is gone: report how the process ended to everyone still waiting. A
+    // server that closed stdout but keeps running is reaped once it exits or
+    // ~State kills it.
+    bool reported = false;
+    for (int i = 0; !reap(); i++)
+    {
+        if (!reported && (i >= 100 || !running.load(std::memory_order_acquire)))
+        {
+            fail_pending("StdioTransport: server closed its stdout" + stderr_suffix());
+            reported = true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(i < 100 ? 10 : 50));
+    }
+    if (reported)
+        return;
+
+    std::optional<int> code;
+    {
+        std::lock_guard<std::mutex> lock(exit_mutex);
+        code = exit_code;
+    }
+    if (code)
+        fail_pending("StdioTransport process exited with code: " + std::to_string(*code) +
+                     stderr_suffix());
+    else
+        fail_pending("StdioTransport: server closed its stdout" + stderr_suffix());
+}
+
+bool StdioTransport::State::reap()
+{
+    std::lock_guard<std::mutex> lock(exit_mutex);
+    if (exited)
+        return true;
+    try
+    {
+        auto code = process.try_wait();
+        if (!code)
+            return false;
+        exit_code = *code;
+    }
+    catch (...)
+    {
+        // waitpid failed (e.g. ECHILD): the child is gone, its status unknown
+    }
+    exited = true;
+    exit_cv.notify_all();
+    return true;
+}
+
+bool StdioTransport::State::has_exited()
+{
+    std::lock_guard<std::mutex> lock(exit_mutex);
+    return exited;
+}
+
+void StdioTransport::State::dispatch(const fastmcpp::Json& message)
+{
+    if (!message.is_object())
+        return;
+
+    if (message.contains("method"))
+    {
+        if (message.contains("id") && !message["id"].is_null())
+        {
+            queue_server_request(message);
+            return;
+        }
+        std::function<void(const fastmcpp::Json&)> callback;
+        {
+            std::lock_guard<std::mutex> lock(handler_mutex);
+            callback = notification_callback;
+        }
+        if (callback)
+        {
             try
             {
-                state_->process.spawn(command_, args_,
-                                      proc::ProcessOptions{/*working_directory=*/{},
-                                                           /*environment=*/{},
-                                                           /*inherit_environment=*/true,
-                                                           /*redirect_stdin=*/true,
-                                                           /*redirect_stdout=*/true,
-                                                           /*redirect_stderr=*/true,
-                                                           /*create_no_window=*/true});
+                callback(message);
             }
-            catch (const proc::ProcessError& e)
+            catch (...)
             {
-                state_.reset();
-                throw fastmcpp::TransportError(std::string("StdioTransport: spawn failed: ") +
-                                               e.what());
             }
+        }
+        return;
+    }
 
-            // Background stderr reader to prevent pipe buffer deadlock
-            state_->stderr_running.store(true, std::memory_order_release);
-            state_->stderr_thread = std::thread(
-                [st = state_.get()]()
-                {
-                    char buf[1024];
-                    while (st->stderr_running.load(std::memory_order_acquire))
-                    {
-                        try
-                        {
-                            if (!st->process.stderr_pipe().is_open())
-                                break;
-                            if (!st->process.stderr_pipe().has_data(50))
-                                continue;
-                            size_t n = st->process.stderr_pipe().read(buf, sizeof(buf));
-                            if (n == 0)
-                                break;
-                            std::lock_guard<std::mutex> lock(st->stderr_mutex);
-                            if (st->stderr_target)
-                            {
-                                st->stderr_target->write(buf, static_cast<std::streamsize>(n));
-                                st->stderr_target->flush();
-                            }
-                            st->stderr_data.append(buf, n);
-                        }
-                        catch (...)
-                        {
-                            break;
-                        }
-                    }
-                });
+    if (!message.contains("id") || !message["id"].is_number_integer())
+        return;
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    auto it = pending.find(message["id"].get<int64_t>());
+    if (it == pending.end())
+        return; // Late response to a request that already timed out
+    it->second.set_value(message);
+    pending.erase(it);
+}
+
+void StdioTransport::State::queue_server_request(const fastmcpp::Json& message)
+{
+    {
+        std::lock_guard<std::mutex> lock(server_requests_mutex);
+        server_requests.push_back(message);
+        if (!server_request_thread.joinable())
+            server_request_thread = std::thread([this]() { serve_server_requests(); });
+    }
+    server_requests_cv.notify_one();
+}
+
+void StdioTransport::State::serve_server_requests()
+{
+    std::unique_lock<std::mutex> lock(server_requests_mutex);
+    while (true)
+    {
+        server_requests_cv.wait(lock, [this]()
+                                { return server_requests_stopping || !server_requests.empty(); });
+        if (server_requests_stopping)
+            return;
+        auto message = std::move(server_requests.front());
+        server_requests.pop_front();
+        lock.unlock();
+        answer_server_request(message);
+        lock.lock();
+    }
+}
+
+void StdioTransport::State::answer_server_request(const fastmcpp::Json& message)
+{
+    const std::string method = message.value("method", std::string());
+    const fastmcpp::Json params = message.value("params", fastmcpp::Json::object());
+
+    ServerRequestHandler handler;
+    {
+        std::lock_guard<std::mutex> lock(handler_mutex);
+        handler = server_request_handler;
+    }
+
+    fastmcpp::Json rpc_response = {{"jsonrpc", "2.0"}, {"id", message["id"]}};
+    if (!handler)
+    {
+        rpc_response["error"] = {{"code", -32601}, {"message", "Method not handled: " + method}};
+    }
+    else
+    {
+        try
+        {
+            rpc_response["result"] = handler(method, params);
+        }
+        catch (const std::exception& e)
+        {
+            rpc_response["error"] = {{"code", -32603}, {"message", e.what()}};
         }
+        catch (...)
+        {
+            rpc_response["error"] = {{"code", -32603}, {"message", "Unknown error"}};
+        }
+    }
+
+    try
+    {
+        write_line(rpc_response.dump() + "\n");
+    }
+    catch (...)
+    {
+        // Best-effort: the process is going away
+    }
+}
+
+void StdioTransport::State::write_line(const std::string& line)
+{
+    std::lock_guard<std::mutex> lock(write_mutex);
+    process.stdin_pipe().write(line);
+}
+
+void StdioTransport::State::fail_pending(const std::string& reason)
+{
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    closed = true;
+    closed_reason = reason;
+    for (auto& [id, promise] : pending)
+        promise.set_exception(std::make_exception_ptr(fastmcpp::TransportError(reason)));
+    pending.clear();
+}
+
+std::future<fastmcpp::Json> StdioTransport::State::expect(int64_t id)
+{
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    if (closed)
+        throw fastmcpp::TransportError(closed_reason);
+    return pending[id].get_future();
+}
+
+bool StdioTransport::State::forget(int64_t id)
+{
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    return pending.erase(id) > 0;
+}
+
+fastmcpp::Json StdioTransport::State::await(int64_t id, std::future<fastmcpp::Json>& future)
+{
+    // A response delivered between the timeout and forget() still counts
+    if (future.wait_for(kStdioResponseTimeout) != std::future_status::ready && forget(id))
+        throw fastmcpp::TransportError("StdioTransport: timed out waiting for response");
+    return future.get();
+}
+
+std::string StdioTransport::State::stderr_suffix()
+{
+    // Give the stderr reader a moment to drain what the process wrote last
+    std::unique_lock<std::mutex> lock(stderr_mutex);
+    stderr_cv.wait_for(lock, std::chrono::milliseconds(200), [this]() { return stderr_done; });
+    return stderr_data.empty() ? std::string() : "; stderr: " + stderr_data;
+}
+
+StdioTransport::StdioTransport(std::string command, std::vector<std::string> args,
+                               std::optional<std::filesystem::path> log_file, bool keep_alive)
+    : command_(std::move(command)), args_(std::move(args)), log_file_(std::move(log_file)),
+      keep_alive_(keep_alive)
+{
+}
+
+StdioTransport::StdioTransport(std::string command, std::vector<std::string> args,
+                               std::ostream* log_stream, bool keep_alive)
+    : command_(std::move(command)), args_(std::move(args)), log_stream_(log_stream),
+      keep_alive_(keep_alive)
+{
+}
 
-        auto* st = state_.get();
-        std::lock_guard<std::mutex> request_lock(st->request_mutex);
+std::shared_ptr<StdioTransport::State> StdioTransport::live_state()
+{
+    namespace proc = fastmcpp::process;
 
-        const int64_t id = next_id_++;
-        fastmcpp::Json rpc_request = {
-            {"jsonrpc", "2.0"},
-            {"id", id},
-            {"method", route},
-            {"params", payload},
-        };
+    std::lock_guard<std::mutex> lock(*state_mutex_);
 
+    // Python fastmcp commit f5804f47 (#3630): if the subprocess died between calls,
+    // reset state and respawn on the next request rather than failing forever.
+    // Requests still holding the old state finish (or fail) against it.
+    if (state_)
+    {
+        bool closed;
         {
-            std::lock_guard<std::mutex> lock(st->stderr_mutex);
-            st->stderr_data.clear();
+            std::lock_guard<std::mutex> pending_lock(state_->pending_mutex);
+            closed = state_->closed;
         }
+        if (closed || state_->has_exited())
+            state_.reset();
+    }
+    if (state_)
+        return state_;
 
+    auto state = std::make_shared<State>();
+    if (log_file_.has_value())
+    {
+        state->log_file_stream.open(log_file_.value(), std::ios::app);
+        if (state->log_file_stream.is_open())
+            state->stderr_target = &state->log_file_stream;
+    }
+    else if (log_stream_ != nullptr)
+    {
+        state->stderr_target = log_stream_;
+    }
+    state->notification_callback = notification_callback_;
+    state->server_request_handler = server_request_handler_;
+
+    try
+    {
+        state->process.spawn(command_, args_,
+                             proc::ProcessOptions{/*working_directory=*/{},
+                                                  /*environment=*/{},
+                                                  /*inherit_environment=*/true,
+                                                  /*redirect_stdin=*/true,
+                                                  /*redirect_stdout=*/true,
+                                                  /*redirect_stderr=*/true,
+                                                  /*create_no_window=*/true});
+    }
+    catch (const proc::ProcessError& e)
+    {
+        throw fastmcpp::TransportError(std::string("StdioTransport: spawn failed: ") + e.what());
+    }
+
+    state->start_readers();
+    state_ = state;
+    return state;
+}
+
+fastmcpp::Json StdioTransport::request(const std::string& route, const fastmcpp::Json& payload)
+{
+    if (!keep_alive_)
+        return request_one_shot(route, payload);
+
+    // --- Keep-alive mode: spawn once, reuse across calls ---
+    auto st = live_state();
+    const int64_t id = st->next_id.fetch_add(1, std::memory_order_relaxed);
+    fastmcpp::Json rpc_request = {
+        {"jsonrpc", "2.0"},
+        {"id", id},
+        {"method", route},
+        {"params", payload},
+    };
+
+    auto future = st->expect(id);
+    try
+    {
+        st->write_line(rpc_request.dump() + "\n");
+    }
+    catch (const fastmcpp::process::ProcessError& e)
+    {
+        st->forget(id);
+        throw fastmcpp::TransportError(std::string("StdioTransport: failed to write: ") + e.what());
+    }
+    return st->await(id, future);
+}
+
+std::vector<fastmcpp::Json> StdioTransport::request_batch(const std::vector<BatchCall>& calls)
+{
+    if (!keep_alive_)
+    {
+        // One process per call: a fresh server has no state to share anyway
+        std::vector<fastmcpp::Json> responses;
+        responses.reserve(calls.size());
+        for (const auto& call : calls)
+            responses.push_back(request_one_shot(call.method, call.params));
+        return responses;
+    }
+
+    auto st = live_state();
+    fastmcpp::Json batch = fastmcpp::Json::array();
+    std::vector<int64_t> ids;
+    std::vector<std::future<fastmcpp::Json>> futures;
+    ids.reserve(calls.size());
+    futures.reserve(calls.size());
+    for (const auto& call : calls)
+    {
+        ids.push_back(st->next_id.fetch_add(1, std::memory_order_relaxed));
+        batch.push_back({{"jsonrpc", "2.0"},
+                         {"id", ids.back()},
+                         {"method", call.method},
+                         {"params", call.params}});
         try
         {
-            st->process.stdin_pipe().write(rpc_request.dump() + "\n");
+            futures.push_back(st->expect(ids.back()));
         }
-        catch (const proc::ProcessError& e)
+        catch (...)
         {
-            throw fastmcpp::TransportError(std::string("StdioTransport: failed to write: ") +
-                                           e.what());
+            for (size_t i = 0; i + 1 < ids.size(); ++i)
+                st->forget(ids[i]);
+            throw;
         }
+    }
 
-        // Read lines from stdout until we get a JSON response matching our ID
-        for (;;)
+    try
+    {
+        st->write_line(batch.dump() + "\n");
+    }
+    catch (const fastmcpp::process::ProcessError& e)
+    {
+        for (auto id : ids)
+            st->forget(id);
+        throw fastmcpp::TransportError(std::string("StdioTransport: failed to write: ") + e.what());
+    }
+
+    // Entries the server leaves unanswered are reported like a missing batch reply
+    fastmcpp::Json replies = fastmcpp::Json::array();
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        try
         {
-            // Check if process exited
-            auto exit_code = st->process.try_wait();
-            if (exit_code.has_value())
-            {
-                std::lock_guard<std::mutex> lock(st->stderr_mutex);
-                throw fastmcpp::TransportError(
-                    "StdioTransport process exited with code: " + std::to_string(*exit_code) +
-                    (st->stderr_data.empty() ? std::string() : "; stderr: " + st->stderr_data));
-            }
+            replies.push_back(st->await(ids[i], futures[i]));
+        }
+        catch (const fastmcpp::TransportError&)
+        {
+            for (size_t j = i + 1; j < ids.size(); ++j)
+                st->forget(ids[j]);
+            if (replies.empty())
+                throw;
+            break;
+        }
+    }
+    return detail::match_batch_responses(replies, ids);
+}
 
-            // Wait for data with timeout, checking process liveness periodically
-            bool have_data = false;
-            constexpr int total_timeout_ms = 30000;
-            constexpr int poll_ms = 200;
-            for (int elapsed = 0; elapsed < total_timeout_ms; elapsed += poll_ms)
-            {
-                if (st->process.stdout_pipe().has_data(poll_ms))
-                {
-                    have_data = true;
-                    break;
-                }
-                // Re-check process liveness during the wait
-                auto code = st->process.try_wait();
-                if (code.has_value())
-                {
-                    // Drain any remaining data from stdout before throwing
-                    if (st->process.stdout_pipe().has_data(0))
-                    {
-                        have_data = true;
-                        break;
-                    }
-                    std::lock_guard<std::mutex> lock(st->stderr_mutex);
-                    throw fastmcpp::TransportError(
-                        "StdioTransport process exited with code: " + std::to_string(*code) +
-                        (st->stderr_data.empty() ? std::string() : "; stderr: " + st->stderr_data));
-                }
-            }
-            if (!have_data)
-                throw fastmcpp::TransportError("StdioTransport: timed out waiting for response");
+void StdioTransport::set_server_request_handler(ServerRequestHandler handler)
+{
+    std::lock_guard<std::mutex> lock(*state_mutex_);
+    server_request_handler_ = std::move(handler);
+    if (state_)
+    {
+        std::lock_guard<std::mutex> handler_lock(state_->handler_mutex);
+        state_->server_request_handler = server_request_handler_;
+    }
+}
 
-            std::string line = st->process.stdout_pipe().read_line();
-            // Strip trailing \r\n
-            while (!line.empty() && (line.back() == '\n' || line.back() == '\r'))
-                line.pop_back();
+void StdioTransport::set_notification_callback(std::function<void(const fastmcpp::Json&)> callback)
+{
+    std::lock_guard<std::mutex> lock(*state_mutex_);
+    notification_callback_ = std::move(callback);
+    if (state_)
+    {
+        std::lock_guard<std::mutex> handler_lock(state_->handler_mutex);
+        state_->notification_callback = notification_callback_;
+    }
+}
 
-            if (line.empty())
-                continue;
+std::function<void(const fastmcpp::Json&)> StdioTransport::notification_callback() const
+{
+    std::lock_guard<std::mutex> lock(*state_mutex_);
+    return notification_callback_;
+}
 
-            try
-            {
-                auto parsed = fastmcpp::util::json::parse(line);
-                if (parsed.contains("id") && parsed["id"].is_number_integer() &&
-                    parsed["id"].get<int64_t>() == id)
-                {
-                    return parsed;
-                }
-            }
-            catch (...)
-            {
-                // Ignore non-JSON stdout lines (e.g., server logs)
-            }
-        }
-    }
+fastmcpp::Json StdioTransport::request_one_shot(const std::string& route,
+                                                const fastmcpp::Json& payload)
+{
+    namespace proc = fastmcpp::process;
 
-    // --- One-shot mode: spawn per call ---
     proc::Process process;
     try
     {
@@ -741,49 +1294,9 @@ fastmcpp::Json StdioTransport::request(const std::string& route, const fastmcpp:
 StdioTransport::StdioTransport(StdioTransport&&) noexcept = default;
 StdioTransport& StdioTransport::operator=(StdioTransport&&) noexcept = default;
 
-StdioTransport::~StdioTransport()
-{
-    if (state_)
-    {
-        // Stop stderr reader thread
-        state_->stderr_running.store(false, std::memory_order_release);
-
-        // Close stdin to signal the server to exit
-        try
-        {
-            state_->process.stdin_pipe().close();
-        }
-        catch (...)
-        {
-        }
-
-        // Poll for graceful exit
-        for (int i = 0; i < 10; i++)
-        {
-            auto code = state_->process.try_wait();
-            if (code.has_value())
-            {
-                if (state_->stderr_thread.joinable())
-                    state_->stderr_thread.join();
-                return;
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        }
-
-        // Force kill if still running
-        try
-        {
-            state_->process.kill();
-            state_->process.wait();
-        }
-        catch (...)
-        {
-        }
-
-        if (state_->stderr_thread.joinable())
-            state_->stderr_thread.join();
-    }
-}
+// Tearing down the subprocess is State's job, so requests still running on
+// another thread keep it alive until they return.
+StdioTransport::~StdioTransport() = default;
 
 // =============================================================================
 // SseClientTransport implementation
@@ -1080,20 +1593,15 @@ void SseClientTransport::process_sse_event(const fastmcpp::Json& event)
 
     try
     {
-        auto url = parse_url(base_url_);
-        httplib::Client cli(url.host.c_str(), url.port);
-#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
-        cli.enable_server_certificate_verification(verify_ssl_);
-#endif
-        cli.set_connection_timeout(5, 0);
-        cli.set_read_timeout(30, 0);
+        auto cli = acquire_sse_post_client(*pool_, base_url_, verify_ssl_);
 
         std::string post_path;
         {
             std::lock_guard<std::mutex> lock(endpoint_mutex_);
             post_path = endpoint_path_.empty() ? messages_path_ : endpoint_path_;
         }
-        (void)cli.Post(post_path.c_str(), rpc_response.dump(), "application/json");
+        if (!cli->Post(post_path.c_str(), rpc_response.dump(), "application/json"))
+            cli.discard();
     }
     catch (...)
     {
@@ -1123,13 +1631,7 @@ fastmcpp::Json SseClientTransport::request(const std::string& route, const fastm
     }
 
     // Send request via POST to /messages with session_id
-    auto url = parse_url(base_url_);
-    httplib::Client cli(url.host.c_str(), url.port);
-#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
-    cli.enable_server_certificate_verification(verify_ssl_);
-#endif
-    cli.set_connection_timeout(5, 0);
-    cli.set_read_timeout(30, 0);
+    auto cli = acquire_sse_post_client(*pool_, base_url_, verify_ssl_);
 
     // Use the endpoint path from SSE if available, otherwise use default
     std::string post_path;
@@ -1137,9 +1639,10 @@ fastmcpp::Json SseClientTransport::request(const std::string& route, const fastm
         std::lock_guard<std::mutex> lock(endpoint_mutex_);
         post_path = endpoint_path_.empty() ? messages_path_ : endpoint_path_;
     }
-    auto res = cli.Post(post_path.c_str(), rpc_request.dump(), "application/json");
+    auto res = cli->Post(post_path.c_str(), rpc_request.dump(), "application/json");
     if (!res)
     {
+        cli.discard();
         std::lock_guard<std::mutex> lock(pending_mutex_);
         pending_requests_.erase(id);
         throw fastmcpp::TransportError("Failed to send request to " + messages_path_);
@@ -1208,9 +1711,16 @@ bool StreamableHttpTransport::has_session() const
 void StreamableHttpTransport::set_notification_callback(
     std::function<void(const fastmcpp::Json&)> callback)
 {
+    std::lock_guard<std::mutex> lock(notification_mutex_);
     notification_callback_ = std::move(callback);
 }
 
+std::function<void(const fastmcpp::Json&)> StreamableHttpTransport::notification_callback() const
+{
+    std::lock_guard<std::mutex> lock(notification_mutex_);
+    return notification_callback_;
+}
+
 void StreamableHttpTransport::reset(bool /*full*/)
 {
     std::lock_guard<std::mutex> lock(session_mutex_);
@@ -1253,7 +1763,7 @@ void StreamableHttpTransport::process_sse_line(const std::string& line,
 }
 
 fastmcpp::Json StreamableHttpTransport::parse_response(const std::string& body,
-                                                       const std::string& content_type)
+                                                       const std::string& content_type, bool batch)
 {
     // Check if response is SSE stream
     bool is_sse = content_type.find("text/event-stream") != std::string::npos;
@@ -1274,15 +1784,35 @@ fastmcpp::Json StreamableHttpTransport::parse_response(const std::string& body,
             process_sse_line(line, messages);
         }
 
-        // Process messages - notifications go to callback, find the main response
+        // Process messages - notifications go to callback, find the main response.
+        // A batch collects every response, whether sent as one array or one by one.
+        auto on_notification = notification_callback();
         fastmcpp::Json response;
+        fastmcpp::Json batch_responses = fastmcpp::Json::array();
         for (const auto& msg : messages)
         {
+            if (batch)
+            {
+                for (const auto& entry : msg.is_array() ? msg : fastmcpp::Json::array({msg}))
+                {
+                    if (entry.contains("method") && !entry.contains("id"))
+                    {
+                        if (on_notification)
+                            on_notification(entry);
+                    }
+                    else if (entry.contains("id"))
+                    {
+                        batch_responses.push_back(entry);
+                    }
+                }
+                continue;
+            }
+
             // Check if this is a notification (has method, no id)
             if (msg.contains("method") && !msg.contains("id"))
             {
-                if (notification_callback_)
-                    notification_callback_(msg);
+                if (on_notification)
+                    on_notification(msg);
             }
             else if (msg.contains("id"))
             {
@@ -1291,7 +1821,7 @@ fastmcpp::Json StreamableHttpTransport::parse_response(const std::string& body,
             }
         }
 
-        return response;
+        return batch ? batch_responses : response;
     }
     else
     {
@@ -1302,6 +1832,48 @@ fastmcpp::Json StreamableHttpTransport::parse_response(const std::string& body,
 
 fastmcpp::Json StreamableHttpTransport::request(const std::string& route,
                                                 const fastmcpp::Json& payload)
+{
+    // Build JSON-RPC request (route is method, payload is params)
+    int64_t id = next_id_.fetch_add(1, std::memory_order_relaxed);
+    fastmcpp::Json rpc_request = {
+        {"jsonrpc", "2.0"}, {"method", route}, {"params", payload}, {"id", id}};
+
+    auto rpc_response = post_message(rpc_request, false);
+
+    // Check for JSON-RPC error
+    if (rpc_response.contains("error"))
+    {
+        auto error = rpc_response["error"];
+        std::string message = error.value("message", "Unknown error");
+        throw fastmcpp::TransportError("JSON-RPC error: " + message);
+    }
+
+    // Extract result from JSON-RPC envelope
+    if (rpc_response.contains("result"))
+        return rpc_response["result"];
+
+    // If no result or error, return empty object
+    return fastmcpp::Json::object();
+}
+
+std::vector<fastmcpp::Json>
+StreamableHttpTransport::request_batch(const std::vector<BatchCall>& calls)
+{
+    fastmcpp::Json batch = fastmcpp::Json::array();
+    std::vector<int64_t> ids;
+    ids.reserve(calls.size());
+    for (const auto& call : calls)
+    {
+        ids.push_back(next_id_.fetch_add(1, std::memory_order_relaxed));
+        batch.push_back({{"jsonrpc", "2.0"},
+                         {"method", call.method},
+                         {"params", call.params},
+                         {"id", ids.back()}});
+    }
+    return detail::match_batch_responses(post_message(batch, true), ids);
+}
+
+fastmcpp::Json StreamableHttpTransport::post_message(const fastmcpp::Json& message, bool batch)
 {
     auto url = parse_url(base_url_);
 
@@ -1323,11 +1895,6 @@ fastmcpp::Json StreamableHttpTransport::request(const std::string& route,
             request_headers.emplace("Mcp-Session-Id", session_id_);
     }
 
-    // Build JSON-RPC request (route is method, payload is params)
-    int64_t id = next_id_.fetch_add(1, std::memory_order_relaxed);
-    fastmcpp::Json rpc_request = {
-        {"jsonrpc", "2.0"}, {"method", route}, {"params", payload}, {"id", id}};
-
     std::string path = mcp_path_.empty() ? "/mcp" : mcp_path_;
     if (!path.empty() && path[0] != '/')
         path.insert(path.begin(), '/');
@@ -1336,22 +1903,33 @@ fastmcpp::Json StreamableHttpTransport::request(const std::string& route,
     httplib::Result res;
     for (int redirects = 0; redirects <= 5; ++redirects)
     {
-        httplib::Client cli(full_url.c_str());
+        auto cli = pool_->acquire(full_url,
+                                  [&]()
+                                  {
+                                      auto client =
+                                          std::make_unique<httplib::Client>(full_url.c_str());
 #ifdef CPPHTTPLIB_OPENSSL_SUPPORT
-        cli.enable_server_certificate_verification(verify_ssl_);
+                                      client->enable_server_certificate_verification(verify_ssl_);
 #endif
-        cli.set_connection_timeout(30, 0);
-        cli.set_read_timeout(300, 0); // Align with MCP HTTP defaults (30s connect, 5min read)
-        cli.set_keep_alive(true);
-        // Manual redirect loop below (set_follow_location(false)) is a deliberate
-        // policy: fastmcpp uses libcurl/cpp-httplib and explicitly handles 3xx
-        // so it can manage Authorization-stripping on cross-origin redirects.
-        // Python fastmcp commit 226bfb49 made the same policy choice on httpx.
-        cli.set_follow_location(false);
-
-        res = cli.Post(path.c_str(), request_headers, rpc_request.dump(), "application/json");
+                                      client->set_connection_timeout(30, 0);
+                                      // Align with MCP HTTP defaults (30s connect, 5min read)
+                                      client->set_read_timeout(300, 0);
+                                      // Manual redirect loop below (set_follow_location(false)) is
+                                      // a deliberate policy: fastmcpp uses libcurl/cpp-httplib and
+                                      // explicitly handles 3xx so it can manage
+                                      // Authorization-stripping on cross-origin redirects. Python
+                                      // fastmcp commit 226bfb49 made the same policy choice on
+                                      // httpx.
+                                      client->set_follow_location(false);
+                                      return client;
+                                  });
+
+        res = cli->Post(path.c_str(), request_headers, message.dump(), "application/json");
         if (!res)
+        {
+            cli.discard();
             throw fastmcpp::TransportError("StreamableHttp request failed: no response");
+        }
 
         if (is_redirect_status(res->status))
         {
@@ -1395,23 +1973,11 @@ fastmcpp::Json StreamableHttpTransport::request(const std::string& route,
     if (ct_header != res->headers.end())
         content_type = ct_header->second;
 
-    // Parse response
-    auto rpc_response = parse_response(res->body, content_type);
+    // A batch of notifications only is answered with 202 and no body
+    if (batch && res->body.empty())
+        return fastmcpp::Json::array();
 
-    // Check for JSON-RPC error
-    if (rpc_response.contains("error"))
-    {
-        auto error = rpc_response["error"];
-        std::string message = error.value("message", "Unknown error");
-        throw fastmcpp::TransportError("JSON-RPC error: " + message);
-    }
-
-    // Extract result from JSON-RPC envelope
-    if (rpc_response.contains("result"))
-        return rpc_response["result"];
-
-    // If no result or error, return empty object
-    return fastmcpp::Json::object();
+    return parse_response(res->body, content_type, batch);
 }
 
 } // namespace fastmcpp::client
@@ -1,9 +1,124 @@
 // Process dispatcher - includes platform-specific implementation
 // This file is added to CMakeLists.txt as a single source; it pulls in the
-// correct platform implementation via the preprocessor.
+// correct platform implementation via the preprocessor. Buffered line reading,
+// which is the same everywhere, lives below.
 
 #ifdef _WIN32
 #include "process_win32.cpp"
 #else
 #include "process_posix.cpp"
 #endif
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+// =============================================================================
+// ReadPipe buffering (shared by both platforms)
+// =============================================================================
+
+namespace fastmcpp::process
+{
+
+namespace
+{
+constexpr size_t kReadChunk = 64 * 1024;
+/// An idle buffer that grew past this for one huge line is given back
+constexpr size_t kMaxIdleBuffer = 1024 * 1024;
+} // namespace
+
+ReadPipe::ReadPipe(ReadPipe&& other) noexcept
+    : handle_(std::move(other.handle_)), buffer_(std::move(other.buffer_)),
+      begin_(std::exchange(other.begin_, 0)), end_(std::exchange(other.end_, 0))
+{
+}
+
+ReadPipe& ReadPipe::operator=(ReadPipe&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        handle_ = std::move(other.handle_);
+        buffer_ = std::move(other.buffer_);
+        begin_ = std::exchange(other.begin_, 0);
+        end_ = std::exchange(other.end_, 0);
+    }
+    return *this;
+}
+
+size_t ReadPipe::read(char* buffer, size_t size)
+{
+    if (begin_ == end_)
+        return read_from_os(buffer, size);
+
+    size_t n = std::min(size, end_ - begin_);
+    std::memcpy(buffer, buffer_.data() + begin_, n);
+    take(n);
+    return n;
+}
+
+std::string ReadPipe::read_line(size_t max_size)
+{
+    return std::string(read_line_view(max_size));
+}
+
+std::string_view ReadPipe::read_line_view(size_t max_size)
+{
+    size_t scanned = 0; // bytes after begin_ known to hold no newline
+    for (;;)
+    {
+        size_t available = end_ - begin_;
+        size_t limit = max_size ? std::min(available, max_size) : available;
+        if (limit > scanned)
+        {
+            const char* start = buffer_.data() + begin_;
+            if (const auto* newline =
+                    static_cast<const char*>(std::memchr(start + scanned, '\n', limit - scanned)))
+                return take(static_cast<size_t>(newline - start) + 1);
+            scanned = limit;
+        }
+        if (max_size && available >= max_size)
+            return take(max_size);
+        if (fill() == 0)
+            return take(available);
+    }
+}
+
+size_t ReadPipe::buffered() const
+{
+    return end_ - begin_;
+}
+
+bool ReadPipe::has_data(int timeout_ms)
+{
+    return begin_ < end_ || wait_for_data(timeout_ms);
+}
+
+size_t ReadPipe::fill()
+{
+    if (begin_ == end_ && buffer_.size() > kMaxIdleBuffer)
+        std::vector<char>().swap(buffer_);
+    if (begin_ > 0)
+    {
+        std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+    }
+    if (buffer_.size() - end_ < kReadChunk)
+        buffer_.resize(std::max(buffer_.size() * 2, end_ + kReadChunk));
+
+    size_t n = read_from_os(buffer_.data() + end_, buffer_.size() - end_);
+    end_ += n;
+    return n;
+}
+
+std::string_view ReadPipe::take(size_t size)
+{
+    std::string_view out(buffer_.data() + begin_, size);
+    begin_ += size;
+    if (begin_ == end_)
+        begin_ = end_ = 0;
+    return out;
+}
+
+} // namespace fastmcpp::process
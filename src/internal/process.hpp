@@ -8,6 +8,7 @@
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace fastmcpp::process
@@ -40,8 +41,18 @@ class ReadPipe
     /// @return Number of bytes read, 0 on EOF
     size_t read(char* buffer, size_t size);
 
-    /// Read a line (up to newline or max_size)
-    std::string read_line(size_t max_size = 4096);
+    /// Read a line, including its newline
+    /// @param max_size Longest piece returned at once (0 = no limit); longer lines
+    ///                 are handed out in max_size chunks
+    /// @return The line; at EOF whatever is left, then an empty string
+    std::string read_line(size_t max_size = 0);
+
+    /// Same as read_line, but returns a view into the pipe's buffer instead of a
+    /// copy. The view is valid until the next read from this pipe.
+    std::string_view read_line_view(size_t max_size = 0);
+
+    /// Bytes already pulled from the pipe but not yet consumed
+    size_t buffered() const;
 
     /// Check if data is available without blocking
     /// @param timeout_ms Timeout in milliseconds (0 = non-blocking check)
@@ -55,7 +66,22 @@ class ReadPipe
 
   private:
     friend class Process;
+
+    /// Platform read/poll on the underlying pipe, bypassing the buffer
+    size_t read_from_os(char* buffer, size_t size);
+    bool wait_for_data(int timeout_ms);
+
+    /// Pull the next chunk from the pipe into the buffer; returns bytes added
+    size_t fill();
+    std::string_view take(size_t size);
+
     std::unique_ptr<PipeHandle> handle_;
+
+    // Lines are scanned in place in [begin_, end_); consumed bytes are compacted
+    // away on the next fill, so each byte is read once and moved at most once.
+    std::vector<char> buffer_;
+    size_t begin_{0};
+    size_t end_{0};
 };
 
 /// Pipe for writing input to a subprocess
@@ -220,10 +220,7 @@ ReadPipe::~ReadPipe()
     close();
 }
 
-ReadPipe::ReadPipe(ReadPipe&&) noexcept = default;
-ReadPipe& ReadPipe::operator=(ReadPipe&&) noexcept = default;
-
-size_t ReadPipe::read(char* buffer, size_t size)
+size_t ReadPipe::read_from_os(char* buffer, size_t size)
 {
     if (!is_open())
         throw ProcessError("Pipe is not open");
@@ -243,26 +240,7 @@ size_t ReadPipe::read(char* buffer, size_t size)
     return bytes_read;
 }
 
-std::string ReadPipe::read_line(size_t max_size)
-{
-    std::string line;
-    line.reserve(256);
-
-    char ch;
-    while (line.size() < max_size)
-    {
-        size_t bytes_read = read(&ch, 1);
-        if (bytes_read == 0)
-            break;
-        line.push_back(ch);
-        if (ch == '\n')
-            break;
-    }
-
-    return line;
-}
-
-bool ReadPipe::has_data(int timeout_ms)
+bool ReadPipe::wait_for_data(int timeout_ms)
 {
     if (!is_open())
         return false;
@@ -5,9 +5,12 @@
 #include "fastmcpp/proxy.hpp"
 #include "fastmcpp/server/sse_server.hpp"
 #include "fastmcpp/telemetry.hpp"
+#include "fastmcpp/util/json_schema.hpp"
+#include "fastmcpp/util/jsonrpc.hpp"
 #include "fastmcpp/util/pagination.hpp"
 #include "fastmcpp/version.hpp"
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -20,6 +23,7 @@
 #include <optional>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <unordered_map>
 #include <utility>
@@ -83,7 +87,12 @@ static std::optional<fastmcpp::AppConfig> find_resource_app_config(const FastMCP
                                                                    const std::string& uri)
 {
     const std::string normalized = normalize_resource_uri(uri);
-    for (const auto& resource : app.list_all_resources())
+    // Untracked catalogs walk the two lists needed rather than build a snapshot
+    auto catalog = app.cached_catalog();
+    std::vector<fastmcpp::resources::Resource> walked_resources;
+    if (!catalog)
+        walked_resources = app.list_all_resources();
+    for (const auto& resource : catalog ? catalog->resources : walked_resources)
     {
         if (!resource.app || resource.app->empty())
             continue;
@@ -91,7 +100,10 @@ static std::optional<fastmcpp::AppConfig> find_resource_app_config(const FastMCP
             return resource.app;
     }
 
-    for (const auto& templ : app.list_all_templates())
+    std::vector<fastmcpp::resources::ResourceTemplate> walked_templates;
+    if (!catalog)
+        walked_templates = app.list_all_templates();
+    for (const auto& templ : catalog ? catalog->templates : walked_templates)
     {
         if (!templ.app || templ.app->empty())
             continue;
@@ -168,25 +180,6 @@ static fastmcpp::Json apply_pagination(const fastmcpp::Json& items, const std::s
     return result_obj;
 }
 
-static bool schema_is_object(const fastmcpp::Json& schema)
-{
-    if (!schema.is_object())
-        return false;
-
-    auto it = schema.find("type");
-    if (it != schema.end() && it->is_string() && it->get<std::string>() == "object")
-        return true;
-
-    if (schema.contains("properties"))
-        return true;
-
-    // Self-referencing types often use a top-level $ref into $defs.
-    if (schema.contains("$ref") && schema.contains("$defs"))
-        return true;
-
-    return false;
-}
-
 // Extract session_id from request meta (injected by transports like SSE).
 static std::string extract_session_id(const fastmcpp::Json& params)
 {
@@ -210,24 +203,6 @@ static bool schema_has_wrap_result(const fastmcpp::Json& schema)
            schema["x-fastmcp-wrap-result"].get<bool>();
 }
 
-static fastmcpp::Json normalize_output_schema_for_mcp(const fastmcpp::Json& schema)
-{
-    if (schema.is_null())
-        return schema;
-
-    // Python fastmcp requires object-shaped output schemas (MCP structuredContent is a dict).
-    // For scalar/array outputs, wrap into {"result": ...} and annotate for clients.
-    if (schema_is_object(schema))
-        return schema;
-
-    return fastmcpp::Json{
-        {"type", "object"},
-        {"properties", fastmcpp::Json{{"result", schema}}},
-        {"required", fastmcpp::Json::array({"result"})},
-        {"x-fastmcp-wrap-result", true},
-    };
-}
-
 static fastmcpp::Json make_tool_entry(
     const std::string& name, const std::string& description, const fastmcpp::Json& schema,
     const std::optional<std::string>& title = std::nullopt,
@@ -253,8 +228,9 @@ static fastmcpp::Json make_tool_entry(
         entry["inputSchema"] = schema;
     else
         entry["inputSchema"] = fastmcpp::Json::object();
+    // Callers pass the MCP form (Tool::mcp_output_schema()), so it is copied as is
     if (!output_schema.is_null() && !output_schema.empty())
-        entry["outputSchema"] = normalize_output_schema_for_mcp(output_schema);
+        entry["outputSchema"] = output_schema;
     if (task_support != fastmcpp::TaskSupport::Forbidden || sequential)
     {
         fastmcpp::Json execution = fastmcpp::Json::object();
@@ -286,6 +262,109 @@ static fastmcpp::Json make_tool_entry(
     return entry;
 }
 
+static fastmcpp::Json icons_to_json(const std::vector<fastmcpp::Icon>& icons)
+{
+    fastmcpp::Json icons_json = fastmcpp::Json::array();
+    for (const auto& icon : icons)
+    {
+        fastmcpp::Json icon_obj = {{"src", icon.src}};
+        if (icon.mime_type)
+            icon_obj["mimeType"] = *icon.mime_type;
+        if (icon.sizes)
+            icon_obj["sizes"] = *icon.sizes;
+        icons_json.push_back(icon_obj);
+    }
+    return icons_json;
+}
+
+static fastmcpp::Json tool_info_list_entry(const fastmcpp::client::ToolInfo& tool_info)
+{
+    fastmcpp::Json tool_json = {{"name", tool_info.name}, {"inputSchema", tool_info.inputSchema}};
+    if (tool_info.version)
+        tool_json["version"] = *tool_info.version;
+    if (tool_info.title)
+        tool_json["title"] = *tool_info.title;
+    if (tool_info.description)
+        tool_json["description"] = *tool_info.description;
+    if (tool_info.outputSchema && !tool_info.outputSchema->is_null())
+    {
+        auto wrapped = fastmcpp::util::schema::wrap_output_schema(*tool_info.outputSchema);
+        tool_json["outputSchema"] = wrapped ? std::move(*wrapped) : *tool_info.outputSchema;
+    }
+    if (tool_info.execution)
+        tool_json["execution"] = *tool_info.execution;
+    if (tool_info.icons && !tool_info.icons->empty())
+        tool_json["icons"] = icons_to_json(*tool_info.icons);
+    attach_meta_ui(tool_json, tool_info.app, tool_info._meta);
+    return tool_json;
+}
+
+static fastmcpp::Json resource_list_entry(const fastmcpp::resources::Resource& res)
+{
+    fastmcpp::Json res_json = {{"uri", res.uri}, {"name", res.name}};
+    if (res.version)
+        res_json["version"] = *res.version;
+    if (res.description)
+        res_json["description"] = *res.description;
+    if (res.mime_type)
+        res_json["mimeType"] = *res.mime_type;
+    if (res.title)
+        res_json["title"] = *res.title;
+    if (res.annotations)
+        res_json["annotations"] = *res.annotations;
+    if (res.icons)
+        res_json["icons"] = icons_to_json(*res.icons);
+    attach_meta_ui(res_json, res.app);
+    res_json["fastmcp"] = make_fastmcp_meta();
+    return res_json;
+}
+
+static fastmcpp::Json template_list_entry(const fastmcpp::resources::ResourceTemplate& templ)
+{
+    fastmcpp::Json templ_json = {{"uriTemplate", templ.uri_template}, {"name", templ.name}};
+    if (templ.description)
+        templ_json["description"] = *templ.description;
+    if (templ.mime_type)
+        templ_json["mimeType"] = *templ.mime_type;
+    if (templ.title)
+        templ_json["title"] = *templ.title;
+    if (templ.annotations)
+        templ_json["annotations"] = *templ.annotations;
+    if (templ.icons)
+        templ_json["icons"] = icons_to_json(*templ.icons);
+    attach_meta_ui(templ_json, templ.app);
+    templ_json["parameters"] =
+        templ.parameters.is_null() ? fastmcpp::Json::object() : templ.parameters;
+    return templ_json;
+}
+
+static fastmcpp::Json prompt_list_entry(const std::string& name,
+                                        const std::optional<fastmcpp::prompts::Prompt>& prompt)
+{
+    fastmcpp::Json prompt_json = {{"name", name}};
+    if (prompt)
+    {
+        if (prompt->version)
+            prompt_json["version"] = *prompt->version;
+        if (prompt->description)
+            prompt_json["description"] = *prompt->description;
+        if (!prompt->arguments.empty())
+        {
+            fastmcpp::Json args_array = fastmcpp::Json::array();
+            for (const auto& arg : prompt->arguments)
+            {
+                fastmcpp::Json arg_json = {{"name", arg.name}, {"required", arg.required}};
+                if (arg.description)
+                    arg_json["description"] = *arg.description;
+                args_array.push_back(arg_json);
+            }
+            prompt_json["arguments"] = args_array;
+        }
+    }
+    prompt_json["fastmcp"] = make_fastmcp_meta();
+    return prompt_json;
+}
+
 // ---------------------------------------------------------------------------
 // Simple in-process task registry (SEP-1686 subset)
 // ---------------------------------------------------------------------------
@@ -333,21 +412,20 @@ inline std::string to_iso8601_now()
 class TaskRegistry
 {
   public:
-    explicit TaskRegistry(SessionAccessor session_accessor = {})
-        : session_accessor_(std::move(session_accessor))
+    explicit TaskRegistry(SessionAccessor session_accessor = {},
+                          std::shared_ptr<tasks::TaskExecutor> executor = nullptr)
+        : session_accessor_(std::move(session_accessor)), executor_(std::move(executor))
     {
-        worker_ = std::thread([this]() { worker_loop(); });
+        if (!executor_)
+            executor_ = std::make_shared<tasks::TaskExecutor>();
     }
 
     ~TaskRegistry()
     {
-        {
-            std::lock_guard<std::mutex> lock(queue_mutex_);
-            stop_requested_ = true;
-        }
-        queue_cv_.notify_all();
-        if (worker_.joinable())
-            worker_.join();
+        // The executor may be shared with other handlers; wait for our own work,
+        // which captures `this`, before tearing down.
+        std::unique_lock<std::mutex> lock(inflight_mutex_);
+        inflight_cv_.wait(lock, [this] { return inflight_ == 0; });
     }
 
     struct CreateResult
@@ -387,21 +465,53 @@ class TaskRegistry
         return {std::move(task_id), std::move(created_at)};
     }
 
-    void enqueue_task(const std::string& task_id, std::function<fastmcpp::Json()> work)
+    /// Hand the task to the executor. Higher `priority` runs first; tasks of
+    /// equal priority are interleaved across owning sessions. A task the
+    /// executor cannot admit is failed immediately.
+    void enqueue_task(const std::string& task_id, int priority,
+                      std::function<fastmcpp::Json()> work)
     {
+        std::string owner;
         {
             std::lock_guard<std::mutex> lock(mutex_);
             auto it = tasks_.find(task_id);
             if (it == tasks_.end())
                 return;
             it->second.work = std::move(work);
+            owner = it->second.owner_session_id;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(inflight_mutex_);
+            ++inflight_;
         }
+        bool admitted = executor_->submit(owner, priority,
+                                          [this, task_id]()
+                                          {
+                                              execute_task(task_id);
+                                              finish_inflight();
+                                          });
+        if (admitted)
+            return;
 
+        finish_inflight();
+        std::optional<StatusNotification> notify;
         {
-            std::lock_guard<std::mutex> lock(queue_mutex_);
-            queue_.push_back(task_id);
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = tasks_.find(task_id);
+            if (it == tasks_.end())
+                return;
+            auto& entry = it->second;
+            entry.work = nullptr;
+            entry.info.status = "failed";
+            entry.info.status_message = "Task queue is full";
+            entry.error_message = "Task queue is full";
+            entry.info.last_updated_at = to_iso8601_now();
+            entry.last_updated_tp = std::chrono::steady_clock::now();
+            notify = build_status_notification(entry, /*include_non_terminal=*/false);
         }
-        queue_cv_.notify_one();
+        if (notify)
+            send_status_notification(*notify);
     }
 
     std::optional<TaskInfo> get_task(const std::string& task_id)
@@ -604,22 +714,12 @@ class TaskRegistry
         session->send_notification("notifications/tasks/status", notification.params);
     }
 
-    void worker_loop()
+    void finish_inflight()
     {
-        while (true)
-        {
-            std::string task_id;
-            {
-                std::unique_lock<std::mutex> lock(queue_mutex_);
-                queue_cv_.wait(lock, [&] { return stop_requested_ || !queue_.empty(); });
-                if (stop_requested_ && queue_.empty())
-                    break;
-                task_id = std::move(queue_.front());
-                queue_.pop_front();
-            }
-
-            execute_task(task_id);
-        }
+        // Notify under the lock: once it is released the destructor may proceed.
+        std::lock_guard<std::mutex> lock(inflight_mutex_);
+        --inflight_;
+        inflight_cv_.notify_all();
     }
 
     void execute_task(const std::string& task_id)
@@ -798,13 +898,11 @@ class TaskRegistry
     std::unordered_map<std::string, TaskEntry> tasks_;
     std::atomic<uint64_t> next_id_{0};
 
-    std::mutex queue_mutex_;
-    std::condition_variable queue_cv_;
-    std::deque<std::string> queue_;
-    bool stop_requested_{false};
-    std::thread worker_;
-
     SessionAccessor session_accessor_;
+    std::shared_ptr<tasks::TaskExecutor> executor_;
+    std::mutex inflight_mutex_;
+    std::condition_variable inflight_cv_;
+    size_t inflight_{0};
 };
 
 // Helper: convert a tool invocation JSON result into an MCP CallToolResult payload.
@@ -880,6 +978,21 @@ inline bool extract_task_ttl(const fastmcpp::Json& params, int& ttl_ms_out)
     return true;
 }
 
+// Optional background-task priority from params._meta.fastmcp.priority (higher runs first).
+inline int extract_task_priority(const fastmcpp::Json& params)
+{
+    auto meta = params.find("_meta");
+    if (meta == params.end() || !meta->is_object())
+        return 0;
+    auto fastmcp = meta->find("fastmcp");
+    if (fastmcp == meta->end() || !fastmcp->is_object())
+        return 0;
+    auto priority = fastmcp->find("priority");
+    if (priority == fastmcp->end() || !priority->is_number_integer())
+        return 0;
+    return priority->get<int>();
+}
+
 inline fastmcpp::Json tasks_capabilities()
 {
     return fastmcpp::Json{
@@ -894,32 +1007,106 @@ inline fastmcpp::Json tasks_capabilities()
     };
 }
 
-inline bool app_supports_tasks(const fastmcpp::FastMCP& app)
+/// Wire-format list arrays for one catalog snapshot. Each array is built on the
+/// first request that needs it and reused until FastMCP::catalog() hands out a
+/// new snapshot, i.e. until the catalog generation changes.
+class CatalogListCache
 {
-    for (const auto& [name, tool] : app.list_all_tools())
-        if (tool && tool->task_support() != fastmcpp::TaskSupport::Forbidden)
-            return true;
-    for (const auto& res : app.list_all_resources())
-        if (res.task_support != fastmcpp::TaskSupport::Forbidden)
-            return true;
-    for (const auto& [name, prompt] : app.list_all_prompts())
-        if (prompt && prompt->task_support != fastmcpp::TaskSupport::Forbidden)
-            return true;
-    return false;
-}
+  public:
+    enum class Kind
+    {
+        Tools,
+        Resources,
+        Templates,
+        Prompts,
+    };
 
-inline std::optional<fastmcpp::TaskSupport> find_tool_task_support(const fastmcpp::FastMCP& app,
-                                                                   const std::string& name)
-{
-    for (const auto& [tool_name, tool] : app.list_all_tools())
-        if (tool_name == name && tool)
-            return tool->task_support();
-    return std::nullopt;
-}
+    std::shared_ptr<const fastmcpp::Json> get(const fastmcpp::FastMCP& app, Kind kind)
+    {
+        auto snapshot = app.cached_catalog();
+        if (!snapshot)
+            return std::make_shared<const fastmcpp::Json>(build_uncached(app, kind));
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (snapshot != snapshot_)
+        {
+            snapshot_ = snapshot;
+            arrays_ = {};
+        }
+        auto& slot = arrays_[static_cast<size_t>(kind)];
+        if (!slot)
+            slot = std::make_shared<const fastmcpp::Json>(build(*snapshot, kind));
+        return slot;
+    }
+
+  private:
+    /// For untracked catalogs: walks only the requested kind, as nothing is reused
+    static fastmcpp::Json build_uncached(const fastmcpp::FastMCP& app, Kind kind)
+    {
+        fastmcpp::Json array = fastmcpp::Json::array();
+        switch (kind)
+        {
+        case Kind::Tools:
+            for (const auto& tool_info : app.list_all_tools_info())
+                array.push_back(tool_info_list_entry(tool_info));
+            break;
+        case Kind::Resources:
+            for (const auto& res : app.list_all_resources())
+                array.push_back(resource_list_entry(res));
+            break;
+        case Kind::Templates:
+            for (const auto& templ : app.list_all_templates())
+                array.push_back(template_list_entry(templ));
+            break;
+        case Kind::Prompts:
+            for (const auto& [name, prompt] : app.list_all_prompts())
+                array.push_back(prompt_list_entry(
+                    name,
+                    prompt ? std::optional<fastmcpp::prompts::Prompt>(*prompt) : std::nullopt));
+            break;
+        }
+        return array;
+    }
+
+    static fastmcpp::Json build(const fastmcpp::CatalogSnapshot& snapshot, Kind kind)
+    {
+        fastmcpp::Json array = fastmcpp::Json::array();
+        switch (kind)
+        {
+        case Kind::Tools:
+            for (const auto& tool_info : snapshot.tools)
+                array.push_back(tool_info_list_entry(tool_info));
+            break;
+        case Kind::Resources:
+            for (const auto& res : snapshot.resources)
+                array.push_back(resource_list_entry(res));
+            break;
+        case Kind::Templates:
+            for (const auto& templ : snapshot.templates)
+                array.push_back(template_list_entry(templ));
+            break;
+        case Kind::Prompts:
+            for (const auto& [name, prompt] : snapshot.prompts)
+                array.push_back(prompt_list_entry(name, prompt));
+            break;
+        }
+        return array;
+    }
+
+    std::mutex mutex_;
+    std::shared_ptr<const fastmcpp::CatalogSnapshot> snapshot_;
+    std::array<std::shared_ptr<const fastmcpp::Json>, 4> arrays_;
+};
 
 inline std::optional<fastmcpp::TaskSupport> find_prompt_task_support(const fastmcpp::FastMCP& app,
                                                                      const std::string& name)
 {
+    if (auto catalog = app.cached_catalog())
+    {
+        for (const auto& [prompt_name, prompt] : catalog->prompts)
+            if (prompt_name == name && prompt)
+                return prompt->task_support;
+        return std::nullopt;
+    }
     for (const auto& [prompt_name, prompt] : app.list_all_prompts())
         if (prompt_name == name && prompt)
             return prompt->task_support;
@@ -929,383 +1116,599 @@ inline std::optional<fastmcpp::TaskSupport> find_prompt_task_support(const fastm
 inline std::optional<fastmcpp::TaskSupport> find_resource_task_support(const fastmcpp::FastMCP& app,
                                                                        const std::string& uri)
 {
-    for (const auto& res : app.list_all_resources())
+    auto catalog = app.cached_catalog();
+    std::vector<fastmcpp::resources::Resource> walked;
+    if (!catalog)
+        walked = app.list_all_resources();
+    for (const auto& res : catalog ? catalog->resources : walked)
         if (res.uri == uri)
             return res.task_support;
     return std::nullopt;
 }
-} // namespace
 
-std::function<fastmcpp::Json(const fastmcpp::Json&)>
-make_mcp_handler(const std::string& server_name, const std::string& version,
-                 const tools::ToolManager& tools,
-                 const std::unordered_map<std::string, std::string>& descriptions,
-                 const std::unordered_map<std::string, fastmcpp::Json>& input_schemas_override,
-                 const std::optional<std::string>& instructions)
+// ---------------------------------------------------------------------------
+// JSON-RPC method dispatch shared by every make_mcp_handler variant
+// ---------------------------------------------------------------------------
+
+/// MCP methods that get a dedicated dispatch slot. Other methods go to the
+/// variant's fallback (e.g. custom server routes) or "method not found".
+enum class McpMethod : uint8_t
 {
-    return [server_name, version, &tools, descriptions, input_schemas_override,
-            instructions](const fastmcpp::Json& message) -> fastmcpp::Json
-    {
-        try
-        {
-            const auto id = message.contains("id") ? message.at("id") : fastmcpp::Json();
-            std::string method = message.value("method", "");
-            fastmcpp::Json params = message.value("params", fastmcpp::Json::object());
-            const std::string session_id = extract_session_id(params);
+    Initialize,
+    Ping,
+    ToolsList,
+    ToolsCall,
+    ResourcesList,
+    ResourcesTemplatesList,
+    ResourcesRead,
+    PromptsList,
+    PromptsGet,
+    TasksGet,
+    TasksResult,
+    TasksList,
+    TasksCancel,
+    Count,
+};
 
-            if (method == "initialize")
-            {
-                fastmcpp::Json result_obj = {
-                    {"protocolVersion", "2024-11-05"},
-                    {"capabilities", fastmcpp::Json{{"tools", fastmcpp::Json::object()}}},
-                    {"serverInfo", fastmcpp::Json{{"name", server_name}, {"version", version}}},
-                };
-                if (instructions.has_value())
-                    result_obj["instructions"] = *instructions;
-                return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", result_obj}};
-            }
+constexpr size_t kMcpMethodCount = static_cast<size_t>(McpMethod::Count);
 
-            if (method == "ping")
-            {
-                return fastmcpp::Json{
-                    {"jsonrpc", "2.0"}, {"id", id}, {"result", fastmcpp::Json::object()}};
-            }
+// Indexed by McpMethod
+constexpr std::array<std::string_view, kMcpMethodCount> kMcpMethodNames = {
+    "initialize",     "ping",           "tools/list",
+    "tools/call",     "resources/list", "resources/templates/list",
+    "resources/read", "prompts/list",   "prompts/get",
+    "tasks/get",      "tasks/result",   "tasks/list",
+    "tasks/cancel",
+};
 
-            if (method == "tools/list")
-            {
-                fastmcpp::Json tools_array = fastmcpp::Json::array();
-                for (auto& name : tools.list_names())
-                {
-                    // Get full tool object to access all fields
-                    const auto& tool = tools.get(name);
+// Perfect hash over kMcpMethodNames: length plus two characters select a unique
+// bucket (checked by the static_assert below), so a lookup is one hash and one
+// string compare. Names shorter than the shortest method never match.
+constexpr size_t kMcpMethodBuckets = 32;
+constexpr size_t kMcpMethodMinLength = 4;
 
-                    fastmcpp::Json schema = fastmcpp::Json::object();
-                    auto it = input_schemas_override.find(name);
-                    if (it != input_schemas_override.end())
-                    {
-                        schema = it->second;
-                    }
-                    else
-                    {
-                        try
-                        {
-                            schema = tool.input_schema();
-                        }
-                        catch (...)
-                        {
-                            schema = fastmcpp::Json::object();
-                        }
-                    }
+constexpr size_t mcp_method_bucket(std::string_view name)
+{
+    return (name.size() * 5 + static_cast<unsigned char>(name[1]) +
+            static_cast<unsigned char>(name[name.size() - 2])) &
+           (kMcpMethodBuckets - 1);
+}
 
-                    // Get description from override map or from tool
-                    std::string desc = "";
-                    auto dit = descriptions.find(name);
-                    if (dit != descriptions.end())
-                        desc = dit->second;
-                    else if (tool.description())
-                        desc = *tool.description();
-
-                    tools_array.push_back(make_tool_entry(
-                        name, desc, schema, tool.title(), tool.icons(), tool.output_schema(),
-                        tool.task_support(), tool.sequential(), tool.app(), tool.meta(),
-                        tool.version(), tool.annotations()));
-                }
+constexpr std::array<McpMethod, kMcpMethodBuckets> make_mcp_method_buckets()
+{
+    std::array<McpMethod, kMcpMethodBuckets> buckets{};
+    for (auto& bucket : buckets)
+        bucket = McpMethod::Count;
+    for (size_t i = 0; i < kMcpMethodCount; ++i)
+        buckets[mcp_method_bucket(kMcpMethodNames[i])] = static_cast<McpMethod>(i);
+    return buckets;
+}
 
-                return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                      {"id", id},
-                                      {"result", fastmcpp::Json{{"tools", tools_array}}}};
-            }
+constexpr auto kMcpMethodBucketTable = make_mcp_method_buckets();
 
-            if (method == "tools/call")
-            {
-                std::string name = params.value("name", "");
-                fastmcpp::Json args = params.value("arguments", fastmcpp::Json::object());
-                if (name.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing tool name");
-                auto span = telemetry::server_span(
-                    "tool " + name, "tools/call", server_name, "tool", name,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
-                {
-                    const auto& tool = tools.get(name);
-                    bool has_output_schema = !tool.output_schema().is_null();
-                    bool wrap_result = schema_has_wrap_result(tool.output_schema());
+constexpr bool mcp_method_hash_is_perfect()
+{
+    for (size_t i = 0; i < kMcpMethodCount; ++i)
+        if (kMcpMethodNames[i].size() < kMcpMethodMinLength ||
+            kMcpMethodBucketTable[mcp_method_bucket(kMcpMethodNames[i])] !=
+                static_cast<McpMethod>(i))
+            return false;
+    return true;
+}
+static_assert(mcp_method_hash_is_perfect(), "MCP method names collide in the dispatch table");
 
-                    auto result = tools.invoke(name, args);
-                    fastmcpp::Json result_payload =
-                        build_fastmcp_tool_result(result, has_output_schema, wrap_result);
-                    return fastmcpp::Json{
-                        {"jsonrpc", "2.0"}, {"id", id}, {"result", result_payload}};
-                }
-                catch (const std::exception& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_tool_error(id, e);
-                }
-            }
+std::optional<McpMethod> lookup_mcp_method(std::string_view name)
+{
+    if (name.size() < kMcpMethodMinLength)
+        return std::nullopt;
+    auto method = kMcpMethodBucketTable[mcp_method_bucket(name)];
+    if (method == McpMethod::Count || kMcpMethodNames[static_cast<size_t>(method)] != name)
+        return std::nullopt;
+    return method;
+}
 
-            if (method == "resources/list")
-            {
-                return fastmcpp::Json{
-                    {"jsonrpc", "2.0"},
-                    {"id", id},
-                    {"result", fastmcpp::Json{{"resources", fastmcpp::Json::array()}}}};
-            }
-            if (method == "resources/read")
-            {
-                return fastmcpp::Json{
-                    {"jsonrpc", "2.0"},
-                    {"id", id},
-                    {"result", fastmcpp::Json{{"contents", fastmcpp::Json::array()}}}};
-            }
-            if (method == "prompts/list")
-            {
-                return fastmcpp::Json{
-                    {"jsonrpc", "2.0"},
-                    {"id", id},
-                    {"result", fastmcpp::Json{{"prompts", fastmcpp::Json::array()}}}};
-            }
-            if (method == "prompts/get")
+/// One incoming request. Members refer into the message being dispatched.
+struct McpRequest
+{
+    const fastmcpp::Json& id;
+    const std::string& method;
+    const fastmcpp::Json& params;
+    const std::string& session_id;
+};
+
+using McpMethodHandler = std::function<fastmcpp::Json(const McpRequest&)>;
+
+/// JSON-RPC front end shared by the make_mcp_handler variants: unpacks the
+/// envelope once (by reference), answers ping, routes the method to its slot
+/// and turns escaping exceptions into internal errors. Variants only plug in
+/// their backend slots.
+class McpDispatcher
+{
+  public:
+    McpDispatcher()
+    {
+        on(
+            McpMethod::Ping,
+            [](const McpRequest& request)
             {
                 return fastmcpp::Json{
-                    {"jsonrpc", "2.0"},
-                    {"id", id},
-                    {"result", fastmcpp::Json{{"messages", fastmcpp::Json::array()}}}};
-            }
+                    {"jsonrpc", "2.0"}, {"id", request.id}, {"result", fastmcpp::Json::object()}};
+            });
+    }
 
-            // Fallback: allow custom routes (resources/prompts/etc.) registered on server-like
-            // adapters
-            try
-            {
-                auto routed = tools.invoke(method, params);
-                return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", routed}};
-            }
-            catch (...)
-            {
-                // fall through to not found
-            }
+    void on(McpMethod method, McpMethodHandler handler)
+    {
+        slots_[static_cast<size_t>(method)] = std::move(handler);
+    }
+
+    /// Handles methods without a slot; by default they get "method not found".
+    void otherwise(McpMethodHandler handler)
+    {
+        fallback_ = std::move(handler);
+    }
+
+    fastmcpp::Json operator()(const fastmcpp::Json& message) const
+    {
+        static const fastmcpp::Json kNoId;
+        static const fastmcpp::Json kNoParams = fastmcpp::Json::object();
+        static const std::string kNoMethod;
+
+        auto id_it = message.find("id");
+        const auto& id = id_it != message.end() ? *id_it : kNoId;
+        try
+        {
+            auto method_it = message.find("method");
+            const auto& method = method_it != message.end() && method_it->is_string()
+                                     ? method_it->get_ref<const std::string&>()
+                                     : kNoMethod;
+            auto params_it = message.find("params");
+            const auto& params = params_it != message.end() ? *params_it : kNoParams;
+            const std::string session_id = extract_session_id(params);
+            const McpRequest request{id, method, params, session_id};
 
-            return jsonrpc_error(message.value("id", fastmcpp::Json()), kJsonRpcMethodNotFound,
+            if (auto slot = lookup_mcp_method(method))
+                if (const auto& handler = slots_[static_cast<size_t>(*slot)])
+                    return handler(request);
+            if (fallback_)
+                return fallback_(request);
+            return jsonrpc_error(id, kJsonRpcMethodNotFound,
                                  std::string("Method '") + method + "' not found");
         }
         catch (const std::exception& e)
         {
-            return jsonrpc_error(message.value("id", fastmcpp::Json()), kJsonRpcInternalError,
-                                 e.what());
+            return jsonrpc_error(id, kJsonRpcInternalError, e.what());
         }
-    };
+    }
+
+  private:
+    std::array<McpMethodHandler, kMcpMethodCount> slots_;
+    McpMethodHandler fallback_;
+};
+
+/// telemetry::server_span for a request, carrying its _meta and session id.
+telemetry::SpanScope request_span(const McpRequest& request, const std::string& name,
+                                  const std::string& server_name, const std::string& component_type,
+                                  const std::string& component_key)
+{
+    return telemetry::server_span(
+        name, request.method, server_name, component_type, component_key,
+        extract_request_meta(request.params),
+        request.session_id.empty() ? std::nullopt : std::optional<std::string>(request.session_id));
 }
 
-std::function<fastmcpp::Json(const fastmcpp::Json&)> make_mcp_handler(
-    const std::string& server_name, const std::string& version, const server::Server& server,
-    const std::vector<std::tuple<std::string, std::string, fastmcpp::Json>>& tools_meta)
+/// Wraps a filled-in dispatcher as the handler type the factories return.
+std::function<fastmcpp::Json(const fastmcpp::Json&)> into_handler(McpDispatcher dispatcher)
 {
-    return
-        [server_name, version, &server, tools_meta](const fastmcpp::Json& message) -> fastmcpp::Json
+    auto shared = std::make_shared<const McpDispatcher>(std::move(dispatcher));
+    return [shared](const fastmcpp::Json& message)
     {
-        try
-        {
-            const auto id = message.contains("id") ? message.at("id") : fastmcpp::Json();
-            std::string method = message.value("method", "");
-            fastmcpp::Json params = message.value("params", fastmcpp::Json::object());
-            const std::string session_id = extract_session_id(params);
+        if (!message.is_array())
+            return (*shared)(message);
+
+        // JSON-RPC batch: answer every request in one array, leaving out notifications
+        return util::jsonrpc::dispatch_batch(message,
+                                             [&shared](const fastmcpp::Json& entry)
+                                             {
+                                                 auto reply = (*shared)(entry);
+                                                 return util::jsonrpc::is_notification(entry)
+                                                            ? fastmcpp::Json()
+                                                            : reply;
+                                             });
+    };
+}
 
-            if (method == "initialize")
-            {
-                // Build serverInfo from Server metadata (v2.13.0+)
-                fastmcpp::Json serverInfo = {{"name", server.name()},
-                                             {"version", server.version()}};
-
-                // Add optional fields if present
-                if (server.website_url())
-                    serverInfo["websiteUrl"] = *server.website_url();
-                if (server.icons())
-                {
-                    fastmcpp::Json icons_array = fastmcpp::Json::array();
-                    for (const auto& icon : *server.icons())
-                    {
-                        fastmcpp::Json icon_json;
-                        to_json(icon_json, icon);
-                        icons_array.push_back(icon_json);
-                    }
-                    serverInfo["icons"] = icons_array;
-                }
+// ---------------------------------------------------------------------------
+// Slot bodies shared between handler variants
+// ---------------------------------------------------------------------------
 
-                fastmcpp::Json result_obj = {
-                    {"protocolVersion", "2024-11-05"},
-                    {"capabilities", fastmcpp::Json{{"tools", fastmcpp::Json::object()}}},
-                    {"serverInfo", serverInfo}};
-                if (server.instructions().has_value())
-                    result_obj["instructions"] = *server.instructions();
-                return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", result_obj}};
-            }
+/// serverInfo block of an initialize result, from Server metadata (v2.13.0+).
+fastmcpp::Json server_info_json(const server::Server& server)
+{
+    fastmcpp::Json serverInfo = {{"name", server.name()}, {"version", server.version()}};
 
-            if (method == "ping")
-            {
-                return fastmcpp::Json{
-                    {"jsonrpc", "2.0"}, {"id", id}, {"result", fastmcpp::Json::object()}};
-            }
+    // Add optional fields if present
+    if (server.website_url())
+        serverInfo["websiteUrl"] = *server.website_url();
+    if (server.icons())
+    {
+        fastmcpp::Json icons_array = fastmcpp::Json::array();
+        for (const auto& icon : *server.icons())
+        {
+            fastmcpp::Json icon_json;
+            to_json(icon_json, icon);
+            icons_array.push_back(icon_json);
+        }
+        serverInfo["icons"] = icons_array;
+    }
+    return serverInfo;
+}
 
-            if (method == "tools/list")
-            {
-                // Build base tools list from tools_meta
-                fastmcpp::Json tools_array = fastmcpp::Json::array();
-                for (const auto& t : tools_meta)
-                {
-                    const auto& name = std::get<0>(t);
-                    const auto& desc = std::get<1>(t);
-                    const auto& schema = std::get<2>(t);
-                    tools_array.push_back(make_tool_entry(name, desc, schema));
-                }
+/// tools/list straight from a ToolManager.
+fastmcpp::Json tool_manager_list(const McpRequest& request, const tools::ToolManager& tools)
+{
+    fastmcpp::Json tools_array = fastmcpp::Json::array();
+    for (const auto& name : tools.list_names())
+    {
+        const auto& tool = tools.get(name);
+        std::string desc = tool.description() ? *tool.description() : "";
+        tools_array.push_back(make_tool_entry(name, desc, tool.input_schema(), tool.title(),
+                                              tool.icons(), tool.mcp_output_schema(),
+                                              tool.task_support(), tool.sequential(), tool.app(),
+                                              tool.meta(), tool.version(), tool.annotations()));
+    }
+    return fastmcpp::Json{
+        {"jsonrpc", "2.0"}, {"id", request.id}, {"result", fastmcpp::Json{{"tools", tools_array}}}};
+}
 
-                // Create result object that can be modified by hooks
-                fastmcpp::Json result = fastmcpp::Json{{"tools", tools_array}};
+/// tools/call straight through a ToolManager.
+fastmcpp::Json tool_manager_call(const McpRequest& request, const tools::ToolManager& tools,
+                                 const std::string& server_name)
+{
+    std::string name = request.params.value("name", "");
+    fastmcpp::Json args = request.params.value("arguments", fastmcpp::Json::object());
+    if (name.empty())
+        return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Missing tool name");
+    auto span = request_span(request, "tool " + name, server_name, "tool", name);
+    try
+    {
+        const auto& tool = tools.get(name);
+        bool has_output_schema = !tool.output_schema().is_null();
+        bool wrap_result = schema_has_wrap_result(tool.output_schema());
+
+        auto result = tools.invoke(name, args);
+        fastmcpp::Json result_payload =
+            build_fastmcp_tool_result(result, has_output_schema, wrap_result);
+        return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", request.id}, {"result", result_payload}};
+    }
+    catch (const std::exception& e)
+    {
+        if (span.active())
+            span.span().record_exception(e.what());
+        return jsonrpc_tool_error(request.id, e);
+    }
+}
 
-                // Try to route through server to trigger BeforeHooks and AfterHooks
-                try
-                {
-                    auto hooked_result = server.handle("tools/list", params);
-                    // If a route exists and returned a result, use it
-                    if (hooked_result.contains("tools"))
-                        result = hooked_result;
-                }
-                catch (...)
-                {
-                    // No route exists - that's fine, we'll use our base result
-                    // But we still want AfterHooks to run, so we need to manually trigger them
-                    // Since Server::handle() threw, hooks weren't applied.
-                    // For now, just return base result - hooks won't augment it.
-                }
+/// resources/list or prompts/list routed through the Server; an empty `key`
+/// array when no route is registered.
+fastmcpp::Json server_routed_list(const McpRequest& request, const server::Server& server,
+                                  const char* key)
+{
+    try
+    {
+        auto routed = server.handle(request.method, request.params);
+        return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", request.id}, {"result", routed}};
+    }
+    catch (...)
+    {
+        return fastmcpp::Json{{"jsonrpc", "2.0"},
+                              {"id", request.id},
+                              {"result", fastmcpp::Json{{key, fastmcpp::Json::array()}}}};
+    }
+}
 
-                return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", result}};
-            }
+/// resources/read routed through the Server.
+fastmcpp::Json server_routed_resource_read(const McpRequest& request, const server::Server& server)
+{
+    std::string uri = request.params.value("uri", "");
+    auto span = request_span(request, "resource " + uri, server.name(), "resource", uri);
+    try
+    {
+        auto routed = server.handle(request.method, request.params);
+        return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", request.id}, {"result", routed}};
+    }
+    catch (...)
+    {
+        if (span.active())
+            span.span().record_exception("resource read failed");
+        return fastmcpp::Json{{"jsonrpc", "2.0"},
+                              {"id", request.id},
+                              {"result", fastmcpp::Json{{"contents", fastmcpp::Json::array()}}}};
+    }
+}
 
-            if (method == "tools/call")
-            {
-                std::string name = params.value("name", "");
-                fastmcpp::Json args = params.value("arguments", fastmcpp::Json::object());
-                if (name.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing tool name");
-                auto span = telemetry::server_span(
-                    "tool " + name, "tools/call", server.name(), "tool", name,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
+/// prompts/get routed through the Server.
+fastmcpp::Json server_routed_prompt_get(const McpRequest& request, const server::Server& server)
+{
+    std::string prompt_name = request.params.value("name", "");
+    auto span =
+        request_span(request, "prompt " + prompt_name, server.name(), "prompt", prompt_name);
+    try
+    {
+        auto routed = server.handle(request.method, request.params);
+        return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", request.id}, {"result", routed}};
+    }
+    catch (...)
+    {
+        if (span.active())
+            span.span().record_exception("prompt get failed");
+        return fastmcpp::Json{{"jsonrpc", "2.0"},
+                              {"id", request.id},
+                              {"result", fastmcpp::Json{{"messages", fastmcpp::Json::array()}}}};
+    }
+}
+
+/// One page of a FastMCP catalog list, served from the handler's list cache.
+fastmcpp::Json catalog_list_page(const McpRequest& request, const FastMCP& app,
+                                 CatalogListCache& lists, CatalogListCache::Kind kind,
+                                 const char* key)
+{
+    auto array = lists.get(app, kind);
+    return fastmcpp::Json{
+        {"jsonrpc", "2.0"},
+        {"id", request.id},
+        {"result", apply_pagination(*array, key, request.params, app.list_page_size())}};
+}
+} // namespace
+
+std::function<fastmcpp::Json(const fastmcpp::Json&)>
+make_mcp_handler(const std::string& server_name, const std::string& version,
+                 const tools::ToolManager& tools,
+                 const std::unordered_map<std::string, std::string>& descriptions,
+                 const std::unordered_map<std::string, fastmcpp::Json>& input_schemas_override,
+                 const std::optional<std::string>& instructions)
+{
+    McpDispatcher dispatcher;
+
+    dispatcher.on(
+        McpMethod::Initialize,
+        [server_name, version, instructions](const McpRequest& request) -> fastmcpp::Json
+        {
+            fastmcpp::Json result_obj = {
+                {"protocolVersion", "2024-11-05"},
+                {"capabilities", fastmcpp::Json{{"tools", fastmcpp::Json::object()}}},
+                {"serverInfo", fastmcpp::Json{{"name", server_name}, {"version", version}}},
+            };
+            if (instructions.has_value())
+                result_obj["instructions"] = *instructions;
+            return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", request.id}, {"result", result_obj}};
+        });
+
+    dispatcher.on(
+        McpMethod::ToolsList,
+        [&tools, descriptions, input_schemas_override](const McpRequest& request) -> fastmcpp::Json
+        {
+            fastmcpp::Json tools_array = fastmcpp::Json::array();
+            for (auto& name : tools.list_names())
+            {
+                // Get full tool object to access all fields
+                const auto& tool = tools.get(name);
+
+                fastmcpp::Json schema = fastmcpp::Json::object();
+                auto it = input_schemas_override.find(name);
+                if (it != input_schemas_override.end())
                 {
-                    auto result = server.handle(name, args);
-                    fastmcpp::Json result_payload = build_fastmcp_tool_result(result);
-                    return fastmcpp::Json{
-                        {"jsonrpc", "2.0"}, {"id", id}, {"result", result_payload}};
+                    schema = it->second;
                 }
-                catch (const std::exception& e)
+                else
                 {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_tool_error(id, e);
+                    try
+                    {
+                        schema = tool.input_schema();
+                    }
+                    catch (...)
+                    {
+                        schema = fastmcpp::Json::object();
+                    }
                 }
+
+                // Get description from override map or from tool
+                std::string desc = "";
+                auto dit = descriptions.find(name);
+                if (dit != descriptions.end())
+                    desc = dit->second;
+                else if (tool.description())
+                    desc = *tool.description();
+
+                tools_array.push_back(
+                    make_tool_entry(name, desc, schema, tool.title(), tool.icons(),
+                                    tool.mcp_output_schema(), tool.task_support(),
+                                    tool.sequential(), tool.app(), tool.meta(), tool.version(),
+                                    tool.annotations()));
             }
 
-            if (method == "resources/list")
+            return fastmcpp::Json{{"jsonrpc", "2.0"},
+                                  {"id", request.id},
+                                  {"result", fastmcpp::Json{{"tools", tools_array}}}};
+        });
+
+    dispatcher.on(
+        McpMethod::ToolsCall, [server_name, &tools](const McpRequest& request)
+        { return tool_manager_call(request, tools, server_name); });
+
+    dispatcher.on(
+        McpMethod::ResourcesList,
+        [](const McpRequest& request) -> fastmcpp::Json
+        {
+            return fastmcpp::Json{
+                {"jsonrpc", "2.0"},
+                {"id", request.id},
+                {"result", fastmcpp::Json{{"resources", fastmcpp::Json::array()}}}};
+        });
+
+    dispatcher.on(
+        McpMethod::ResourcesRead,
+        [](const McpRequest& request) -> fastmcpp::Json
+        {
+            return fastmcpp::Json{
+                {"jsonrpc", "2.0"},
+                {"id", request.id},
+                {"result", fastmcpp::Json{{"contents", fastmcpp::Json::array()}}}};
+        });
+
+    dispatcher.on(
+        McpMethod::PromptsList,
+        [](const McpRequest& request) -> fastmcpp::Json
+        {
+            return fastmcpp::Json{{"jsonrpc", "2.0"},
+                                  {"id", request.id},
+                                  {"result", fastmcpp::Json{{"prompts", fastmcpp::Json::array()}}}};
+        });
+
+    dispatcher.on(McpMethod::PromptsGet,
+                  [](const McpRequest& request) -> fastmcpp::Json
+                  {
+                      return fastmcpp::Json{
+                          {"jsonrpc", "2.0"},
+                          {"id", request.id},
+                          {"result", fastmcpp::Json{{"messages", fastmcpp::Json::array()}}}};
+                  });
+
+    // Fallback: allow custom routes (resources/prompts/etc.) registered on server-like adapters
+    dispatcher.otherwise(
+        [&tools](const McpRequest& request) -> fastmcpp::Json
+        {
+            try
             {
-                try
-                {
-                    auto routed = server.handle(method, params);
-                    return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", routed}};
-                }
-                catch (...)
-                {
-                    return fastmcpp::Json{
-                        {"jsonrpc", "2.0"},
-                        {"id", id},
-                        {"result", fastmcpp::Json{{"resources", fastmcpp::Json::array()}}}};
-                }
+                auto routed = tools.invoke(request.method, request.params);
+                return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", request.id}, {"result", routed}};
             }
-            if (method == "resources/read")
+            catch (...)
             {
-                std::string uri = params.value("uri", "");
-                auto span = telemetry::server_span(
-                    "resource " + uri, "resources/read", server.name(), "resource", uri,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
-                {
-                    auto routed = server.handle(method, params);
-                    return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", routed}};
-                }
-                catch (...)
-                {
-                    if (span.active())
-                        span.span().record_exception("resource read failed");
-                    return fastmcpp::Json{
-                        {"jsonrpc", "2.0"},
-                        {"id", id},
-                        {"result", fastmcpp::Json{{"contents", fastmcpp::Json::array()}}}};
-                }
+                return jsonrpc_error(request.id, kJsonRpcMethodNotFound,
+                                     std::string("Method '") + request.method + "' not found");
             }
-            if (method == "prompts/list")
+        });
+
+    return into_handler(std::move(dispatcher));
+}
+
+std::function<fastmcpp::Json(const fastmcpp::Json&)> make_mcp_handler(
+    const std::string& /*server_name*/, const std::string& /*version*/,
+    const server::Server& server,
+    const std::vector<std::tuple<std::string, std::string, fastmcpp::Json>>& tools_meta)
+{
+    McpDispatcher dispatcher;
+
+    dispatcher.on(
+        McpMethod::Initialize,
+        [&server](const McpRequest& request) -> fastmcpp::Json
+        {
+            fastmcpp::Json serverInfo = server_info_json(server);
+
+            fastmcpp::Json result_obj = {
+                {"protocolVersion", "2024-11-05"},
+                {"capabilities", fastmcpp::Json{{"tools", fastmcpp::Json::object()}}},
+                {"serverInfo", serverInfo}};
+            if (server.instructions().has_value())
+                result_obj["instructions"] = *server.instructions();
+            return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", request.id}, {"result", result_obj}};
+        });
+
+    dispatcher.on(
+        McpMethod::ToolsList,
+        [&server, tools_meta](const McpRequest& request) -> fastmcpp::Json
+        {
+            // Build base tools list from tools_meta
+            fastmcpp::Json tools_array = fastmcpp::Json::array();
+            for (const auto& t : tools_meta)
             {
-                try
-                {
-                    auto routed = server.handle(method, params);
-                    return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", routed}};
-                }
-                catch (...)
-                {
-                    return fastmcpp::Json{
-                        {"jsonrpc", "2.0"},
-                        {"id", id},
-                        {"result", fastmcpp::Json{{"prompts", fastmcpp::Json::array()}}}};
-                }
+                const auto& name = std::get<0>(t);
+                const auto& desc = std::get<1>(t);
+                const auto& schema = std::get<2>(t);
+                tools_array.push_back(make_tool_entry(name, desc, schema));
             }
-            if (method == "prompts/get")
+
+            // Create result object that can be modified by hooks
+            fastmcpp::Json result = fastmcpp::Json{{"tools", tools_array}};
+
+            // Try to route through server to trigger BeforeHooks and AfterHooks
+            try
             {
-                std::string prompt_name = params.value("name", "");
-                auto span = telemetry::server_span(
-                    "prompt " + prompt_name, "prompts/get", server.name(), "prompt", prompt_name,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
-                {
-                    auto routed = server.handle(method, params);
-                    return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", routed}};
-                }
-                catch (...)
-                {
-                    if (span.active())
-                        span.span().record_exception("prompt get failed");
-                    return fastmcpp::Json{
-                        {"jsonrpc", "2.0"},
-                        {"id", id},
-                        {"result", fastmcpp::Json{{"messages", fastmcpp::Json::array()}}}};
-                }
+                auto hooked_result = server.handle("tools/list", request.params);
+                // If a route exists and returned a result, use it
+                if (hooked_result.contains("tools"))
+                    result = hooked_result;
             }
+            catch (...)
+            {
+                // No route exists - that's fine, we'll use our base result
+                // But we still want AfterHooks to run, so we need to manually trigger them
+                // Since Server::handle() threw, hooks weren't applied.
+                // For now, just return base result - hooks won't augment it.
+            }
+
+            return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", request.id}, {"result", result}};
+        });
 
-            // Route any other method to the server (resources/prompts/etc.)
+    dispatcher.on(
+        McpMethod::ToolsCall,
+        [&server](const McpRequest& request) -> fastmcpp::Json
+        {
+            std::string name = request.params.value("name", "");
+            fastmcpp::Json args = request.params.value("arguments", fastmcpp::Json::object());
+            if (name.empty())
+                return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Missing tool name");
+            auto span = request_span(request, "tool " + name, server.name(), "tool", name);
             try
             {
-                auto routed = server.handle(method, params);
-                return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", routed}};
+                auto result = server.handle(name, args);
+                fastmcpp::Json result_payload = build_fastmcp_tool_result(result);
+                return fastmcpp::Json{
+                    {"jsonrpc", "2.0"}, {"id", request.id}, {"result", result_payload}};
             }
             catch (const std::exception& e)
             {
-                return jsonrpc_error(id, kJsonRpcInternalError, e.what());
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_tool_error(request.id, e);
             }
+        });
 
-            return jsonrpc_error(message.value("id", fastmcpp::Json()), kJsonRpcMethodNotFound,
-                                 std::string("Method '") + method + "' not found");
-        }
-        catch (const std::exception& e)
+    dispatcher.on(
+        McpMethod::ResourcesList, [&server](const McpRequest& request)
+        { return server_routed_list(request, server, "resources"); });
+
+    dispatcher.on(
+        McpMethod::ResourcesRead, [&server](const McpRequest& request)
+        { return server_routed_resource_read(request, server); });
+
+    dispatcher.on(
+        McpMethod::PromptsList, [&server](const McpRequest& request)
+        { return server_routed_list(request, server, "prompts"); });
+
+    dispatcher.on(McpMethod::PromptsGet, [&server](const McpRequest& request)
+                  { return server_routed_prompt_get(request, server); });
+
+    // Route any other method to the server (resources/prompts/etc.)
+    dispatcher.otherwise(
+        [&server](const McpRequest& request) -> fastmcpp::Json
         {
-            return jsonrpc_error(message.value("id", fastmcpp::Json()), kJsonRpcInternalError,
-                                 e.what());
-        }
-    };
+            try
+            {
+                auto routed = server.handle(request.method, request.params);
+                return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", request.id}, {"result", routed}};
+            }
+            catch (const std::exception& e)
+            {
+                return jsonrpc_error(request.id, kJsonRpcInternalError, e.what());
+            }
+        });
+
+    return into_handler(std::move(dispatcher));
 }
 
 std::function<fastmcpp::Json(const fastmcpp::Json&)>
-make_mcp_handler(const std::string& server_name, const std::string& version,
+make_mcp_handler(const std::string& /*server_name*/, const std::string& /*version*/,
                  const server::Server& server, const tools::ToolManager& tools,
                  const std::unordered_map<std::string, std::string>& descriptions)
 {
@@ -1331,501 +1734,274 @@ make_mcp_handler(const std::string& server_name, const std::string& version,
 
     // Create handler that captures both server AND tools
     // This allows tools/call to use tools.invoke() directly
-    return [server_name, version, &server, &tools,
-            tools_meta](const fastmcpp::Json& message) -> fastmcpp::Json
-    {
-        try
-        {
-            const auto id = message.contains("id") ? message.at("id") : fastmcpp::Json();
-            std::string method = message.value("method", "");
-            fastmcpp::Json params = message.value("params", fastmcpp::Json::object());
-            const std::string session_id = extract_session_id(params);
-
-            if (method == "initialize")
-            {
-                fastmcpp::Json serverInfo = {{"name", server.name()},
-                                             {"version", server.version()}};
-                if (server.website_url())
-                    serverInfo["websiteUrl"] = *server.website_url();
-                if (server.icons())
-                {
-                    fastmcpp::Json icons_array = fastmcpp::Json::array();
-                    for (const auto& icon : *server.icons())
-                    {
-                        fastmcpp::Json icon_json;
-                        to_json(icon_json, icon);
-                        icons_array.push_back(icon_json);
-                    }
-                    serverInfo["icons"] = icons_array;
-                }
-                fastmcpp::Json result_obj = {
-                    {"protocolVersion", "2024-11-05"},
-                    {"capabilities", fastmcpp::Json{{"tools", fastmcpp::Json::object()}}},
-                    {"serverInfo", serverInfo}};
-                if (server.instructions().has_value())
-                    result_obj["instructions"] = *server.instructions();
-                return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", result_obj}};
-            }
+    McpDispatcher dispatcher;
 
-            if (method == "ping")
-            {
-                return fastmcpp::Json{
-                    {"jsonrpc", "2.0"}, {"id", id}, {"result", fastmcpp::Json::object()}};
-            }
-
-            if (method == "tools/list")
-            {
-                fastmcpp::Json tools_array = fastmcpp::Json::array();
-                for (const auto& name : tools.list_names())
-                {
-                    const auto& tool = tools.get(name);
-                    std::string desc = tool.description() ? *tool.description() : "";
-                    tools_array.push_back(make_tool_entry(
-                        name, desc, tool.input_schema(), tool.title(), tool.icons(),
-                        tool.output_schema(), tool.task_support(), tool.sequential(), tool.app(),
-                        tool.meta(), tool.version(), tool.annotations()));
-                }
-                return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                      {"id", id},
-                                      {"result", fastmcpp::Json{{"tools", tools_array}}}};
-            }
-
-            if (method == "tools/call")
-            {
-                std::string name = params.value("name", "");
-                fastmcpp::Json args = params.value("arguments", fastmcpp::Json::object());
-                if (name.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing tool name");
-                auto span = telemetry::server_span(
-                    "tool " + name, "tools/call", server.name(), "tool", name,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
-                {
-                    const auto& tool = tools.get(name);
-                    bool has_output_schema = !tool.output_schema().is_null();
-                    bool wrap_result = schema_has_wrap_result(tool.output_schema());
-
-                    // Use tools.invoke() directly - this is why we capture tools
-                    auto result = tools.invoke(name, args);
-                    fastmcpp::Json result_payload =
-                        build_fastmcp_tool_result(result, has_output_schema, wrap_result);
-                    return fastmcpp::Json{
-                        {"jsonrpc", "2.0"}, {"id", id}, {"result", result_payload}};
-                }
-                catch (const std::exception& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_tool_error(id, e);
-                }
-            }
-
-            if (method == "resources/read")
-            {
-                std::string uri = params.value("uri", "");
-                auto span = telemetry::server_span(
-                    "resource " + uri, "resources/read", server.name(), "resource", uri,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
-                {
-                    auto routed = server.handle(method, params);
-                    return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", routed}};
-                }
-                catch (...)
-                {
-                    if (span.active())
-                        span.span().record_exception("resource read failed");
-                    return fastmcpp::Json{
-                        {"jsonrpc", "2.0"},
-                        {"id", id},
-                        {"result", fastmcpp::Json{{"contents", fastmcpp::Json::array()}}}};
-                }
-            }
-
-            if (method == "prompts/get")
-            {
-                std::string prompt_name = params.value("name", "");
-                auto span = telemetry::server_span(
-                    "prompt " + prompt_name, "prompts/get", server.name(), "prompt", prompt_name,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
-                {
-                    auto routed = server.handle(method, params);
-                    return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", routed}};
-                }
-                catch (...)
-                {
-                    if (span.active())
-                        span.span().record_exception("prompt get failed");
-                    return fastmcpp::Json{
-                        {"jsonrpc", "2.0"},
-                        {"id", id},
-                        {"result", fastmcpp::Json{{"messages", fastmcpp::Json::array()}}}};
-                }
-            }
-
-            if (method == "resources/list" || method == "prompts/list")
-            {
-                try
-                {
-                    auto routed = server.handle(method, params);
-                    return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", routed}};
-                }
-                catch (...)
-                {
-                    if (method == "resources/list")
-                        return fastmcpp::Json{
-                            {"jsonrpc", "2.0"},
-                            {"id", id},
-                            {"result", fastmcpp::Json{{"resources", fastmcpp::Json::array()}}}};
-                    return fastmcpp::Json{
-                        {"jsonrpc", "2.0"},
-                        {"id", id},
-                        {"result", fastmcpp::Json{{"prompts", fastmcpp::Json::array()}}}};
-                }
-            }
-
-            return jsonrpc_error(id, kJsonRpcMethodNotFound,
-                                 std::string("Method '") + method + "' not found");
-        }
-        catch (const std::exception& e)
+    dispatcher.on(
+        McpMethod::Initialize,
+        [&server](const McpRequest& request) -> fastmcpp::Json
         {
-            return jsonrpc_error(message.value("id", fastmcpp::Json()), kJsonRpcInternalError,
-                                 e.what());
-        }
-    };
+            fastmcpp::Json serverInfo = server_info_json(server);
+            fastmcpp::Json result_obj = {
+                {"protocolVersion", "2024-11-05"},
+                {"capabilities", fastmcpp::Json{{"tools", fastmcpp::Json::object()}}},
+                {"serverInfo", serverInfo}};
+            if (server.instructions().has_value())
+                result_obj["instructions"] = *server.instructions();
+            return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", request.id}, {"result", result_obj}};
+        });
+
+    dispatcher.on(
+        McpMethod::ToolsList,
+        [&tools](const McpRequest& request) { return tool_manager_list(request, tools); });
+
+    dispatcher.on(
+        McpMethod::ToolsCall, [&server, &tools](const McpRequest& request)
+        { return tool_manager_call(request, tools, server.name()); });
+
+    dispatcher.on(
+        McpMethod::ResourcesRead, [&server](const McpRequest& request)
+        { return server_routed_resource_read(request, server); });
+
+    dispatcher.on(
+        McpMethod::PromptsGet,
+        [&server](const McpRequest& request) { return server_routed_prompt_get(request, server); });
+
+    dispatcher.on(
+        McpMethod::ResourcesList, [&server](const McpRequest& request)
+        { return server_routed_list(request, server, "resources"); });
+
+    dispatcher.on(McpMethod::PromptsList, [&server](const McpRequest& request)
+                  { return server_routed_list(request, server, "prompts"); });
+
+    return into_handler(std::move(dispatcher));
 }
 
 // Full MCP handler with tools, resources, and prompts support
 std::function<fastmcpp::Json(const fastmcpp::Json&)>
-make_mcp_handler(const std::string& server_name, const std::string& version,
+make_mcp_handler(const std::string& /*server_name*/, const std::string& /*version*/,
                  const server::Server& server, const tools::ToolManager& tools,
                  const resources::ResourceManager& resources, const prompts::PromptManager& prompts,
-                 const std::unordered_map<std::string, std::string>& descriptions)
+                 const std::unordered_map<std::string, std::string>& /*descriptions*/)
 {
-    return [server_name, version, &server, &tools, &resources, &prompts,
-            descriptions](const fastmcpp::Json& message) -> fastmcpp::Json
-    {
-        try
-        {
-            const auto id = message.contains("id") ? message.at("id") : fastmcpp::Json();
-            std::string method = message.value("method", "");
-            fastmcpp::Json params = message.value("params", fastmcpp::Json::object());
-            const std::string session_id = extract_session_id(params);
+    McpDispatcher dispatcher;
 
-            if (method == "initialize")
-            {
-                fastmcpp::Json serverInfo = {{"name", server.name()},
-                                             {"version", server.version()}};
-                if (server.website_url())
-                    serverInfo["websiteUrl"] = *server.website_url();
-                if (server.icons())
-                {
-                    fastmcpp::Json icons_array = fastmcpp::Json::array();
-                    for (const auto& icon : *server.icons())
+    dispatcher.on(
+        McpMethod::Initialize,
+        [&server, &resources, &prompts](const McpRequest& request) -> fastmcpp::Json
+        {
+            fastmcpp::Json serverInfo = server_info_json(server);
+
+            // Advertise capabilities for tools, resources, and prompts
+            fastmcpp::Json capabilities = {{"tools", fastmcpp::Json::object()}};
+            if (!resources.list().empty() || !resources.list_templates().empty())
+                capabilities["resources"] = fastmcpp::Json::object();
+            if (!prompts.list().empty())
+                capabilities["prompts"] = fastmcpp::Json::object();
+
+            fastmcpp::Json result_obj = {{"protocolVersion", "2024-11-05"},
+                                         {"capabilities", capabilities},
+                                         {"serverInfo", serverInfo}};
+            if (server.instructions().has_value())
+                result_obj["instructions"] = *server.instructions();
+            return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", request.id}, {"result", result_obj}};
+        });
+
+    dispatcher.on(
+        McpMethod::ToolsList,
+        [&tools](const McpRequest& request) { return tool_manager_list(request, tools); });
+
+    dispatcher.on(McpMethod::ToolsCall, [&server, &tools](const McpRequest& request)
+                  { return tool_manager_call(request, tools, server.name()); });
+
+    // Resources support
+    dispatcher.on(McpMethod::ResourcesList,
+                  [&resources](const McpRequest& request) -> fastmcpp::Json
+                  {
+                      fastmcpp::Json resources_array = fastmcpp::Json::array();
+                      for (const auto& res : resources.list())
+                      {
+                          fastmcpp::Json res_json = {{"uri", res.uri}, {"name", res.name}};
+                          if (res.version)
+                              res_json["version"] = *res.version;
+                          if (res.description)
+                              res_json["description"] = *res.description;
+                          if (res.mime_type)
+                              res_json["mimeType"] = *res.mime_type;
+                          if (res.title)
+                              res_json["title"] = *res.title;
+                          if (res.annotations)
+                              res_json["annotations"] = *res.annotations;
+                          if (res.icons)
+                          {
+                              fastmcpp::Json icons_json = fastmcpp::Json::array();
+                              for (const auto& icon : *res.icons)
+                              {
+                                  fastmcpp::Json icon_obj = {{"src", icon.src}};
+                                  if (icon.mime_type)
+                                      icon_obj["mimeType"] = *icon.mime_type;
+                                  if (icon.sizes)
+                                      icon_obj["sizes"] = *icon.sizes;
+                                  icons_json.push_back(icon_obj);
+                              }
+                              res_json["icons"] = icons_json;
+                          }
+                          attach_meta_ui(res_json, res.app);
+                          res_json["fastmcp"] = make_fastmcp_meta();
+                          resources_array.push_back(res_json);
+                      }
+                      return fastmcpp::Json{
+                          {"jsonrpc", "2.0"},
+                          {"id", request.id},
+                          {"result", fastmcpp::Json{{"resources", resources_array}}}};
+                  });
+
+    // Resource templates support
+    dispatcher.on(
+        McpMethod::ResourcesTemplatesList,
+        [&resources](const McpRequest& request) -> fastmcpp::Json
+        {
+            fastmcpp::Json templates_array = fastmcpp::Json::array();
+            for (const auto& templ : resources.list_templates())
+            {
+                fastmcpp::Json templ_json = {{"uriTemplate", templ.uri_template},
+                                             {"name", templ.name}};
+                if (templ.description)
+                    templ_json["description"] = *templ.description;
+                if (templ.mime_type)
+                    templ_json["mimeType"] = *templ.mime_type;
+                if (templ.title)
+                    templ_json["title"] = *templ.title;
+                if (templ.annotations)
+                    templ_json["annotations"] = *templ.annotations;
+                if (templ.icons)
+                {
+                    fastmcpp::Json icons_json = fastmcpp::Json::array();
+                    for (const auto& icon : *templ.icons)
                     {
-                        fastmcpp::Json icon_json;
-                        to_json(icon_json, icon);
-                        icons_array.push_back(icon_json);
+                        fastmcpp::Json icon_obj = {{"src", icon.src}};
+                        if (icon.mime_type)
+                            icon_obj["mimeType"] = *icon.mime_type;
+                        if (icon.sizes)
+                            icon_obj["sizes"] = *icon.sizes;
+                        icons_json.push_back(icon_obj);
                     }
-                    serverInfo["icons"] = icons_array;
-                }
-
-                // Advertise capabilities for tools, resources, and prompts
-                fastmcpp::Json capabilities = {{"tools", fastmcpp::Json::object()}};
-                if (!resources.list().empty() || !resources.list_templates().empty())
-                    capabilities["resources"] = fastmcpp::Json::object();
-                if (!prompts.list().empty())
-                    capabilities["prompts"] = fastmcpp::Json::object();
-
-                fastmcpp::Json result_obj = {{"protocolVersion", "2024-11-05"},
-                                             {"capabilities", capabilities},
-                                             {"serverInfo", serverInfo}};
-                if (server.instructions().has_value())
-                    result_obj["instructions"] = *server.instructions();
-                return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", result_obj}};
-            }
-
-            if (method == "ping")
+                    templ_json["icons"] = icons_json;
+                }
+                attach_meta_ui(templ_json, templ.app);
+                templ_json["parameters"] =
+                    templ.parameters.is_null() ? fastmcpp::Json::object() : templ.parameters;
+                templates_array.push_back(templ_json);
+            }
+            return fastmcpp::Json{
+                {"jsonrpc", "2.0"},
+                {"id", request.id},
+                {"result", fastmcpp::Json{{"resourceTemplates", templates_array}}}};
+        });
+
+    dispatcher.on(
+        McpMethod::ResourcesRead,
+        [&server, &resources](const McpRequest& request) -> fastmcpp::Json
+        {
+            std::string uri = request.params.value("uri", "");
+            if (uri.empty())
+                return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Missing resource URI");
+            // Strip trailing slashes for compatibility with Python fastmcp
+            while (!uri.empty() && uri.back() == '/')
+                uri.pop_back();
+            auto span = request_span(request, "resource " + uri, server.name(), "resource", uri);
+            try
             {
-                return fastmcpp::Json{
-                    {"jsonrpc", "2.0"}, {"id", id}, {"result", fastmcpp::Json::object()}};
-            }
+                auto content_json =
+                    fastmcpp::resources::content_to_json(resources.read(uri, request.params));
 
-            if (method == "tools/list")
-            {
-                fastmcpp::Json tools_array = fastmcpp::Json::array();
-                for (const auto& name : tools.list_names())
-                {
-                    const auto& tool = tools.get(name);
-                    std::string desc = tool.description() ? *tool.description() : "";
-                    tools_array.push_back(make_tool_entry(
-                        name, desc, tool.input_schema(), tool.title(), tool.icons(),
-                        tool.output_schema(), tool.task_support(), tool.sequential(), tool.app(),
-                        tool.meta(), tool.version(), tool.annotations()));
-                }
-                return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                      {"id", id},
-                                      {"result", fastmcpp::Json{{"tools", tools_array}}}};
+                return fastmcpp::Json{
+                    {"jsonrpc", "2.0"},
+                    {"id", request.id},
+                    {"result", fastmcpp::Json{{"contents", {std::move(content_json)}}}}};
             }
-
-            if (method == "tools/call")
+            catch (const NotFoundError& e)
             {
-                std::string name = params.value("name", "");
-                fastmcpp::Json args = params.value("arguments", fastmcpp::Json::object());
-                if (name.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing tool name");
-                auto span = telemetry::server_span(
-                    "tool " + name, "tools/call", server.name(), "tool", name,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
-                {
-                    const auto& tool = tools.get(name);
-                    bool has_output_schema = !tool.output_schema().is_null();
-                    bool wrap_result = schema_has_wrap_result(tool.output_schema());
-
-                    auto result = tools.invoke(name, args);
-                    fastmcpp::Json result_payload =
-                        build_fastmcp_tool_result(result, has_output_schema, wrap_result);
-                    return fastmcpp::Json{
-                        {"jsonrpc", "2.0"}, {"id", id}, {"result", result_payload}};
-                }
-                catch (const std::exception& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_tool_error(id, e);
-                }
+                return jsonrpc_error(request.id, kMcpResourceNotFound, e.what());
             }
-
-            // Resources support
-            if (method == "resources/list")
+            catch (const std::exception& e)
             {
-                fastmcpp::Json resources_array = fastmcpp::Json::array();
-                for (const auto& res : resources.list())
-                {
-                    fastmcpp::Json res_json = {{"uri", res.uri}, {"name", res.name}};
-                    if (res.version)
-                        res_json["version"] = *res.version;
-                    if (res.description)
-                        res_json["description"] = *res.description;
-                    if (res.mime_type)
-                        res_json["mimeType"] = *res.mime_type;
-                    if (res.title)
-                        res_json["title"] = *res.title;
-                    if (res.annotations)
-                        res_json["annotations"] = *res.annotations;
-                    if (res.icons)
-                    {
-                        fastmcpp::Json icons_json = fastmcpp::Json::array();
-                        for (const auto& icon : *res.icons)
-                        {
-                            fastmcpp::Json icon_obj = {{"src", icon.src}};
-                            if (icon.mime_type)
-                                icon_obj["mimeType"] = *icon.mime_type;
-                            if (icon.sizes)
-                                icon_obj["sizes"] = *icon.sizes;
-                            icons_json.push_back(icon_obj);
-                        }
-                        res_json["icons"] = icons_json;
-                    }
-                    attach_meta_ui(res_json, res.app);
-                    res_json["fastmcp"] = make_fastmcp_meta();
-                    resources_array.push_back(res_json);
-                }
-                return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                      {"id", id},
-                                      {"result", fastmcpp::Json{{"resources", resources_array}}}};
+                return jsonrpc_tool_error(request.id, e);
             }
+        });
 
-            // Resource templates support
-            if (method == "resources/templates/list")
-            {
-                fastmcpp::Json templates_array = fastmcpp::Json::array();
-                for (const auto& templ : resources.list_templates())
-                {
-                    fastmcpp::Json templ_json = {{"uriTemplate", templ.uri_template},
-                                                 {"name", templ.name}};
-                    if (templ.description)
-                        templ_json["description"] = *templ.description;
-                    if (templ.mime_type)
-                        templ_json["mimeType"] = *templ.mime_type;
-                    if (templ.title)
-                        templ_json["title"] = *templ.title;
-                    if (templ.annotations)
-                        templ_json["annotations"] = *templ.annotations;
-                    if (templ.icons)
+    // Prompts support
+    dispatcher.on(
+        McpMethod::PromptsList,
+        [&prompts](const McpRequest& request) -> fastmcpp::Json
+        {
+            fastmcpp::Json prompts_array = fastmcpp::Json::array();
+            for (const auto& prompt : prompts.list())
+            {
+                fastmcpp::Json prompt_json = {{"name", prompt.name}};
+                if (prompt.version)
+                    prompt_json["version"] = *prompt.version;
+                if (prompt.description)
+                    prompt_json["description"] = *prompt.description;
+                if (!prompt.arguments.empty())
+                {
+                    fastmcpp::Json args_array = fastmcpp::Json::array();
+                    for (const auto& arg : prompt.arguments)
                     {
-                        fastmcpp::Json icons_json = fastmcpp::Json::array();
-                        for (const auto& icon : *templ.icons)
-                        {
-                            fastmcpp::Json icon_obj = {{"src", icon.src}};
-                            if (icon.mime_type)
-                                icon_obj["mimeType"] = *icon.mime_type;
-                            if (icon.sizes)
-                                icon_obj["sizes"] = *icon.sizes;
-                            icons_json.push_back(icon_obj);
-                        }
-                        templ_json["icons"] = icons_json;
+                        fastmcpp::Json arg_json = {{"name", arg.name}, {"required", arg.required}};
+                        if (arg.description)
+                            arg_json["description"] = *arg.description;
+                        args_array.push_back(arg_json);
                     }
-                    attach_meta_ui(templ_json, templ.app);
-                    templ_json["parameters"] =
-                        templ.parameters.is_null() ? fastmcpp::Json::object() : templ.parameters;
-                    templates_array.push_back(templ_json);
+                    prompt_json["arguments"] = args_array;
                 }
-                return fastmcpp::Json{
-                    {"jsonrpc", "2.0"},
-                    {"id", id},
-                    {"result", fastmcpp::Json{{"resourceTemplates", templates_array}}}};
+                prompt_json["fastmcp"] = make_fastmcp_meta();
+                prompts_array.push_back(prompt_json);
             }
+            return fastmcpp::Json{{"jsonrpc", "2.0"},
+                                  {"id", request.id},
+                                  {"result", fastmcpp::Json{{"prompts", prompts_array}}}};
+        });
 
-            if (method == "resources/read")
+    dispatcher.on(
+        McpMethod::PromptsGet,
+        [&server, &prompts](const McpRequest& request) -> fastmcpp::Json
+        {
+            std::string name = request.params.value("name", "");
+            if (name.empty())
+                return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Missing prompt name");
+            auto span = request_span(request, "prompt " + name, server.name(), "prompt", name);
+            try
             {
-                std::string uri = params.value("uri", "");
-                if (uri.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing resource URI");
-                // Strip trailing slashes for compatibility with Python fastmcp
-                while (!uri.empty() && uri.back() == '/')
-                    uri.pop_back();
-                auto span = telemetry::server_span(
-                    "resource " + uri, "resources/read", server.name(), "resource", uri,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
-                {
-                    auto content = resources.read(uri, params);
-                    fastmcpp::Json content_json = {{"uri", content.uri}};
-                    if (content.mime_type)
-                        content_json["mimeType"] = *content.mime_type;
+                fastmcpp::Json args = request.params.value("arguments", fastmcpp::Json::object());
+                auto messages = prompts.render(name, args);
 
-                    // Handle text vs binary content
-                    if (std::holds_alternative<std::string>(content.data))
-                    {
-                        content_json["text"] = std::get<std::string>(content.data);
-                    }
-                    else
-                    {
-                        // Binary data - base64 encode
-                        const auto& binary = std::get<std::vector<uint8_t>>(content.data);
-                        static const char* b64_chars =
-                            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-                        std::string b64;
-                        b64.reserve((binary.size() + 2) / 3 * 4);
-                        for (size_t i = 0; i < binary.size(); i += 3)
-                        {
-                            uint32_t n = binary[i] << 16;
-                            if (i + 1 < binary.size())
-                                n |= binary[i + 1] << 8;
-                            if (i + 2 < binary.size())
-                                n |= binary[i + 2];
-                            b64.push_back(b64_chars[(n >> 18) & 0x3F]);
-                            b64.push_back(b64_chars[(n >> 12) & 0x3F]);
-                            b64.push_back((i + 1 < binary.size()) ? b64_chars[(n >> 6) & 0x3F]
-                                                                  : '=');
-                            b64.push_back((i + 2 < binary.size()) ? b64_chars[n & 0x3F] : '=');
-                        }
-                        content_json["blob"] = b64;
-                    }
-
-                    return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                          {"id", id},
-                                          {"result", fastmcpp::Json{{"contents", {content_json}}}}};
-                }
-                catch (const NotFoundError& e)
+                fastmcpp::Json messages_array = fastmcpp::Json::array();
+                for (const auto& msg : messages)
                 {
-                    return jsonrpc_error(id, kMcpResourceNotFound, e.what());
+                    messages_array.push_back(
+                        {{"role", msg.role},
+                         {"content", fastmcpp::Json{{"type", "text"}, {"text", msg.content}}}});
                 }
-                catch (const std::exception& e)
-                {
-                    return jsonrpc_tool_error(id, e);
-                }
-            }
 
-            // Prompts support
-            if (method == "prompts/list")
-            {
-                fastmcpp::Json prompts_array = fastmcpp::Json::array();
-                for (const auto& prompt : prompts.list())
-                {
-                    fastmcpp::Json prompt_json = {{"name", prompt.name}};
-                    if (prompt.version)
-                        prompt_json["version"] = *prompt.version;
-                    if (prompt.description)
-                        prompt_json["description"] = *prompt.description;
-                    if (!prompt.arguments.empty())
-                    {
-                        fastmcpp::Json args_array = fastmcpp::Json::array();
-                        for (const auto& arg : prompt.arguments)
-                        {
-                            fastmcpp::Json arg_json = {{"name", arg.name},
-                                                       {"required", arg.required}};
-                            if (arg.description)
-                                arg_json["description"] = *arg.description;
-                            args_array.push_back(arg_json);
-                        }
-                        prompt_json["arguments"] = args_array;
-                    }
-                    prompt_json["fastmcp"] = make_fastmcp_meta();
-                    prompts_array.push_back(prompt_json);
-                }
                 return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                      {"id", id},
-                                      {"result", fastmcpp::Json{{"prompts", prompts_array}}}};
+                                      {"id", request.id},
+                                      {"result", fastmcpp::Json{{"messages", messages_array}}}};
             }
-
-            if (method == "prompts/get")
+            catch (const NotFoundError& e)
             {
-                std::string name = params.value("name", "");
-                if (name.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing prompt name");
-                auto span = telemetry::server_span(
-                    "prompt " + name, "prompts/get", server.name(), "prompt", name,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
-                {
-                    fastmcpp::Json args = params.value("arguments", fastmcpp::Json::object());
-                    auto messages = prompts.render(name, args);
-
-                    fastmcpp::Json messages_array = fastmcpp::Json::array();
-                    for (const auto& msg : messages)
-                    {
-                        messages_array.push_back(
-                            {{"role", msg.role},
-                             {"content", fastmcpp::Json{{"type", "text"}, {"text", msg.content}}}});
-                    }
-
-                    return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                          {"id", id},
-                                          {"result", fastmcpp::Json{{"messages", messages_array}}}};
-                }
-                catch (const NotFoundError& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_error(id, kMcpMethodNotFound, e.what());
-                }
-                catch (const std::exception& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_tool_error(id, e);
-                }
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_error(request.id, kMcpMethodNotFound, e.what());
+            }
+            catch (const std::exception& e)
+            {
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_tool_error(request.id, e);
             }
+        });
 
-            return jsonrpc_error(id, kJsonRpcMethodNotFound,
-                                 std::string("Method '") + method + "' not found");
-        }
-        catch (const std::exception& e)
-        {
-            return jsonrpc_error(message.value("id", fastmcpp::Json()), kJsonRpcInternalError,
-                                 e.what());
-        }
-    };
+    return into_handler(std::move(dispatcher));
 }
 
 // FastMCP handler - supports mounted apps with aggregation
@@ -1838,827 +2014,841 @@ std::function<fastmcpp::Json(const fastmcpp::Json&)>
 make_mcp_handler(const FastMCP& app, SessionAccessor session_accessor)
 {
     auto task_session_accessor = session_accessor;
-    auto tasks = std::make_shared<TaskRegistry>(std::move(task_session_accessor));
-    return [&app, tasks, session_accessor](const fastmcpp::Json& message) -> fastmcpp::Json
-    {
-        try
+    auto tasks =
+        std::make_shared<TaskRegistry>(std::move(task_session_accessor), app.task_executor());
+    auto lists = std::make_shared<CatalogListCache>();
+    McpDispatcher dispatcher;
+
+    dispatcher.on(
+        McpMethod::Initialize,
+        [&app, session_accessor](const McpRequest& request) -> fastmcpp::Json
         {
-            const auto id = message.contains("id") ? message.at("id") : fastmcpp::Json();
-            std::string method = message.value("method", "");
-            fastmcpp::Json params = message.value("params", fastmcpp::Json::object());
-            const std::string session_id = extract_session_id(params);
-
-            if (method == "initialize")
+            if (!request.session_id.empty() && session_accessor)
+            {
+                auto session = session_accessor(request.session_id);
+                if (session && request.params.contains("capabilities"))
+                    session->set_capabilities(request.params["capabilities"]);
+            }
+
+            fastmcpp::Json serverInfo = {{"name", app.name()}, {"version", app.version()}};
+            if (app.website_url())
+                serverInfo["websiteUrl"] = *app.website_url();
+            if (app.icons())
+            {
+                fastmcpp::Json icons_array = fastmcpp::Json::array();
+                for (const auto& icon : *app.icons())
+                {
+                    fastmcpp::Json icon_json;
+                    to_json(icon_json, icon);
+                    icons_array.push_back(icon_json);
+                }
+                serverInfo["icons"] = icons_array;
+            }
+
+            // Advertise capabilities
+            fastmcpp::Json capabilities = {{"tools", fastmcpp::Json::object()}};
+            auto catalog = app.catalog();
+            if (catalog->supports_tasks)
+                capabilities["tasks"] = tasks_capabilities();
+            if (!catalog->resources.empty() || !catalog->templates.empty())
+                capabilities["resources"] = fastmcpp::Json::object();
+            if (!catalog->prompts.empty())
+                capabilities["prompts"] = fastmcpp::Json::object();
+            advertise_ui_extension(capabilities);
+            advertise_experimental(capabilities, app);
+
+            fastmcpp::Json result_obj = {{"protocolVersion", "2024-11-05"},
+                                         {"capabilities", capabilities},
+                                         {"serverInfo", serverInfo}};
+            if (app.instructions().has_value())
+                result_obj["instructions"] = *app.instructions();
+            return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", request.id}, {"result", result_obj}};
+        });
+
+    dispatcher.on(McpMethod::ToolsList,
+                  [&app, lists](const McpRequest& request)
+                  {
+                      return catalog_list_page(request, app, *lists, CatalogListCache::Kind::Tools,
+                                               "tools");
+                  });
+
+    dispatcher.on(
+        McpMethod::ToolsCall,
+        [&app, tasks, session_accessor](const McpRequest& request) -> fastmcpp::Json
+        {
+            std::string name = request.params.value("name", "");
+            fastmcpp::Json args = request.params.value("arguments", fastmcpp::Json::object());
+            if (name.empty())
+                return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Missing tool name");
+            auto span = request_span(request, "tool " + name, app.name(), "tool", name);
+            try
             {
-                if (!session_id.empty() && session_accessor)
+                if (!request.session_id.empty())
                 {
-                    auto session = session_accessor(session_id);
-                    if (session && params.contains("capabilities"))
-                        session->set_capabilities(params["capabilities"]);
-                }
-
-                fastmcpp::Json serverInfo = {{"name", app.name()}, {"version", app.version()}};
-                if (app.website_url())
-                    serverInfo["websiteUrl"] = *app.website_url();
-                if (app.icons())
-                {
-                    fastmcpp::Json icons_array = fastmcpp::Json::array();
-                    for (const auto& icon : *app.icons())
+                    if (!args.contains("_meta") || !args["_meta"].is_object())
+                        args["_meta"] = fastmcpp::Json::object();
+                    args["_meta"]["session_id"] = request.session_id;
+                    if (session_accessor)
                     {
-                        fastmcpp::Json icon_json;
-                        to_json(icon_json, icon);
-                        icons_array.push_back(icon_json);
+                        auto session = session_accessor(request.session_id);
+                        if (session)
+                            inject_client_extensions_meta(args, *session);
                     }
-                    serverInfo["icons"] = icons_array;
                 }
 
-                // Advertise capabilities
-                fastmcpp::Json capabilities = {{"tools", fastmcpp::Json::object()}};
-                if (app_supports_tasks(app))
-                    capabilities["tasks"] = tasks_capabilities();
-                if (!app.list_all_resources().empty() || !app.list_all_templates().empty())
-                    capabilities["resources"] = fastmcpp::Json::object();
-                if (!app.list_all_prompts().empty())
-                    capabilities["prompts"] = fastmcpp::Json::object();
-                advertise_ui_extension(capabilities);
-                advertise_experimental(capabilities, app);
-
-                fastmcpp::Json result_obj = {{"protocolVersion", "2024-11-05"},
-                                             {"capabilities", capabilities},
-                                             {"serverInfo", serverInfo}};
-                if (app.instructions().has_value())
-                    result_obj["instructions"] = *app.instructions();
-                return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", result_obj}};
-            }
-
-            if (method == "ping")
-            {
-                return fastmcpp::Json{
-                    {"jsonrpc", "2.0"}, {"id", id}, {"result", fastmcpp::Json::object()}};
-            }
+                auto route = app.find_tool_route(name);
+                bool has_output_schema = route && route->has_output_schema;
+                bool wrap_result = route && route->wrap_result;
 
-            if (method == "tools/list")
-            {
-                fastmcpp::Json tools_array = fastmcpp::Json::array();
-                for (const auto& tool_info : app.list_all_tools_info())
+                // Detect SEP-1686 task metadata via params._meta
+                int ttl_ms = 60000;
+                bool has_task_meta = false;
+                if (request.params.contains("_meta") && request.params["_meta"].is_object())
                 {
-                    fastmcpp::Json tool_json = {{"name", tool_info.name},
-                                                {"inputSchema", tool_info.inputSchema}};
-                    if (tool_info.version)
-                        tool_json["version"] = *tool_info.version;
-                    if (tool_info.title)
-                        tool_json["title"] = *tool_info.title;
-                    if (tool_info.description)
-                        tool_json["description"] = *tool_info.description;
-                    if (tool_info.outputSchema && !tool_info.outputSchema->is_null())
-                        tool_json["outputSchema"] =
-                            normalize_output_schema_for_mcp(*tool_info.outputSchema);
-                    if (tool_info.execution)
-                        tool_json["execution"] = *tool_info.execution;
-                    if (tool_info.icons && !tool_info.icons->empty())
+                    const auto& meta = request.params["_meta"];
+                    auto it = meta.find("modelcontextprotocol.io/task");
+                    if (it != meta.end() && it->is_object())
                     {
-                        fastmcpp::Json icons_json = fastmcpp::Json::array();
-                        for (const auto& icon : *tool_info.icons)
-                        {
-                            fastmcpp::Json icon_obj = {{"src", icon.src}};
-                            if (icon.mime_type)
-                                icon_obj["mimeType"] = *icon.mime_type;
-                            if (icon.sizes)
-                                icon_obj["sizes"] = *icon.sizes;
-                            icons_json.push_back(icon_obj);
-                        }
-                        tool_json["icons"] = icons_json;
+                        has_task_meta = true;
+                        const auto& task_meta = *it;
+                        if (task_meta.contains("ttl") && task_meta["ttl"].is_number_integer())
+                            ttl_ms = task_meta["ttl"].get<int>();
                     }
-                    attach_meta_ui(tool_json, tool_info.app, tool_info._meta);
-                    tools_array.push_back(tool_json);
                 }
-                return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                      {"id", id},
-                                      {"result", apply_pagination(tools_array, "tools", params,
-                                                                  app.list_page_size())}};
-            }
 
-            if (method == "tools/call")
-            {
-                std::string name = params.value("name", "");
-                fastmcpp::Json args = params.value("arguments", fastmcpp::Json::object());
-                if (name.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing tool name");
-                auto span = telemetry::server_span(
-                    "tool " + name, "tools/call", app.name(), "tool", name,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
+                auto support = route ? route->task_support : std::nullopt;
+                if (support)
                 {
-                    if (!session_id.empty())
-                    {
-                        if (!args.contains("_meta") || !args["_meta"].is_object())
-                            args["_meta"] = fastmcpp::Json::object();
-                        args["_meta"]["session_id"] = session_id;
-                        if (session_accessor)
-                        {
-                            auto session = session_accessor(session_id);
-                            if (session)
-                                inject_client_extensions_meta(args, *session);
-                        }
-                    }
+                    if (has_task_meta && *support == fastmcpp::TaskSupport::Forbidden)
+                        return jsonrpc_error(request.id, kJsonRpcMethodNotFound,
+                                             "Task execution forbidden for tool: " + name);
+                    if (!has_task_meta && *support == fastmcpp::TaskSupport::Required)
+                        return jsonrpc_error(request.id, kJsonRpcMethodNotFound,
+                                             "Task execution required for tool: " + name);
+                }
 
-                    bool has_output_schema = false;
-                    bool wrap_result = false;
-                    for (const auto& tool_info : app.list_all_tools_info())
-                    {
-                        if (tool_info.name != name)
-                            continue;
-                        has_output_schema =
-                            tool_info.outputSchema && !tool_info.outputSchema->is_null();
-                        if (has_output_schema)
-                            wrap_result = schema_has_wrap_result(*tool_info.outputSchema);
-                        break;
-                    }
+                if (has_task_meta)
+                {
+                    auto created = tasks->create_task("tool", name, ttl_ms,
+                                                      extract_session_id(request.params));
+                    std::string task_id = created.task_id;
 
-                    // Detect SEP-1686 task metadata via params._meta
-                    int ttl_ms = 60000;
-                    bool has_task_meta = false;
-                    if (params.contains("_meta") && params["_meta"].is_object())
-                    {
-                        const auto& meta = params["_meta"];
-                        auto it = meta.find("modelcontextprotocol.io/task");
-                        if (it != meta.end() && it->is_object())
+                    tasks->enqueue_task(
+                        task_id, extract_task_priority(request.params),
+                        [&app, name, args, has_output_schema, wrap_result]() -> fastmcpp::Json
                         {
-                            has_task_meta = true;
-                            const auto& task_meta = *it;
-                            if (task_meta.contains("ttl") && task_meta["ttl"].is_number_integer())
-                                ttl_ms = task_meta["ttl"].get<int>();
-                        }
-                    }
-
-                    auto support = find_tool_task_support(app, name);
-                    if (support)
-                    {
-                        if (has_task_meta && *support == fastmcpp::TaskSupport::Forbidden)
-                            return jsonrpc_error(id, kJsonRpcMethodNotFound,
-                                                 "Task execution forbidden for tool: " + name);
-                        if (!has_task_meta && *support == fastmcpp::TaskSupport::Required)
-                            return jsonrpc_error(id, kJsonRpcMethodNotFound,
-                                                 "Task execution required for tool: " + name);
-                    }
-
-                    if (has_task_meta)
-                    {
-                        auto created =
-                            tasks->create_task("tool", name, ttl_ms, extract_session_id(params));
-                        std::string task_id = created.task_id;
+                            auto invoke_result = app.invoke_tool(name, args, false);
+                            return build_fastmcp_tool_result(invoke_result, has_output_schema,
+                                                             wrap_result);
+                        });
+
+                    fastmcpp::Json task_meta = {
+                        {"taskId", task_id},
+                        {"status", "working"},
+                        {"ttl", ttl_ms},
+                        {"createdAt", created.created_at},
+                        {"lastUpdatedAt", created.created_at},
+                    };
 
-                        tasks->enqueue_task(
-                            task_id,
-                            [&app, name, args, has_output_schema, wrap_result]() -> fastmcpp::Json
-                            {
-                                auto invoke_result = app.invoke_tool(name, args, false);
-                                return build_fastmcp_tool_result(invoke_result, has_output_schema,
-                                                                 wrap_result);
-                            });
-
-                        fastmcpp::Json task_meta = {
-                            {"taskId", task_id},
-                            {"status", "working"},
-                            {"ttl", ttl_ms},
-                            {"createdAt", created.created_at},
-                            {"lastUpdatedAt", created.created_at},
-                        };
-
-                        fastmcpp::Json response_result = {
-                            {"content", fastmcpp::Json::array()},
-                            {"_meta",
-                             fastmcpp::Json{
-                                 {"modelcontextprotocol.io/task", task_meta},
-                             }},
-                        };
-
-                        return fastmcpp::Json{
-                            {"jsonrpc", "2.0"},
-                            {"id", id},
-                            {"result", response_result},
-                        };
-                    }
+                    fastmcpp::Json response_result = {
+                        {"content", fastmcpp::Json::array()},
+                        {"_meta",
+                         fastmcpp::Json{
+                             {"modelcontextprotocol.io/task", task_meta},
+                         }},
+                    };
 
-                    // Synchronous execution (no task metadata)
-                    auto invoke_result = app.invoke_tool(name, args);
-                    fastmcpp::Json result_payload =
-                        build_fastmcp_tool_result(invoke_result, has_output_schema, wrap_result);
                     return fastmcpp::Json{
                         {"jsonrpc", "2.0"},
-                        {"id", id},
-                        {"result", result_payload},
+                        {"id", request.id},
+                        {"result", response_result},
                     };
                 }
-                catch (const std::exception& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_tool_error(id, e);
-                }
-            }
-
-            // Tasks protocol (SEP-1686 subset)
-            if (method == "tasks/get")
-            {
-                std::string task_id = params.value("taskId", "");
-                if (task_id.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing taskId");
-
-                auto info = tasks->get_task(task_id);
-                if (!info)
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Invalid taskId");
-
-                fastmcpp::Json status_json = {
-                    {"taskId", info->task_id},
-                    {"status", mcp_status_from_internal(info->status)},
-                };
-                if (!info->created_at.empty())
-                    status_json["createdAt"] = info->created_at;
-                if (!info->last_updated_at.empty())
-                    status_json["lastUpdatedAt"] = info->last_updated_at;
-                status_json["ttl"] = info->ttl_ms;
-                status_json["pollInterval"] = 1000;
-                if (!info->status_message.empty())
-                    status_json["statusMessage"] = info->status_message;
 
+                // Synchronous execution (no task metadata)
+                auto invoke_result = app.invoke_tool(name, args);
+                fastmcpp::Json result_payload =
+                    build_fastmcp_tool_result(invoke_result, has_output_schema, wrap_result);
                 return fastmcpp::Json{
                     {"jsonrpc", "2.0"},
-                    {"id", id},
-                    {"result", status_json},
+                    {"id", request.id},
+                    {"result", result_payload},
                 };
             }
-
-            if (method == "tasks/result")
+            catch (const std::exception& e)
             {
-                std::string task_id = params.value("taskId", "");
-                if (task_id.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing taskId");
-
-                auto q = tasks->get_result(task_id);
-                if (q.state == TaskRegistry::ResultState::NotFound)
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Invalid taskId");
-                if (q.state == TaskRegistry::ResultState::NotReady)
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Task not completed");
-                if (q.state == TaskRegistry::ResultState::Cancelled)
-                    return jsonrpc_error(id, kJsonRpcInternalError,
-                                         q.error_message.empty() ? "Task cancelled"
-                                                                 : q.error_message);
-                if (q.state == TaskRegistry::ResultState::Failed)
-                    return jsonrpc_error(id, kJsonRpcInternalError,
-                                         q.error_message.empty() ? "Task failed" : q.error_message);
-
-                return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", q.payload}};
-            }
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_tool_error(request.id, e);
+            }
+        });
+
+    // Tasks protocol (SEP-1686 subset)
+    dispatcher.on(McpMethod::TasksGet,
+                  [tasks](const McpRequest& request) -> fastmcpp::Json
+                  {
+                      std::string task_id = request.params.value("taskId", "");
+                      if (task_id.empty())
+                          return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Missing taskId");
+
+                      auto info = tasks->get_task(task_id);
+                      if (!info)
+                          return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Invalid taskId");
+
+                      fastmcpp::Json status_json = {
+                          {"taskId", info->task_id},
+                          {"status", mcp_status_from_internal(info->status)},
+                      };
+                      if (!info->created_at.empty())
+                          status_json["createdAt"] = info->created_at;
+                      if (!info->last_updated_at.empty())
+                          status_json["lastUpdatedAt"] = info->last_updated_at;
+                      status_json["ttl"] = info->ttl_ms;
+                      status_json["pollInterval"] = 1000;
+                      if (!info->status_message.empty())
+                          status_json["statusMessage"] = info->status_message;
+
+                      return fastmcpp::Json{
+                          {"jsonrpc", "2.0"},
+                          {"id", request.id},
+                          {"result", status_json},
+                      };
+                  });
+
+    dispatcher.on(
+        McpMethod::TasksResult,
+        [tasks](const McpRequest& request) -> fastmcpp::Json
+        {
+            std::string task_id = request.params.value("taskId", "");
+            if (task_id.empty())
+                return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Missing taskId");
+
+            auto q = tasks->get_result(task_id);
+            if (q.state == TaskRegistry::ResultState::NotFound)
+                return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Invalid taskId");
+            if (q.state == TaskRegistry::ResultState::NotReady)
+                return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Task not completed");
+            if (q.state == TaskRegistry::ResultState::Cancelled)
+                return jsonrpc_error(request.id, kJsonRpcInternalError,
+                                     q.error_message.empty() ? "Task cancelled" : q.error_message);
+            if (q.state == TaskRegistry::ResultState::Failed)
+                return jsonrpc_error(request.id, kJsonRpcInternalError,
+                                     q.error_message.empty() ? "Task failed" : q.error_message);
+
+            return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", request.id}, {"result", q.payload}};
+        });
+
+    dispatcher.on(McpMethod::TasksList,
+                  [tasks](const McpRequest& request) -> fastmcpp::Json
+                  {
+                      fastmcpp::Json tasks_array = fastmcpp::Json::array();
+                      for (const auto& t : tasks->list_tasks())
+                      {
+                          fastmcpp::Json t_json = {{"taskId", t.task_id},
+                                                   {"status", mcp_status_from_internal(t.status)}};
+                          if (!t.created_at.empty())
+                              t_json["createdAt"] = t.created_at;
+                          if (!t.last_updated_at.empty())
+                              t_json["lastUpdatedAt"] = t.last_updated_at;
+                          t_json["ttl"] = t.ttl_ms;
+                          t_json["pollInterval"] = 1000;
+                          if (!t.status_message.empty())
+                              t_json["statusMessage"] = t.status_message;
+                          tasks_array.push_back(t_json);
+                      }
+
+                      fastmcpp::Json result = {{"tasks", tasks_array}, {"nextCursor", nullptr}};
+                      return fastmcpp::Json{
+                          {"jsonrpc", "2.0"},
+                          {"id", request.id},
+                          {"result", result},
+                      };
+                  });
+
+    dispatcher.on(McpMethod::TasksCancel,
+                  [tasks](const McpRequest& request) -> fastmcpp::Json
+                  {
+                      std::string task_id = request.params.value("taskId", "");
+                      if (task_id.empty())
+                          return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Missing taskId");
+
+                      if (!tasks->cancel(task_id))
+                          return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Invalid taskId");
+
+                      auto info = tasks->get_task(task_id);
+                      if (!info)
+                          return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Invalid taskId");
+
+                      fastmcpp::Json result = {
+                          {"taskId", info->task_id},
+                          {"status", mcp_status_from_internal(info->status)},
+                      };
+                      if (!info->created_at.empty())
+                          result["createdAt"] = info->created_at;
+                      if (!info->last_updated_at.empty())
+                          result["lastUpdatedAt"] = info->last_updated_at;
+                      result["ttl"] = info->ttl_ms;
+                      result["pollInterval"] = 1000;
+                      if (!info->status_message.empty())
+                          result["statusMessage"] = info->status_message;
+
+                      return fastmcpp::Json{
+                          {"jsonrpc", "2.0"},
+                          {"id", request.id},
+                          {"result", result},
+                      };
+                  });
+
+    // Resources
+    dispatcher.on(
+        McpMethod::ResourcesList,
+        [&app, lists](const McpRequest& request)
+        {
+            return catalog_list_page(request, app, *lists, CatalogListCache::Kind::Resources,
+                                     "resources");
+        });
+
+    dispatcher.on(
+        McpMethod::ResourcesTemplatesList,
+        [&app, lists](const McpRequest& request)
+        {
+            return catalog_list_page(request, app, *lists, CatalogListCache::Kind::Templates,
+                                     "resourceTemplates");
+        });
 
-            if (method == "tasks/list")
+    dispatcher.on(
+        McpMethod::ResourcesRead,
+        [&app, tasks](const McpRequest& request) -> fastmcpp::Json
+        {
+            std::string uri = request.params.value("uri", "");
+            if (uri.empty())
+                return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Missing resource URI");
+            while (!uri.empty() && uri.back() == '/')
+                uri.pop_back();
+            auto span = request_span(request, "resource " + uri, app.name(), "resource", uri);
+            try
             {
-                fastmcpp::Json tasks_array = fastmcpp::Json::array();
-                for (const auto& t : tasks->list_tasks())
+                int ttl_ms = 60000;
+                bool as_task = extract_task_ttl(request.params, ttl_ms);
+
+                auto support = find_resource_task_support(app, uri);
+                if (support)
                 {
-                    fastmcpp::Json t_json = {{"taskId", t.task_id},
-                                             {"status", mcp_status_from_internal(t.status)}};
-                    if (!t.created_at.empty())
-                        t_json["createdAt"] = t.created_at;
-                    if (!t.last_updated_at.empty())
-                        t_json["lastUpdatedAt"] = t.last_updated_at;
-                    t_json["ttl"] = t.ttl_ms;
-                    t_json["pollInterval"] = 1000;
-                    if (!t.status_message.empty())
-                        t_json["statusMessage"] = t.status_message;
-                    tasks_array.push_back(t_json);
+                    if (as_task && *support == fastmcpp::TaskSupport::Forbidden)
+                        return jsonrpc_error(request.id, kJsonRpcMethodNotFound,
+                                             "Task execution forbidden for resource: " + uri);
+                    if (!as_task && *support == fastmcpp::TaskSupport::Required)
+                        return jsonrpc_error(request.id, kJsonRpcMethodNotFound,
+                                             "Task execution required for resource: " + uri);
                 }
 
-                fastmcpp::Json result = {{"tasks", tasks_array}, {"nextCursor", nullptr}};
-                return fastmcpp::Json{
-                    {"jsonrpc", "2.0"},
-                    {"id", id},
-                    {"result", result},
-                };
-            }
+                if (as_task)
+                {
+                    auto created = tasks->create_task("resource", uri, ttl_ms,
+                                                      extract_session_id(request.params));
+                    std::string task_id = created.task_id;
 
-            if (method == "tasks/cancel")
-            {
-                std::string task_id = params.value("taskId", "");
-                if (task_id.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing taskId");
+                    fastmcpp::Json params_for_task = request.params;
+                    if (params_for_task.contains("_meta") && params_for_task["_meta"].is_object())
+                        params_for_task["_meta"].erase("modelcontextprotocol.io/task");
 
-                if (!tasks->cancel(task_id))
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Invalid taskId");
+                    tasks->enqueue_task(
+                        task_id, extract_task_priority(request.params),
+                        [&app, uri, params_for_task]() mutable -> fastmcpp::Json
+                        {
+                            auto content_json =
+                                resources::content_to_json(app.read_resource(uri, params_for_task));
+                            attach_resource_content_meta_ui(content_json, app, uri);
+
+                            return fastmcpp::Json{
+                                {"contents", fastmcpp::Json::array({std::move(content_json)})}};
+                        });
+
+                    fastmcpp::Json task_meta = {
+                        {"taskId", task_id},
+                        {"status", "working"},
+                        {"ttl", ttl_ms},
+                        {"createdAt", created.created_at},
+                        {"lastUpdatedAt", created.created_at},
+                    };
 
-                auto info = tasks->get_task(task_id);
-                if (!info)
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Invalid taskId");
+                    fastmcpp::Json response_result = {
+                        {"contents", fastmcpp::Json::array()},
+                        {"_meta",
+                         fastmcpp::Json{
+                             {"modelcontextprotocol.io/task", task_meta},
+                         }},
+                    };
 
-                fastmcpp::Json result = {
-                    {"taskId", info->task_id},
-                    {"status", mcp_status_from_internal(info->status)},
-                };
-                if (!info->created_at.empty())
-                    result["createdAt"] = info->created_at;
-                if (!info->last_updated_at.empty())
-                    result["lastUpdatedAt"] = info->last_updated_at;
-                result["ttl"] = info->ttl_ms;
-                result["pollInterval"] = 1000;
-                if (!info->status_message.empty())
-                    result["statusMessage"] = info->status_message;
+                    return fastmcpp::Json{
+                        {"jsonrpc", "2.0"}, {"id", request.id}, {"result", response_result}};
+                }
+
+                auto content_json =
+                    resources::content_to_json(app.read_resource(uri, request.params));
+                attach_resource_content_meta_ui(content_json, app, uri);
+
+                fastmcpp::Json result_payload =
+                    fastmcpp::Json{{"contents", fastmcpp::Json::array({std::move(content_json)})}};
 
                 return fastmcpp::Json{
-                    {"jsonrpc", "2.0"},
-                    {"id", id},
-                    {"result", result},
-                };
+                    {"jsonrpc", "2.0"}, {"id", request.id}, {"result", result_payload}};
             }
-
-            // Resources
-            if (method == "resources/list")
+            catch (const NotFoundError& e)
             {
-                fastmcpp::Json resources_array = fastmcpp::Json::array();
-                for (const auto& res : app.list_all_resources())
-                {
-                    fastmcpp::Json res_json = {{"uri", res.uri}, {"name", res.name}};
-                    if (res.version)
-                        res_json["version"] = *res.version;
-                    if (res.description)
-                        res_json["description"] = *res.description;
-                    if (res.mime_type)
-                        res_json["mimeType"] = *res.mime_type;
-                    if (res.title)
-                        res_json["title"] = *res.title;
-                    if (res.annotations)
-                        res_json["annotations"] = *res.annotations;
-                    if (res.icons)
-                    {
-                        fastmcpp::Json icons_json = fastmcpp::Json::array();
-                        for (const auto& icon : *res.icons)
-                        {
-                            fastmcpp::Json icon_obj = {{"src", icon.src}};
-                            if (icon.mime_type)
-                                icon_obj["mimeType"] = *icon.mime_type;
-                            if (icon.sizes)
-                                icon_obj["sizes"] = *icon.sizes;
-                            icons_json.push_back(icon_obj);
-                        }
-                        res_json["icons"] = icons_json;
-                    }
-                    attach_meta_ui(res_json, res.app);
-                    res_json["fastmcp"] = make_fastmcp_meta();
-                    resources_array.push_back(res_json);
-                }
-                return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                      {"id", id},
-                                      {"result", apply_pagination(resources_array, "resources",
-                                                                  params, app.list_page_size())}};
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_error(request.id, kMcpResourceNotFound, e.what());
             }
-
-            if (method == "resources/templates/list")
+            catch (const std::exception& e)
             {
-                fastmcpp::Json templates_array = fastmcpp::Json::array();
-                for (const auto& templ : app.list_all_templates())
-                {
-                    fastmcpp::Json templ_json = {{"uriTemplate", templ.uri_template},
-                                                 {"name", templ.name}};
-                    if (templ.description)
-                        templ_json["description"] = *templ.description;
-                    if (templ.mime_type)
-                        templ_json["mimeType"] = *templ.mime_type;
-                    if (templ.title)
-                        templ_json["title"] = *templ.title;
-                    if (templ.annotations)
-                        templ_json["annotations"] = *templ.annotations;
-                    if (templ.icons)
-                    {
-                        fastmcpp::Json icons_json = fastmcpp::Json::array();
-                        for (const auto& icon : *templ.icons)
-                        {
-                            fastmcpp::Json icon_obj = {{"src", icon.src}};
-                            if (icon.mime_type)
-                                icon_obj["mimeType"] = *icon.mime_type;
-                            if (icon.sizes)
-                                icon_obj["sizes"] = *icon.sizes;
-                            icons_json.push_back(icon_obj);
-                        }
-                        templ_json["icons"] = icons_json;
-                    }
-                    attach_meta_ui(templ_json, templ.app);
-                    templ_json["parameters"] =
-                        templ.parameters.is_null() ? fastmcpp::Json::object() : templ.parameters;
-                    templates_array.push_back(templ_json);
-                }
-                return fastmcpp::Json{
-                    {"jsonrpc", "2.0"},
-                    {"id", id},
-                    {"result", apply_pagination(templates_array, "resourceTemplates", params,
-                                                app.list_page_size())}};
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_tool_error(request.id, e);
             }
+        });
 
-            if (method == "resources/read")
+    // Prompts
+    dispatcher.on(
+        McpMethod::PromptsList,
+        [&app, lists](const McpRequest& request)
+        {
+            return catalog_list_page(request, app, *lists, CatalogListCache::Kind::Prompts,
+                                     "prompts");
+        });
+
+    dispatcher.on(
+        McpMethod::PromptsGet,
+        [&app, tasks](const McpRequest& request) -> fastmcpp::Json
+        {
+            std::string name = request.params.value("name", "");
+            if (name.empty())
+                return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Missing prompt name");
+            auto span = request_span(request, "prompt " + name, app.name(), "prompt", name);
+            try
             {
-                std::string uri = params.value("uri", "");
-                if (uri.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing resource URI");
-                while (!uri.empty() && uri.back() == '/')
-                    uri.pop_back();
-                auto span = telemetry::server_span(
-                    "resource " + uri, "resources/read", app.name(), "resource", uri,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
+                int ttl_ms = 60000;
+                bool as_task = extract_task_ttl(request.params, ttl_ms);
+
+                auto support = find_prompt_task_support(app, name);
+                if (support)
                 {
-                    int ttl_ms = 60000;
-                    bool as_task = extract_task_ttl(params, ttl_ms);
+                    if (as_task && *support == fastmcpp::TaskSupport::Forbidden)
+                        return jsonrpc_error(request.id, kJsonRpcMethodNotFound,
+                                             "Task execution forbidden for prompt: " + name);
+                    if (!as_task && *support == fastmcpp::TaskSupport::Required)
+                        return jsonrpc_error(request.id, kJsonRpcMethodNotFound,
+                                             "Task execution required for prompt: " + name);
+                }
 
-                    auto support = find_resource_task_support(app, uri);
-                    if (support)
-                    {
-                        if (as_task && *support == fastmcpp::TaskSupport::Forbidden)
-                            return jsonrpc_error(id, kJsonRpcMethodNotFound,
-                                                 "Task execution forbidden for resource: " + uri);
-                        if (!as_task && *support == fastmcpp::TaskSupport::Required)
-                            return jsonrpc_error(id, kJsonRpcMethodNotFound,
-                                                 "Task execution required for resource: " + uri);
-                    }
+                if (as_task)
+                {
+                    auto created = tasks->create_task("prompt", name, ttl_ms,
+                                                      extract_session_id(request.params));
+                    std::string task_id = created.task_id;
 
-                    if (as_task)
-                    {
-                        auto created =
-                            tasks->create_task("resource", uri, ttl_ms, extract_session_id(params));
-                        std::string task_id = created.task_id;
-
-                        fastmcpp::Json params_for_task = params;
-                        if (params_for_task.contains("_meta") &&
-                            params_for_task["_meta"].is_object())
-                            params_for_task["_meta"].erase("modelcontextprotocol.io/task");
-
-                        tasks->enqueue_task(
-                            task_id,
-                            [&app, uri, params_for_task]() mutable -> fastmcpp::Json
+                    fastmcpp::Json args_for_task =
+                        request.params.value("arguments", fastmcpp::Json::object());
+                    tasks->enqueue_task(
+                        task_id, extract_task_priority(request.params),
+                        [&app, name, args_for_task]() -> fastmcpp::Json
+                        {
+                            auto prompt_result = app.get_prompt_result(name, args_for_task);
+                            fastmcpp::Json messages_array = fastmcpp::Json::array();
+                            for (const auto& msg : prompt_result.messages)
                             {
-                                auto content = app.read_resource(uri, params_for_task);
-                                fastmcpp::Json content_json = {{"uri", content.uri}};
-                                if (content.mime_type)
-                                    content_json["mimeType"] = *content.mime_type;
-
-                                if (std::holds_alternative<std::string>(content.data))
-                                {
-                                    content_json["text"] = std::get<std::string>(content.data);
-                                }
-                                else
-                                {
-                                    const auto& binary =
-                                        std::get<std::vector<uint8_t>>(content.data);
-                                    static const char* b64_chars =
-                                        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz012345"
-                                        "6789+/";
-                                    std::string b64;
-                                    b64.reserve((binary.size() + 2) / 3 * 4);
-                                    for (size_t i = 0; i < binary.size(); i += 3)
-                                    {
-                                        uint32_t n = binary[i] << 16;
-                                        if (i + 1 < binary.size())
-                                            n |= binary[i + 1] << 8;
-                                        if (i + 2 < binary.size())
-                                            n |= binary[i + 2];
-                                        b64.push_back(b64_chars[(n >> 18) & 0x3F]);
-                                        b64.push_back(b64_chars[(n >> 12) & 0x3F]);
-                                        b64.push_back((i + 1 < binary.size())
-                                                          ? b64_chars[(n >> 6) & 0x3F]
-                                                          : '=');
-                                        b64.push_back((i + 2 < binary.size()) ? b64_chars[n & 0x3F]
-                                                                              : '=');
-                                    }
-                                    content_json["blob"] = b64;
-                                }
-                                attach_resource_content_meta_ui(content_json, app, uri);
-
-                                return fastmcpp::Json{
-                                    {"contents", fastmcpp::Json::array({content_json})}};
-                            });
-
-                        fastmcpp::Json task_meta = {
-                            {"taskId", task_id},
-                            {"status", "working"},
-                            {"ttl", ttl_ms},
-                            {"createdAt", created.created_at},
-                            {"lastUpdatedAt", created.created_at},
-                        };
-
-                        fastmcpp::Json response_result = {
-                            {"contents", fastmcpp::Json::array()},
-                            {"_meta",
-                             fastmcpp::Json{
-                                 {"modelcontextprotocol.io/task", task_meta},
-                             }},
-                        };
-
-                        return fastmcpp::Json{
-                            {"jsonrpc", "2.0"}, {"id", id}, {"result", response_result}};
-                    }
-
-                    auto content = app.read_resource(uri, params);
-                    fastmcpp::Json content_json = {{"uri", content.uri}};
-                    if (content.mime_type)
-                        content_json["mimeType"] = *content.mime_type;
+                                messages_array.push_back(
+                                    {{"role", msg.role},
+                                     {"content",
+                                      fastmcpp::Json{{"type", "text"}, {"text", msg.content}}}});
+                            }
 
-                    if (std::holds_alternative<std::string>(content.data))
-                    {
-                        content_json["text"] = std::get<std::string>(content.data);
-                    }
-                    else
-                    {
-                        const auto& binary = std::get<std::vector<uint8_t>>(content.data);
-                        static const char* b64_chars =
-                            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-                        std::string b64;
-                        b64.reserve((binary.size() + 2) / 3 * 4);
-                        for (size_t i = 0; i < binary.size(); i += 3)
-                        {
-                            uint32_t n = binary[i] << 16;
-                            if (i + 1 < binary.size())
-                                n |= binary[i + 1] << 8;
-                            if (i + 2 < binary.size())
-                                n |= binary[i + 2];
-                            b64.push_back(b64_chars[(n >> 18) & 0x3F]);
-                            b64.push_back(b64_chars[(n >> 12) & 0x3F]);
-                            b64.push_back((i + 1 < binary.size()) ? b64_chars[(n >> 6) & 0x3F]
-                                                                  : '=');
-                            b64.push_back((i + 2 < binary.size()) ? b64_chars[n & 0x3F] : '=');
-                        }
-                        content_json["blob"] = b64;
-                    }
-                    attach_resource_content_meta_ui(content_json, app, uri);
+                            fastmcpp::Json result_payload = {{"messages", messages_array}};
+                            if (prompt_result.description)
+                                result_payload["description"] = *prompt_result.description;
+                            if (prompt_result.meta)
+                                result_payload["_meta"] = *prompt_result.meta;
+                            return result_payload;
+                        });
+
+                    fastmcpp::Json task_meta = {
+                        {"taskId", task_id},
+                        {"status", "working"},
+                        {"ttl", ttl_ms},
+                        {"createdAt", created.created_at},
+                        {"lastUpdatedAt", created.created_at},
+                    };
 
-                    fastmcpp::Json result_payload =
-                        fastmcpp::Json{{"contents", fastmcpp::Json::array({content_json})}};
+                    fastmcpp::Json response_result = {
+                        {"messages", fastmcpp::Json::array()},
+                        {"_meta",
+                         fastmcpp::Json{
+                             {"modelcontextprotocol.io/task", task_meta},
+                         }},
+                    };
 
                     return fastmcpp::Json{
-                        {"jsonrpc", "2.0"}, {"id", id}, {"result", result_payload}};
+                        {"jsonrpc", "2.0"}, {"id", request.id}, {"result", response_result}};
                 }
-                catch (const NotFoundError& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_error(id, kMcpResourceNotFound, e.what());
-                }
-                catch (const std::exception& e)
+
+                fastmcpp::Json args = request.params.value("arguments", fastmcpp::Json::object());
+                auto prompt_result = app.get_prompt_result(name, args);
+
+                fastmcpp::Json messages_array = fastmcpp::Json::array();
+                for (const auto& msg : prompt_result.messages)
                 {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_tool_error(id, e);
+                    messages_array.push_back(
+                        {{"role", msg.role},
+                         {"content", fastmcpp::Json{{"type", "text"}, {"text", msg.content}}}});
                 }
-            }
 
-            // Prompts
-            if (method == "prompts/list")
+                fastmcpp::Json result_payload = {{"messages", messages_array}};
+                if (prompt_result.description)
+                    result_payload["description"] = *prompt_result.description;
+                if (prompt_result.meta)
+                    result_payload["_meta"] = *prompt_result.meta;
+
+                return fastmcpp::Json{
+                    {"jsonrpc", "2.0"}, {"id", request.id}, {"result", result_payload}};
+            }
+            catch (const NotFoundError& e)
             {
-                fastmcpp::Json prompts_array = fastmcpp::Json::array();
-                for (const auto& [name, prompt] : app.list_all_prompts())
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_error(request.id, kMcpMethodNotFound, e.what());
+            }
+            catch (const std::exception& e)
+            {
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_tool_error(request.id, e);
+            }
+        });
+
+    return into_handler(std::move(dispatcher));
+}
+
+// ProxyApp handler - supports proxying to backend server
+std::function<fastmcpp::Json(const fastmcpp::Json&)> make_mcp_handler(const ProxyApp& app)
+{
+    McpDispatcher dispatcher;
+
+    dispatcher.on(
+        McpMethod::Initialize,
+        [&app](const McpRequest& request) -> fastmcpp::Json
+        {
+            fastmcpp::Json serverInfo = {{"name", app.name()}, {"version", app.version()}};
+
+            // Advertise capabilities
+            fastmcpp::Json capabilities = {{"tools", fastmcpp::Json::object()}};
+            if (!app.list_all_resources().empty() || !app.list_all_resource_templates().empty())
+                capabilities["resources"] = fastmcpp::Json::object();
+            if (!app.list_all_prompts().empty())
+                capabilities["prompts"] = fastmcpp::Json::object();
+            advertise_ui_extension(capabilities);
+            // Note: ProxyApp does not propagate experimental_capabilities (that field is
+            // FastMCP-only); skip advertise_experimental here intentionally.
+
+            fastmcpp::Json result_obj = {{"protocolVersion", "2024-11-05"},
+                                         {"capabilities", capabilities},
+                                         {"serverInfo", serverInfo}};
+            if (app.instructions().has_value())
+                result_obj["instructions"] = *app.instructions();
+            return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", request.id}, {"result", result_obj}};
+        });
+
+    // Tools
+    dispatcher.on(
+        McpMethod::ToolsList,
+        [&app](const McpRequest& request) -> fastmcpp::Json
+        {
+            fastmcpp::Json tools_array = fastmcpp::Json::array();
+            for (const auto& tool : app.list_all_tools())
+            {
+                fastmcpp::Json tool_json = {{"name", tool.name}, {"inputSchema", tool.inputSchema}};
+                if (tool.version)
+                    tool_json["version"] = *tool.version;
+                if (tool.description)
+                    tool_json["description"] = *tool.description;
+                if (tool.title)
+                    tool_json["title"] = *tool.title;
+                if (tool.outputSchema)
+                    tool_json["outputSchema"] = *tool.outputSchema;
+                if (tool.execution)
+                    tool_json["execution"] = *tool.execution;
+                if (tool.icons)
                 {
-                    fastmcpp::Json prompt_json = {{"name", name}};
-                    if (prompt)
+                    fastmcpp::Json icons_array = fastmcpp::Json::array();
+                    for (const auto& icon : *tool.icons)
                     {
-                        if (prompt->version)
-                            prompt_json["version"] = *prompt->version;
-                        if (prompt->description)
-                            prompt_json["description"] = *prompt->description;
-                        if (!prompt->arguments.empty())
-                        {
-                            fastmcpp::Json args_array = fastmcpp::Json::array();
-                            for (const auto& arg : prompt->arguments)
-                            {
-                                fastmcpp::Json arg_json = {{"name", arg.name},
-                                                           {"required", arg.required}};
-                                if (arg.description)
-                                    arg_json["description"] = *arg.description;
-                                args_array.push_back(arg_json);
-                            }
-                            prompt_json["arguments"] = args_array;
-                        }
+                        fastmcpp::Json icon_json;
+                        to_json(icon_json, icon);
+                        icons_array.push_back(icon_json);
                     }
-                    prompt_json["fastmcp"] = make_fastmcp_meta();
-                    prompts_array.push_back(prompt_json);
+                    tool_json["icons"] = icons_array;
                 }
-                return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                      {"id", id},
-                                      {"result", apply_pagination(prompts_array, "prompts", params,
-                                                                  app.list_page_size())}};
+                attach_meta_ui(tool_json, tool.app, tool._meta);
+                tools_array.push_back(tool_json);
             }
+            return fastmcpp::Json{{"jsonrpc", "2.0"},
+                                  {"id", request.id},
+                                  {"result", fastmcpp::Json{{"tools", tools_array}}}};
+        });
 
-            if (method == "prompts/get")
+    dispatcher.on(
+        McpMethod::ToolsCall,
+        [&app](const McpRequest& request) -> fastmcpp::Json
+        {
+            std::string name = request.params.value("name", "");
+            fastmcpp::Json arguments = request.params.value("arguments", fastmcpp::Json::object());
+            if (name.empty())
+                return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Missing tool name");
+            auto span = request_span(request, "tool " + name, app.name(), "tool", name);
+            try
             {
-                std::string name = params.value("name", "");
-                if (name.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing prompt name");
-                auto span = telemetry::server_span(
-                    "prompt " + name, "prompts/get", app.name(), "prompt", name,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
-                {
-                    int ttl_ms = 60000;
-                    bool as_task = extract_task_ttl(params, ttl_ms);
+                auto result = app.invoke_tool(name, arguments);
 
-                    auto support = find_prompt_task_support(app, name);
-                    if (support)
+                // Convert result to JSON-RPC response
+                fastmcpp::Json content_array = fastmcpp::Json::array();
+                for (const auto& content : result.content)
+                {
+                    if (auto* text = std::get_if<client::TextContent>(&content))
                     {
-                        if (as_task && *support == fastmcpp::TaskSupport::Forbidden)
-                            return jsonrpc_error(id, kJsonRpcMethodNotFound,
-                                                 "Task execution forbidden for prompt: " + name);
-                        if (!as_task && *support == fastmcpp::TaskSupport::Required)
-                            return jsonrpc_error(id, kJsonRpcMethodNotFound,
-                                                 "Task execution required for prompt: " + name);
+                        content_array.push_back({{"type", "text"}, {"text", text->text}});
                     }
-
-                    if (as_task)
+                    else if (auto* img = std::get_if<client::ImageContent>(&content))
                     {
-                        auto created =
-                            tasks->create_task("prompt", name, ttl_ms, extract_session_id(params));
-                        std::string task_id = created.task_id;
-
-                        fastmcpp::Json args_for_task =
-                            params.value("arguments", fastmcpp::Json::object());
-                        tasks->enqueue_task(
-                            task_id,
-                            [&app, name, args_for_task]() -> fastmcpp::Json
-                            {
-                                auto prompt_result = app.get_prompt_result(name, args_for_task);
-                                fastmcpp::Json messages_array = fastmcpp::Json::array();
-                                for (const auto& msg : prompt_result.messages)
-                                {
-                                    messages_array.push_back(
-                                        {{"role", msg.role},
-                                         {"content", fastmcpp::Json{{"type", "text"},
-                                                                    {"text", msg.content}}}});
-                                }
-
-                                fastmcpp::Json result_payload = {{"messages", messages_array}};
-                                if (prompt_result.description)
-                                    result_payload["description"] = *prompt_result.description;
-                                if (prompt_result.meta)
-                                    result_payload["_meta"] = *prompt_result.meta;
-                                return result_payload;
-                            });
-
-                        fastmcpp::Json task_meta = {
-                            {"taskId", task_id},
-                            {"status", "working"},
-                            {"ttl", ttl_ms},
-                            {"createdAt", created.created_at},
-                            {"lastUpdatedAt", created.created_at},
-                        };
-
-                        fastmcpp::Json response_result = {
-                            {"messages", fastmcpp::Json::array()},
-                            {"_meta",
-                             fastmcpp::Json{
-                                 {"modelcontextprotocol.io/task", task_meta},
-                             }},
-                        };
-
-                        return fastmcpp::Json{
-                            {"jsonrpc", "2.0"}, {"id", id}, {"result", response_result}};
+                        fastmcpp::Json img_json = {
+                            {"type", "image"}, {"data", img->data}, {"mimeType", img->mimeType}};
+                        content_array.push_back(img_json);
                     }
-
-                    fastmcpp::Json args = params.value("arguments", fastmcpp::Json::object());
-                    auto prompt_result = app.get_prompt_result(name, args);
-
-                    fastmcpp::Json messages_array = fastmcpp::Json::array();
-                    for (const auto& msg : prompt_result.messages)
+                    else if (auto* res = std::get_if<client::EmbeddedResourceContent>(&content))
                     {
-                        messages_array.push_back(
-                            {{"role", msg.role},
-                             {"content", fastmcpp::Json{{"type", "text"}, {"text", msg.content}}}});
+                        fastmcpp::Json res_json = {{"type", "resource"}, {"uri", res->uri}};
+                        if (!res->text.empty())
+                            res_json["text"] = res->text;
+                        if (res->blob)
+                            res_json["blob"] = *res->blob;
+                        if (res->mimeType)
+                            res_json["mimeType"] = *res->mimeType;
+                        content_array.push_back(res_json);
                     }
+                }
 
-                    fastmcpp::Json result_payload = {{"messages", messages_array}};
-                    if (prompt_result.description)
-                        result_payload["description"] = *prompt_result.description;
-                    if (prompt_result.meta)
-                        result_payload["_meta"] = *prompt_result.meta;
+                fastmcpp::Json response_result = {{"content", content_array}};
+                if (result.isError)
+                    response_result["isError"] = true;
+                if (result.structuredContent)
+                    response_result["structuredContent"] = *result.structuredContent;
 
-                    return fastmcpp::Json{
-                        {"jsonrpc", "2.0"}, {"id", id}, {"result", result_payload}};
-                }
-                catch (const NotFoundError& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_error(id, kMcpMethodNotFound, e.what());
-                }
-                catch (const std::exception& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_tool_error(id, e);
-                }
+                return fastmcpp::Json{
+                    {"jsonrpc", "2.0"}, {"id", request.id}, {"result", response_result}};
             }
-
-            return jsonrpc_error(id, kJsonRpcMethodNotFound,
-                                 std::string("Method '") + method + "' not found");
-        }
-        catch (const std::exception& e)
+            catch (const NotFoundError& e)
+            {
+                return jsonrpc_error(request.id, kJsonRpcInvalidParams, e.what());
+            }
+            catch (const std::exception& e)
+            {
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_error(request.id, kJsonRpcInternalError, e.what());
+            }
+        });
+
+    // Resources
+    dispatcher.on(McpMethod::ResourcesList,
+                  [&app](const McpRequest& request) -> fastmcpp::Json
+                  {
+                      fastmcpp::Json resources_array = fastmcpp::Json::array();
+                      for (const auto& res : app.list_all_resources())
+                      {
+                          fastmcpp::Json res_json = {{"uri", res.uri}, {"name", res.name}};
+                          if (res.version)
+                              res_json["version"] = *res.version;
+                          if (res.description)
+                              res_json["description"] = *res.description;
+                          if (res.mimeType)
+                              res_json["mimeType"] = *res.mimeType;
+                          if (res.title)
+                              res_json["title"] = *res.title;
+                          if (res.annotations)
+                              res_json["annotations"] = *res.annotations;
+                          if (res.icons && !res.icons->empty())
+                          {
+                              fastmcpp::Json icons_json = fastmcpp::Json::array();
+                              for (const auto& icon : *res.icons)
+                              {
+                                  fastmcpp::Json icon_obj = {{"src", icon.src}};
+                                  if (icon.mime_type)
+                                      icon_obj["mimeType"] = *icon.mime_type;
+                                  if (icon.sizes)
+                                      icon_obj["sizes"] = *icon.sizes;
+                                  icons_json.push_back(icon_obj);
+                              }
+                              res_json["icons"] = icons_json;
+                          }
+                          attach_meta_ui(res_json, res.app, res._meta);
+                          res_json["fastmcp"] = make_fastmcp_meta();
+                          resources_array.push_back(res_json);
+                      }
+                      return fastmcpp::Json{
+                          {"jsonrpc", "2.0"},
+                          {"id", request.id},
+                          {"result", fastmcpp::Json{{"resources", resources_array}}}};
+                  });
+
+    dispatcher.on(
+        McpMethod::ResourcesTemplatesList,
+        [&app](const McpRequest& request) -> fastmcpp::Json
         {
-            return jsonrpc_error(message.value("id", fastmcpp::Json()), kJsonRpcInternalError,
-                                 e.what());
-        }
-    };
-}
-
-// ProxyApp handler - supports proxying to backend server
-std::function<fastmcpp::Json(const fastmcpp::Json&)> make_mcp_handler(const ProxyApp& app)
-{
-    return [&app](const fastmcpp::Json& message) -> fastmcpp::Json
-    {
-        try
+            fastmcpp::Json templates_array = fastmcpp::Json::array();
+            for (const auto& templ : app.list_all_resource_templates())
+            {
+                fastmcpp::Json templ_json = {{"uriTemplate", templ.uriTemplate},
+                                             {"name", templ.name}};
+                if (templ.description)
+                    templ_json["description"] = *templ.description;
+                if (templ.mimeType)
+                    templ_json["mimeType"] = *templ.mimeType;
+                if (templ.title)
+                    templ_json["title"] = *templ.title;
+                if (templ.annotations)
+                    templ_json["annotations"] = *templ.annotations;
+                if (templ.icons && !templ.icons->empty())
+                {
+                    fastmcpp::Json icons_json = fastmcpp::Json::array();
+                    for (const auto& icon : *templ.icons)
+                    {
+                        fastmcpp::Json icon_obj = {{"src", icon.src}};
+                        if (icon.mime_type)
+                            icon_obj["mimeType"] = *icon.mime_type;
+                        if (icon.sizes)
+                            icon_obj["sizes"] = *icon.sizes;
+                        icons_json.push_back(icon_obj);
+                    }
+                    templ_json["icons"] = icons_json;
+                }
+                attach_meta_ui(templ_json, templ.app, templ._meta);
+                if (templ.parameters)
+                    templ_json["parameters"] = *templ.parameters;
+                else
+                    templ_json["parameters"] = fastmcpp::Json::object();
+                templates_array.push_back(templ_json);
+            }
+            return fastmcpp::Json{
+                {"jsonrpc", "2.0"},
+                {"id", request.id},
+                {"result", fastmcpp::Json{{"resourceTemplates", templates_array}}}};
+        });
+
+    dispatcher.on(
+        McpMethod::ResourcesRead,
+        [&app](const McpRequest& request) -> fastmcpp::Json
         {
-            const auto id = message.contains("id") ? message.at("id") : fastmcpp::Json();
-            std::string method = message.value("method", "");
-            fastmcpp::Json params = message.value("params", fastmcpp::Json::object());
-            const std::string session_id = extract_session_id(params);
+            std::string uri = request.params.value("uri", "");
+            if (uri.empty())
+                return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Missing resource URI");
+            auto span = request_span(request, "resource " + uri, app.name(), "resource", uri);
+            try
+            {
+                auto result = app.read_resource(uri);
+
+                fastmcpp::Json contents_array = fastmcpp::Json::array();
+                for (auto& content : result.contents)
+                {
+                    if (auto* text_content = std::get_if<client::TextResourceContent>(&content))
+                    {
+                        fastmcpp::Json content_json = {{"uri", text_content->uri}};
+                        if (text_content->mimeType)
+                            content_json["mimeType"] = *text_content->mimeType;
+                        content_json["text"] = std::move(text_content->text);
+                        if (text_content->_meta)
+                            content_json["_meta"] = *text_content->_meta;
+                        contents_array.push_back(std::move(content_json));
+                    }
+                    else if (auto* blob_content =
+                                 std::get_if<client::BlobResourceContent>(&content))
+                    {
+                        fastmcpp::Json content_json = {{"uri", blob_content->uri}};
+                        if (blob_content->mimeType)
+                            content_json["mimeType"] = *blob_content->mimeType;
+                        content_json["blob"] = std::move(blob_content->blob);
+                        if (blob_content->_meta)
+                            content_json["_meta"] = *blob_content->_meta;
+                        contents_array.push_back(std::move(content_json));
+                    }
+                }
 
-            if (method == "initialize")
+                return fastmcpp::Json{{"jsonrpc", "2.0"},
+                                      {"id", request.id},
+                                      {"result", fastmcpp::Json{{"contents", contents_array}}}};
+            }
+            catch (const NotFoundError& e)
             {
-                fastmcpp::Json serverInfo = {{"name", app.name()}, {"version", app.version()}};
-
-                // Advertise capabilities
-                fastmcpp::Json capabilities = {{"tools", fastmcpp::Json::object()}};
-                if (!app.list_all_resources().empty() || !app.list_all_resource_templates().empty())
-                    capabilities["resources"] = fastmcpp::Json::object();
-                if (!app.list_all_prompts().empty())
-                    capabilities["prompts"] = fastmcpp::Json::object();
-                advertise_ui_extension(capabilities);
-                // Note: ProxyApp does not propagate experimental_capabilities (that field is
-                // FastMCP-only); skip advertise_experimental here intentionally.
-
-                fastmcpp::Json result_obj = {{"protocolVersion", "2024-11-05"},
-                                             {"capabilities", capabilities},
-                                             {"serverInfo", serverInfo}};
-                if (app.instructions().has_value())
-                    result_obj["instructions"] = *app.instructions();
-                return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", result_obj}};
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_error(request.id, kMcpResourceNotFound, e.what());
             }
-
-            if (method == "ping")
+            catch (const std::exception& e)
             {
-                return fastmcpp::Json{
-                    {"jsonrpc", "2.0"}, {"id", id}, {"result", fastmcpp::Json::object()}};
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_error(request.id, kJsonRpcInternalError, e.what());
             }
+        });
 
-            // Tools
-            if (method == "tools/list")
-            {
-                fastmcpp::Json tools_array = fastmcpp::Json::array();
-                for (const auto& tool : app.list_all_tools())
-                {
-                    fastmcpp::Json tool_json = {{"name", tool.name},
-                                                {"inputSchema", tool.inputSchema}};
-                    if (tool.version)
-                        tool_json["version"] = *tool.version;
-                    if (tool.description)
-                        tool_json["description"] = *tool.description;
-                    if (tool.title)
-                        tool_json["title"] = *tool.title;
-                    if (tool.outputSchema)
-                        tool_json["outputSchema"] = *tool.outputSchema;
-                    if (tool.execution)
-                        tool_json["execution"] = *tool.execution;
-                    if (tool.icons)
+    // Prompts
+    dispatcher.on(
+        McpMethod::PromptsList,
+        [&app](const McpRequest& request) -> fastmcpp::Json
+        {
+            fastmcpp::Json prompts_array = fastmcpp::Json::array();
+            for (const auto& prompt : app.list_all_prompts())
+            {
+                fastmcpp::Json prompt_json = {{"name", prompt.name}};
+                if (prompt.version)
+                    prompt_json["version"] = *prompt.version;
+                if (prompt.description)
+                    prompt_json["description"] = *prompt.description;
+                if (prompt.arguments)
+                {
+                    fastmcpp::Json args_array = fastmcpp::Json::array();
+                    for (const auto& arg : *prompt.arguments)
                     {
-                        fastmcpp::Json icons_array = fastmcpp::Json::array();
-                        for (const auto& icon : *tool.icons)
-                        {
-                            fastmcpp::Json icon_json;
-                            to_json(icon_json, icon);
-                            icons_array.push_back(icon_json);
-                        }
-                        tool_json["icons"] = icons_array;
+                        fastmcpp::Json arg_json = {{"name", arg.name}, {"required", arg.required}};
+                        if (arg.description)
+                            arg_json["description"] = *arg.description;
+                        args_array.push_back(arg_json);
                     }
-                    attach_meta_ui(tool_json, tool.app, tool._meta);
-                    tools_array.push_back(tool_json);
+                    prompt_json["arguments"] = args_array;
                 }
-                return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                      {"id", id},
-                                      {"result", fastmcpp::Json{{"tools", tools_array}}}};
+                prompt_json["fastmcp"] = make_fastmcp_meta();
+                prompts_array.push_back(prompt_json);
             }
+            return fastmcpp::Json{{"jsonrpc", "2.0"},
+                                  {"id", request.id},
+                                  {"result", fastmcpp::Json{{"prompts", prompts_array}}}};
+        });
 
-            if (method == "tools/call")
+    dispatcher.on(
+        McpMethod::PromptsGet,
+        [&app](const McpRequest& request) -> fastmcpp::Json
+        {
+            std::string name = request.params.value("name", "");
+            if (name.empty())
+                return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Missing prompt name");
+            auto span = request_span(request, "prompt " + name, app.name(), "prompt", name);
+            try
             {
-                std::string name = params.value("name", "");
-                fastmcpp::Json arguments = params.value("arguments", fastmcpp::Json::object());
-                if (name.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing tool name");
-                auto span = telemetry::server_span(
-                    "tool " + name, "tools/call", app.name(), "tool", name,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
-                {
-                    auto result = app.invoke_tool(name, arguments);
+                fastmcpp::Json args = request.params.value("arguments", fastmcpp::Json::object());
+                auto result = app.get_prompt(name, args);
 
-                    // Convert result to JSON-RPC response
+                fastmcpp::Json messages_array = fastmcpp::Json::array();
+                for (const auto& msg : result.messages)
+                {
                     fastmcpp::Json content_array = fastmcpp::Json::array();
-                    for (const auto& content : result.content)
+                    for (const auto& content : msg.content)
                     {
                         if (auto* text = std::get_if<client::TextContent>(&content))
                         {
@@ -2666,10 +2856,9 @@ std::function<fastmcpp::Json(const fastmcpp::Json&)> make_mcp_handler(const Prox
                         }
                         else if (auto* img = std::get_if<client::ImageContent>(&content))
                         {
-                            fastmcpp::Json img_json = {{"type", "image"},
-                                                       {"data", img->data},
-                                                       {"mimeType", img->mimeType}};
-                            content_array.push_back(img_json);
+                            content_array.push_back({{"type", "image"},
+                                                     {"data", img->data},
+                                                     {"mimeType", img->mimeType}});
                         }
                         else if (auto* res = std::get_if<client::EmbeddedResourceContent>(&content))
                         {
@@ -2678,283 +2867,39 @@ std::function<fastmcpp::Json(const fastmcpp::Json&)> make_mcp_handler(const Prox
                                 res_json["text"] = res->text;
                             if (res->blob)
                                 res_json["blob"] = *res->blob;
-                            if (res->mimeType)
-                                res_json["mimeType"] = *res->mimeType;
                             content_array.push_back(res_json);
                         }
                     }
 
-                    fastmcpp::Json response_result = {{"content", content_array}};
-                    if (result.isError)
-                        response_result["isError"] = true;
-                    if (result.structuredContent)
-                        response_result["structuredContent"] = *result.structuredContent;
-
-                    return fastmcpp::Json{
-                        {"jsonrpc", "2.0"}, {"id", id}, {"result", response_result}};
-                }
-                catch (const NotFoundError& e)
-                {
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, e.what());
-                }
-                catch (const std::exception& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_error(id, kJsonRpcInternalError, e.what());
+                    std::string role_str =
+                        (msg.role == client::Role::Assistant) ? "assistant" : "user";
+                    fastmcpp::Json content_val =
+                        (content_array.size() == 1) ? content_array[0] : content_array;
+                    messages_array.push_back({{"role", role_str}, {"content", content_val}});
                 }
-            }
 
-            // Resources
-            if (method == "resources/list")
-            {
-                fastmcpp::Json resources_array = fastmcpp::Json::array();
-                for (const auto& res : app.list_all_resources())
-                {
-                    fastmcpp::Json res_json = {{"uri", res.uri}, {"name", res.name}};
-                    if (res.version)
-                        res_json["version"] = *res.version;
-                    if (res.description)
-                        res_json["description"] = *res.description;
-                    if (res.mimeType)
-                        res_json["mimeType"] = *res.mimeType;
-                    if (res.title)
-                        res_json["title"] = *res.title;
-                    if (res.annotations)
-                        res_json["annotations"] = *res.annotations;
-                    if (res.icons && !res.icons->empty())
-                    {
-                        fastmcpp::Json icons_json = fastmcpp::Json::array();
-                        for (const auto& icon : *res.icons)
-                        {
-                            fastmcpp::Json icon_obj = {{"src", icon.src}};
-                            if (icon.mime_type)
-                                icon_obj["mimeType"] = *icon.mime_type;
-                            if (icon.sizes)
-                                icon_obj["sizes"] = *icon.sizes;
-                            icons_json.push_back(icon_obj);
-                        }
-                        res_json["icons"] = icons_json;
-                    }
-                    attach_meta_ui(res_json, res.app, res._meta);
-                    res_json["fastmcp"] = make_fastmcp_meta();
-                    resources_array.push_back(res_json);
-                }
-                return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                      {"id", id},
-                                      {"result", fastmcpp::Json{{"resources", resources_array}}}};
-            }
+                fastmcpp::Json response_result = {{"messages", messages_array}};
+                if (result.description)
+                    response_result["description"] = *result.description;
 
-            if (method == "resources/templates/list")
-            {
-                fastmcpp::Json templates_array = fastmcpp::Json::array();
-                for (const auto& templ : app.list_all_resource_templates())
-                {
-                    fastmcpp::Json templ_json = {{"uriTemplate", templ.uriTemplate},
-                                                 {"name", templ.name}};
-                    if (templ.description)
-                        templ_json["description"] = *templ.description;
-                    if (templ.mimeType)
-                        templ_json["mimeType"] = *templ.mimeType;
-                    if (templ.title)
-                        templ_json["title"] = *templ.title;
-                    if (templ.annotations)
-                        templ_json["annotations"] = *templ.annotations;
-                    if (templ.icons && !templ.icons->empty())
-                    {
-                        fastmcpp::Json icons_json = fastmcpp::Json::array();
-                        for (const auto& icon : *templ.icons)
-                        {
-                            fastmcpp::Json icon_obj = {{"src", icon.src}};
-                            if (icon.mime_type)
-                                icon_obj["mimeType"] = *icon.mime_type;
-                            if (icon.sizes)
-                                icon_obj["sizes"] = *icon.sizes;
-                            icons_json.push_back(icon_obj);
-                        }
-                        templ_json["icons"] = icons_json;
-                    }
-                    attach_meta_ui(templ_json, templ.app, templ._meta);
-                    if (templ.parameters)
-                        templ_json["parameters"] = *templ.parameters;
-                    else
-                        templ_json["parameters"] = fastmcpp::Json::object();
-                    templates_array.push_back(templ_json);
-                }
                 return fastmcpp::Json{
-                    {"jsonrpc", "2.0"},
-                    {"id", id},
-                    {"result", fastmcpp::Json{{"resourceTemplates", templates_array}}}};
-            }
-
-            if (method == "resources/read")
-            {
-                std::string uri = params.value("uri", "");
-                if (uri.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing resource URI");
-                auto span = telemetry::server_span(
-                    "resource " + uri, "resources/read", app.name(), "resource", uri,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
-                {
-                    auto result = app.read_resource(uri);
-
-                    fastmcpp::Json contents_array = fastmcpp::Json::array();
-                    for (const auto& content : result.contents)
-                    {
-                        if (auto* text_content = std::get_if<client::TextResourceContent>(&content))
-                        {
-                            fastmcpp::Json content_json = {{"uri", text_content->uri}};
-                            if (text_content->mimeType)
-                                content_json["mimeType"] = *text_content->mimeType;
-                            content_json["text"] = text_content->text;
-                            if (text_content->_meta)
-                                content_json["_meta"] = *text_content->_meta;
-                            contents_array.push_back(content_json);
-                        }
-                        else if (auto* blob_content =
-                                     std::get_if<client::BlobResourceContent>(&content))
-                        {
-                            fastmcpp::Json content_json = {{"uri", blob_content->uri}};
-                            if (blob_content->mimeType)
-                                content_json["mimeType"] = *blob_content->mimeType;
-                            content_json["blob"] = blob_content->blob;
-                            if (blob_content->_meta)
-                                content_json["_meta"] = *blob_content->_meta;
-                            contents_array.push_back(content_json);
-                        }
-                    }
-
-                    return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                          {"id", id},
-                                          {"result", fastmcpp::Json{{"contents", contents_array}}}};
-                }
-                catch (const NotFoundError& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_error(id, kMcpResourceNotFound, e.what());
-                }
-                catch (const std::exception& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_error(id, kJsonRpcInternalError, e.what());
-                }
+                    {"jsonrpc", "2.0"}, {"id", request.id}, {"result", response_result}};
             }
-
-            // Prompts
-            if (method == "prompts/list")
+            catch (const NotFoundError& e)
             {
-                fastmcpp::Json prompts_array = fastmcpp::Json::array();
-                for (const auto& prompt : app.list_all_prompts())
-                {
-                    fastmcpp::Json prompt_json = {{"name", prompt.name}};
-                    if (prompt.version)
-                        prompt_json["version"] = *prompt.version;
-                    if (prompt.description)
-                        prompt_json["description"] = *prompt.description;
-                    if (prompt.arguments)
-                    {
-                        fastmcpp::Json args_array = fastmcpp::Json::array();
-                        for (const auto& arg : *prompt.arguments)
-                        {
-                            fastmcpp::Json arg_json = {{"name", arg.name},
-                                                       {"required", arg.required}};
-                            if (arg.description)
-                                arg_json["description"] = *arg.description;
-                            args_array.push_back(arg_json);
-                        }
-                        prompt_json["arguments"] = args_array;
-                    }
-                    prompt_json["fastmcp"] = make_fastmcp_meta();
-                    prompts_array.push_back(prompt_json);
-                }
-                return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                      {"id", id},
-                                      {"result", fastmcpp::Json{{"prompts", prompts_array}}}};
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_error(request.id, kMcpMethodNotFound, e.what());
             }
-
-            if (method == "prompts/get")
+            catch (const std::exception& e)
             {
-                std::string name = params.value("name", "");
-                if (name.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing prompt name");
-                auto span = telemetry::server_span(
-                    "prompt " + name, "prompts/get", app.name(), "prompt", name,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
-                {
-                    fastmcpp::Json args = params.value("arguments", fastmcpp::Json::object());
-                    auto result = app.get_prompt(name, args);
-
-                    fastmcpp::Json messages_array = fastmcpp::Json::array();
-                    for (const auto& msg : result.messages)
-                    {
-                        fastmcpp::Json content_array = fastmcpp::Json::array();
-                        for (const auto& content : msg.content)
-                        {
-                            if (auto* text = std::get_if<client::TextContent>(&content))
-                            {
-                                content_array.push_back({{"type", "text"}, {"text", text->text}});
-                            }
-                            else if (auto* img = std::get_if<client::ImageContent>(&content))
-                            {
-                                content_array.push_back({{"type", "image"},
-                                                         {"data", img->data},
-                                                         {"mimeType", img->mimeType}});
-                            }
-                            else if (auto* res =
-                                         std::get_if<client::EmbeddedResourceContent>(&content))
-                            {
-                                fastmcpp::Json res_json = {{"type", "resource"}, {"uri", res->uri}};
-                                if (!res->text.empty())
-                                    res_json["text"] = res->text;
-                                if (res->blob)
-                                    res_json["blob"] = *res->blob;
-                                content_array.push_back(res_json);
-                            }
-                        }
-
-                        std::string role_str =
-                            (msg.role == client::Role::Assistant) ? "assistant" : "user";
-                        fastmcpp::Json content_val =
-                            (content_array.size() == 1) ? content_array[0] : content_array;
-                        messages_array.push_back({{"role", role_str}, {"content", content_val}});
-                    }
-
-                    fastmcpp::Json response_result = {{"messages", messages_array}};
-                    if (result.description)
-                        response_result["description"] = *result.description;
-
-                    return fastmcpp::Json{
-                        {"jsonrpc", "2.0"}, {"id", id}, {"result", response_result}};
-                }
-                catch (const NotFoundError& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_error(id, kMcpMethodNotFound, e.what());
-                }
-                catch (const std::exception& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_error(id, kJsonRpcInternalError, e.what());
-                }
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_error(request.id, kJsonRpcInternalError, e.what());
             }
+        });
 
-            return jsonrpc_error(id, kJsonRpcMethodNotFound,
-                                 std::string("Method '") + method + "' not found");
-        }
-        catch (const std::exception& e)
-        {
-            return jsonrpc_error(message.value("id", fastmcpp::Json()), kJsonRpcInternalError,
-                                 e.what());
-        }
-    };
+    return into_handler(std::move(dispatcher));
 }
 
 // Helper to create a SamplingCallback from a ServerSession
@@ -3013,404 +2958,223 @@ make_sampling_callback(std::shared_ptr<server::ServerSession> session)
 std::function<fastmcpp::Json(const fastmcpp::Json&)>
 make_mcp_handler_with_sampling(const FastMCP& app, SessionAccessor session_accessor)
 {
-    return [&app, session_accessor](const fastmcpp::Json& message) -> fastmcpp::Json
-    {
-        try
-        {
-            const auto id = message.contains("id") ? message.at("id") : fastmcpp::Json();
-            std::string method = message.value("method", "");
-            fastmcpp::Json params = message.value("params", fastmcpp::Json::object());
+    auto lists = std::make_shared<CatalogListCache>();
+    McpDispatcher dispatcher;
 
-            // Extract session_id for sampling support
-            const std::string session_id = extract_session_id(params);
+    dispatcher.on(
+        McpMethod::Initialize,
+        [&app, session_accessor](const McpRequest& request) -> fastmcpp::Json
+        {
+            // Store client capabilities in session for later use
+            if (!request.session_id.empty())
+            {
+                auto session = session_accessor(request.session_id);
+                if (session && request.params.contains("capabilities"))
+                    session->set_capabilities(request.params["capabilities"]);
+            }
 
-            if (method == "initialize")
+            fastmcpp::Json serverInfo = {{"name", app.name()}, {"version", app.version()}};
+            if (app.website_url())
+                serverInfo["websiteUrl"] = *app.website_url();
+            if (app.icons())
             {
-                // Store client capabilities in session for later use
-                if (!session_id.empty())
+                fastmcpp::Json icons_array = fastmcpp::Json::array();
+                for (const auto& icon : *app.icons())
                 {
-                    auto session = session_accessor(session_id);
-                    if (session && params.contains("capabilities"))
-                        session->set_capabilities(params["capabilities"]);
+                    fastmcpp::Json icon_json;
+                    to_json(icon_json, icon);
+                    icons_array.push_back(icon_json);
                 }
+                serverInfo["icons"] = icons_array;
+            }
+
+            // Advertise capabilities including sampling
+            fastmcpp::Json capabilities = {
+                {"tools", fastmcpp::Json::object()},
+                {"sampling", fastmcpp::Json::object()} // We support sampling
+            };
+            auto catalog = app.catalog();
+            if (catalog->supports_tasks)
+                capabilities["tasks"] = tasks_capabilities();
+            if (!catalog->resources.empty() || !catalog->templates.empty())
+                capabilities["resources"] = fastmcpp::Json::object();
+            if (!catalog->prompts.empty())
+                capabilities["prompts"] = fastmcpp::Json::object();
+            advertise_ui_extension(capabilities);
+            advertise_experimental(capabilities, app);
+
+            fastmcpp::Json result_obj = {{"protocolVersion", "2024-11-05"},
+                                         {"capabilities", capabilities},
+                                         {"serverInfo", serverInfo}};
+            if (app.instructions().has_value())
+                result_obj["instructions"] = *app.instructions();
+            return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", request.id}, {"result", result_obj}};
+        });
+
+    dispatcher.on(McpMethod::ToolsList,
+                  [&app, lists](const McpRequest& request)
+                  {
+                      return catalog_list_page(request, app, *lists, CatalogListCache::Kind::Tools,
+                                               "tools");
+                  });
+
+    dispatcher.on(
+        McpMethod::ToolsCall,
+        [&app, session_accessor](const McpRequest& request) -> fastmcpp::Json
+        {
+            std::string name = request.params.value("name", "");
+            fastmcpp::Json args = request.params.value("arguments", fastmcpp::Json::object());
+            if (name.empty())
+                return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Missing tool name");
+            auto span = request_span(request, "tool " + name, app.name(), "tool", name);
+
+            auto route = app.find_tool_route(name);
+            bool has_output_schema = route && route->has_output_schema;
+
+            // Inject _meta with session_id and sampling callback into args
+            // This allows tools to access sampling via Context
+            if (!request.session_id.empty())
+            {
+                args["_meta"] = {{"session_id", request.session_id}};
 
-                fastmcpp::Json serverInfo = {{"name", app.name()}, {"version", app.version()}};
-                if (app.website_url())
-                    serverInfo["websiteUrl"] = *app.website_url();
-                if (app.icons())
+                // Get session and create sampling callback
+                auto session = session_accessor(request.session_id);
+                if (session)
                 {
-                    fastmcpp::Json icons_array = fastmcpp::Json::array();
-                    for (const auto& icon : *app.icons())
-                    {
-                        fastmcpp::Json icon_json;
-                        to_json(icon_json, icon);
-                        icons_array.push_back(icon_json);
-                    }
-                    serverInfo["icons"] = icons_array;
+                    // Store sampling context that tool can access
+                    args["_meta"]["sampling_enabled"] = true;
+                    inject_client_extensions_meta(args, *session);
                 }
-
-                // Advertise capabilities including sampling
-                fastmcpp::Json capabilities = {
-                    {"tools", fastmcpp::Json::object()},
-                    {"sampling", fastmcpp::Json::object()} // We support sampling
-                };
-                if (app_supports_tasks(app))
-                    capabilities["tasks"] = tasks_capabilities();
-                if (!app.list_all_resources().empty() || !app.list_all_templates().empty())
-                    capabilities["resources"] = fastmcpp::Json::object();
-                if (!app.list_all_prompts().empty())
-                    capabilities["prompts"] = fastmcpp::Json::object();
-                advertise_ui_extension(capabilities);
-                advertise_experimental(capabilities, app);
-
-                fastmcpp::Json result_obj = {{"protocolVersion", "2024-11-05"},
-                                             {"capabilities", capabilities},
-                                             {"serverInfo", serverInfo}};
-                if (app.instructions().has_value())
-                    result_obj["instructions"] = *app.instructions();
-                return fastmcpp::Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", result_obj}};
             }
 
-            if (method == "ping")
+            try
             {
+                auto result = app.invoke_tool(name, args);
+                fastmcpp::Json result_payload =
+                    build_fastmcp_tool_result(result, has_output_schema);
                 return fastmcpp::Json{
-                    {"jsonrpc", "2.0"}, {"id", id}, {"result", fastmcpp::Json::object()}};
+                    {"jsonrpc", "2.0"}, {"id", request.id}, {"result", result_payload}};
             }
-
-            if (method == "tools/list")
+            catch (const std::exception& e)
             {
-                fastmcpp::Json tools_array = fastmcpp::Json::array();
-                for (const auto& tool_info : app.list_all_tools_info())
-                {
-                    fastmcpp::Json tool_json = {{"name", tool_info.name},
-                                                {"inputSchema", tool_info.inputSchema}};
-                    if (tool_info.version)
-                        tool_json["version"] = *tool_info.version;
-                    if (tool_info.title)
-                        tool_json["title"] = *tool_info.title;
-                    if (tool_info.description)
-                        tool_json["description"] = *tool_info.description;
-                    if (tool_info.outputSchema && !tool_info.outputSchema->is_null())
-                        tool_json["outputSchema"] =
-                            normalize_output_schema_for_mcp(*tool_info.outputSchema);
-                    if (tool_info.execution)
-                        tool_json["execution"] = *tool_info.execution;
-                    if (tool_info.icons && !tool_info.icons->empty())
-                    {
-                        fastmcpp::Json icons_json = fastmcpp::Json::array();
-                        for (const auto& icon : *tool_info.icons)
-                        {
-                            fastmcpp::Json icon_obj = {{"src", icon.src}};
-                            if (icon.mime_type)
-                                icon_obj["mimeType"] = *icon.mime_type;
-                            if (icon.sizes)
-                                icon_obj["sizes"] = *icon.sizes;
-                            icons_json.push_back(icon_obj);
-                        }
-                        tool_json["icons"] = icons_json;
-                    }
-                    attach_meta_ui(tool_json, tool_info.app, tool_info._meta);
-                    tools_array.push_back(tool_json);
-                }
-                return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                      {"id", id},
-                                      {"result", apply_pagination(tools_array, "tools", params,
-                                                                  app.list_page_size())}};
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_error(request.id, kJsonRpcInternalError, e.what());
             }
+        });
 
-            if (method == "tools/call")
-            {
-                std::string name = params.value("name", "");
-                fastmcpp::Json args = params.value("arguments", fastmcpp::Json::object());
-                if (name.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing tool name");
-                auto span = telemetry::server_span(
-                    "tool " + name, "tools/call", app.name(), "tool", name,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-
-                bool has_output_schema = false;
-                for (const auto& tool_info : app.list_all_tools_info())
-                {
-                    if (tool_info.name != name)
-                        continue;
-                    has_output_schema =
-                        tool_info.outputSchema && !tool_info.outputSchema->is_null();
-                    break;
-                }
+    // Forward other methods to base handler
+    // (resources, prompts, etc. - use the same logic as make_mcp_handler(McpApp))
+    // Resources
+    dispatcher.on(
+        McpMethod::ResourcesList,
+        [&app, lists](const McpRequest& request)
+        {
+            return catalog_list_page(request, app, *lists, CatalogListCache::Kind::Resources,
+                                     "resources");
+        });
 
-                // Inject _meta with session_id and sampling callback into args
-                // This allows tools to access sampling via Context
-                if (!session_id.empty())
-                {
-                    args["_meta"] = {{"session_id", session_id}};
+    dispatcher.on(
+        McpMethod::ResourcesTemplatesList,
+        [&app, lists](const McpRequest& request)
+        {
+            return catalog_list_page(request, app, *lists, CatalogListCache::Kind::Templates,
+                                     "resourceTemplates");
+        });
 
-                    // Get session and create sampling callback
-                    auto session = session_accessor(session_id);
-                    if (session)
-                    {
-                        // Store sampling context that tool can access
-                        args["_meta"]["sampling_enabled"] = true;
-                        inject_client_extensions_meta(args, *session);
-                    }
-                }
+    dispatcher.on(
+        McpMethod::ResourcesRead,
+        [&app](const McpRequest& request) -> fastmcpp::Json
+        {
+            std::string uri = request.params.value("uri", "");
+            if (uri.empty())
+                return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Missing resource URI");
+            while (!uri.empty() && uri.back() == '/')
+                uri.pop_back();
+            auto span = request_span(request, "resource " + uri, app.name(), "resource", uri);
+            try
+            {
+                auto content_json =
+                    resources::content_to_json(app.read_resource(uri, request.params));
+                attach_resource_content_meta_ui(content_json, app, uri);
 
-                try
-                {
-                    auto result = app.invoke_tool(name, args);
-                    fastmcpp::Json result_payload =
-                        build_fastmcp_tool_result(result, has_output_schema);
-                    return fastmcpp::Json{
-                        {"jsonrpc", "2.0"}, {"id", id}, {"result", result_payload}};
-                }
-                catch (const std::exception& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_error(id, kJsonRpcInternalError, e.what());
-                }
+                return fastmcpp::Json{
+                    {"jsonrpc", "2.0"},
+                    {"id", request.id},
+                    {"result", fastmcpp::Json{{"contents", {std::move(content_json)}}}}};
             }
-
-            // Forward other methods to base handler
-            // (resources, prompts, etc. - use the same logic as make_mcp_handler(McpApp))
-
-            // Resources
-            if (method == "resources/list")
+            catch (const NotFoundError& e)
             {
-                fastmcpp::Json resources_array = fastmcpp::Json::array();
-                for (const auto& res : app.list_all_resources())
-                {
-                    fastmcpp::Json res_json = {{"uri", res.uri}, {"name", res.name}};
-                    if (res.version)
-                        res_json["version"] = *res.version;
-                    if (res.description)
-                        res_json["description"] = *res.description;
-                    if (res.mime_type)
-                        res_json["mimeType"] = *res.mime_type;
-                    if (res.title)
-                        res_json["title"] = *res.title;
-                    if (res.annotations)
-                        res_json["annotations"] = *res.annotations;
-                    if (res.icons)
-                    {
-                        fastmcpp::Json icons_json = fastmcpp::Json::array();
-                        for (const auto& icon : *res.icons)
-                        {
-                            fastmcpp::Json icon_obj = {{"src", icon.src}};
-                            if (icon.mime_type)
-                                icon_obj["mimeType"] = *icon.mime_type;
-                            if (icon.sizes)
-                                icon_obj["sizes"] = *icon.sizes;
-                            icons_json.push_back(icon_obj);
-                        }
-                        res_json["icons"] = icons_json;
-                    }
-                    attach_meta_ui(res_json, res.app);
-                    res_json["fastmcp"] = make_fastmcp_meta();
-                    resources_array.push_back(res_json);
-                }
-                return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                      {"id", id},
-                                      {"result", apply_pagination(resources_array, "resources",
-                                                                  params, app.list_page_size())}};
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_error(request.id, kMcpResourceNotFound, e.what());
             }
-
-            if (method == "resources/templates/list")
+            catch (const std::exception& e)
             {
-                fastmcpp::Json templates_array = fastmcpp::Json::array();
-                for (const auto& templ : app.list_all_templates())
-                {
-                    fastmcpp::Json templ_json = {{"uriTemplate", templ.uri_template},
-                                                 {"name", templ.name}};
-                    if (templ.description)
-                        templ_json["description"] = *templ.description;
-                    if (templ.mime_type)
-                        templ_json["mimeType"] = *templ.mime_type;
-                    if (templ.title)
-                        templ_json["title"] = *templ.title;
-                    if (templ.annotations)
-                        templ_json["annotations"] = *templ.annotations;
-                    if (templ.icons)
-                    {
-                        fastmcpp::Json icons_json = fastmcpp::Json::array();
-                        for (const auto& icon : *templ.icons)
-                        {
-                            fastmcpp::Json icon_obj = {{"src", icon.src}};
-                            if (icon.mime_type)
-                                icon_obj["mimeType"] = *icon.mime_type;
-                            if (icon.sizes)
-                                icon_obj["sizes"] = *icon.sizes;
-                            icons_json.push_back(icon_obj);
-                        }
-                        templ_json["icons"] = icons_json;
-                    }
-                    attach_meta_ui(templ_json, templ.app);
-                    templ_json["parameters"] =
-                        templ.parameters.is_null() ? fastmcpp::Json::object() : templ.parameters;
-                    templates_array.push_back(templ_json);
-                }
-                return fastmcpp::Json{
-                    {"jsonrpc", "2.0"},
-                    {"id", id},
-                    {"result", apply_pagination(templates_array, "resourceTemplates", params,
-                                                app.list_page_size())}};
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_error(request.id, kJsonRpcInternalError, e.what());
             }
+        });
 
-            if (method == "resources/read")
-            {
-                std::string uri = params.value("uri", "");
-                if (uri.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing resource URI");
-                while (!uri.empty() && uri.back() == '/')
-                    uri.pop_back();
-                auto span = telemetry::server_span(
-                    "resource " + uri, "resources/read", app.name(), "resource", uri,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
-                {
-                    auto content = app.read_resource(uri, params);
-                    fastmcpp::Json content_json = {{"uri", content.uri}};
-                    if (content.mime_type)
-                        content_json["mimeType"] = *content.mime_type;
+    // Prompts
+    dispatcher.on(
+        McpMethod::PromptsList,
+        [&app, lists](const McpRequest& request)
+        {
+            return catalog_list_page(request, app, *lists, CatalogListCache::Kind::Prompts,
+                                     "prompts");
+        });
 
-                    if (std::holds_alternative<std::string>(content.data))
-                    {
-                        content_json["text"] = std::get<std::string>(content.data);
-                    }
-                    else
-                    {
-                        const auto& binary = std::get<std::vector<uint8_t>>(content.data);
-                        static const char* b64_chars =
-                            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-                        std::string b64;
-                        b64.reserve((binary.size() + 2) / 3 * 4);
-                        for (size_t i = 0; i < binary.size(); i += 3)
-                        {
-                            uint32_t n = binary[i] << 16;
-                            if (i + 1 < binary.size())
-                                n |= binary[i + 1] << 8;
-                            if (i + 2 < binary.size())
-                                n |= binary[i + 2];
-                            b64.push_back(b64_chars[(n >> 18) & 0x3F]);
-                            b64.push_back(b64_chars[(n >> 12) & 0x3F]);
-                            b64.push_back((i + 1 < binary.size()) ? b64_chars[(n >> 6) & 0x3F]
-                                                                  : '=');
-                            b64.push_back((i + 2 < binary.size()) ? b64_chars[n & 0x3F] : '=');
-                        }
-                        content_json["blob"] = b64;
-                    }
-                    attach_resource_content_meta_ui(content_json, app, uri);
+    dispatcher.on(
+        McpMethod::PromptsGet,
+        [&app](const McpRequest& request) -> fastmcpp::Json
+        {
+            std::string prompt_name = request.params.value("name", "");
+            if (prompt_name.empty())
+                return jsonrpc_error(request.id, kJsonRpcInvalidParams, "Missing prompt name");
+            auto span =
+                request_span(request, "prompt " + prompt_name, app.name(), "prompt", prompt_name);
+            try
+            {
+                fastmcpp::Json args = request.params.value("arguments", fastmcpp::Json::object());
+                auto prompt_result = app.get_prompt_result(prompt_name, args);
 
-                    return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                          {"id", id},
-                                          {"result", fastmcpp::Json{{"contents", {content_json}}}}};
-                }
-                catch (const NotFoundError& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_error(id, kMcpResourceNotFound, e.what());
-                }
-                catch (const std::exception& e)
+                fastmcpp::Json messages_array = fastmcpp::Json::array();
+                for (const auto& msg : prompt_result.messages)
                 {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_error(id, kJsonRpcInternalError, e.what());
+                    messages_array.push_back(
+                        {{"role", msg.role},
+                         {"content", fastmcpp::Json{{"type", "text"}, {"text", msg.content}}}});
                 }
-            }
 
-            // Prompts
-            if (method == "prompts/list")
-            {
-                fastmcpp::Json prompts_array = fastmcpp::Json::array();
-                for (const auto& [name, prompt] : app.list_all_prompts())
-                {
-                    fastmcpp::Json prompt_json = {{"name", name}};
-                    if (prompt->version)
-                        prompt_json["version"] = *prompt->version;
-                    if (prompt->description)
-                        prompt_json["description"] = *prompt->description;
-                    if (!prompt->arguments.empty())
-                    {
-                        fastmcpp::Json args_array = fastmcpp::Json::array();
-                        for (const auto& arg : prompt->arguments)
-                        {
-                            fastmcpp::Json arg_json = {{"name", arg.name},
-                                                       {"required", arg.required}};
-                            if (arg.description)
-                                arg_json["description"] = *arg.description;
-                            args_array.push_back(arg_json);
-                        }
-                        prompt_json["arguments"] = args_array;
-                    }
-                    prompt_json["fastmcp"] = make_fastmcp_meta();
-                    prompts_array.push_back(prompt_json);
-                }
                 return fastmcpp::Json{{"jsonrpc", "2.0"},
-                                      {"id", id},
-                                      {"result", apply_pagination(prompts_array, "prompts", params,
-                                                                  app.list_page_size())}};
+                                      {"id", request.id},
+                                      {"result", [&]()
+                                       {
+                                           fastmcpp::Json result = {{"messages", messages_array}};
+                                           if (prompt_result.description)
+                                               result["description"] = *prompt_result.description;
+                                           if (prompt_result.meta)
+                                               result["_meta"] = *prompt_result.meta;
+                                           return result;
+                                       }()}};
+            }
+            catch (const NotFoundError& e)
+            {
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_error(request.id, kMcpMethodNotFound, e.what());
             }
-
-            if (method == "prompts/get")
+            catch (const std::exception& e)
             {
-                std::string prompt_name = params.value("name", "");
-                if (prompt_name.empty())
-                    return jsonrpc_error(id, kJsonRpcInvalidParams, "Missing prompt name");
-                auto span = telemetry::server_span(
-                    "prompt " + prompt_name, "prompts/get", app.name(), "prompt", prompt_name,
-                    extract_request_meta(params),
-                    session_id.empty() ? std::nullopt : std::optional<std::string>(session_id));
-                try
-                {
-                    fastmcpp::Json args = params.value("arguments", fastmcpp::Json::object());
-                    auto prompt_result = app.get_prompt_result(prompt_name, args);
-
-                    fastmcpp::Json messages_array = fastmcpp::Json::array();
-                    for (const auto& msg : prompt_result.messages)
-                    {
-                        messages_array.push_back(
-                            {{"role", msg.role},
-                             {"content", fastmcpp::Json{{"type", "text"}, {"text", msg.content}}}});
-                    }
-
-                    return fastmcpp::Json{
-                        {"jsonrpc", "2.0"},
-                        {"id", id},
-                        {"result", [&]()
-                         {
-                             fastmcpp::Json result = {{"messages", messages_array}};
-                             if (prompt_result.description)
-                                 result["description"] = *prompt_result.description;
-                             if (prompt_result.meta)
-                                 result["_meta"] = *prompt_result.meta;
-                             return result;
-                         }()}};
-                }
-                catch (const NotFoundError& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_error(id, kMcpMethodNotFound, e.what());
-                }
-                catch (const std::exception& e)
-                {
-                    if (span.active())
-                        span.span().record_exception(e.what());
-                    return jsonrpc_error(id, kJsonRpcInternalError, e.what());
-                }
+                if (span.active())
+                    span.span().record_exception(e.what());
+                return jsonrpc_error(request.id, kJsonRpcInternalError, e.what());
             }
+        });
 
-            return jsonrpc_error(id, kJsonRpcMethodNotFound,
-                                 std::string("Method '") + method + "' not found");
-        }
-        catch (const std::exception& e)
-        {
-            return jsonrpc_error(message.value("id", fastmcpp::Json()), kJsonRpcInternalError,
-                                 e.what());
-        }
-    };
+    return into_handler(std::move(dispatcher));
 }
 
 std::function<fastmcpp::Json(const fastmcpp::Json&)>
@@ -1,5 +1,6 @@
 #include "fastmcpp/mcp/tasks.hpp"
 
+#include <algorithm>
 #include <utility>
 
 namespace fastmcpp::mcp::tasks
@@ -23,6 +24,119 @@ void report_status_message(const std::string& message)
     tls_task.fn(tls_task.ctx, tls_task.task_id, message);
 }
 
+TaskExecutor::TaskExecutor(TaskExecutorOptions options) : options_(options)
+{
+    if (options_.workers == 0)
+        options_.workers = std::max(1u, std::thread::hardware_concurrency());
+    // Workers start with the first submissions, so apps that never run tasks
+    // pay for no threads
+}
+
+TaskExecutor::~TaskExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_)
+        if (worker.joinable())
+            worker.join();
+}
+
+bool TaskExecutor::submit(const std::string& owner, int priority, std::function<void()> work)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_ || stats_.queue_depth >= options_.max_queued)
+        {
+            ++stats_.rejected;
+            return false;
+        }
+
+        auto& level = levels_[priority];
+        auto& queue = level.pending[owner];
+        if (queue.empty())
+            level.turns.push_back(owner);
+        queue.push_back(Job{std::move(work), std::chrono::steady_clock::now()});
+        ++stats_.queue_depth;
+        ++stats_.submitted;
+        if (stats_.queue_depth > idle_workers_ && workers_.size() < options_.workers)
+        {
+            workers_.emplace_back([this]() { worker_loop(); });
+            stats_.workers = workers_.size();
+        }
+    }
+    cv_.notify_one();
+    return true;
+}
+
+TaskExecutorStats TaskExecutor::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    TaskExecutorStats out = stats_;
+    for (const auto& [priority, level] : levels_)
+        out.waiting_owners += level.pending.size();
+    return out;
+}
+
+TaskExecutor::Job TaskExecutor::pop_next_locked()
+{
+    auto level_it = levels_.begin();
+    auto& level = level_it->second;
+
+    std::string owner = std::move(level.turns.front());
+    level.turns.pop_front();
+    auto queue_it = level.pending.find(owner);
+    Job job = std::move(queue_it->second.front());
+    queue_it->second.pop_front();
+
+    // Owners with more work go to the back of the rotation
+    if (queue_it->second.empty())
+        level.pending.erase(queue_it);
+    else
+        level.turns.push_back(std::move(owner));
+    if (level.turns.empty())
+        levels_.erase(level_it);
+
+    --stats_.queue_depth;
+    auto waited = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - job.queued_at);
+    stats_.total_wait += waited;
+    stats_.max_wait = std::max(stats_.max_wait, waited);
+    return job;
+}
+
+void TaskExecutor::worker_loop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        ++idle_workers_;
+        cv_.wait(lock, [this]() { return stopping_ || !levels_.empty(); });
+        --idle_workers_;
+        if (levels_.empty())
+            break;
+
+        Job job = pop_next_locked();
+        ++stats_.running;
+        lock.unlock();
+
+        try
+        {
+            job.work();
+        }
+        catch (...)
+        {
+        }
+        job.work = nullptr;
+
+        lock.lock();
+        --stats_.running;
+        ++stats_.completed;
+    }
+}
+
 namespace detail
 {
 void set_current_task(void* ctx, StatusMessageFn fn, std::string task_id)
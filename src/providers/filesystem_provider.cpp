@@ -3,9 +3,11 @@
 #include "fastmcpp/providers/component_registry.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <iostream>
-#include <unordered_set>
+#include <set>
 #include <utility>
 
 #ifdef _WIN32
@@ -80,35 +82,6 @@ std::vector<std::filesystem::path> discover_files(const std::filesystem::path& r
     return files;
 }
 
-class LocalRegistry final : public ComponentRegistry
-{
-  public:
-    explicit LocalRegistry(LocalProvider& provider) : provider_(provider) {}
-
-    void add_tool(tools::Tool tool) override
-    {
-        provider_.add_tool(std::move(tool));
-    }
-
-    void add_resource(resources::Resource resource) override
-    {
-        provider_.add_resource(std::move(resource));
-    }
-
-    void add_template(resources::ResourceTemplate resource_template) override
-    {
-        provider_.add_template(std::move(resource_template));
-    }
-
-    void add_prompt(prompts::Prompt prompt) override
-    {
-        provider_.add_prompt(std::move(prompt));
-    }
-
-  private:
-    LocalProvider& provider_;
-};
-
 #ifdef _WIN32
 std::string format_win32_error(DWORD error)
 {
@@ -135,7 +108,7 @@ std::string format_win32_error(DWORD error)
 
 struct FileSystemProvider::SharedLibrary
 {
-    explicit SharedLibrary(std::filesystem::path path) : path_(std::move(path)) {}
+    SharedLibrary() = default;
 
     SharedLibrary(SharedLibrary&& other) noexcept
     {
@@ -147,9 +120,10 @@ struct FileSystemProvider::SharedLibrary
         if (this != &other)
         {
             reset();
-            path_ = std::move(other.path_);
             handle_ = other.handle_;
             other.handle_ = nullptr;
+            temporary_copy_ = std::move(other.temporary_copy_);
+            other.temporary_copy_.clear();
         }
         return *this;
     }
@@ -162,19 +136,28 @@ struct FileSystemProvider::SharedLibrary
         reset();
     }
 
-    bool load(std::string* error)
+    /// @param temporary_copy Whether `image` is a private copy to delete once unused
+    bool load(const std::filesystem::path& image, bool temporary_copy, std::string* error)
     {
         reset();
 #ifdef _WIN32
-        handle_ = LoadLibraryW(path_.wstring().c_str());
+        handle_ = LoadLibraryW(image.wstring().c_str());
+        if (temporary_copy)
+            temporary_copy_ = image; // Windows cannot delete a loaded library
         if (!handle_)
         {
             if (error)
                 *error = format_win32_error(GetLastError());
+            reset();
             return false;
         }
 #else
-        handle_ = dlopen(path_.c_str(), RTLD_LAZY);
+        handle_ = dlopen(image.c_str(), RTLD_LAZY);
+        if (temporary_copy)
+        {
+            std::error_code ec;
+            std::filesystem::remove(image, ec); // The mapping outlives the directory entry
+        }
         if (!handle_)
         {
             if (error)
@@ -224,9 +207,15 @@ struct FileSystemProvider::SharedLibrary
             dlclose(handle_);
 #endif
         handle_ = nullptr;
+        if (!temporary_copy_.empty())
+        {
+            std::error_code ec;
+            std::filesystem::remove(temporary_copy_, ec);
+            temporary_copy_.clear();
+        }
     }
 
-    std::filesystem::path path_;
+    std::filesystem::path temporary_copy_;
 #ifdef _WIN32
     HMODULE handle_{nullptr};
 #else
@@ -234,151 +223,285 @@ struct FileSystemProvider::SharedLibrary
 #endif
 };
 
-FileSystemProvider::FileSystemProvider(std::filesystem::path root, bool reload)
-    : LocalProvider(DuplicateBehavior::Replace), root_(std::move(root)), reload_(reload)
+/// One loaded library and everything it registered. The library is declared
+/// first so that it is unloaded only after the components, whose code it holds.
+struct FileSystemProvider::Plugin
 {
-    std::error_code ec;
-    root_ = std::filesystem::absolute(root_, ec);
-    load_components();
-}
+    SharedLibrary library;
+    std::vector<tools::Tool> tools;
+    std::vector<resources::Resource> resources;
+    std::vector<resources::ResourceTemplate> templates;
+    std::vector<prompts::Prompt> prompts;
+};
 
-FileSystemProvider::~FileSystemProvider()
+/// Immutable view served to readers. Holding the plugins keeps their libraries
+/// loaded for as long as any reader still uses this catalog.
+struct FileSystemProvider::Catalog
 {
-    clear();
-}
+    std::vector<std::shared_ptr<const Plugin>> plugins;
+    LocalProvider components{DuplicateBehavior::Replace}; // Later paths win, as before
+    uint64_t generation{0};
+};
 
-void FileSystemProvider::ensure_loaded() const
+namespace
 {
-    if (!reload_ && loaded_)
-        return;
+class PluginRegistry final : public ComponentRegistry
+{
+  public:
+    PluginRegistry(std::vector<tools::Tool>& tools, std::vector<resources::Resource>& resources,
+                   std::vector<resources::ResourceTemplate>& templates,
+                   std::vector<prompts::Prompt>& prompts)
+        : tools_(tools), resources_(resources), templates_(templates), prompts_(prompts)
+    {
+    }
 
-    std::lock_guard<std::mutex> lock(reload_mutex_);
-    if (!reload_ && loaded_)
-        return;
+    void add_tool(tools::Tool tool) override
+    {
+        tools_.push_back(std::move(tool));
+    }
+
+    void add_resource(resources::Resource resource) override
+    {
+        resources_.push_back(std::move(resource));
+    }
+
+    void add_template(resources::ResourceTemplate resource_template) override
+    {
+        templates_.push_back(std::move(resource_template));
+    }
+
+    void add_prompt(prompts::Prompt prompt) override
+    {
+        prompts_.push_back(std::move(prompt));
+    }
+
+  private:
+    std::vector<tools::Tool>& tools_;
+    std::vector<resources::Resource>& resources_;
+    std::vector<resources::ResourceTemplate>& templates_;
+    std::vector<prompts::Prompt>& prompts_;
+};
 
-    const_cast<FileSystemProvider*>(this)->load_components();
+bool is_at_or_below(const std::string& path, const std::string& dir)
+{
+    return path.size() >= dir.size() && path.compare(0, dir.size(), dir) == 0 &&
+           (path.size() == dir.size() ||
+            path[dir.size()] == std::filesystem::path::preferred_separator);
 }
 
-void FileSystemProvider::load_components()
+std::filesystem::path temporary_copy_path(const std::filesystem::path& library)
 {
-    clear();
-    libraries_.clear();
-    loaded_ = false;
+    static std::atomic<uint64_t> counter{0};
+    std::error_code ec;
+    auto dir = std::filesystem::temp_directory_path(ec);
+    if (ec)
+        dir = library.parent_path();
+    const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    return dir / ("fastmcpp-" + std::to_string(stamp) + "-" + std::to_string(++counter) + "-" +
+                  library.filename().string());
+}
+} // namespace
 
-    const auto files = discover_files(root_);
-    if (files.empty())
+FileSystemProvider::FileSystemProvider(std::filesystem::path root, bool reload)
+    : LocalProvider(DuplicateBehavior::Replace), root_(std::move(root)), reload_(reload)
+{
+    std::error_code ec;
+    root_ = std::filesystem::absolute(root_, ec);
+    // Watch first: anything changing during the initial load is picked up later
+    if (reload_)
+        watcher_ = std::make_unique<util::FileWatcher>(root_);
+
+    for (const auto& file : discover_files(root_))
+        if (auto plugin = load_plugin(file, false))
+            plugins_.emplace(file.string(), std::move(plugin));
+    publish_catalog();
+}
+
+FileSystemProvider::~FileSystemProvider() = default;
+
+std::shared_ptr<const FileSystemProvider::Catalog> FileSystemProvider::catalog() const
+{
+    if (watcher_ && watcher_->has_changes())
     {
-        loaded_ = true;
-        return;
+        std::lock_guard<std::mutex> lock(reload_mutex_);
+        auto changed = watcher_->take_changes(); // Empty if another caller got here first
+        if (!changed.empty())
+            const_cast<FileSystemProvider*>(this)->reload_paths(changed);
     }
+    return std::atomic_load(&catalog_);
+}
 
-    LocalRegistry registry(*this);
-    std::unordered_set<std::string> successful_files;
+void FileSystemProvider::reload_paths(const std::vector<std::filesystem::path>& changed)
+{
+    // A changed path may be a library or a directory holding several
+    std::set<std::string> affected;
+    for (const auto& path : changed)
+    {
+        const auto key = path.string();
+        for (auto it = plugins_.lower_bound(key);
+             it != plugins_.end() && it->first.compare(0, key.size(), key) == 0; ++it)
+            if (is_at_or_below(it->first, key))
+                affected.insert(it->first);
+        for (const auto& file : discover_files(path))
+            affected.insert(file.string());
+    }
+    if (affected.empty())
+        return;
 
-    auto warn_once = [this](const std::filesystem::path& path, const std::string& message)
+    for (const auto& key : affected)
     {
+        auto known = plugins_.find(key);
         std::error_code ec;
-        const auto mtime = std::filesystem::last_write_time(path, ec);
-        const std::string key = path.string();
-        auto it = warned_files_.find(key);
-        if (it != warned_files_.end())
+        std::shared_ptr<const Plugin> plugin;
+        if (std::filesystem::is_regular_file(key, ec))
+            plugin = load_plugin(key, true);
+        if (known != plugins_.end())
         {
-            if ((!ec && it->second == mtime) ||
-                (ec && it->second == std::filesystem::file_time_type{}))
-                return;
+            // Components handed out earlier may still call into the old build
+            retired_plugins_.push_back(std::move(known->second));
+            plugins_.erase(known);
         }
+        if (plugin)
+            plugins_.emplace(key, std::move(plugin));
+    }
+    publish_catalog();
+}
 
-        std::cerr << "FileSystemProvider failed to load " << key << ": " << message << std::endl;
-        warned_files_[key] = ec ? std::filesystem::file_time_type{} : mtime;
-    };
+std::shared_ptr<const FileSystemProvider::Plugin>
+FileSystemProvider::load_plugin(const std::filesystem::path& path, bool shadow_copy)
+{
+    auto plugin = std::make_shared<Plugin>();
+    std::string error;
 
-    for (const auto& file : files)
+    std::filesystem::path image = path;
+    if (shadow_copy)
     {
-        SharedLibrary library(file);
-        std::string error;
-        if (!library.load(&error))
+        // An earlier build of this path may stay loaded while a catalog refers
+        // to it, and loading a path that is already loaded yields that image again
+        image = temporary_copy_path(path);
+        std::error_code ec;
+        std::filesystem::copy_file(path, image, std::filesystem::copy_options::overwrite_existing,
+                                   ec);
+        if (ec)
         {
-            warn_once(file, error);
-            continue;
+            warn_once(path, "cannot copy for reloading: " + ec.message());
+            return nullptr;
         }
+    }
+    if (!plugin->library.load(image, shadow_copy, &error))
+    {
+        warn_once(path, error);
+        return nullptr;
+    }
 
-        auto* symbol = library.get_symbol(kRegisterSymbol, &error);
-        if (!symbol)
-        {
-            warn_once(file, error);
-            continue;
-        }
+    auto* symbol = plugin->library.get_symbol(kRegisterSymbol, &error);
+    if (!symbol)
+    {
+        warn_once(path, error);
+        return nullptr;
+    }
 
-        auto register_fn = reinterpret_cast<RegisterComponentsFn>(symbol);
-        try
-        {
-            register_fn(registry);
-            libraries_.push_back(std::move(library)); // Keep library only on success
-            successful_files.insert(file.string());
-        }
-        catch (const std::exception& e)
-        {
-            warn_once(file, e.what());
-        }
-        catch (...)
-        {
-            warn_once(file, "unknown error");
-        }
+    auto register_fn = reinterpret_cast<RegisterComponentsFn>(symbol);
+    PluginRegistry registry(plugin->tools, plugin->resources, plugin->templates, plugin->prompts);
+    try
+    {
+        register_fn(registry);
+    }
+    catch (const std::exception& e)
+    {
+        warn_once(path, e.what());
+        return nullptr;
+    }
+    catch (...)
+    {
+        warn_once(path, "unknown error");
+        return nullptr;
     }
 
-    for (const auto& path : successful_files)
-        warned_files_.erase(path);
+    warned_files_.erase(path.string());
+    return plugin;
+}
+
+void FileSystemProvider::warn_once(const std::filesystem::path& path, const std::string& message)
+{
+    std::error_code ec;
+    const auto mtime = std::filesystem::last_write_time(path, ec);
+    const std::string key = path.string();
+    auto it = warned_files_.find(key);
+    if (it != warned_files_.end())
+    {
+        if ((!ec && it->second == mtime) || (ec && it->second == std::filesystem::file_time_type{}))
+            return;
+    }
+
+    std::cerr << "FileSystemProvider failed to load " << key << ": " << message << std::endl;
+    warned_files_[key] = ec ? std::filesystem::file_time_type{} : mtime;
+}
 
-    loaded_ = true;
+void FileSystemProvider::publish_catalog()
+{
+    auto next = std::make_shared<Catalog>();
+    for (const auto& [path, plugin] : plugins_)
+    {
+        next->plugins.push_back(plugin);
+        for (const auto& tool : plugin->tools)
+            next->components.add_tool(tool);
+        for (const auto& resource : plugin->resources)
+            next->components.add_resource(resource);
+        for (const auto& resource_template : plugin->templates)
+            next->components.add_template(resource_template);
+        for (const auto& prompt : plugin->prompts)
+            next->components.add_prompt(prompt);
+    }
+    catalog_generation_.bump();
+    next->generation = catalog_generation_.value();
+    std::atomic_store(&catalog_, std::shared_ptr<const Catalog>(std::move(next)));
+}
+
+std::optional<uint64_t> FileSystemProvider::content_generation() const
+{
+    return catalog()->generation;
 }
 
 std::vector<tools::Tool> FileSystemProvider::list_tools() const
 {
-    ensure_loaded();
-    return LocalProvider::list_tools();
+    return catalog()->components.list_tools();
 }
 
 std::optional<tools::Tool> FileSystemProvider::get_tool(const std::string& name) const
 {
-    ensure_loaded();
-    return LocalProvider::get_tool(name);
+    return catalog()->components.get_tool(name);
 }
 
 std::vector<resources::Resource> FileSystemProvider::list_resources() const
 {
-    ensure_loaded();
-    return LocalProvider::list_resources();
+    return catalog()->components.list_resources();
 }
 
 std::optional<resources::Resource> FileSystemProvider::get_resource(const std::string& uri) const
 {
-    ensure_loaded();
-    return LocalProvider::get_resource(uri);
+    return catalog()->components.get_resource(uri);
 }
 
 std::vector<resources::ResourceTemplate> FileSystemProvider::list_resource_templates() const
 {
-    ensure_loaded();
-    return LocalProvider::list_resource_templates();
+    return catalog()->components.list_resource_templates();
 }
 
 std::optional<resources::ResourceTemplate>
 FileSystemProvider::get_resource_template(const std::string& uri) const
 {
-    ensure_loaded();
-    return LocalProvider::get_resource_template(uri);
+    return catalog()->components.get_resource_template(uri);
 }
 
 std::vector<prompts::Prompt> FileSystemProvider::list_prompts() const
 {
-    ensure_loaded();
-    return LocalProvider::list_prompts();
+    return catalog()->components.list_prompts();
 }
 
 std::optional<prompts::Prompt> FileSystemProvider::get_prompt(const std::string& name) const
 {
-    ensure_loaded();
-    return LocalProvider::get_prompt(name);
+    return catalog()->components.get_prompt(name);
 }
 
 } // namespace fastmcpp::providers
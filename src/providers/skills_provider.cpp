@@ -1,17 +1,28 @@
 #include "fastmcpp/providers/skills_provider.hpp"
 
 #include "fastmcpp/exceptions.hpp"
+#include "fastmcpp/util/file_watcher.hpp"
+#include "fastmcpp/util/sha256.hpp"
 
 #include <algorithm>
-#include <array>
+#include <atomic>
 #include <cctype>
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
+#include <exception>
 #include <fstream>
-#include <iomanip>
-#include <sstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
 namespace fastmcpp::providers
 {
 
@@ -50,96 +61,150 @@ std::optional<std::string> detect_mime_type(const std::filesystem::path& path)
     return "application/octet-stream";
 }
 
-std::string compute_file_hash(const std::filesystem::path& path)
+/// What stat() says about a file; a changed stamp means the contents may have changed
+struct FileStamp
 {
-    std::ifstream in(path, std::ios::binary);
-    if (!in)
-        return "sha256:";
+    uint64_t device{0};
+    uint64_t inode{0};
+    uint64_t size{0};
+    int64_t mtime_ns{0};
+
+    bool operator==(const FileStamp& other) const
+    {
+        return device == other.device && inode == other.inode && size == other.size &&
+               mtime_ns == other.mtime_ns;
+    }
+};
+
+std::optional<FileStamp> stat_file(const std::filesystem::path& path)
+{
+#ifdef _WIN32
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec))
+        return std::nullopt;
+    FileStamp stamp;
+    stamp.size = std::filesystem::file_size(path, ec);
+    const auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec)
+        return std::nullopt;
+    stamp.mtime_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(mtime.time_since_epoch()).count();
+    return stamp;
+#else
+    struct stat info;
+    if (::stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode))
+        return std::nullopt;
+#ifdef __APPLE__
+    const auto& mtime = info.st_mtimespec;
+#else
+    const auto& mtime = info.st_mtim;
+#endif
+    return FileStamp{static_cast<uint64_t>(info.st_dev), static_cast<uint64_t>(info.st_ino),
+                     static_cast<uint64_t>(info.st_size),
+                     static_cast<int64_t>(mtime.tv_sec) * 1000000000 + mtime.tv_nsec};
+#endif
+}
+
+/// Values derived from file contents, reused while the file's stamp is unchanged.
+/// Process-wide so that providers rebuilt by a reloading SkillsDirectoryProvider
+/// keep the work done by their predecessors.
+class StampedCache
+{
+  public:
+    std::optional<std::string> find(const std::string& path, const FileStamp& stamp) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(path);
+        if (it == entries_.end() || !(it->second.stamp == stamp))
+            return std::nullopt;
+        return it->second.value;
+    }
+
+    void store(const std::string& path, const FileStamp& stamp, std::string value)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (entries_.size() >= kMaxEntries && entries_.find(path) == entries_.end())
+            entries_.clear();
+        entries_[path] = Entry{stamp, std::move(value)};
+    }
+
+  private:
+    static constexpr size_t kMaxEntries = 1 << 16;
 
-    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)),
-                               std::istreambuf_iterator<char>());
-
-    auto rotr = [](uint32_t x, uint32_t n) -> uint32_t { return (x >> n) | (x << (32 - n)); };
-    auto ch = [](uint32_t x, uint32_t y, uint32_t z) -> uint32_t { return (x & y) ^ (~x & z); };
-    auto maj = [](uint32_t x, uint32_t y, uint32_t z) -> uint32_t
-    { return (x & y) ^ (x & z) ^ (y & z); };
-    auto bsig0 = [&](uint32_t x) -> uint32_t { return rotr(x, 2) ^ rotr(x, 13) ^ rotr(x, 22); };
-    auto bsig1 = [&](uint32_t x) -> uint32_t { return rotr(x, 6) ^ rotr(x, 11) ^ rotr(x, 25); };
-    auto ssig0 = [&](uint32_t x) -> uint32_t { return rotr(x, 7) ^ rotr(x, 18) ^ (x >> 3); };
-    auto ssig1 = [&](uint32_t x) -> uint32_t { return rotr(x, 17) ^ rotr(x, 19) ^ (x >> 10); };
-
-    static constexpr std::array<uint32_t, 64> k = {
-        0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U, 0x923f82a4U,
-        0xab1c5ed5U, 0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U, 0x72be5d74U, 0x80deb1feU,
-        0x9bdc06a7U, 0xc19bf174U, 0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU,
-        0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU, 0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U,
-        0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U, 0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU,
-        0x53380d13U, 0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U, 0xa2bfe8a1U, 0xa81a664bU,
-        0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U, 0x19a4c116U,
-        0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU, 0x682e6ff3U,
-        0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U, 0x90befffaU, 0xa4506cebU, 0xbef9a3f7U,
-        0xc67178f2U,
+    struct Entry
+    {
+        FileStamp stamp;
+        std::string value;
     };
 
-    uint64_t bit_len = static_cast<uint64_t>(bytes.size()) * 8ULL;
-    bytes.push_back(0x80U);
-    while ((bytes.size() % 64) != 56)
-        bytes.push_back(0x00U);
-    for (int i = 7; i >= 0; --i)
-        bytes.push_back(static_cast<uint8_t>((bit_len >> (i * 8)) & 0xFFU));
-
-    uint32_t h0 = 0x6a09e667U;
-    uint32_t h1 = 0xbb67ae85U;
-    uint32_t h2 = 0x3c6ef372U;
-    uint32_t h3 = 0xa54ff53aU;
-    uint32_t h4 = 0x510e527fU;
-    uint32_t h5 = 0x9b05688cU;
-    uint32_t h6 = 0x1f83d9abU;
-    uint32_t h7 = 0x5be0cd19U;
-
-    for (size_t offset = 0; offset < bytes.size(); offset += 64)
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+};
+
+StampedCache& hash_cache()
+{
+    static StampedCache cache;
+    return cache;
+}
+
+StampedCache& description_cache()
+{
+    static StampedCache cache;
+    return cache;
+}
+
+/// "sha256:<hex>", or just "sha256:" when the file cannot be read
+std::string compute_file_hash(const std::filesystem::path& path)
+{
+    util::Sha256 sha;
+    try
     {
-        std::array<uint32_t, 64> w{};
-        for (size_t i = 0; i < 16; ++i)
-        {
-            const size_t j = offset + i * 4;
-            w[i] = (static_cast<uint32_t>(bytes[j]) << 24) |
-                   (static_cast<uint32_t>(bytes[j + 1]) << 16) |
-                   (static_cast<uint32_t>(bytes[j + 2]) << 8) | static_cast<uint32_t>(bytes[j + 3]);
-        }
-        for (size_t i = 16; i < 64; ++i)
-            w[i] = ssig1(w[i - 2]) + w[i - 7] + ssig0(w[i - 15]) + w[i - 16];
+        resources::ContentStream::from_file(path).write_to([&sha](const char* data, size_t size)
+                                                           { sha.update(data, size); });
+    }
+    catch (const Error&)
+    {
+        return "sha256:";
+    }
+    return "sha256:" + util::Sha256::hex(sha.finish());
+}
 
-        uint32_t a = h0, b = h1, c = h2, d = h3, e = h4, f = h5, g = h6, h = h7;
-        for (size_t i = 0; i < 64; ++i)
+/// Calls fn(0) .. fn(count - 1) on up to kMaxHashThreads threads, the caller
+/// included. The first exception thrown is rethrown once all calls are done.
+template <typename Fn>
+void parallel_for(size_t count, const Fn& fn)
+{
+    constexpr size_t kMaxHashThreads = 8;
+    const size_t threads = std::min(
+        {count, kMaxHashThreads, std::max<size_t>(1, std::thread::hardware_concurrency())});
+    std::atomic<size_t> next{0};
+    std::exception_ptr failure;
+    std::mutex failure_mutex;
+    auto work = [&]()
+    {
+        for (size_t i; (i = next.fetch_add(1)) < count;)
         {
-            uint32_t t1 = h + bsig1(e) + ch(e, f, g) + k[i] + w[i];
-            uint32_t t2 = bsig0(a) + maj(a, b, c);
-            h = g;
-            g = f;
-            f = e;
-            e = d + t1;
-            d = c;
-            c = b;
-            b = a;
-            a = t1 + t2;
+            try
+            {
+                fn(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(failure_mutex);
+                if (!failure)
+                    failure = std::current_exception();
+            }
         }
+    };
 
-        h0 += a;
-        h1 += b;
-        h2 += c;
-        h3 += d;
-        h4 += e;
-        h5 += f;
-        h6 += g;
-        h7 += h;
-    }
-
-    std::ostringstream out;
-    out << "sha256:" << std::hex << std::setfill('0') << std::nouppercase << std::setw(8) << h0
-        << std::setw(8) << h1 << std::setw(8) << h2 << std::setw(8) << h3 << std::setw(8) << h4
-        << std::setw(8) << h5 << std::setw(8) << h6 << std::setw(8) << h7;
-    return out.str();
+    std::vector<std::thread> helpers;
+    for (size_t t = 1; t < threads; ++t)
+        helpers.emplace_back(work);
+    work();
+    for (auto& helper : helpers)
+        helper.join();
+    if (failure)
+        std::rethrow_exception(failure);
 }
 
 std::string trim_copy(std::string value)
@@ -206,17 +271,12 @@ resources::ResourceContent read_file_content(const std::filesystem::path& path,
 
     if (is_text_extension(path))
     {
-        std::ifstream in(path, std::ios::binary);
-        std::ostringstream ss;
-        ss << in.rdbuf();
-        content.data = ss.str();
+        content.data = resources::ContentStream::from_file(path, true).read_all();
         return content;
     }
 
-    std::ifstream in(path, std::ios::binary);
-    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)),
-                               std::istreambuf_iterator<char>());
-    content.data = std::move(bytes);
+    // Binary files can be large: stream them so they are never buffered whole
+    content.data = resources::ContentStream::from_file(path);
     return content;
 }
 
@@ -265,6 +325,18 @@ std::vector<std::filesystem::path> SkillProvider::list_files() const
 std::string SkillProvider::build_description() const
 {
     const auto main_path = skill_path_ / main_file_name_;
+    const auto stamp = stat_file(main_path);
+    if (!stamp)
+        return read_description(main_path);
+    if (auto cached = description_cache().find(main_path.string(), *stamp))
+        return *cached;
+    auto description = read_description(main_path);
+    description_cache().store(main_path.string(), *stamp, description);
+    return description;
+}
+
+std::string SkillProvider::read_description(const std::filesystem::path& main_path) const
+{
     if (auto frontmatter_description = parse_frontmatter_description(main_path))
         return *frontmatter_description;
 
@@ -296,17 +368,45 @@ std::string SkillProvider::build_description() const
 
 std::string SkillProvider::build_manifest_json() const
 {
+    struct ManifestFile
+    {
+        std::filesystem::path path;
+        FileStamp stamp;
+        std::string hash;
+    };
+
+    // Unchanged files cost one stat(); the rest are hashed concurrently
+    std::vector<ManifestFile> entries;
+    std::vector<size_t> misses;
+    for (auto& file : list_files())
+    {
+        auto stamp = stat_file(file);
+        if (!stamp)
+            continue; // Removed since listing
+        auto hash = hash_cache().find(file.string(), *stamp);
+        if (!hash)
+            misses.push_back(entries.size());
+        entries.push_back({std::move(file), *stamp, hash.value_or("")});
+    }
+    parallel_for(misses.size(),
+                 [&entries, &misses](size_t i)
+                 {
+                     auto& entry = entries[misses[i]];
+                     entry.hash = compute_file_hash(entry.path);
+                     if (entry.hash.size() > std::string("sha256:").size())
+                         hash_cache().store(entry.path.string(), entry.stamp, entry.hash);
+                 });
+
     Json files = Json::array();
-    for (const auto& file : list_files())
+    for (auto& entry : entries)
     {
-        const auto rel = std::filesystem::relative(file, skill_path_);
         files.push_back(Json{
-            {"path", to_uri_path(rel)},
-            {"size", static_cast<int64_t>(std::filesystem::file_size(file))},
-            {"hash", compute_file_hash(file)},
+            {"path", to_uri_path(entry.path.lexically_relative(skill_path_))},
+            {"size", static_cast<int64_t>(entry.stamp.size)},
+            {"hash", std::move(entry.hash)},
         });
     }
-    return Json{{"skill", skill_name_}, {"files", files}}.dump(2);
+    return Json{{"skill", skill_name_}, {"files", std::move(files)}}.dump(2);
 }
 
 std::vector<resources::Resource> SkillProvider::list_resources() const
@@ -342,7 +442,7 @@ std::vector<resources::Resource> SkillProvider::list_resources() const
     {
         for (const auto& file : list_files())
         {
-            const auto rel = std::filesystem::relative(file, skill_path_);
+            const auto rel = file.lexically_relative(skill_path_);
             if (to_uri_path(rel) == main_file_name_)
                 continue;
 
@@ -408,13 +508,276 @@ SkillProvider::get_resource_template(const std::string& uri) const
     return std::nullopt;
 }
 
+/// One discovered skill with its listings, computed once per change
+struct SkillsDirectoryProvider::Skill
+{
+    std::string name;
+    std::shared_ptr<const SkillProvider> provider;
+    std::vector<resources::Resource> resources;
+    std::vector<resources::ResourceTemplate> templates;
+};
+
+namespace
+{
+/// Whether two builds of a skill would list the same resources and templates
+bool same_listing(const std::vector<resources::Resource>& a_resources,
+                  const std::vector<resources::ResourceTemplate>& a_templates,
+                  const std::vector<resources::Resource>& b_resources,
+                  const std::vector<resources::ResourceTemplate>& b_templates)
+{
+    if (a_resources.size() != b_resources.size() || a_templates.size() != b_templates.size())
+        return false;
+    for (size_t i = 0; i < a_resources.size(); ++i)
+    {
+        const auto& a = a_resources[i];
+        const auto& b = b_resources[i];
+        if (a.uri != b.uri || a.name != b.name || a.description != b.description ||
+            a.mime_type != b.mime_type)
+            return false;
+    }
+    for (size_t i = 0; i < a_templates.size(); ++i)
+        if (a_templates[i].uri_template != b_templates[i].uri_template)
+            return false;
+    return true;
+}
+} // namespace
+
+/// The skills directly under one root. Built once, then (with reload) kept
+/// current from FileWatcher events: a change below `root/<name>` rebuilds only
+/// skill `<name>`. Readers take the published snapshot with one atomic load.
+class SkillsDirectoryProvider::Index
+{
+  public:
+    struct Snapshot
+    {
+        std::vector<std::shared_ptr<const Skill>> skills; // By name
+        uint64_t generation{0};
+    };
+
+    Index(std::filesystem::path root, bool reload, std::string main_file_name,
+          SkillSupportingFiles supporting_files)
+        : root_(std::move(root)), main_file_name_(std::move(main_file_name)),
+          supporting_files_(supporting_files)
+    {
+        // Events arriving before the first snapshot wait on mutex_, then apply
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (reload)
+        {
+            util::FileWatcher::Options options;
+            options.on_change = [this]() { on_change(); };
+            watcher_ = std::make_unique<util::FileWatcher>(root_, std::move(options));
+        }
+        for (const auto& name : list_skill_dirs())
+            if (auto skill = load_skill(name))
+                skills_.emplace(name, std::move(skill));
+        publish();
+    }
+
+    std::shared_ptr<const Snapshot> snapshot() const
+    {
+        return std::atomic_load(&snapshot_);
+    }
+
+    /// `listener` runs on the watcher thread after each published change
+    uint64_t subscribe(std::function<void()> listener)
+    {
+        std::lock_guard<std::mutex> lock(listeners_mutex_);
+        listeners_.emplace(++last_listener_, std::move(listener));
+        return last_listener_;
+    }
+
+    /// Once this returns, the listener is not running and will not run again
+    void unsubscribe(uint64_t id)
+    {
+        std::lock_guard<std::mutex> lock(listeners_mutex_);
+        listeners_.erase(id);
+    }
+
+  private:
+    std::vector<std::string> list_skill_dirs() const
+    {
+        std::vector<std::string> names;
+        std::error_code ec;
+        for (auto it = std::filesystem::directory_iterator(root_, ec);
+             it != std::filesystem::directory_iterator(); it.increment(ec))
+        {
+            if (ec)
+                break;
+            if (it->is_directory(ec))
+                names.push_back(it->path().filename().string());
+        }
+        return names;
+    }
+
+    std::shared_ptr<const Skill> load_skill(const std::string& name) const
+    {
+        const auto dir = root_ / name;
+        std::error_code ec;
+        if (!std::filesystem::is_directory(dir, ec) ||
+            !std::filesystem::exists(dir / main_file_name_, ec))
+            return nullptr;
+
+        auto skill = std::make_shared<Skill>();
+        try
+        {
+            auto provider =
+                std::make_shared<const SkillProvider>(dir, main_file_name_, supporting_files_);
+            skill->resources = provider->list_resources();
+            skill->templates = provider->list_resource_templates();
+            skill->name = provider->skill_name();
+            // The manifest reader calls back into the provider: keep it alive
+            // for as long as any copy of the resource is
+            for (auto& resource : skill->resources)
+                resource.provider = [provider, read = std::move(resource.provider)](
+                                        const Json& params) { return read(params); };
+            skill->provider = std::move(provider);
+        }
+        catch (...)
+        {
+            return nullptr; // Skip unreadable/invalid skills.
+        }
+        return skill;
+    }
+
+    void on_change()
+    {
+        bool changed = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!watcher_)
+                return;
+            changed = apply(watcher_->take_changes());
+            if (changed)
+                publish();
+        }
+        if (!changed)
+            return;
+        std::lock_guard<std::mutex> lock(listeners_mutex_);
+        for (const auto& [id, listener] : listeners_)
+            listener();
+    }
+
+    /// Rebuilds the skills containing `paths`; true if any listing changed
+    bool apply(const std::vector<std::filesystem::path>& paths)
+    {
+        std::set<std::string> names;
+        bool rescan = false;
+        for (const auto& path : paths)
+        {
+            const auto relative = path.lexically_relative(root_);
+            if (relative.empty() || relative == "." || *relative.begin() == "..")
+                rescan = true; // The root itself, e.g. after an event queue overflow
+            else
+                names.insert(relative.begin()->string());
+        }
+        if (rescan)
+        {
+            for (auto& name : list_skill_dirs())
+                names.insert(std::move(name));
+            for (const auto& [name, skill] : skills_)
+                names.insert(name);
+        }
+
+        bool changed = false;
+        for (const auto& name : names)
+        {
+            auto fresh = load_skill(name);
+            auto it = skills_.find(name);
+            if (!fresh)
+            {
+                if (it != skills_.end())
+                {
+                    skills_.erase(it);
+                    changed = true;
+                }
+                continue;
+            }
+            if (it != skills_.end() && same_listing(it->second->resources, it->second->templates,
+                                                    fresh->resources, fresh->templates))
+                continue; // Contents changed, listing did not
+            skills_[name] = std::move(fresh);
+            changed = true;
+        }
+        return changed;
+    }
+
+    void publish()
+    {
+        auto next = std::make_shared<Snapshot>();
+        next->skills.reserve(skills_.size());
+        for (const auto& [name, skill] : skills_)
+            next->skills.push_back(skill);
+        generation_.bump();
+        next->generation = generation_.value();
+        std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>(std::move(next)));
+    }
+
+    std::filesystem::path root_;
+    std::string main_file_name_;
+    SkillSupportingFiles supporting_files_;
+
+    std::mutex mutex_; // Guards skills_ and publishing
+    std::map<std::string, std::shared_ptr<const Skill>> skills_;
+    std::shared_ptr<const Snapshot> snapshot_;
+    util::GenerationStamp generation_;
+
+    std::mutex listeners_mutex_;
+    std::map<uint64_t, std::function<void()>> listeners_;
+    uint64_t last_listener_{0};
+
+    std::unique_ptr<util::FileWatcher> watcher_; // Reload only; stopped first on destruction
+};
+
+/// Every root's skills merged, first root winning on name clashes
+struct SkillsDirectoryProvider::Listing
+{
+    std::vector<std::shared_ptr<const Index::Snapshot>> snapshots; // One per index
+    std::vector<resources::Resource> resources;
+    std::unordered_map<std::string, size_t> resource_by_uri;
+    std::vector<resources::ResourceTemplate> templates;
+    uint64_t generation{0}; // Sum of the snapshots' generations
+};
+
+std::shared_ptr<SkillsDirectoryProvider::Index>
+SkillsDirectoryProvider::acquire_index(const std::filesystem::path& root, bool reload,
+                                       const std::string& main_file_name,
+                                       SkillSupportingFiles supporting_files)
+{
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<Index>> indexes;
+
+    const auto key = root.string() + '\n' + main_file_name + '\n' +
+                     std::to_string(static_cast<int>(supporting_files)) + (reload ? "r" : "");
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = indexes.begin(); it != indexes.end();)
+        it = it->second.expired() ? indexes.erase(it) : std::next(it);
+
+    auto& slot = indexes[key];
+    auto index = slot.lock();
+    if (!index)
+    {
+        index = std::make_shared<Index>(root, reload, main_file_name, supporting_files);
+        slot = index;
+    }
+    return index;
+}
+
 SkillsDirectoryProvider::SkillsDirectoryProvider(std::vector<std::filesystem::path> roots,
                                                  bool reload, std::string main_file_name,
                                                  SkillSupportingFiles supporting_files)
     : roots_(std::move(roots)), reload_(reload), main_file_name_(std::move(main_file_name)),
       supporting_files_(supporting_files)
 {
-    discover_skills();
+    for (const auto& root_raw : roots_)
+    {
+        std::error_code ec;
+        auto root = std::filesystem::absolute(root_raw, ec).lexically_normal();
+        if (!root.has_filename())
+            root = root.parent_path(); // Drop a trailing separator
+        auto index = acquire_index(root, reload_, main_file_name_, supporting_files_);
+        subscriptions_.push_back(index->subscribe([this]() { notify_list_changed(); }));
+        indexes_.push_back(std::move(index));
+    }
 }
 
 SkillsDirectoryProvider::SkillsDirectoryProvider(std::filesystem::path root, bool reload,
@@ -425,103 +788,103 @@ SkillsDirectoryProvider::SkillsDirectoryProvider(std::filesystem::path root, boo
 {
 }
 
-void SkillsDirectoryProvider::ensure_discovered() const
+SkillsDirectoryProvider::~SkillsDirectoryProvider()
 {
-    if (!discovered_ || reload_)
-        discover_skills();
+    for (size_t i = 0; i < indexes_.size(); ++i)
+        indexes_[i]->unsubscribe(subscriptions_[i]);
 }
 
-void SkillsDirectoryProvider::discover_skills() const
+void SkillsDirectoryProvider::set_notification_callback(NotificationCallback callback)
 {
-    providers_.clear();
-    std::unordered_set<std::string> seen_names;
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    notification_callback_ = std::move(callback);
+}
 
-    for (const auto& root_raw : roots_)
+void SkillsDirectoryProvider::notify_list_changed()
+{
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (notification_callback_)
+        notification_callback_("notifications/resources/list_changed", Json::object());
+}
+
+std::shared_ptr<const SkillsDirectoryProvider::Listing> SkillsDirectoryProvider::listing() const
+{
+    auto is_current = [this](const std::shared_ptr<const Listing>& listing)
     {
-        const auto root = std::filesystem::absolute(root_raw).lexically_normal();
-        if (!std::filesystem::exists(root) || !std::filesystem::is_directory(root))
-            continue;
+        if (!listing)
+            return false;
+        for (size_t i = 0; i < indexes_.size(); ++i)
+            if (indexes_[i]->snapshot() != listing->snapshots[i])
+                return false;
+        return true;
+    };
 
-        for (const auto& entry : std::filesystem::directory_iterator(root))
-        {
-            if (!entry.is_directory())
-                continue;
+    auto current = std::atomic_load(&listing_);
+    if (is_current(current))
+        return current;
 
-            const auto skill_dir = entry.path();
-            const auto main_file = skill_dir / main_file_name_;
-            if (!std::filesystem::exists(main_file))
-                continue;
+    std::lock_guard<std::mutex> lock(listing_mutex_);
+    current = std::atomic_load(&listing_);
+    if (is_current(current))
+        return current;
 
-            const auto skill_name = skill_dir.filename().string();
-            if (!seen_names.insert(skill_name).second)
+    auto next = std::make_shared<Listing>();
+    std::unordered_set<std::string> seen_names;
+    std::unordered_set<std::string> seen_templates;
+    for (const auto& index : indexes_)
+    {
+        auto snapshot = index->snapshot();
+        next->generation += snapshot->generation;
+        for (const auto& skill : snapshot->skills)
+        {
+            if (!seen_names.insert(skill->name).second)
                 continue;
-
-            try
-            {
-                providers_.push_back(
-                    std::make_shared<SkillProvider>(skill_dir, main_file_name_, supporting_files_));
-            }
-            catch (...)
-            {
-                // Skip unreadable/invalid skills.
-            }
+            for (const auto& resource : skill->resources)
+                if (next->resource_by_uri.emplace(resource.uri, next->resources.size()).second)
+                    next->resources.push_back(resource);
+            for (const auto& templ : skill->templates)
+                if (seen_templates.insert(templ.uri_template).second)
+                    next->templates.push_back(templ);
         }
+        next->snapshots.push_back(std::move(snapshot));
     }
+    current = std::move(next);
+    std::atomic_store(&listing_, current);
+    return current;
+}
 
-    discovered_ = true;
+std::optional<uint64_t> SkillsDirectoryProvider::content_generation() const
+{
+    return listing()->generation;
 }
 
 std::vector<resources::Resource> SkillsDirectoryProvider::list_resources() const
 {
-    ensure_discovered();
-    std::vector<resources::Resource> out;
-    std::unordered_set<std::string> seen;
-    for (const auto& provider : providers_)
-    {
-        for (const auto& resource : provider->list_resources())
-            if (seen.insert(resource.uri).second)
-                out.push_back(resource);
-    }
-    return out;
+    return listing()->resources;
 }
 
 std::optional<resources::Resource>
 SkillsDirectoryProvider::get_resource(const std::string& uri) const
 {
-    ensure_discovered();
-    for (const auto& provider : providers_)
-    {
-        auto resource = provider->get_resource(uri);
-        if (resource)
-            return resource;
-    }
-    return std::nullopt;
+    auto current = listing();
+    auto it = current->resource_by_uri.find(uri);
+    if (it == current->resource_by_uri.end())
+        return std::nullopt;
+    return current->resources[it->second];
 }
 
 std::vector<resources::ResourceTemplate> SkillsDirectoryProvider::list_resource_templates() const
 {
-    ensure_discovered();
-    std::vector<resources::ResourceTemplate> out;
-    std::unordered_set<std::string> seen;
-    for (const auto& provider : providers_)
-    {
-        for (const auto& templ : provider->list_resource_templates())
-            if (seen.insert(templ.uri_template).second)
-                out.push_back(templ);
-    }
-    return out;
+    return listing()->templates;
 }
 
 std::optional<resources::ResourceTemplate>
 SkillsDirectoryProvider::get_resource_template(const std::string& uri) const
 {
-    ensure_discovered();
-    for (const auto& provider : providers_)
-    {
-        auto templ = provider->get_resource_template(uri);
-        if (templ)
+    auto current = listing();
+    for (const auto& templ : current->templates)
+        if (templ.match(uri))
             return templ;
-    }
     return std::nullopt;
 }
 
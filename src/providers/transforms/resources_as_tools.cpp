@@ -59,11 +59,12 @@ tools::Tool ResourcesAsTools::make_read_resource_tool() const
         auto content = reader(uri, Json::object());
         if (auto* text = std::get_if<std::string>(&content.data))
             return Json{{"type", "text"}, {"text", *text}};
-        if (std::get_if<std::vector<uint8_t>>(&content.data))
-            return Json{{"type", "text"},
-                        {"text", std::string("[binary data: ") +
-                                     content.mime_type.value_or("application/octet-stream") + "]"}};
-        return Json{{"type", "text"}, {"text", ""}};
+        if (auto* stream = std::get_if<resources::ContentStream>(&content.data);
+            stream && stream->is_text())
+            return Json{{"type", "text"}, {"text", stream->read_all()}};
+        return Json{{"type", "text"},
+                    {"text", std::string("[binary data: ") +
+                                 content.mime_type.value_or("application/octet-stream") + "]"}};
     };
 
     Json schema = {{"type", "object"},
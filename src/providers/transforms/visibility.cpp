@@ -14,6 +14,7 @@ void Visibility::disable(const std::vector<std::string>& keys)
 {
     for (const auto& key : keys)
         disabled_keys_.insert(key);
+    generation_.bump();
 }
 
 void Visibility::enable(const std::vector<std::string>& keys, bool only)
@@ -24,11 +25,13 @@ void Visibility::enable(const std::vector<std::string>& keys, bool only)
         enabled_keys_.clear();
         for (const auto& key : keys)
             enabled_keys_.insert(key);
+        generation_.bump();
         return;
     }
 
     for (const auto& key : keys)
         disabled_keys_.erase(key);
+    generation_.bump();
 }
 
 void Visibility::reset()
@@ -36,6 +39,7 @@ void Visibility::reset()
     disabled_keys_.clear();
     enabled_keys_.clear();
     default_enabled_ = true;
+    generation_.bump();
 }
 
 bool Visibility::is_enabled(const std::string& key) const
@@ -3,18 +3,250 @@
 #include "fastmcpp/client/transports.hpp"
 #include "fastmcpp/exceptions.hpp"
 
+#include <mutex>
+#include <tuple>
 #include <unordered_set>
 
 namespace fastmcpp
 {
 
+namespace detail
+{
+
+struct ProxyRemote : std::enable_shared_from_this<ProxyRemote>
+{
+    template <typename T>
+    struct CacheSlot
+    {
+        std::shared_ptr<const std::vector<T>> items;
+        std::chrono::steady_clock::time_point fetched_at;
+        uint64_t generation{0}; // Bumped on invalidation so in-flight fetches are not stored
+    };
+
+    explicit ProxyRemote(ProxyApp::ClientFactory client_factory)
+        : factory(std::move(client_factory))
+    {
+    }
+
+    ProxyApp::ClientFactory factory;
+
+    mutable std::mutex mutex;
+    std::mutex hook_mutex; // Serializes hook_notifications()
+    std::chrono::milliseconds ttl{std::chrono::seconds(30)};
+    size_t max_idle{4};
+    std::vector<std::unique_ptr<client::Client>> idle;
+    std::tuple<CacheSlot<client::ToolInfo>, CacheSlot<client::ResourceInfo>,
+               CacheSlot<client::ResourceTemplate>, CacheSlot<client::PromptInfo>>
+        slots;
+    ProxyCacheStats stats;
+
+    std::unique_ptr<client::Client> acquire()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!idle.empty())
+            {
+                auto client = std::move(idle.back());
+                idle.pop_back();
+                return client;
+            }
+            ++stats.clients_created;
+        }
+
+        auto client = std::make_unique<client::Client>(factory());
+        hook_notifications(*client);
+        return client;
+    }
+
+    /// Notification callback that drops cached lists on list_changed, then passes
+    /// every notification on to the callback the transport had before.
+    struct ListChangedForwarder
+    {
+        std::weak_ptr<ProxyRemote> remote;
+        std::function<void(const Json&)> next;
+
+        void operator()(const Json& notification) const
+        {
+            if (auto self = remote.lock())
+                self->handle_list_changed(notification.value("method", ""));
+            if (next)
+                next(notification);
+        }
+    };
+
+    /// Install a forwarder on the client's transport unless its chain already has
+    /// one of ours. Factories may hand out clients sharing one transport, so this
+    /// usually happens once per transport.
+    void hook_notifications(client::Client& client)
+    {
+        std::lock_guard<std::mutex> lock(hook_mutex);
+        auto current = client.notification_handler();
+        for (auto* link = current.target<ListChangedForwarder>(); link;
+             link = link->next.target<ListChangedForwarder>())
+            if (link->remote.lock().get() == this)
+                return;
+        client.set_notification_handler(ListChangedForwarder{weak_from_this(), std::move(current)});
+    }
+
+    void release(std::unique_ptr<client::Client> client)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (idle.size() < max_idle)
+            idle.push_back(std::move(client));
+    }
+
+    /// Run `fn` with a pooled client. The client goes back to the pool unless the
+    /// call failed in a way that may have left its connection unusable.
+    template <typename Fn>
+    auto with_client(Fn&& fn) -> decltype(fn(std::declval<client::Client&>()))
+    {
+        auto client = acquire();
+        try
+        {
+            auto result = fn(*client);
+            release(std::move(client));
+            return result;
+        }
+        catch (const TransportError&)
+        {
+            throw;
+        }
+        catch (const Error&)
+        {
+            // A JSON-RPC error reply; the connection itself is fine
+            release(std::move(client));
+            throw;
+        }
+    }
+
+    /// Remote list of `T`, from the cache while it is fresh.
+    template <typename T, typename Fetch>
+    std::shared_ptr<const std::vector<T>> list(Fetch&& fetch)
+    {
+        auto& slot = std::get<CacheSlot<T>>(slots);
+        uint64_t generation;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (slot.items && std::chrono::steady_clock::now() - slot.fetched_at < ttl)
+            {
+                ++stats.hits;
+                return slot.items;
+            }
+            ++stats.misses;
+            generation = slot.generation;
+        }
+
+        auto items = std::make_shared<const std::vector<T>>(with_client(fetch));
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (ttl.count() > 0 && slot.generation == generation)
+        {
+            slot.items = items;
+            slot.fetched_at = std::chrono::steady_clock::now();
+        }
+        return items;
+    }
+
+    template <typename T>
+    void invalidate_locked()
+    {
+        auto& slot = std::get<CacheSlot<T>>(slots);
+        ++slot.generation;
+        if (slot.items)
+        {
+            slot.items.reset();
+            ++stats.invalidations;
+        }
+    }
+
+    void invalidate_all()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        invalidate_locked<client::ToolInfo>();
+        invalidate_locked<client::ResourceInfo>();
+        invalidate_locked<client::ResourceTemplate>();
+        invalidate_locked<client::PromptInfo>();
+    }
+
+    bool handle_list_changed(const std::string& method)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (method == "notifications/tools/list_changed")
+        {
+            invalidate_locked<client::ToolInfo>();
+        }
+        else if (method == "notifications/resources/list_changed")
+        {
+            invalidate_locked<client::ResourceInfo>();
+            invalidate_locked<client::ResourceTemplate>();
+        }
+        else if (method == "notifications/prompts/list_changed")
+        {
+            invalidate_locked<client::PromptInfo>();
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+};
+
+} // namespace detail
+
 ProxyApp::ProxyApp(ClientFactory client_factory, std::string name, std::string version,
                    std::optional<std::string> instructions)
-    : client_factory_(std::move(client_factory)), name_(std::move(name)),
-      version_(std::move(version)), instructions_(std::move(instructions))
+    : client_factory_(client_factory),
+      remote_(std::make_shared<detail::ProxyRemote>(std::move(client_factory))),
+      name_(std::move(name)), version_(std::move(version)), instructions_(std::move(instructions))
 {
 }
 
+// =========================================================================
+// Remote Caching
+// =========================================================================
+
+std::chrono::milliseconds ProxyApp::catalog_ttl() const
+{
+    std::lock_guard<std::mutex> lock(remote_->mutex);
+    return remote_->ttl;
+}
+
+void ProxyApp::set_catalog_ttl(std::chrono::milliseconds ttl)
+{
+    {
+        std::lock_guard<std::mutex> lock(remote_->mutex);
+        remote_->ttl = ttl;
+    }
+    invalidate_catalog();
+}
+
+void ProxyApp::set_max_idle_clients(size_t max_idle)
+{
+    std::lock_guard<std::mutex> lock(remote_->mutex);
+    remote_->max_idle = max_idle;
+    if (remote_->idle.size() > max_idle)
+        remote_->idle.resize(max_idle);
+}
+
+void ProxyApp::invalidate_catalog()
+{
+    remote_->invalidate_all();
+}
+
+bool ProxyApp::handle_list_changed(const std::string& method)
+{
+    return remote_->handle_list_changed(method);
+}
+
+ProxyCacheStats ProxyApp::cache_stats() const
+{
+    std::lock_guard<std::mutex> lock(remote_->mutex);
+    auto stats = remote_->stats;
+    stats.idle_clients = remote_->idle.size();
+    return stats;
+}
+
 // =========================================================================
 // Conversion Helpers
 // =========================================================================
@@ -109,10 +341,10 @@ std::vector<client::ToolInfo> ProxyApp::list_all_tools() const
     // Try to fetch remote tools
     try
     {
-        auto client = client_factory_();
-        auto remote_tools = client.list_tools();
+        auto remote_tools = remote_->list<client::ToolInfo>([](client::Client& client)
+                                                            { return client.list_tools(); });
 
-        for (const auto& tool : remote_tools)
+        for (const auto& tool : *remote_tools)
         {
             // Only add if not already present locally
             if (local_names.find(tool.name) == local_names.end())
@@ -145,10 +377,10 @@ std::vector<client::ResourceInfo> ProxyApp::list_all_resources() const
     // Try to fetch remote resources
     try
     {
-        auto client = client_factory_();
-        auto remote_resources = client.list_resources();
+        auto remote_resources = remote_->list<client::ResourceInfo>(
+            [](client::Client& client) { return client.list_resources(); });
 
-        for (const auto& res : remote_resources)
+        for (const auto& res : *remote_resources)
             if (local_uris.find(res.uri) == local_uris.end())
                 result.push_back(res);
     }
@@ -177,10 +409,10 @@ std::vector<client::ResourceTemplate> ProxyApp::list_all_resource_templates() co
     // Try to fetch remote templates
     try
     {
-        auto client = client_factory_();
-        auto remote_templates = client.list_resource_templates();
+        auto remote_templates = remote_->list<client::ResourceTemplate>(
+            [](client::Client& client) { return client.list_resource_templates(); });
 
-        for (const auto& templ : remote_templates)
+        for (const auto& templ : *remote_templates)
             if (local_templates.find(templ.uriTemplate) == local_templates.end())
                 result.push_back(templ);
     }
@@ -209,10 +441,10 @@ std::vector<client::PromptInfo> ProxyApp::list_all_prompts() const
     // Try to fetch remote prompts
     try
     {
-        auto client = client_factory_();
-        auto remote_prompts = client.list_prompts();
+        auto remote_prompts = remote_->list<client::PromptInfo>([](client::Client& client)
+                                                                { return client.list_prompts(); });
 
-        for (const auto& prompt : remote_prompts)
+        for (const auto& prompt : *remote_prompts)
             if (local_names.find(prompt.name) == local_names.end())
                 result.push_back(prompt);
     }
@@ -264,8 +496,12 @@ client::CallToolResult ProxyApp::invoke_tool(const std::string& name, const Json
     }
 
     // Try remote
-    auto client = client_factory_();
-    return client.call_tool(name, args, std::nullopt, std::chrono::milliseconds{0}, nullptr, false);
+    return remote_->with_client(
+        [&](client::Client& client)
+        {
+            return client.call_tool(name, args, std::nullopt, std::chrono::milliseconds{0}, nullptr,
+                                    false);
+        });
 }
 
 client::ReadResourceResult ProxyApp::read_resource(const std::string& uri) const
@@ -278,43 +514,29 @@ client::ReadResourceResult ProxyApp::read_resource(const std::string& uri) const
         // Convert to ReadResourceResult
         client::ReadResourceResult result;
 
-        // Handle text vs binary content
-        if (std::holds_alternative<std::string>(content.data))
+        // Text, binary and streamed content all arrive as {uri, mimeType?, text | blob}
+        auto entry = resources::content_to_json(std::move(content));
+        auto take = [&entry](const char* key)
+        { return std::move(entry[key].get_ref<std::string&>()); };
+        std::optional<std::string> mime_type;
+        if (entry.contains("mimeType"))
+            mime_type = take("mimeType");
+
+        if (entry.contains("text"))
         {
             client::TextResourceContent trc;
-            trc.uri = content.uri;
-            trc.mimeType = content.mime_type;
-            trc.text = std::get<std::string>(content.data);
-            result.contents.push_back(trc);
+            trc.uri = take("uri");
+            trc.mimeType = std::move(mime_type);
+            trc.text = take("text");
+            result.contents.push_back(std::move(trc));
         }
         else
         {
-            // Binary data - base64 encode
-            const auto& bytes = std::get<std::vector<uint8_t>>(content.data);
-            static const char* base64_chars =
-                "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-            std::string encoded;
-            int val = 0, valb = -6;
-            for (uint8_t c : bytes)
-            {
-                val = (val << 8) + c;
-                valb += 8;
-                while (valb >= 0)
-                {
-                    encoded.push_back(base64_chars[(val >> valb) & 0x3F]);
-                    valb -= 6;
-                }
-            }
-            if (valb > -6)
-                encoded.push_back(base64_chars[((val << 8) >> (valb + 8)) & 0x3F]);
-            while (encoded.size() % 4)
-                encoded.push_back('=');
-
             client::BlobResourceContent brc;
-            brc.uri = content.uri;
-            brc.mimeType = content.mime_type;
-            brc.blob = encoded;
-            result.contents.push_back(brc);
+            brc.uri = take("uri");
+            brc.mimeType = std::move(mime_type);
+            brc.blob = take("blob");
+            result.contents.push_back(std::move(brc));
         }
 
         return result;
@@ -325,8 +547,8 @@ client::ReadResourceResult ProxyApp::read_resource(const std::string& uri) const
     }
 
     // Try remote
-    auto client = client_factory_();
-    return client.read_resource_mcp(uri);
+    return remote_->with_client([&](client::Client& client)
+                                { return client.read_resource_mcp(uri); });
 }
 
 client::GetPromptResult ProxyApp::get_prompt(const std::string& name, const Json& args) const
@@ -369,8 +591,8 @@ client::GetPromptResult ProxyApp::get_prompt(const std::string& name, const Json
     }
 
     // Try remote
-    auto client = client_factory_();
-    return client.get_prompt_mcp(name, args);
+    return remote_->with_client([&](client::Client& client)
+                                { return client.get_prompt_mcp(name, args); });
 }
 
 // ===============================================================================
@@ -1,3 +1,223 @@
 #include "fastmcpp/resources/resource.hpp"
 
-// header-only for now
+#include "fastmcpp/exceptions.hpp"
+#include "fastmcpp/util/base64.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fastmcpp::resources
+{
+namespace
+{
+constexpr size_t kReadChunk = 64 * 1024;
+
+void write_file_buffered(const std::filesystem::path& path, uint64_t offset, uint64_t length,
+                         const ContentStream::ChunkSink& sink)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        throw NotFoundError("Resource file not found: " + path.string());
+    in.seekg(static_cast<std::streamoff>(offset));
+    std::string buffer(kReadChunk, '\0');
+    while (length > 0 && in)
+    {
+        in.read(buffer.data(),
+                static_cast<std::streamsize>(std::min<uint64_t>(buffer.size(), length)));
+        const auto got = static_cast<size_t>(in.gcount());
+        if (got == 0)
+            break;
+        sink(buffer.data(), got);
+        length -= got;
+    }
+}
+
+#ifndef _WIN32
+struct Fd
+{
+    int value;
+    ~Fd()
+    {
+        if (value >= 0)
+            ::close(value);
+    }
+};
+
+/// Reads the range through one bounded buffer with pread(). A file truncated
+/// meanwhile just ends the stream early.
+void write_file_pread(const std::filesystem::path& path, uint64_t offset, uint64_t length,
+                      const ContentStream::ChunkSink& sink)
+{
+    Fd fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (fd.value < 0)
+        throw NotFoundError("Resource file not found: " + path.string());
+    std::string buffer(static_cast<size_t>(std::min<uint64_t>(kReadChunk, length)), '\0');
+    while (length > 0)
+    {
+        const auto want = static_cast<size_t>(std::min<uint64_t>(buffer.size(), length));
+        const ssize_t got = ::pread(fd.value, buffer.data(), want, static_cast<off_t>(offset));
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got < 0)
+            throw Error("Failed to read resource file: " + path.string());
+        if (got == 0)
+            break;
+        sink(buffer.data(), static_cast<size_t>(got));
+        offset += static_cast<uint64_t>(got);
+        length -= static_cast<uint64_t>(got);
+    }
+}
+
+/// Maps the range one window at a time and hands each window to the sink
+/// directly, so resident memory is bounded by the window size.
+/// @return false, before writing anything, when the file cannot be mapped
+bool write_file_mapped(const std::filesystem::path& path, uint64_t offset, uint64_t length,
+                       const ContentStream::ChunkSink& sink)
+{
+    constexpr uint64_t kWindow = 4 * 1024 * 1024;
+
+    Fd fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (fd.value < 0)
+        return false;
+    struct stat info;
+    if (::fstat(fd.value, &info) != 0 || !S_ISREG(info.st_mode))
+        return false;
+
+    const auto file_size = static_cast<uint64_t>(info.st_size);
+    if (offset >= file_size)
+        return true;
+    length = std::min(length, file_size - offset);
+
+    const auto page = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+    uint64_t pos = offset;
+    const uint64_t end = offset + length;
+    while (pos < end)
+    {
+        const uint64_t base = pos / page * page;
+        const uint64_t window_end = std::min(end, base + kWindow);
+        const auto mapped = static_cast<size_t>(window_end - base);
+        void* addr =
+            ::mmap(nullptr, mapped, PROT_READ, MAP_PRIVATE, fd.value, static_cast<off_t>(base));
+        if (addr == MAP_FAILED)
+        {
+            if (pos == offset)
+                return false;
+            throw Error("Failed to map resource file: " + path.string());
+        }
+        struct Mapping
+        {
+            void* addr;
+            size_t size;
+            ~Mapping()
+            {
+                ::munmap(addr, size);
+            }
+        } mapping{addr, mapped};
+        ::madvise(addr, mapped, MADV_SEQUENTIAL);
+
+        sink(static_cast<const char*>(addr) + (pos - base), static_cast<size_t>(window_end - pos));
+        pos = window_end;
+    }
+    return true;
+}
+#endif
+
+/// Byte count a stream of `length` bytes from `offset` of `path` will produce.
+uint64_t file_range_size(const std::filesystem::path& path, uint64_t offset,
+                         std::optional<uint64_t> length)
+{
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec))
+        throw NotFoundError("Resource file not found: " + path.string());
+    const uint64_t file_size = std::filesystem::file_size(path, ec);
+    const uint64_t available = ec || offset > file_size ? 0 : file_size - offset;
+    return std::min(length.value_or(available), available);
+}
+} // namespace
+
+ContentStream ContentStream::from_file(const std::filesystem::path& path, bool text,
+                                       uint64_t offset, std::optional<uint64_t> length)
+{
+    const uint64_t size = file_range_size(path, offset, length);
+    Producer producer = [path, offset, size](const ChunkSink& sink)
+    {
+        if (size == 0)
+            return;
+#ifndef _WIN32
+        write_file_pread(path, offset, size, sink);
+#else
+        write_file_buffered(path, offset, size, sink);
+#endif
+    };
+    return ContentStream(std::move(producer), size, text);
+}
+
+ContentStream ContentStream::from_mapped_file(const std::filesystem::path& path, bool text,
+                                              uint64_t offset, std::optional<uint64_t> length)
+{
+    const uint64_t size = file_range_size(path, offset, length);
+    Producer producer = [path, offset, size](const ChunkSink& sink)
+    {
+        if (size == 0)
+            return;
+#ifndef _WIN32
+        if (write_file_mapped(path, offset, size, sink))
+            return;
+#endif
+        write_file_buffered(path, offset, size, sink);
+    };
+    return ContentStream(std::move(producer), size, text);
+}
+
+std::string ContentStream::read_all() const
+{
+    std::string out;
+    if (size_)
+        out.reserve(static_cast<size_t>(*size_));
+    write_to([&out](const char* data, size_t size) { out.append(data, size); });
+    return out;
+}
+
+Json content_to_json(ResourceContent content)
+{
+    Json entry = {{"uri", std::move(content.uri)}};
+    if (content.mime_type)
+        entry["mimeType"] = std::move(*content.mime_type);
+
+    if (auto* text = std::get_if<std::string>(&content.data))
+    {
+        entry["text"] = std::move(*text);
+    }
+    else if (auto* bytes = std::get_if<std::vector<uint8_t>>(&content.data))
+    {
+        entry["blob"] = util::base64::encode(bytes->data(), bytes->size());
+    }
+    else
+    {
+        const auto& stream = std::get<ContentStream>(content.data);
+        if (stream.is_text())
+        {
+            entry["text"] = stream.read_all();
+            return entry;
+        }
+        std::string blob;
+        if (auto size = stream.size())
+            blob.reserve(util::base64::encoded_size(static_cast<size_t>(*size)));
+        util::base64::Encoder encoder([&blob](const char* data, size_t size)
+                                      { blob.append(data, size); });
+        stream.write_to([&encoder](const char* data, size_t size) { encoder.update(data, size); });
+        encoder.finish();
+        entry["blob"] = std::move(blob);
+    }
+    return entry;
+}
+
+} // namespace fastmcpp::resources
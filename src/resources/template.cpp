@@ -1,10 +1,12 @@
 #include "fastmcpp/resources/template.hpp"
 
 #include "fastmcpp/exceptions.hpp"
+#include "fastmcpp/resources/uri_router.hpp"
 
 #include <algorithm>
 #include <cctype>
 #include <iomanip>
+#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -20,6 +22,18 @@ std::string to_lower(std::string s)
     return s;
 }
 
+ParamKind kind_from_schema_type(const std::string& schema_type)
+{
+    if (schema_type == "boolean")
+        return ParamKind::Boolean;
+    if (schema_type == "integer")
+        return ParamKind::Integer;
+    if (schema_type == "number")
+        return ParamKind::Number;
+    return ParamKind::String;
+}
+} // namespace
+
 // Python fastmcp commit 970b92bb: parameter names with hyphens are exposed to providers as
 // underscore-keyed entries (Python identifiers cannot contain hyphens, and `re` named groups
 // follow the same rule). We mirror this for cross-implementation parity so a template such as
@@ -33,18 +47,6 @@ std::string normalize_param_key(const std::string& name)
     return result;
 }
 
-ParamKind kind_from_schema_type(const std::string& schema_type)
-{
-    if (schema_type == "boolean")
-        return ParamKind::Boolean;
-    if (schema_type == "integer")
-        return ParamKind::Integer;
-    if (schema_type == "number")
-        return ParamKind::Number;
-    return ParamKind::String;
-}
-} // namespace
-
 Json coerce_param_value(const std::string& value, ParamKind kind, const std::string& param_name)
 {
     switch (kind)
@@ -351,18 +353,9 @@ void ResourceTemplate::parse()
         }
     }
 
-    // Build and compile regex
-    std::string pattern = build_regex_pattern(uri_template);
-
-    try
-    {
-        uri_regex = std::regex(pattern, std::regex::ECMAScript);
-    }
-    catch (const std::regex_error& e)
-    {
-        throw fastmcpp::ValidationError("Failed to compile URI template regex: " +
-                                        std::string(e.what()));
-    }
+    auto router = std::make_shared<UriTemplateRouter>();
+    router->add(*this);
+    matcher = std::move(router);
 }
 
 Json ResourceTemplate::build_typed_params(
@@ -388,74 +381,12 @@ Json ResourceTemplate::build_typed_params(
 std::optional<std::unordered_map<std::string, std::string>>
 ResourceTemplate::match(const std::string& uri) const
 {
-    std::smatch match;
-
-    if (!std::regex_match(uri, match, uri_regex))
+    if (!matcher)
         return std::nullopt;
-
-    std::unordered_map<std::string, std::string> params;
-
-    // Extract named groups
-    for (const auto& param : parsed_params)
-    {
-        if (param.is_query)
-        {
-            // Parse query string manually
-            size_t query_start = uri.find('?');
-            if (query_start != std::string::npos)
-            {
-                std::string query = uri.substr(query_start + 1);
-
-                // Parse key=value pairs
-                std::istringstream iss(query);
-                std::string pair;
-                while (std::getline(iss, pair, '&'))
-                {
-                    size_t eq_pos = pair.find('=');
-                    if (eq_pos != std::string::npos)
-                    {
-                        std::string key = pair.substr(0, eq_pos);
-                        std::string value = pair.substr(eq_pos + 1);
-
-                        if (key == param.name)
-                            params[normalize_param_key(param.name)] = url_decode(value);
-                    }
-                }
-            }
-        }
-        else
-        {
-            // Try to get named group from regex match
-            // Note: std::regex doesn't support named groups well in all implementations
-            // We'll fall back to positional matching
-
-            // Find position of this parameter in the template
-            std::string placeholder = "{" + param.name + (param.is_wildcard ? "*}" : "}");
-            size_t param_pos = uri_template.find(placeholder);
-
-            // Count how many groups come before this one
-            int group_index = 1;
-            for (const auto& other_param : parsed_params)
-            {
-                if (other_param.is_query)
-                    continue;
-
-                std::string other_placeholder =
-                    "{" + other_param.name + (other_param.is_wildcard ? "*}" : "}");
-                size_t other_pos = uri_template.find(other_placeholder);
-
-                if (other_pos < param_pos)
-                    ++group_index;
-                else if (&other_param == &param)
-                    break;
-            }
-
-            if (group_index < static_cast<int>(match.size()))
-                params[normalize_param_key(param.name)] = url_decode(match[group_index].str());
-        }
-    }
-
-    return params;
+    auto match = matcher->match(uri);
+    if (!match)
+        return std::nullopt;
+    return std::move(match->params);
 }
 
 Resource
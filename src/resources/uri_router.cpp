@@ -0,0 +1,277 @@
+#include "fastmcpp/resources/uri_router.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace fastmcpp::resources
+{
+
+namespace
+{
+enum class TokenKind
+{
+    Literal,
+    Param,
+    Wildcard,
+    Query
+};
+
+struct Token
+{
+    TokenKind kind;
+    std::string text; // Literal text, or the placeholder without its braces
+};
+
+// Splits a template exactly as build_regex_pattern() does: an unterminated '{'
+// starts literal text, "{?...}" is a query, any '*' makes a wildcard.
+std::vector<Token> tokenize_template(const std::string& uri_template)
+{
+    std::vector<Token> tokens;
+    size_t pos = 0;
+    while (pos < uri_template.size())
+    {
+        size_t start = uri_template.find('{', pos);
+        size_t end = start == std::string::npos ? std::string::npos : uri_template.find('}', start);
+        if (end == std::string::npos)
+        {
+            tokens.push_back({TokenKind::Literal, uri_template.substr(pos)});
+            break;
+        }
+        if (start > pos)
+            tokens.push_back({TokenKind::Literal, uri_template.substr(pos, start - pos)});
+
+        std::string content = uri_template.substr(start + 1, end - start - 1);
+        if (!content.empty() && content[0] == '?')
+            tokens.push_back({TokenKind::Query, content.substr(1)});
+        else if (content.find('*') != std::string::npos)
+            tokens.push_back({TokenKind::Wildcard, content.substr(0, content.find('*'))});
+        else
+            tokens.push_back({TokenKind::Param, std::move(content)});
+        pos = end + 1;
+    }
+    return tokens;
+}
+} // namespace
+
+/// Depth-first walk over the tree. Each placeholder tries its longest extent
+/// first, so the first time a template's terminal is reached its captures are
+/// the ones a backtracking regex would produce. Subtrees holding no template
+/// earlier than the best match so far are skipped.
+struct UriTemplateRouter::Search
+{
+    const std::vector<Node>& nodes;
+    const std::string& uri;
+    std::vector<Span> spans;
+    size_t best = npos;
+    std::vector<Span> best_spans;
+
+    void visit(NodeId id, size_t pos)
+    {
+        const Node& node = nodes[id];
+        if (node.min_template >= best)
+            return;
+        if (pos == uri.size() && node.terminal < best)
+        {
+            best = node.terminal;
+            best_spans = spans;
+        }
+
+        if (pos < uri.size() && !node.literals.empty())
+        {
+            size_t at = edge_at(node, uri[pos]);
+            if (at < node.literals.size())
+            {
+                const auto& edge = node.literals[at];
+                if (uri.compare(pos, edge.label.size(), edge.label) == 0)
+                    visit(edge.child, pos + edge.label.size());
+            }
+        }
+        if (node.param != kNoNode)
+            capture(node.param, pos, std::min(uri.find_first_of("/?#", pos), uri.size()));
+        if (node.wildcard != kNoNode)
+            capture(node.wildcard, pos, std::min(uri.find_first_of("\r\n", pos), uri.size()));
+        if (node.query != kNoNode)
+        {
+            // (?:\?[^#]*)? - the query string itself is parsed from the URI afterwards
+            if (pos < uri.size() && uri[pos] == '?')
+                for (size_t end = std::min(uri.find('#', pos), uri.size()); end > pos; --end)
+                    visit(node.query, end);
+            visit(node.query, pos);
+        }
+    }
+
+    /// One or more characters of [pos, stop), longest first.
+    void capture(NodeId child, size_t pos, size_t stop)
+    {
+        for (size_t end = stop; end > pos; --end)
+        {
+            spans.push_back({pos, end});
+            visit(child, end);
+            spans.pop_back();
+        }
+    }
+};
+
+void UriTemplateRouter::add(const ResourceTemplate& templ)
+{
+    const size_t index = templates_.size();
+    CompiledTemplate compiled;
+    for (const auto& param : templ.parsed_params)
+        compiled.kinds.emplace(param.name, param.kind);
+
+    if (nodes_.empty())
+        new_node();
+    NodeId node = 0;
+    nodes_[node].min_template = std::min(nodes_[node].min_template, index);
+    for (const auto& token : tokenize_template(templ.uri_template))
+    {
+        switch (token.kind)
+        {
+        case TokenKind::Literal:
+            node = insert_literal(node, token.text, index);
+            break;
+        case TokenKind::Param:
+            compiled.path_names.push_back(token.text);
+            node = child(node, &Node::param, index);
+            break;
+        case TokenKind::Wildcard:
+            compiled.path_names.push_back(token.text);
+            node = child(node, &Node::wildcard, index);
+            break;
+        case TokenKind::Query:
+            for (const auto& name : extract_query_params("{?" + token.text + "}"))
+                compiled.query_names.push_back(name);
+            node = child(node, &Node::query, index);
+            break;
+        }
+    }
+    if (nodes_[node].terminal == npos)
+        nodes_[node].terminal = index;
+    templates_.push_back(std::move(compiled));
+}
+
+void UriTemplateRouter::clear()
+{
+    nodes_.clear();
+    templates_.clear();
+}
+
+std::optional<UriTemplateRouter::Match> UriTemplateRouter::match(const std::string& uri) const
+{
+    if (nodes_.empty())
+        return std::nullopt;
+    Search search{nodes_, uri, {}, npos, {}};
+    search.visit(0, 0);
+    if (search.best == npos)
+        return std::nullopt;
+
+    Match match{search.best, {}};
+    const auto& compiled = templates_[search.best];
+    const size_t captured = std::min(search.best_spans.size(), compiled.path_names.size());
+    for (size_t i = 0; i < captured; ++i)
+    {
+        const auto& span = search.best_spans[i];
+        match.params[normalize_param_key(compiled.path_names[i])] =
+            url_decode(uri.substr(span.begin, span.end - span.begin));
+    }
+
+    size_t query_start = uri.find('?');
+    if (compiled.query_names.empty() || query_start == std::string::npos)
+        return match;
+    size_t pos = query_start + 1;
+    while (pos <= uri.size())
+    {
+        size_t end = std::min(uri.find('&', pos), uri.size());
+        size_t eq = uri.find('=', pos);
+        if (eq < end)
+        {
+            std::string key = uri.substr(pos, eq - pos);
+            for (const auto& name : compiled.query_names)
+                if (key == name)
+                    match.params[normalize_param_key(name)] =
+                        url_decode(uri.substr(eq + 1, end - eq - 1));
+        }
+        pos = end + 1;
+    }
+    return match;
+}
+
+Json UriTemplateRouter::typed_params(const Match& match) const
+{
+    const auto& kinds = templates_[match.index].kinds;
+    Json result = Json::object();
+    for (const auto& [key, value] : match.params)
+    {
+        auto it = kinds.find(key);
+        result[key] =
+            coerce_param_value(value, it == kinds.end() ? ParamKind::String : it->second, key);
+    }
+    return result;
+}
+
+UriTemplateRouter::NodeId UriTemplateRouter::new_node()
+{
+    nodes_.emplace_back();
+    return static_cast<NodeId>(nodes_.size() - 1);
+}
+
+size_t UriTemplateRouter::edge_at(const Node& node, char c)
+{
+    auto it = std::lower_bound(node.literals.begin(), node.literals.end(), c,
+                               [](const Edge& edge, char first) { return edge.label[0] < first; });
+    return static_cast<size_t>(it - node.literals.begin());
+}
+
+UriTemplateRouter::NodeId UriTemplateRouter::insert_literal(NodeId node, const std::string& text,
+                                                            size_t index)
+{
+    size_t i = 0;
+    while (i < text.size())
+    {
+        size_t at = edge_at(nodes_[node], text[i]);
+        const auto& edges = nodes_[node].literals;
+        if (at == edges.size() || edges[at].label[0] != text[i])
+        {
+            NodeId leaf = new_node(); // Invalidates `edges`
+            nodes_[leaf].min_template = index;
+            auto& literals = nodes_[node].literals;
+            literals.insert(literals.begin() + static_cast<std::ptrdiff_t>(at),
+                            Edge{text.substr(i), leaf});
+            return leaf;
+        }
+
+        size_t common = 0;
+        const auto& label = edges[at].label;
+        while (common < label.size() && i + common < text.size() &&
+               label[common] == text[i + common])
+            ++common;
+        if (common < label.size())
+        {
+            // Split the edge where the texts diverge
+            NodeId mid = new_node();
+            auto& edge = nodes_[node].literals[at];
+            nodes_[mid].literals.push_back(Edge{edge.label.substr(common), edge.child});
+            nodes_[mid].min_template = nodes_[edge.child].min_template;
+            edge.label.resize(common);
+            edge.child = mid;
+        }
+        node = nodes_[node].literals[at].child;
+        nodes_[node].min_template = std::min(nodes_[node].min_template, index);
+        i += common;
+    }
+    return node;
+}
+
+UriTemplateRouter::NodeId UriTemplateRouter::child(NodeId node, NodeId Node::*slot, size_t index)
+{
+    if (nodes_[node].*slot == kNoNode)
+    {
+        NodeId created = new_node();
+        nodes_[node].*slot = created;
+    }
+    NodeId next = nodes_[node].*slot;
+    nodes_[next].min_template = std::min(nodes_[next].min_template, index);
+    return next;
+}
+
+} // namespace fastmcpp::resources
@@ -2,6 +2,7 @@
 
 #include "fastmcpp/exceptions.hpp"
 #include "fastmcpp/util/json.hpp"
+#include "fastmcpp/util/jsonrpc.hpp"
 
 #include <algorithm>
 #include <cctype>
@@ -13,6 +14,7 @@
 #include <optional>
 #include <random>
 #include <sstream>
+#include <thread>
 
 namespace fastmcpp::server
 {
@@ -75,6 +77,86 @@ std::optional<TaskNotificationInfo> extract_task_notification_info(const fastmcp
         info.last_updated_at = task["lastUpdatedAt"].get<std::string>();
     return info;
 }
+
+/// httplib task queue whose workers are started on demand, up to a cap, and then
+/// reused. Every open SSE stream occupies a worker for its whole lifetime, so the
+/// streams allowed must leave some of the cap to the workers that serve POSTs;
+/// unlike httplib's fixed ThreadPool, threads are only created once needed.
+class OnDemandTaskQueue : public httplib::TaskQueue
+{
+  public:
+    explicit OnDemandTaskQueue(size_t max_workers) : max_workers_(std::max<size_t>(max_workers, 1))
+    {
+    }
+
+    bool enqueue(std::function<void()> fn) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_)
+                return false;
+            jobs_.push_back(std::move(fn));
+            if (jobs_.size() > idle_workers_ && workers_.size() < max_workers_)
+                workers_.emplace_back([this]() { worker_loop(); });
+        }
+        cv_.notify_one();
+        return true;
+    }
+
+    void shutdown() override
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        // No worker is added once stopping_ is set; queued jobs still run
+        for (auto& worker : workers_)
+            if (worker.joinable())
+                worker.join();
+    }
+
+  private:
+    void worker_loop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;)
+        {
+            ++idle_workers_;
+            cv_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+            --idle_workers_;
+            if (jobs_.empty())
+                return;
+
+            auto job = std::move(jobs_.front());
+            jobs_.pop_front();
+            lock.unlock();
+            try
+            {
+                job();
+            }
+            catch (...)
+            {
+            }
+            lock.lock();
+        }
+    }
+
+    const size_t max_workers_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> jobs_;
+    std::vector<std::thread> workers_;
+    size_t idle_workers_{0};
+    bool stopping_{false};
+};
+
+/// Workers kept available for POST requests next to the SSE streams, out of
+/// `max_threads`; at most half of them, so streams always get some.
+size_t request_workers(size_t max_threads)
+{
+    return std::min(std::max<size_t>(8, std::thread::hardware_concurrency()), max_threads / 2);
+}
 } // namespace
 
 SseServerWrapper::SseServerWrapper(McpHandler handler, std::string host, int port,
@@ -163,117 +245,101 @@ void SseServerWrapper::handle_sse_connection(httplib::DataSink& sink,
         return;
     }
 
-    // Keep connection alive and send events
-    auto last_heartbeat = std::chrono::steady_clock::now();
-    int heartbeat_counter = 0;
+    // Keep connection alive and send events. The worker sleeps until a frame is
+    // queued (events or heartbeats) or the queue is closed by stop() or overflow.
+    schedule_heartbeat(*heartbeats_, conn, heartbeat_interval_, heartbeat_interval_);
 
     while (running_)
     {
-        std::unique_lock<std::mutex> lock(conn->m);
-        // Wait for events on this connection or shutdown
-        conn->cv.wait_for(lock, std::chrono::milliseconds(100),
-                          [&] { return !conn->queue.empty() || !running_ || !conn->alive; });
-
-        if (!running_ || !conn->alive)
+        auto entry = conn->queue.pop();
+        if (!entry)
             break;
 
-        // Send all queued events
-        while (!conn->queue.empty())
-        {
-            auto event = conn->queue.front();
-            conn->queue.pop_front();
-
-            // Release lock while writing to avoid blocking other operations
-            lock.unlock();
+        // is_writable() also notices a client that has hung up while idle
+        if (entry->kind == SseStreamQueue::Kind::Heartbeat && sink.is_writable &&
+            !sink.is_writable())
+            break;
 
-            // Format as SSE event
-            std::string sse_data = "data: " + event.dump() + "\n\n";
+        // Frames are already SSE-encoded and may be shared with other streams
+        if (!sink.write(entry->frame->data(), entry->frame->size()))
+            break;
+    }
+    conn->alive = false;
+    conn->queue.close();
+}
 
-            // Write to sink
-            if (!sink.write(sse_data.data(), sse_data.size()))
-            {
-                conn->alive = false;
+void SseServerWrapper::schedule_heartbeat(util::TimerWheel& wheel,
+                                          std::weak_ptr<ConnectionState> weak_conn,
+                                          std::chrono::milliseconds interval,
+                                          std::chrono::milliseconds delay)
+{
+    wheel.schedule(
+        delay,
+        [&wheel, weak_conn, interval]()
+        {
+            auto conn = weak_conn.lock();
+            if (!conn || !conn->alive || conn->queue.closed())
                 return;
+            auto next = interval;
+            auto idle = conn->queue.idle_for();
+            if (idle >= interval)
+            {
+                // If idle, emit MCP heartbeat event (per MCP SSE protocol, every
+                // 15-30s recommended)
+                auto frame = make_sse_frame(Json(++conn->heartbeat_counter), "heartbeat");
+                conn->queue.push(
+                    SseStreamQueue::Entry{std::move(frame), SseStreamQueue::Kind::Heartbeat, {}});
             }
-
-            lock.lock();
-            last_heartbeat = std::chrono::steady_clock::now();
-        }
-
-        // If idle, emit MCP heartbeat event (per MCP SSE protocol, every 15-30s recommended)
-        auto now = std::chrono::steady_clock::now();
-        if (now - last_heartbeat > std::chrono::seconds(15))
-        {
-            lock.unlock();
-            std::string hb =
-                "event: heartbeat\ndata: " + std::to_string(++heartbeat_counter) + "\n\n";
-            if (!sink.write(hb.data(), hb.size()))
+            else
             {
-                conn->alive = false;
-                return;
+                // Written to recently: check again once it could be idle
+                next = std::chrono::ceil<std::chrono::milliseconds>(interval - idle);
             }
-            last_heartbeat = now;
-            lock.lock();
-        }
-    }
-    conn->alive = false;
+            schedule_heartbeat(wheel, weak_conn, interval, next);
+        });
 }
 
-void SseServerWrapper::send_event_to_all_clients(const fastmcpp::Json& event)
+std::vector<std::shared_ptr<SseServerWrapper::ConnectionState>>
+SseServerWrapper::live_connections(const std::string* session_id)
 {
-    std::lock_guard<std::mutex> lock(conns_mutex_);
-    for (auto it = connections_.begin(); it != connections_.end();)
+    std::vector<std::shared_ptr<ConnectionState>> out;
+    if (session_id)
     {
-        auto& [session_id, conn] = *it;
-        if (!conn->alive)
-        {
-            it = connections_.erase(it);
-            continue;
-        }
-        {
-            std::lock_guard<std::mutex> ql(conn->m);
-            // Enforce queue size limit
-            if (conn->queue.size() >= MAX_QUEUE_SIZE)
-            {
-                // Drop oldest event when queue is full
-                conn->queue.pop_front();
-            }
-            conn->queue.push_back(event);
-        }
-        conn->cv.notify_one();
-        ++it;
+        if (auto conn = connections_.find(*session_id); conn && conn->alive)
+            out.push_back(std::move(conn));
+        return out;
     }
+    for (auto& conn : connections_.snapshot())
+        if (conn->alive)
+            out.push_back(std::move(conn));
+        else
+            connections_.erase_if_same(conn->session_id, conn);
+    return out;
+}
+
+void SseServerWrapper::send_event_to_all_clients(const fastmcpp::Json& event)
+{
+    // Serialized once; every stream queues the same bytes. The push never waits, so a
+    // client stalled under the Block policy cannot hold up the others.
+    auto entry = SseStreamQueue::classify(event, make_sse_frame(event));
+    for (const auto& conn : live_connections(nullptr))
+        conn->queue.try_push(entry);
 }
 
 void SseServerWrapper::send_event_to_session(const std::string& session_id,
                                              const fastmcpp::Json& event)
 {
-    std::lock_guard<std::mutex> lock(conns_mutex_);
-    auto it = connections_.find(session_id);
-    if (it == connections_.end())
-    {
-        // Session not found - likely disconnected or invalid
-        return;
-    }
-
-    auto& conn = it->second;
-    if (!conn->alive)
-    {
-        connections_.erase(it);
-        return;
-    }
+    // Session not found - likely disconnected or invalid
+    for (const auto& conn : live_connections(&session_id))
+        conn->queue.push(event);
+}
 
-    {
-        std::lock_guard<std::mutex> ql(conn->m);
-        // Enforce queue size limit
-        if (conn->queue.size() >= MAX_QUEUE_SIZE)
-        {
-            // Drop oldest event when queue is full
-            conn->queue.pop_front();
-        }
-        conn->queue.push_back(event);
-    }
-    conn->cv.notify_one();
+std::optional<SseQueueStats> SseServerWrapper::queue_stats(const std::string& session_id) const
+{
+    auto conn = connections_.find(session_id);
+    if (!conn)
+        return std::nullopt;
+    return conn->queue.stats();
 }
 
 void SseServerWrapper::run_server()
@@ -308,6 +374,18 @@ bool SseServerWrapper::start()
     bound_port_.store(0); // Reset the bound port's value.
     svr_ = std::make_unique<httplib::Server>();
 
+    // SSE streams park a worker each; POSTs need workers of their own. The thread
+    // cap is fixed, so streams get what the POST workers leave of it.
+    const size_t max_workers = std::max<size_t>(max_threads_, 2);
+    connections_.set_capacity(
+        std::min(max_connections_, max_workers - request_workers(max_workers)));
+    svr_->new_task_queue = [max_workers]() { return new OnDemandTaskQueue(max_workers); };
+
+    // Heartbeats are due every interval; a tick of a quarter of that keeps them
+    // within 25% of schedule without waking more often than needed
+    heartbeats_ = std::make_unique<util::TimerWheel>(std::clamp<std::chrono::milliseconds>(
+        heartbeat_interval_ / 4, std::chrono::milliseconds(10), std::chrono::milliseconds(1000)));
+
     // Security: Set payload and timeout limits to prevent DoS
     svr_->set_payload_max_length(10 * 1024 * 1024); // 10MB max payload
     svr_->set_read_timeout(30, 0);                  // 30 second read timeout
@@ -330,15 +408,12 @@ bool SseServerWrapper::start()
                   }
 
                   // Security: Check connection limit before accepting new connection
+                  if (connections_.full())
                   {
-                      std::lock_guard<std::mutex> lock(conns_mutex_);
-                      if (connections_.size() >= MAX_CONNECTIONS)
-                      {
-                          res.status = 503; // Service Unavailable
-                          res.set_content("{\"error\":\"Maximum connections reached\"}",
-                                          "application/json");
-                          return;
-                      }
+                      res.status = 503; // Service Unavailable
+                      res.set_content("{\"error\":\"Maximum connections reached\"}",
+                                      "application/json");
+                      return;
                   }
 
                   res.status = 200;
@@ -359,37 +434,28 @@ bool SseServerWrapper::start()
                           // Generate cryptographically secure session ID
                           auto session_id = generate_session_id();
 
-                          auto conn = std::make_shared<ConnectionState>();
+                          auto conn = std::make_shared<ConnectionState>(queue_options_);
                           conn->session_id = session_id;
 
                           // Create ServerSession for bidirectional communication
                           // The send callback pushes events to this connection's queue
                           auto weak_conn = std::weak_ptr<ConnectionState>(conn);
-                          conn->server_session = std::make_shared<ServerSession>(
-                              session_id,
-                              [weak_conn, this](const Json& msg)
-                              {
-                                  if (auto c = weak_conn.lock())
-                                  {
-                                      std::lock_guard<std::mutex> ql(c->m);
-                                      if (c->queue.size() < MAX_QUEUE_SIZE)
-                                          c->queue.push_back(msg);
-                                      c->cv.notify_one();
-                                  }
-                              });
-
-                          {
-                              std::lock_guard<std::mutex> lock(conns_mutex_);
-                              connections_[session_id] = conn;
-                          }
+                          conn->server_session =
+                              std::make_shared<ServerSession>(session_id,
+                                                              [weak_conn](const Json& msg)
+                                                              {
+                                                                  if (auto c = weak_conn.lock())
+                                                                      c->queue.push(msg);
+                                                              });
+
+                          // Streams racing past the check above end without a session
+                          if (!connections_.insert(session_id, conn))
+                              return false;
 
                           handle_sse_connection(sink, conn, session_id);
 
                           // Clean up disconnected session
-                          {
-                              std::lock_guard<std::mutex> lock(conns_mutex_);
-                              connections_.erase(session_id);
-                          }
+                          connections_.erase_if_same(session_id, conn);
 
                           return false; // End stream when handle_sse_connection returns
                       },
@@ -461,20 +527,73 @@ bool SseServerWrapper::start()
                 }
 
                 // Security: Verify session exists
+                if (!connections_.contains(session_id))
                 {
-                    std::lock_guard<std::mutex> lock(conns_mutex_);
-                    if (connections_.find(session_id) == connections_.end())
-                    {
-                        res.status = 404;
-                        res.set_content("{\"error\":\"Invalid or expired session_id\"}",
-                                        "application/json");
-                        return;
-                    }
+                    res.status = 404;
+                    res.set_content("{\"error\":\"Invalid or expired session_id\"}",
+                                    "application/json");
+                    return;
                 }
 
                 // Parse JSON-RPC message
                 auto message = fastmcpp::util::json::parse(req.body);
 
+                // Announce a background task started by `response` on the session stream
+                auto announce_task = [this, &session_id](const fastmcpp::Json& response)
+                {
+                    auto info = extract_task_notification_info(response);
+                    if (!info)
+                        return;
+                    auto session = get_session(session_id);
+                    if (!session)
+                        return;
+                    fastmcpp::Json created_meta = {{"modelcontextprotocol.io/related-task",
+                                                    fastmcpp::Json{{"taskId", info->task_id}}}};
+                    session->send_notification("notifications/tasks/created",
+                                               fastmcpp::Json::object(), created_meta);
+
+                    std::string created_at =
+                        info->created_at.empty() ? to_iso8601_now() : info->created_at;
+                    std::string last_updated_at =
+                        info->last_updated_at.empty() ? created_at : info->last_updated_at;
+                    fastmcpp::Json status_params = {
+                        {"taskId", info->task_id}, {"status", info->status},
+                        {"createdAt", created_at}, {"lastUpdatedAt", last_updated_at},
+                        {"ttl", info->ttl_ms},     {"pollInterval", 1000},
+                    };
+                    session->send_notification("notifications/tasks/status", status_params);
+                };
+
+                // JSON-RPC batch: entries are handled like single messages, errors are
+                // reported per entry, and the replies go back as one array
+                if (message.is_array())
+                {
+                    auto reply = fastmcpp::util::jsonrpc::dispatch_batch(
+                        message,
+                        [&](const fastmcpp::Json& entry)
+                        {
+                            auto response = fastmcpp::util::jsonrpc::handle_session_batch_entry(
+                                entry, session_id, handler_,
+                                [&](const fastmcpp::Json& client_response)
+                                {
+                                    if (auto session = get_session(session_id))
+                                        session->handle_response(client_response);
+                                });
+                            announce_task(response);
+                            return response;
+                        });
+
+                    if (reply.is_null())
+                    {
+                        res.status = 202;
+                        return;
+                    }
+                    send_event_to_session(session_id, reply);
+                    res.set_content(reply.dump(), "application/json");
+                    res.status = 200;
+                    return;
+                }
+
                 // Inject session_id into request meta for handler access
                 if (!message.contains("params"))
                     message["params"] = Json::object();
@@ -486,13 +605,7 @@ bool SseServerWrapper::start()
                 if (ServerSession::is_response(message))
                 {
                     // Get the session and route the response
-                    std::shared_ptr<ConnectionState> conn;
-                    {
-                        std::lock_guard<std::mutex> lock(conns_mutex_);
-                        auto it = connections_.find(session_id);
-                        if (it != connections_.end())
-                            conn = it->second;
-                    }
+                    auto conn = connections_.find(session_id);
 
                     if (conn && conn->server_session)
                     {
@@ -530,27 +643,7 @@ bool SseServerWrapper::start()
                 // Normal request - process with handler
                 auto response = handler_(message);
 
-                if (auto info = extract_task_notification_info(response))
-                {
-                    if (auto session = get_session(session_id))
-                    {
-                        fastmcpp::Json created_meta = {{"modelcontextprotocol.io/related-task",
-                                                        fastmcpp::Json{{"taskId", info->task_id}}}};
-                        session->send_notification("notifications/tasks/created",
-                                                   fastmcpp::Json::object(), created_meta);
-
-                        std::string created_at =
-                            info->created_at.empty() ? to_iso8601_now() : info->created_at;
-                        std::string last_updated_at =
-                            info->last_updated_at.empty() ? created_at : info->last_updated_at;
-                        fastmcpp::Json status_params = {
-                            {"taskId", info->task_id}, {"status", info->status},
-                            {"createdAt", created_at}, {"lastUpdatedAt", last_updated_at},
-                            {"ttl", info->ttl_ms},     {"pollInterval", 1000},
-                        };
-                        session->send_notification("notifications/tasks/status", status_params);
-                    }
-                }
+                announce_task(response);
 
                 // Send response only to the requesting session
                 send_event_to_session(session_id, response);
@@ -677,18 +770,17 @@ void SseServerWrapper::stop()
     // Graceful, idempotent shutdown
     running_ = false;
     // Wake any waiting connection queues
+    for (const auto& conn : connections_.snapshot())
     {
-        std::lock_guard<std::mutex> lock(conns_mutex_);
-        for (auto& [session_id, conn] : connections_)
-        {
-            conn->alive = false;
-            conn->cv.notify_all();
-        }
+        conn->alive = false;
+        conn->queue.close();
     }
     if (svr_)
         svr_->stop();
     if (thread_.joinable())
         thread_.join();
+    // Every stream has ended with the server, so no timer is needed any more
+    heartbeats_.reset();
 
     bound_port_.store(0); // Reset the bound port's value.
 }
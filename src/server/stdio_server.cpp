@@ -2,14 +2,20 @@
 
 #include "fastmcpp/exceptions.hpp"
 #include "fastmcpp/util/json.hpp"
+#include "fastmcpp/util/jsonrpc.hpp"
 
 #include <chrono>
+#include <condition_variable>
 #include <ctime>
+#include <deque>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace fastmcpp::server
 {
@@ -72,139 +78,533 @@ std::optional<TaskNotificationInfo> extract_task_notification_info(const fastmcp
         info.last_updated_at = task["lastUpdatedAt"].get<std::string>();
     return info;
 }
-} // namespace
 
-StdioServerWrapper::StdioServerWrapper(McpHandler handler) : handler_(std::move(handler)) {}
+using fastmcpp::util::jsonrpc::is_notification;
 
-StdioServerWrapper::~StdioServerWrapper()
+fastmcpp::Json error_json(const fastmcpp::Json* request, int code, const std::string& message)
 {
-    stop();
+    fastmcpp::Json error_response;
+    error_response["jsonrpc"] = "2.0";
+    if (request && request->is_object() && request->contains("id") && !(*request)["id"].is_null())
+        error_response["id"] = (*request)["id"];
+    error_response["error"] = {{"code", code}, {"message", message}};
+    return error_response;
 }
 
-void StdioServerWrapper::run_loop()
+std::string error_line(const fastmcpp::Json* request, int code, const std::string& message)
 {
-    std::string line;
+    return error_json(request, code, message).dump() + "\n";
+}
 
-    while (running_ && !stop_requested_ && std::getline(std::cin, line))
+/// The request's method, or "" when it is not an object or has no string method.
+std::string method_of(const fastmcpp::Json& request)
+{
+    if (!request.is_object())
+        return {};
+    auto method = request.find("method");
+    return method != request.end() && method->is_string() ? method->get<std::string>()
+                                                           : std::string();
+}
+
+/// What goes back on stdout for one request: task notifications that must precede
+/// the response (when it starts a background task), then the response itself.
+struct Reply
+{
+    std::string prelude;
+    fastmcpp::Json response;
+};
+
+Reply respond(const StdioServerWrapper::McpHandler& handler, const fastmcpp::Json& request)
+{
+    try
     {
-        // Skip empty lines
-        if (line.empty())
-            continue;
+        Reply reply;
+        reply.response = handler(request);
 
-        try
+        if (auto info = extract_task_notification_info(reply.response))
         {
-            // Parse JSON-RPC request
-            auto request = fastmcpp::util::json::parse(line);
+            fastmcpp::Json created_meta = {{"modelcontextprotocol.io/related-task",
+                                            fastmcpp::Json{{"taskId", info->task_id}}}};
+
+            fastmcpp::Json created_notification = {
+                {"jsonrpc", "2.0"},
+                {"method", "notifications/tasks/created"},
+                {"params", fastmcpp::Json::object()},
+                {"_meta", created_meta},
+            };
+
+            std::string created_at = info->created_at.empty() ? to_iso8601_now() : info->created_at;
+            std::string last_updated_at =
+                info->last_updated_at.empty() ? created_at : info->last_updated_at;
+            fastmcpp::Json status_params = {
+                {"taskId", info->task_id}, {"status", info->status},
+                {"createdAt", created_at}, {"lastUpdatedAt", last_updated_at},
+                {"ttl", info->ttl_ms},     {"pollInterval", 1000},
+            };
+
+            fastmcpp::Json status_notification = {
+                {"jsonrpc", "2.0"},
+                {"method", "notifications/tasks/status"},
+                {"params", status_params},
+            };
+
+            reply.prelude += created_notification.dump() + "\n";
+            reply.prelude += status_notification.dump() + "\n";
+        }
+        return reply;
+    }
+    catch (const fastmcpp::NotFoundError& e)
+    {
+        // Method/tool not found → -32601
+        return {{}, error_json(&request, -32601, e.what())};
+    }
+    catch (const fastmcpp::ValidationError& e)
+    {
+        // Invalid params → -32602
+        return {{}, error_json(&request, -32602, e.what())};
+    }
+    catch (const std::exception& e)
+    {
+        // Internal error → -32603
+        return {{}, error_json(&request, -32603, e.what())};
+    }
+}
+
+/// Run one request and render its output, one JSON-RPC message per line.
+std::string handle_request(const StdioServerWrapper::McpHandler& handler,
+                           const fastmcpp::Json& request)
+{
+    auto reply = respond(handler, request);
+    return reply.prelude + reply.response.dump() + "\n";
+}
 
-            // JSON-RPC notifications (missing/null id) must not receive responses.
-            const bool is_notification = !request.contains("id") || request["id"].is_null();
-            if (is_notification)
+void handle_notification(const StdioServerWrapper::McpHandler& handler,
+                         const fastmcpp::Json& request)
+{
+    try
+    {
+        (void)handler(request); // process side effects only
+    }
+    catch (...)
+    {
+        // Ignore notification errors by design.
+    }
+}
+
+/// Run a JSON-RPC batch one entry at a time and render its output: the entries'
+/// task notifications followed by a single array response (none when the batch
+/// held only notifications).
+std::string handle_batch(const StdioServerWrapper::McpHandler& handler, const fastmcpp::Json& batch)
+{
+    std::string prelude;
+    auto responses = fastmcpp::util::jsonrpc::dispatch_batch(
+        batch,
+        [&](const fastmcpp::Json& entry) -> fastmcpp::Json
+        {
+            if (is_notification(entry))
             {
-                try
-                {
-                    (void)handler_(request); // process side effects only
-                }
-                catch (...)
-                {
-                    // Ignore notification errors by design.
-                }
-                continue;
+                handle_notification(handler, entry);
+                return fastmcpp::Json();
             }
+            auto reply = respond(handler, entry);
+            prelude += reply.prelude;
+            return std::move(reply.response);
+        },
+        /*max_parallel=*/1);
+    if (responses.is_null())
+        return prelude;
+    return prelude + responses.dump() + "\n";
+}
 
-            // Process with handler
-            auto response = handler_(request);
+void write_stdout(const std::string& text)
+{
+    std::cout << text;
+    std::cout.flush();
+}
 
-            if (auto info = extract_task_notification_info(response))
+/// Worker pool and single stdout writer behind the concurrent run loop.
+///
+/// Calls to a sequential tool are chained: while one runs, later calls to the
+/// same tool wait in a per-tool queue instead of occupying a worker. Destruction
+/// drains every accepted request and flushes its output.
+class ConcurrentDispatch
+{
+  public:
+    ConcurrentDispatch(const StdioServerWrapper::McpHandler& handler,
+                       const StdioServerWrapper::Options& options)
+        : handler_(handler), options_(options)
+    {
+        if (options_.max_in_flight == 0)
+            options_.max_in_flight = 1;
+        writer_ = std::thread([this]() { write_loop(); });
+        for (size_t i = 0; i < options_.workers; ++i)
+            workers_.emplace_back([this]() { work_loop(); });
+    }
+
+    ~ConcurrentDispatch()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        work_cv_.notify_all();
+        for (auto& worker : workers_)
+            worker.join();
+
+        {
+            std::lock_guard<std::mutex> lock(out_mutex_);
+            out_stopping_ = true;
+        }
+        out_cv_.notify_all();
+        writer_.join();
+    }
+
+    /// Run `request` inline on the calling thread.
+    void run_inline(const fastmcpp::Json& request)
+    {
+        write(handle_request(observed(), request));
+    }
+
+    /// Queue `request` for a worker, blocking while max_in_flight requests are
+    /// already being handled.
+    void dispatch(fastmcpp::Json request)
+    {
+        auto key = sequential_key(request);
+        enqueue(Work{std::move(request), std::move(key), nullptr, 0});
+    }
+
+    /// Fan a JSON-RPC batch out entry by entry, so sequential tools stay serialized
+    /// and the in-flight limit counts each entry. The array response is written
+    /// once the last entry finishes.
+    void dispatch_batch(const fastmcpp::Json& batch)
+    {
+        using fastmcpp::util::jsonrpc::error_response;
+        using fastmcpp::util::jsonrpc::kInvalidRequest;
+        if (batch.empty())
+        {
+            write(error_response(nullptr, kInvalidRequest, "Invalid Request: empty batch").dump() +
+                  "\n");
+            return;
+        }
+
+        auto collector = std::make_shared<BatchCollector>();
+        collector->responses.resize(batch.size());
+        collector->remaining = batch.size();
+        for (size_t i = 0; i < batch.size(); ++i)
+            if (!batch[i].is_object())
+                finish_entry(
+                    *collector, i,
+                    Reply{{}, error_response(nullptr, kInvalidRequest, "Invalid Request")});
+            else
+                enqueue(Work{batch[i], sequential_key(batch[i]), collector, i});
+    }
+
+    void write(std::string text)
+    {
+        {
+            std::lock_guard<std::mutex> lock(out_mutex_);
+            out_.push_back(std::move(text));
+        }
+        out_cv_.notify_one();
+    }
+
+  private:
+    struct BatchCollector
+    {
+        std::mutex mutex;
+        std::string prelude;
+        std::vector<fastmcpp::Json> responses;
+        size_t remaining{0};
+    };
+
+    struct Work
+    {
+        fastmcpp::Json request;
+        std::string sequential_key;            // tool name when calls must not overlap
+        std::shared_ptr<BatchCollector> batch; // set for entries of a batch
+        size_t batch_index{0};
+    };
+
+    void enqueue(Work work)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        space_cv_.wait(lock, [this]() { return in_flight_ < options_.max_in_flight; });
+        ++in_flight_;
+
+        if (!work.sequential_key.empty())
+        {
+            auto [it, idle] = sequential_.try_emplace(work.sequential_key);
+            if (!idle)
             {
-                fastmcpp::Json created_meta = {{"modelcontextprotocol.io/related-task",
-                                                fastmcpp::Json{{"taskId", info->task_id}}}};
-
-                fastmcpp::Json created_notification = {
-                    {"jsonrpc", "2.0"},
-                    {"method", "notifications/tasks/created"},
-                    {"params", fastmcpp::Json::object()},
-                    {"_meta", created_meta},
-                };
-
-                std::string created_at =
-                    info->created_at.empty() ? to_iso8601_now() : info->created_at;
-                std::string last_updated_at =
-                    info->last_updated_at.empty() ? created_at : info->last_updated_at;
-                fastmcpp::Json status_params = {
-                    {"taskId", info->task_id}, {"status", info->status},
-                    {"createdAt", created_at}, {"lastUpdatedAt", last_updated_at},
-                    {"ttl", info->ttl_ms},     {"pollInterval", 1000},
-                };
-
-                fastmcpp::Json status_notification = {
-                    {"jsonrpc", "2.0"},
-                    {"method", "notifications/tasks/status"},
-                    {"params", status_params},
-                };
-
-                std::cout << created_notification.dump() << std::endl;
-                std::cout << status_notification.dump() << std::endl;
+                it->second.push_back(std::move(work));
+                return;
             }
+        }
+        ready_.push_back(std::move(work));
+        lock.unlock();
+        work_cv_.notify_one();
+    }
 
-            // Write JSON-RPC response to stdout (line-delimited)
-            std::cout << response.dump() << std::endl;
-            std::cout.flush();
+    void finish_entry(BatchCollector& batch, size_t index, Reply reply)
+    {
+        std::string out;
+        {
+            std::lock_guard<std::mutex> lock(batch.mutex);
+            batch.prelude += reply.prelude;
+            batch.responses[index] = std::move(reply.response);
+            if (--batch.remaining > 0)
+                return;
+            out = std::move(batch.prelude);
+            auto responses =
+                fastmcpp::util::jsonrpc::collect_batch_replies(std::move(batch.responses));
+            if (!responses.is_null())
+                out += responses.dump() + "\n";
         }
-        catch (const fastmcpp::NotFoundError& e)
+        if (!out.empty())
+            write(std::move(out));
+    }
+
+    /// Handler that also records concurrency hints from tools/list responses.
+    StdioServerWrapper::McpHandler observed()
+    {
+        return [this](const fastmcpp::Json& request)
         {
-            // Method/tool not found → -32601
-            fastmcpp::Json error_response;
-            error_response["jsonrpc"] = "2.0";
-            try
+            auto response = handler_(request);
+            if (!options_.is_sequential && method_of(request) == "tools/list")
+                learn_sequential_tools(response);
+            return response;
+        };
+    }
+
+    void learn_sequential_tools(const fastmcpp::Json& response)
+    {
+        auto result = response.find("result");
+        if (result == response.end() || !result->is_object() || !result->contains("tools"))
+            return;
+        std::lock_guard<std::mutex> lock(learned_mutex_);
+        for (const auto& tool : (*result)["tools"])
+        {
+            if (!tool.is_object() || !tool.contains("name") || !tool["name"].is_string())
+                continue;
+            auto name = tool["name"].get<std::string>();
+            bool sequential = tool.contains("execution") && tool["execution"].is_object() &&
+                              tool["execution"].value("concurrency", "") == "sequential";
+            learned_sequential_[std::move(name)] = sequential;
+        }
+    }
+
+    std::string sequential_key(const fastmcpp::Json& request)
+    {
+        if (method_of(request) != "tools/call")
+            return {};
+        auto params = request.find("params");
+        if (params == request.end() || !params->is_object())
+            return {};
+        auto name = params->find("name");
+        if (name == params->end() || !name->is_string())
+            return {};
+
+        const auto& tool_name = name->get_ref<const std::string&>();
+        if (options_.is_sequential)
+            return options_.is_sequential(tool_name) ? tool_name : std::string();
+        // Names not yet seen in a tools/list response may be sequential, so their
+        // calls are serialized until a listing says otherwise
+        std::lock_guard<std::mutex> lock(learned_mutex_);
+        auto learned = learned_sequential_.find(tool_name);
+        bool sequential = learned == learned_sequential_.end() || learned->second;
+        return sequential ? tool_name : std::string();
+    }
+
+    void work_loop()
+    {
+        auto handler = observed();
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            work_cv_.wait(lock, [this]() { return stopping_ || !ready_.empty(); });
+            if (ready_.empty())
+                return;
+
+            Work work = std::move(ready_.front());
+            ready_.pop_front();
+            lock.unlock();
+
+            if (!work.batch)
             {
-                auto request = fastmcpp::util::json::parse(line);
-                if (request.contains("id") && !request["id"].is_null())
-                    error_response["id"] = request["id"];
+                write(handle_request(handler, work.request));
             }
-            catch (...)
+            else if (is_notification(work.request))
             {
+                handle_notification(handler, work.request);
+                finish_entry(*work.batch, work.batch_index, Reply{});
             }
-            error_response["error"] = {{"code", -32601}, {"message", std::string(e.what())}};
-            std::cout << error_response.dump() << std::endl;
-            std::cout.flush();
-        }
-        catch (const fastmcpp::ValidationError& e)
-        {
-            // Invalid params → -32602
-            fastmcpp::Json error_response;
-            error_response["jsonrpc"] = "2.0";
-            try
+            else
             {
-                auto request = fastmcpp::util::json::parse(line);
-                if (request.contains("id") && !request["id"].is_null())
-                    error_response["id"] = request["id"];
+                finish_entry(*work.batch, work.batch_index, respond(handler, work.request));
             }
-            catch (...)
+
+            lock.lock();
+            --in_flight_;
+            space_cv_.notify_one();
+            if (work.sequential_key.empty())
+                continue;
+
+            // Release the next waiting call to the same sequential tool, if any
+            auto it = sequential_.find(work.sequential_key);
+            if (it->second.empty())
             {
+                sequential_.erase(it);
+                continue;
             }
-            error_response["error"] = {{"code", -32602}, {"message", std::string(e.what())}};
-            std::cout << error_response.dump() << std::endl;
+            ready_.push_back(std::move(it->second.front()));
+            it->second.pop_front();
+            work_cv_.notify_one();
+        }
+    }
+
+    void write_loop()
+    {
+        std::deque<std::string> pending;
+        std::unique_lock<std::mutex> lock(out_mutex_);
+        while (true)
+        {
+            out_cv_.wait(lock, [this]() { return out_stopping_ || !out_.empty(); });
+            if (out_.empty())
+                return;
+            pending.swap(out_);
+            lock.unlock();
+
+            for (const auto& text : pending)
+                std::cout << text;
             std::cout.flush();
+            pending.clear();
+
+            lock.lock();
+        }
+    }
+
+    const StdioServerWrapper::McpHandler& handler_;
+    StdioServerWrapper::Options options_;
+
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable space_cv_;
+    std::deque<Work> ready_;
+    std::unordered_map<std::string, std::deque<Work>> sequential_;
+    size_t in_flight_{0};
+    bool stopping_{false};
+    std::vector<std::thread> workers_;
+
+    std::mutex learned_mutex_;
+    std::unordered_map<std::string, bool> learned_sequential_; // tool name -> sequential
+
+    std::mutex out_mutex_;
+    std::condition_variable out_cv_;
+    std::deque<std::string> out_;
+    bool out_stopping_{false};
+    std::thread writer_;
+};
+} // namespace
+
+StdioServerWrapper::StdioServerWrapper(McpHandler handler) : handler_(std::move(handler)) {}
+
+StdioServerWrapper::StdioServerWrapper(McpHandler handler, Options options)
+    : handler_(std::move(handler)), options_(std::move(options))
+{
+}
+
+StdioServerWrapper::~StdioServerWrapper()
+{
+    stop();
+}
+
+void StdioServerWrapper::run_loop()
+{
+    if (options_.workers > 0)
+    {
+        run_loop_concurrent();
+        return;
+    }
+
+    std::string line;
+
+    while (running_ && !stop_requested_ && std::getline(std::cin, line))
+    {
+        // Skip empty lines
+        if (line.empty())
+            continue;
+
+        fastmcpp::Json request;
+        try
+        {
+            request = fastmcpp::util::json::parse(line);
         }
         catch (const std::exception& e)
         {
-            // Internal error → -32603
-            fastmcpp::Json error_response;
-            error_response["jsonrpc"] = "2.0";
+            write_stdout(error_line(nullptr, -32603, e.what()));
+            continue;
+        }
+
+        if (request.is_array())
+        {
+            write_stdout(handle_batch(handler_, request));
+            continue;
+        }
+
+        if (!request.is_object())
+        {
+            write_stdout(error_line(nullptr, -32600, "Invalid Request"));
+            continue;
+        }
+
+        if (is_notification(request))
+        {
+            handle_notification(handler_, request);
+            continue;
+        }
+
+        write_stdout(handle_request(handler_, request));
+    }
+
+    running_ = false;
+}
+
+void StdioServerWrapper::run_loop_concurrent()
+{
+    {
+        ConcurrentDispatch dispatch(handler_, options_);
+        std::string line;
+
+        while (running_ && !stop_requested_ && std::getline(std::cin, line))
+        {
+            if (line.empty())
+                continue;
+
+            fastmcpp::Json request;
             try
             {
-                auto request = fastmcpp::util::json::parse(line);
-                if (request.contains("id") && !request["id"].is_null())
-                    error_response["id"] = request["id"];
+                request = fastmcpp::util::json::parse(line);
             }
-            catch (...)
+            catch (const std::exception& e)
             {
+                dispatch.write(error_line(nullptr, -32603, e.what()));
+                continue;
             }
-            error_response["error"] = {{"code", -32603}, {"message", std::string(e.what())}};
-            std::cout << error_response.dump() << std::endl;
-            std::cout.flush();
+
+            // Notifications and listings run in order on this thread: cancellations
+            // and sequential hints must be in effect before later requests start.
+            if (request.is_array())
+                dispatch.dispatch_batch(request);
+            else if (!request.is_object())
+                dispatch.write(error_line(nullptr, -32600, "Invalid Request"));
+            else if (is_notification(request))
+                handle_notification(handler_, request);
+            else if (method_of(request) == "tools/list")
+                dispatch.run_inline(request);
+            else
+                dispatch.dispatch(std::move(request));
         }
-    }
+    } // drains in-flight requests and flushes their responses
 
     running_ = false;
 }
@@ -2,6 +2,7 @@
 
 #include "fastmcpp/exceptions.hpp"
 #include "fastmcpp/util/json.hpp"
+#include "fastmcpp/util/jsonrpc.hpp"
 
 #include <algorithm>
 #include <cctype>
@@ -14,6 +15,54 @@
 namespace fastmcpp::server
 {
 
+namespace
+{
+
+bool accepts_event_stream(const httplib::Request& req)
+{
+    auto it = req.headers.find("Accept");
+    return it != req.headers.end() && it->second.find("text/event-stream") != std::string::npos;
+}
+
+const fastmcpp::Json* progress_token_of(const fastmcpp::Json& message)
+{
+    if (!message.contains("params") || !message["params"].is_object())
+        return nullptr;
+    const auto& params = message["params"];
+    if (params.contains("progressToken"))
+        return &params["progressToken"];
+    if (params.contains("_meta") && params["_meta"].is_object() &&
+        params["_meta"].contains("progressToken"))
+        return &params["_meta"]["progressToken"];
+    return nullptr;
+}
+
+/// The response stream whose handler is running on this thread, if any. Messages a
+/// session sends without a progress token go to the request that caused them.
+thread_local const void* current_stream = nullptr;
+
+struct CurrentStreamScope
+{
+    explicit CurrentStreamScope(const void* stream) : previous(current_stream)
+    {
+        current_stream = stream;
+    }
+    ~CurrentStreamScope()
+    {
+        current_stream = previous;
+    }
+
+    const void* previous;
+};
+
+/// Requests whose handling may emit notifications worth streaming.
+bool may_stream(const fastmcpp::Json& message)
+{
+    return message.value("method", "") == "tools/call" || progress_token_of(message);
+}
+
+} // namespace
+
 StreamableHttpServerWrapper::StreamableHttpServerWrapper(
     McpHandler handler, std::string host, int port, std::string mcp_path, std::string auth_token,
     std::string cors_origin, std::unordered_map<std::string, std::string> response_headers)
@@ -76,6 +125,105 @@ std::string StreamableHttpServerWrapper::generate_session_id()
     return oss.str();
 }
 
+bool StreamableHttpServerWrapper::ResponseStream::write(const SseFrame& frame)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!sink || !sink->is_writable())
+        return false;
+    return sink->write(frame->data(), frame->size());
+}
+
+void StreamableHttpServerWrapper::send_to_stream(SessionState& state, const fastmcpp::Json& message)
+{
+    std::shared_ptr<ResponseStream> target;
+    {
+        std::lock_guard<std::mutex> lock(state.streams_mutex);
+        if (auto* token = progress_token_of(message))
+        {
+            // Progress belongs to the request that asked for it; once that request
+            // has finished the event has nowhere to go
+            for (const auto& stream : state.streams)
+                if (stream->progress_token && *stream->progress_token == *token)
+                    target = stream;
+        }
+        else
+        {
+            // Logs and server requests sent while a streamed request's handler runs
+            // on this thread; anything else has no stream of its own
+            for (const auto& stream : state.streams)
+                if (stream.get() == current_stream)
+                    target = stream;
+        }
+    }
+    // Without an owning stream there is no channel to the client (no GET stream)
+    if (target)
+        target->write(make_sse_frame(message));
+}
+
+void StreamableHttpServerWrapper::stream_response(httplib::Response& res,
+                                                  std::shared_ptr<SessionState> state,
+                                                  fastmcpp::Json message)
+{
+    auto stream = std::make_shared<ResponseStream>();
+    if (auto* token = progress_token_of(message))
+        stream->progress_token = *token;
+
+    res.status = 200;
+    res.set_header("Cache-Control", "no-cache, no-transform");
+    res.set_header("X-Accel-Buffering", "no");
+
+    // httplib sends the headers before calling the provider, and the provider runs
+    // on this request's worker thread, so the handler runs inside it with the
+    // stream attached to the session
+    res.set_chunked_content_provider(
+        "text/event-stream",
+        [this, state, stream, message = std::move(message)](size_t, httplib::DataSink& sink)
+        {
+            {
+                std::lock_guard<std::mutex> lock(stream->mutex);
+                stream->sink = &sink;
+            }
+            {
+                std::lock_guard<std::mutex> lock(state->streams_mutex);
+                state->streams.push_back(stream);
+            }
+
+            CurrentStreamScope current(stream.get());
+
+            fastmcpp::Json response;
+            try
+            {
+                response = handler_(message);
+            }
+            catch (const fastmcpp::NotFoundError& e)
+            {
+                response = fastmcpp::util::jsonrpc::error_response(message["id"], -32601, e.what());
+            }
+            catch (const fastmcpp::ValidationError& e)
+            {
+                response = fastmcpp::util::jsonrpc::error_response(message["id"], -32602, e.what());
+            }
+            catch (const std::exception& e)
+            {
+                response = fastmcpp::util::jsonrpc::error_response(message["id"], -32603, e.what());
+            }
+
+            // Detach first so nothing can follow the result on this stream
+            {
+                std::lock_guard<std::mutex> lock(state->streams_mutex);
+                auto& streams = state->streams;
+                streams.erase(std::remove(streams.begin(), streams.end(), stream), streams.end());
+            }
+            stream->write(make_sse_frame(response));
+            {
+                std::lock_guard<std::mutex> lock(stream->mutex);
+                stream->sink = nullptr;
+            }
+            sink.done();
+            return true;
+        });
+}
+
 void StreamableHttpServerWrapper::run_server()
 {
     if (requested_port_ == 0) // Request any available port from the operating system.
@@ -163,35 +311,42 @@ bool StreamableHttpServerWrapper::start()
                     session_id = session_it->second;
 
                 // Handle initialize request - creates new session
-                bool is_initialize = message.contains("method") &&
-                                     message["method"].get<std::string>() == "initialize";
-
+                auto is_initialize_message = [](const fastmcpp::Json& m)
+                {
+                    return m.is_object() && m.contains("method") && m["method"].is_string() &&
+                           m["method"].get<std::string>() == "initialize";
+                };
+                bool is_initialize = is_initialize_message(message);
+                if (message.is_array())
+                    is_initialize =
+                        std::any_of(message.begin(), message.end(), is_initialize_message);
+
+                std::shared_ptr<SessionState> state;
                 if (is_initialize)
                 {
-                    // Security: Check session limit before creating new session
-                    {
-                        std::lock_guard<std::mutex> lock(sessions_mutex_);
-                        if (sessions_.size() >= MAX_SESSIONS)
-                        {
-                            res.status = 503; // Service Unavailable
-                            res.set_content("{\"error\":\"Maximum sessions reached\"}",
-                                            "application/json");
-                            return;
-                        }
-                    }
-
                     // Generate new session ID
                     session_id = generate_session_id();
 
-                    // Create ServerSession for this session
-                    // Note: For streamable HTTP, responses go back in HTTP response,
-                    // so the send callback is not used for normal responses.
-                    // It could be used for server-initiated requests in the future.
-                    auto session = std::make_shared<ServerSession>(session_id, nullptr);
-
+                    // Create ServerSession for this session. Responses go back in the
+                    // HTTP response; anything else the session sends (progress, logs,
+                    // server-initiated requests) rides on an open SSE response stream.
+                    state = std::make_shared<SessionState>();
+                    std::weak_ptr<SessionState> weak_state = state;
+                    state->server_session =
+                        std::make_shared<ServerSession>(session_id,
+                                                        [weak_state](const fastmcpp::Json& msg)
+                                                        {
+                                                            if (auto s = weak_state.lock())
+                                                                send_to_stream(*s, msg);
+                                                        });
+
+                    // Security: the registry refuses new sessions beyond max_sessions()
+                    if (!sessions_.insert(session_id, state))
                     {
-                        std::lock_guard<std::mutex> lock(sessions_mutex_);
-                        sessions_[session_id] = session;
+                        res.status = 503; // Service Unavailable
+                        res.set_content("{\"error\":\"Maximum sessions reached\"}",
+                                        "application/json");
+                        return;
                     }
                 }
                 else if (session_id.empty())
@@ -204,9 +359,9 @@ bool StreamableHttpServerWrapper::start()
                 }
                 else
                 {
-                    // Verify session exists
-                    std::lock_guard<std::mutex> lock(sessions_mutex_);
-                    if (sessions_.find(session_id) == sessions_.end())
+                    // Verify session exists (and mark it as used)
+                    state = sessions_.find(session_id);
+                    if (!state)
                     {
                         res.status = 404;
                         res.set_content("{\"error\":\"Invalid or expired session\"}",
@@ -215,6 +370,33 @@ bool StreamableHttpServerWrapper::start()
                     }
                 }
 
+                // JSON-RPC batch: entries are handled like single messages, errors are
+                // reported per entry, and the replies go back as one array. A batch that
+                // initializes runs in order so later entries see the new session.
+                if (message.is_array())
+                {
+                    auto reply = fastmcpp::util::jsonrpc::dispatch_batch(
+                        message,
+                        [&](const fastmcpp::Json& entry)
+                        {
+                            return fastmcpp::util::jsonrpc::handle_session_batch_entry(
+                                entry, session_id, handler_,
+                                [&](const fastmcpp::Json& client_response)
+                                { state->server_session->handle_response(client_response); });
+                        },
+                        is_initialize ? 1 : fastmcpp::util::jsonrpc::kDefaultBatchParallelism);
+
+                    res.set_header("Mcp-Session-Id", session_id);
+                    if (reply.is_null())
+                    {
+                        res.status = 202;
+                        return;
+                    }
+                    res.set_content(reply.dump(), "application/json");
+                    res.status = 200;
+                    return;
+                }
+
                 // Inject session_id into request meta for handler access
                 if (!message.contains("params"))
                     message["params"] = Json::object();
@@ -226,24 +408,12 @@ bool StreamableHttpServerWrapper::start()
                 if (ServerSession::is_response(message))
                 {
                     // Get the session and route the response
-                    std::shared_ptr<ServerSession> session;
-                    {
-                        std::lock_guard<std::mutex> lock(sessions_mutex_);
-                        auto it = sessions_.find(session_id);
-                        if (it != sessions_.end())
-                            session = it->second;
-                    }
-
-                    if (session)
+                    if (state->server_session->handle_response(message))
                     {
-                        bool handled = session->handle_response(message);
-                        if (handled)
-                        {
-                            res.set_header("Mcp-Session-Id", session_id);
-                            res.set_content("{\"status\":\"ok\"}", "application/json");
-                            res.status = 200;
-                            return;
-                        }
+                        res.set_header("Mcp-Session-Id", session_id);
+                        res.set_content("{\"status\":\"ok\"}", "application/json");
+                        res.status = 200;
+                        return;
                     }
 
                     // Response not handled (unknown request ID)
@@ -273,6 +443,15 @@ bool StreamableHttpServerWrapper::start()
                     return;
                 }
 
+                // Calls that may report progress stream their response when the client
+                // can read one, so notifications reach it before the result
+                if (sse_responses_ && accepts_event_stream(req) && may_stream(message))
+                {
+                    res.set_header("Mcp-Session-Id", session_id);
+                    stream_response(res, std::move(state), std::move(message));
+                    return;
+                }
+
                 // Normal request - process with handler
                 auto response = handler_(message);
 
@@ -394,11 +573,7 @@ bool StreamableHttpServerWrapper::start()
                      }
 
                      const std::string& session_id = session_it->second;
-                     bool did_remove = false;
-                     {
-                         std::lock_guard<std::mutex> lock(sessions_mutex_);
-                         did_remove = sessions_.erase(session_id) > 0;
-                     }
+                     bool did_remove = sessions_.erase(session_id) != nullptr;
 
                      if (did_remove)
                      {
@@ -412,6 +587,15 @@ bool StreamableHttpServerWrapper::start()
                      }
                  });
 
+    if (session_idle_timeout_.count() > 0)
+    {
+        // Coarse ticks are enough: a session outliving its timeout by a tick is harmless
+        auto tick = std::clamp(session_idle_timeout_ / 8, std::chrono::milliseconds(10),
+                               std::chrono::milliseconds(1000));
+        session_timers_ = std::make_unique<util::TimerWheel>(tick);
+        sessions_.enable_idle_eviction(*session_timers_, session_idle_timeout_);
+    }
+
     running_ = true;
 
     thread_ = std::thread([this]() { run_server(); });
@@ -456,10 +640,9 @@ void StreamableHttpServerWrapper::stop()
     if (thread_.joinable())
         thread_.join();
 
-    {
-        std::lock_guard<std::mutex> lock(sessions_mutex_);
-        sessions_.clear();
-    }
+    sessions_.disable_idle_eviction();
+    session_timers_.reset();
+    sessions_.clear();
 
     bound_port_.store(0); // Reset the bound port's value.
 }
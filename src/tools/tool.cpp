@@ -1,3 +1,57 @@
 #include "fastmcpp/tools/tool.hpp"
 
-// inline-only
+#include "fastmcpp/util/json_schema.hpp"
+
+// Mostly inline; the schema dereferencing needs util::schema, which plugins don't link
+
+namespace fastmcpp::tools
+{
+
+const Tool::Schemas& Tool::dereferenced_schemas() const
+{
+    auto& schemas = *schemas_;
+    std::call_once(schemas.dereferenced,
+                   [&schemas]()
+                   {
+                       if (util::schema::contains_ref(schemas.input))
+                           schemas.dereferenced_input =
+                               util::schema::dereference_refs(schemas.input);
+                       if (util::schema::contains_ref(schemas.output))
+                           schemas.dereferenced_output =
+                               util::schema::dereference_refs(schemas.output);
+                       schemas.mcp_output = util::schema::wrap_output_schema(schemas.output);
+                       if (schemas.dereferenced_output)
+                           schemas.mcp_dereferenced_output =
+                               util::schema::wrap_output_schema(*schemas.dereferenced_output);
+                   });
+    return schemas;
+}
+
+const Json& Tool::dereferenced_input_schema() const
+{
+    const auto& schemas = dereferenced_schemas();
+    return schemas.dereferenced_input ? *schemas.dereferenced_input : schemas.input;
+}
+
+const Json& Tool::dereferenced_output_schema() const
+{
+    const auto& schemas = dereferenced_schemas();
+    return schemas.dereferenced_output ? *schemas.dereferenced_output : schemas.output;
+}
+
+const Json& Tool::mcp_output_schema() const
+{
+    const auto& schemas = dereferenced_schemas();
+    return schemas.mcp_output ? *schemas.mcp_output : schemas.output;
+}
+
+const Json& Tool::mcp_dereferenced_output_schema() const
+{
+    const auto& schemas = dereferenced_schemas();
+    if (!schemas.dereferenced_output)
+        return mcp_output_schema();
+    return schemas.mcp_dereferenced_output ? *schemas.mcp_dereferenced_output
+                                           : *schemas.dereferenced_output;
+}
+
+} // namespace fastmcpp::tools
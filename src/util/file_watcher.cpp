@@ -0,0 +1,385 @@
+#include "fastmcpp/util/file_watcher.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fastmcpp::util
+{
+
+namespace
+{
+struct FileState
+{
+    std::filesystem::file_time_type mtime;
+    uintmax_t size;
+
+    bool operator==(const FileState& other) const
+    {
+        return mtime == other.mtime && size == other.size;
+    }
+};
+
+using Snapshot = std::map<std::filesystem::path, FileState>;
+
+Snapshot scan(const std::filesystem::path& root, bool root_is_file)
+{
+    Snapshot files;
+    std::error_code ec;
+    auto add = [&files](const std::filesystem::path& path)
+    {
+        std::error_code stat_ec;
+        const auto mtime = std::filesystem::last_write_time(path, stat_ec);
+        const auto size = std::filesystem::file_size(path, stat_ec);
+        if (!stat_ec)
+            files.emplace(path, FileState{mtime, size});
+    };
+
+    if (root_is_file)
+    {
+        if (std::filesystem::is_regular_file(root, ec))
+            add(root);
+        return files;
+    }
+    if (!std::filesystem::is_directory(root, ec))
+        return files;
+
+    auto options = std::filesystem::directory_options::skip_permission_denied;
+    for (auto it = std::filesystem::recursive_directory_iterator(root, options, ec);
+         it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+    {
+        if (ec)
+        {
+            ec.clear();
+            continue;
+        }
+        if (it->is_regular_file(ec))
+            add(it->path());
+    }
+    return files;
+}
+} // namespace
+
+struct FileWatcher::PollState
+{
+    Snapshot files;
+};
+
+FileWatcher::FileWatcher(std::filesystem::path root) : FileWatcher(std::move(root), Options{}) {}
+
+FileWatcher::FileWatcher(std::filesystem::path root, Options options)
+    : root_(std::move(root)), options_(std::move(options))
+{
+    std::error_code ec;
+    root_ = std::filesystem::absolute(root_, ec).lexically_normal();
+    root_is_file_ = std::filesystem::is_regular_file(root_, ec);
+
+    // Watches (or the first snapshot) are in place before the constructor
+    // returns, so no change made afterwards is missed
+    if (!options_.force_polling && start_inotify())
+    {
+        thread_ = std::thread([this]() { run_inotify(); });
+        return;
+    }
+    poll_state_ = std::make_unique<PollState>();
+    poll_state_->files = scan(root_, root_is_file_);
+    thread_ = std::thread([this]() { run_polling(); });
+}
+
+FileWatcher::~FileWatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+#ifdef __linux__
+    if (wake_fds_[1] >= 0)
+    {
+        const char byte = 0;
+        [[maybe_unused]] auto written = ::write(wake_fds_[1], &byte, 1);
+    }
+#endif
+    if (thread_.joinable())
+        thread_.join();
+#ifdef __linux__
+    for (int fd : {inotify_fd_, wake_fds_[0], wake_fds_[1]})
+        if (fd >= 0)
+            ::close(fd);
+#endif
+}
+
+std::vector<std::filesystem::path> FileWatcher::take_changes()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::filesystem::path> out(changes_.begin(), changes_.end());
+    changes_.clear();
+    pending_.store(false, std::memory_order_release);
+    return out;
+}
+
+bool FileWatcher::wait_for_changes(std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, timeout, [this]() { return has_changes(); });
+}
+
+void FileWatcher::report(const std::filesystem::path& path)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    changes_.insert(path);
+    unpublished_ = true;
+}
+
+/// Ends a batch of report() calls: wakes waiters and runs the callback once
+void FileWatcher::publish()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!unpublished_)
+            return;
+        unpublished_ = false;
+        pending_.store(true, std::memory_order_release);
+    }
+    cv_.notify_all();
+    if (options_.on_change)
+        options_.on_change();
+}
+
+#ifdef __linux__
+namespace
+{
+constexpr uint32_t kWatchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE |
+                                IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+}
+
+bool FileWatcher::start_inotify()
+{
+    std::error_code ec;
+    // A missing root could appear anywhere up the tree; rescanning copes with that
+    if (!root_is_file_ && !std::filesystem::is_directory(root_, ec))
+        return false;
+
+    inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ < 0)
+        return false;
+    if (::pipe2(wake_fds_, O_NONBLOCK | O_CLOEXEC) != 0)
+    {
+        ::close(inotify_fd_);
+        inotify_fd_ = -1;
+        return false;
+    }
+
+    if (root_is_file_)
+    {
+        // Watch the directory so that replacing the file by rename is seen
+        const int wd = ::inotify_add_watch(inotify_fd_, root_.parent_path().c_str(), kWatchMask);
+        if (wd >= 0)
+            watched_dirs_.emplace(wd, root_.parent_path());
+    }
+    else
+    {
+        watch_tree(root_);
+    }
+    if (watched_dirs_.empty())
+    {
+        for (int* fd : {&inotify_fd_, &wake_fds_[0], &wake_fds_[1]})
+        {
+            ::close(*fd);
+            *fd = -1;
+        }
+        return false;
+    }
+    return true;
+}
+
+void FileWatcher::watch_tree(const std::filesystem::path& dir)
+{
+    const int wd = ::inotify_add_watch(inotify_fd_, dir.c_str(), kWatchMask);
+    if (wd < 0)
+        return;
+    // A directory moved within the tree keeps its watch and only changes path
+    watched_dirs_[wd] = dir;
+    moved_dirs_.erase(wd);
+
+    std::error_code ec;
+    auto options = std::filesystem::directory_options::skip_permission_denied;
+    for (auto it = std::filesystem::recursive_directory_iterator(dir, options, ec);
+         it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+    {
+        if (ec)
+        {
+            ec.clear();
+            continue;
+        }
+        if (it->is_directory(ec) && !it->is_symlink(ec))
+        {
+            const int child = ::inotify_add_watch(inotify_fd_, it->path().c_str(), kWatchMask);
+            if (child >= 0)
+            {
+                watched_dirs_[child] = it->path();
+                moved_dirs_.erase(child);
+            }
+        }
+    }
+}
+
+void FileWatcher::forget_tree(const std::filesystem::path& dir)
+{
+    for (auto it = watched_dirs_.begin(); it != watched_dirs_.end();)
+    {
+        const auto relative = it->second.lexically_relative(dir);
+        if (relative.empty() || *relative.begin() == "..")
+        {
+            ++it;
+            continue;
+        }
+        moved_dirs_[it->first] = std::move(it->second);
+        it = watched_dirs_.erase(it);
+    }
+}
+
+void FileWatcher::run_inotify()
+{
+    alignas(struct inotify_event) char buffer[64 * 1024];
+    pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {wake_fds_[0], POLLIN, 0}};
+    while (true)
+    {
+        if (::poll(fds, 2, -1) < 0)
+            continue; // EINTR
+        if (fds[1].revents != 0)
+            return;
+        if ((fds[0].revents & POLLIN) == 0)
+            continue;
+
+        ssize_t length;
+        while ((length = ::read(inotify_fd_, buffer, sizeof(buffer))) > 0)
+            handle_inotify_events(buffer, static_cast<size_t>(length));
+        publish();
+    }
+}
+
+void FileWatcher::handle_inotify_events(const char* buffer, size_t length)
+{
+    for (size_t offset = 0; offset < length;)
+    {
+        const auto* event = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+        offset += sizeof(struct inotify_event) + event->len;
+
+        if (event->mask & IN_Q_OVERFLOW)
+        {
+            // Events were dropped: only a full rescan is safe
+            report(root_);
+            continue;
+        }
+        if (event->mask & IN_IGNORED)
+        {
+            watched_dirs_.erase(event->wd);
+            moved_dirs_.erase(event->wd);
+            continue;
+        }
+        auto moved = moved_dirs_.find(event->wd);
+        if (moved != moved_dirs_.end())
+        {
+            // Still unclaimed when its IN_MOVE_SELF arrives: it left the tree, and
+            // so did everything below it
+            if (event->mask & IN_MOVE_SELF)
+            {
+                const auto old_path = moved->second;
+                for (auto it = moved_dirs_.begin(); it != moved_dirs_.end();)
+                {
+                    const auto relative = it->second.lexically_relative(old_path);
+                    if (relative.empty() || *relative.begin() == "..")
+                    {
+                        ++it;
+                        continue;
+                    }
+                    ::inotify_rm_watch(inotify_fd_, it->first);
+                    it = moved_dirs_.erase(it);
+                }
+            }
+            continue;
+        }
+        auto dir = watched_dirs_.find(event->wd);
+        if (dir == watched_dirs_.end())
+            continue;
+        if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF))
+        {
+            // The parent reports the directory itself. One moved within the tree was
+            // re-registered under its new path by IN_MOVED_TO, so its watch stays.
+            if (dir->second == root_)
+                report(root_);
+            else if (root_is_file_ && (event->mask & IN_MOVE_SELF))
+                ::inotify_rm_watch(inotify_fd_, event->wd);
+            continue;
+        }
+
+        const auto path = event->len > 0 ? dir->second / event->name : dir->second;
+        if (root_is_file_ && path != root_)
+            continue;
+
+        if (event->mask & IN_ISDIR)
+        {
+            if (event->mask & IN_MOVED_FROM)
+                forget_tree(path);
+            if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                watch_tree(path);
+            report(path);
+        }
+        else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE))
+        {
+            report(path);
+        }
+        else if (event->mask & IN_CREATE)
+        {
+            // Regular files are reported once written; links have no such event
+            std::error_code ec;
+            if (std::filesystem::is_symlink(path, ec))
+                report(path);
+        }
+    }
+}
+#else
+bool FileWatcher::start_inotify()
+{
+    return false;
+}
+
+void FileWatcher::watch_tree(const std::filesystem::path&) {}
+
+void FileWatcher::run_inotify() {}
+
+void FileWatcher::handle_inotify_events(const char*, size_t) {}
+#endif
+
+void FileWatcher::run_polling()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!cv_.wait_for(lock, options_.poll_interval, [this]() { return stopping_; }))
+    {
+        lock.unlock();
+        auto current = scan(root_, root_is_file_);
+        auto& previous = poll_state_->files;
+        for (const auto& [path, state] : current)
+        {
+            auto it = previous.find(path);
+            if (it == previous.end() || !(it->second == state))
+                report(path);
+        }
+        for (const auto& [path, state] : previous)
+            if (current.find(path) == current.end())
+                report(path);
+        previous = std::move(current);
+        publish();
+        lock.lock();
+    }
+}
+
+} // namespace fastmcpp::util
@@ -199,6 +199,183 @@ void validate(const Json& schema, const Json& instance)
     }
 }
 
+namespace
+{
+
+enum : uint8_t
+{
+    kObject = 1 << 0,
+    kArray = 1 << 1,
+    kString = 1 << 2,
+    kNumber = 1 << 3,
+    kInteger = 1 << 4,
+    kBoolean = 1 << 5,
+    kNull = 1 << 6,
+};
+constexpr uint8_t kAnyType = 0xff;
+
+uint8_t type_mask(const std::string& type)
+{
+    if (type == "object")
+        return kObject;
+    if (type == "array")
+        return kArray;
+    if (type == "string")
+        return kString;
+    if (type == "number")
+        return kNumber;
+    if (type == "integer")
+        return kInteger;
+    if (type == "boolean")
+        return kBoolean;
+    if (type == "null")
+        return kNull;
+    return kAnyType; // unknown treated as pass-through
+}
+
+/// Allowed types of `schema`, from a type name or a list of them.
+uint8_t type_mask(const Json& schema)
+{
+    auto it = schema.find("type");
+    if (it == schema.end())
+        return kAnyType;
+    if (it->is_string())
+    {
+        // validate() does not know "null" and lets it pass; type lists are ours alone
+        const auto& type = it->get_ref<const std::string&>();
+        return type == "null" ? kAnyType : type_mask(type);
+    }
+    if (!it->is_array())
+        return kAnyType;
+    uint8_t mask = 0;
+    for (const auto& type : *it)
+        mask |= type.is_string() ? type_mask(type.get_ref<const std::string&>()) : kAnyType;
+    return mask ? mask : kAnyType;
+}
+
+/// `node` with local $refs followed, or `node` itself if it has none or they dangle.
+const Json& follow_refs(const Json& root, const Json& node)
+{
+    const Json* current = &node;
+    // A bounded hop count also stops reference cycles
+    for (int hops = 0; hops < 32 && current->is_object() && !current->contains("type"); ++hops)
+    {
+        auto ref_it = current->find("$ref");
+        if (ref_it == current->end() || !ref_it->is_string())
+            break;
+        const auto& ref = ref_it->get_ref<const std::string&>();
+        if (ref.empty() || ref[0] != '#')
+            break;
+        try
+        {
+            current = &root.at(nlohmann::json::json_pointer(ref.substr(1)));
+        }
+        catch (...)
+        {
+            break;
+        }
+    }
+    return *current;
+}
+
+} // namespace
+
+CompiledSchema::CompiledSchema(const Json& schema)
+{
+    if (!schema.is_object())
+        return;
+    const Json& root = follow_refs(schema, schema);
+    if (!root.contains("type"))
+        return; // validate() checks nothing without a root type
+    root_types_ = type_mask(root);
+    check_object_ = (root_types_ & kObject) && root_types_ != kAnyType;
+    if (!check_object_)
+        return;
+
+    if (root.contains("required") && root["required"].is_array())
+        for (const auto& key : root["required"])
+            if (key.is_string())
+                required_.push_back(key.get<std::string>());
+
+    if (root.contains("properties") && root["properties"].is_object())
+    {
+        for (const auto& [name, subschema] : root["properties"].items())
+        {
+            const Json& resolved = follow_refs(schema, subschema);
+            if (!resolved.is_object() || !resolved.contains("type"))
+                continue;
+            auto mask = type_mask(resolved);
+            if (mask != kAnyType)
+                properties_.emplace_back(name, mask);
+        }
+    }
+    // properties_ is sorted since items() visits keys in order; the index serves
+    // instances with more keys than the schema has typed properties
+    property_index_.reserve(properties_.size());
+    for (const auto& [name, mask] : properties_)
+        property_index_.emplace(name, mask);
+}
+
+CompiledSchema::TypeMask CompiledSchema::type_of(const Json& instance)
+{
+    switch (instance.type())
+    {
+    case Json::value_t::object:
+        return kObject;
+    case Json::value_t::array:
+        return kArray;
+    case Json::value_t::string:
+        return kString;
+    case Json::value_t::number_integer:
+    case Json::value_t::number_unsigned:
+        return kNumber | kInteger;
+    case Json::value_t::number_float:
+        return kNumber;
+    case Json::value_t::boolean:
+        return kBoolean;
+    case Json::value_t::null:
+        return kNull;
+    default:
+        return 0;
+    }
+}
+
+void CompiledSchema::validate(const Json& instance) const
+{
+    if (root_types_ == kAnyType)
+        return;
+    if (!(type_of(instance) & root_types_))
+        throw ValidationError("root type mismatch");
+    if (check_object_ && instance.is_object())
+        validate_object(instance);
+}
+
+void CompiledSchema::validate_object(const Json& instance) const
+{
+    for (const auto& key : required_)
+        if (!instance.contains(key))
+            throw ValidationError("missing required: " + key);
+
+    // Both orders visit keys alphabetically, so the first mismatch reported is
+    // the same either way; walk whichever side is smaller
+    if (properties_.size() <= instance.size())
+    {
+        for (const auto& [name, mask] : properties_)
+        {
+            auto it = instance.find(name);
+            if (it != instance.end() && !(type_of(*it) & mask))
+                throw ValidationError("type mismatch for: " + name);
+        }
+        return;
+    }
+    for (const auto& [name, value] : instance.items())
+    {
+        auto it = property_index_.find(name);
+        if (it != property_index_.end() && !(type_of(value) & it->second))
+            throw ValidationError("type mismatch for: " + name);
+    }
+}
+
 bool contains_ref(const Json& schema)
 {
     return contains_ref_impl(schema);
@@ -257,4 +434,38 @@ Json dereference_refs(const Json& schema)
     return dereferenced;
 }
 
+static bool schema_is_object(const Json& schema)
+{
+    if (!schema.is_object())
+        return false;
+
+    auto it = schema.find("type");
+    if (it != schema.end() && it->is_string() && it->get<std::string>() == "object")
+        return true;
+
+    if (schema.contains("properties"))
+        return true;
+
+    // Self-referencing types often use a top-level $ref into $defs.
+    if (schema.contains("$ref") && schema.contains("$defs"))
+        return true;
+
+    return false;
+}
+
+std::optional<Json> wrap_output_schema(const Json& schema)
+{
+    if (schema.is_null() || schema_is_object(schema))
+        return std::nullopt;
+
+    // Python fastmcp requires object-shaped output schemas (MCP structuredContent is a dict).
+    // For scalar/array outputs, wrap into {"result": ...} and annotate for clients.
+    return Json{
+        {"type", "object"},
+        {"properties", Json{{"result", schema}}},
+        {"required", Json::array({"result"})},
+        {"x-fastmcp-wrap-result", true},
+    };
+}
+
 } // namespace fastmcpp::util::schema
@@ -0,0 +1,252 @@
+#include "fastmcpp/util/sha256.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define FASTMCPP_SHA256_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace fastmcpp::util
+{
+namespace
+{
+alignas(16) constexpr uint32_t kRound[64] = {
+    0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U, 0x923f82a4U,
+    0xab1c5ed5U, 0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U, 0x72be5d74U, 0x80deb1feU,
+    0x9bdc06a7U, 0xc19bf174U, 0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU,
+    0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU, 0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U,
+    0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U, 0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU,
+    0x53380d13U, 0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U, 0xa2bfe8a1U, 0xa81a664bU,
+    0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U, 0x19a4c116U,
+    0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU, 0x682e6ff3U,
+    0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U, 0x90befffaU, 0xa4506cebU, 0xbef9a3f7U,
+    0xc67178f2U,
+};
+
+constexpr std::array<uint32_t, 8> kInitialState = {
+    0x6a09e667U, 0xbb67ae85U, 0x3c6ef372U, 0xa54ff53aU,
+    0x510e527fU, 0x9b05688cU, 0x1f83d9abU, 0x5be0cd19U,
+};
+
+inline uint32_t rotr(uint32_t x, unsigned n)
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+inline uint32_t load_be32(const uint8_t* p)
+{
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+/// Straight FIPS 180-4 compression with a rolling 16-word message schedule
+void process_portable(uint32_t* state, const uint8_t* blocks, size_t count)
+{
+    for (; count > 0; --count, blocks += 64)
+    {
+        uint32_t w[16];
+        for (int i = 0; i < 16; ++i)
+            w[i] = load_be32(blocks + i * 4);
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; ++i)
+        {
+            if (i >= 16)
+            {
+                const uint32_t w15 = w[(i - 15) & 15];
+                const uint32_t w2 = w[(i - 2) & 15];
+                const uint32_t s0 = rotr(w15, 7) ^ rotr(w15, 18) ^ (w15 >> 3);
+                const uint32_t s1 = rotr(w2, 17) ^ rotr(w2, 19) ^ (w2 >> 10);
+                w[i & 15] += s0 + w[(i - 7) & 15] + s1;
+            }
+            const uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) +
+                                ((e & f) ^ (~e & g)) + kRound[i] + w[i & 15];
+            const uint32_t t2 =
+                (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#ifdef FASTMCPP_SHA256_X86
+bool cpu_has_sha_extensions()
+{
+    unsigned a = 0, b = 0, c = 0, d = 0;
+    if (!__get_cpuid(1, &a, &b, &c, &d))
+        return false;
+    const bool ssse3 = (c & (1U << 9)) != 0;
+    const bool sse41 = (c & (1U << 19)) != 0;
+    if (!__get_cpuid_count(7, 0, &a, &b, &c, &d))
+        return false;
+    const bool sha = (b & (1U << 29)) != 0;
+    return ssse3 && sse41 && sha;
+}
+
+/// SHA-NI compression. The state is kept as the ABEF/CDGH register pair the
+/// sha256rnds2 instruction works on; each group of four rounds also advances
+/// the message schedule held in msg[0..3].
+__attribute__((target("sha,sse4.1,ssse3"))) void process_sha_ni(uint32_t* state,
+                                                                const uint8_t* blocks, size_t count)
+{
+    const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4));
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);               // CDAB
+    state1 = _mm_shuffle_epi32(state1, 0x1B);         // EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8); // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);      // CDGH
+
+    for (; count > 0; --count, blocks += 64)
+    {
+        const __m128i abef = state0;
+        const __m128i cdgh = state1;
+        __m128i msg[4];
+
+#pragma GCC unroll 16
+        for (int i = 0; i < 16; ++i)
+        {
+            if (i < 4)
+                msg[i] = _mm_shuffle_epi8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + i * 16)), byte_swap);
+
+            __m128i k = _mm_add_epi32(
+                msg[i & 3], _mm_load_si128(reinterpret_cast<const __m128i*>(kRound + i * 4)));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, k);
+            if (i >= 3 && i <= 14)
+            {
+                // Finish the schedule words for group i + 1
+                __m128i next = _mm_add_epi32(msg[(i + 1) & 3],
+                                             _mm_alignr_epi8(msg[i & 3], msg[(i + 3) & 3], 4));
+                msg[(i + 1) & 3] = _mm_sha256msg2_epu32(next, msg[i & 3]);
+            }
+            k = _mm_shuffle_epi32(k, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, k);
+            if (i >= 1 && i <= 12)
+                msg[(i + 3) & 3] = _mm_sha256msg1_epu32(msg[(i + 3) & 3], msg[i & 3]);
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);       // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);    // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0); // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);    // HGFE
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), state1);
+}
+#endif
+} // namespace
+
+Sha256::Sha256(bool allow_hardware) : process_(process_portable), state_(kInitialState)
+{
+#ifdef FASTMCPP_SHA256_X86
+    if (allow_hardware && hardware_available())
+        process_ = process_sha_ni;
+#else
+    (void)allow_hardware;
+#endif
+}
+
+bool Sha256::hardware_available()
+{
+#ifdef FASTMCPP_SHA256_X86
+    static const bool available = cpu_has_sha_extensions();
+    return available;
+#else
+    return false;
+#endif
+}
+
+void Sha256::update(const void* data, size_t size)
+{
+    auto* bytes = static_cast<const uint8_t*>(data);
+    length_ += size;
+    if (buffered_ > 0)
+    {
+        const size_t take = std::min(size, buffer_.size() - buffered_);
+        std::memcpy(buffer_.data() + buffered_, bytes, take);
+        buffered_ += take;
+        bytes += take;
+        size -= take;
+        if (buffered_ < buffer_.size())
+            return;
+        process_(state_.data(), buffer_.data(), 1);
+        buffered_ = 0;
+    }
+    // Whole blocks straight from the input
+    if (size >= 64)
+    {
+        process_(state_.data(), bytes, size / 64);
+        bytes += size / 64 * 64;
+        size %= 64;
+    }
+    if (size > 0)
+    {
+        std::memcpy(buffer_.data(), bytes, size);
+        buffered_ = size;
+    }
+}
+
+Sha256::Digest Sha256::finish()
+{
+    const uint64_t bit_length = length_ * 8;
+    buffer_[buffered_++] = 0x80;
+    if (buffered_ > 56)
+    {
+        std::memset(buffer_.data() + buffered_, 0, buffer_.size() - buffered_);
+        process_(state_.data(), buffer_.data(), 1);
+        buffered_ = 0;
+    }
+    std::memset(buffer_.data() + buffered_, 0, 56 - buffered_);
+    for (int i = 0; i < 8; ++i)
+        buffer_[56 + i] = static_cast<uint8_t>(bit_length >> (56 - i * 8));
+    process_(state_.data(), buffer_.data(), 1);
+    buffered_ = 0;
+
+    Digest digest;
+    for (size_t i = 0; i < state_.size(); ++i)
+    {
+        digest[i * 4] = static_cast<uint8_t>(state_[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(state_[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(state_[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(state_[i]);
+    }
+    return digest;
+}
+
+std::string Sha256::hex(const Digest& digest)
+{
+    static constexpr char kHex[] = "0123456789abcdef";
+    std::string out;
+    out.reserve(digest.size() * 2);
+    for (uint8_t byte : digest)
+    {
+        out.push_back(kHex[byte >> 4]);
+        out.push_back(kHex[byte & 0x0F]);
+    }
+    return out;
+}
+
+} // namespace fastmcpp::util
@@ -0,0 +1,310 @@
+// Unit tests for FastMCP catalog generation and cached catalog snapshots
+#include "fastmcpp/app.hpp"
+#include "fastmcpp/exceptions.hpp"
+#include "fastmcpp/mcp/handler.hpp"
+#include "fastmcpp/providers/local_provider.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <iostream>
+
+using namespace fastmcpp;
+
+namespace
+{
+tools::Tool make_tool(const std::string& name)
+{
+    return tools::Tool{name, Json{{"type", "object"}, {"properties", Json::object()}}, Json(),
+                       [name](const Json&) { return Json(name); }};
+}
+
+bool catalog_has_tool(const CatalogSnapshot& catalog, const std::string& name)
+{
+    for (const auto& tool : catalog.tools)
+        if (tool.name == name)
+            return true;
+    return false;
+}
+
+Json request(const std::string& method, int id)
+{
+    return Json{{"jsonrpc", "2.0"}, {"id", id}, {"method", method}, {"params", Json::object()}};
+}
+} // namespace
+
+void test_snapshot_reused_until_change()
+{
+    std::cout << "test_snapshot_reused_until_change..." << std::endl;
+
+    FastMCP app("SnapshotApp", "1.0.0");
+    app.tools().register_tool(make_tool("one"));
+
+    auto gen1 = app.catalog_generation();
+    assert(gen1.has_value());
+    auto first = app.catalog();
+    auto second = app.catalog();
+    assert(first == second);
+    assert(first->generation == gen1);
+    assert(catalog_has_tool(*first, "one"));
+
+    app.tools().register_tool(make_tool("two"));
+    auto gen2 = app.catalog_generation();
+    assert(gen2.has_value() && *gen2 != *gen1);
+    auto third = app.catalog();
+    assert(third != first);
+    assert(catalog_has_tool(*third, "two"));
+    // Old snapshot is untouched
+    assert(!catalog_has_tool(*first, "two"));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_mounted_child_changes_invalidate_parent()
+{
+    std::cout << "test_mounted_child_changes_invalidate_parent..." << std::endl;
+
+    FastMCP parent("Parent", "1.0.0");
+    FastMCP child("Child", "1.0.0");
+    auto before_mount = parent.catalog();
+
+    parent.mount(child, "child");
+    auto after_mount = parent.catalog();
+    assert(after_mount != before_mount);
+
+    child.tools().register_tool(make_tool("leaf"));
+    auto after_child_change = parent.catalog();
+    assert(after_child_change != after_mount);
+    assert(catalog_has_tool(*after_child_change, "child_leaf"));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_provider_changes_invalidate()
+{
+    std::cout << "test_provider_changes_invalidate..." << std::endl;
+
+    FastMCP app("ProviderApp", "1.0.0");
+    auto provider = std::make_shared<providers::LocalProvider>();
+    app.add_provider(provider);
+
+    provider->add_tool(make_tool("provided"));
+    auto with_tool = app.catalog();
+    assert(catalog_has_tool(*with_tool, "provided"));
+    assert(app.catalog() == with_tool);
+
+    provider->disable({"tool:provided"});
+    auto after_disable = app.catalog();
+    assert(after_disable != with_tool);
+    assert(!catalog_has_tool(*after_disable, "provided"));
+
+    provider->enable({"tool:provided"});
+    assert(catalog_has_tool(*app.catalog(), "provided"));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_untracked_provider_is_not_cached()
+{
+    std::cout << "test_untracked_provider_is_not_cached..." << std::endl;
+
+    struct CountingProvider : providers::Provider
+    {
+        mutable int calls{0};
+        std::vector<tools::Tool> list_tools() const override
+        {
+            ++calls;
+            return {make_tool("dynamic_" + std::to_string(calls))};
+        }
+    };
+
+    FastMCP app("DynamicApp", "1.0.0");
+    auto provider = std::make_shared<CountingProvider>();
+    app.add_provider(provider);
+
+    assert(!app.catalog_generation().has_value());
+    auto first = app.catalog();
+    auto second = app.catalog();
+    assert(first != second);
+    assert(first->tools.size() == 1 && second->tools.size() == 1);
+    assert(first->tools[0].name != second->tools[0].name);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_untracked_lists_walk_one_kind()
+{
+    std::cout << "test_untracked_lists_walk_one_kind..." << std::endl;
+
+    struct CountingProvider : providers::Provider
+    {
+        mutable std::atomic<int> tool_lists{0};
+        mutable std::atomic<int> resource_lists{0};
+        mutable std::atomic<int> prompt_lists{0};
+        std::vector<tools::Tool> list_tools() const override
+        {
+            ++tool_lists;
+            return {make_tool("counted")};
+        }
+        std::vector<resources::Resource> list_resources() const override
+        {
+            ++resource_lists;
+            return {};
+        }
+        std::vector<prompts::Prompt> list_prompts() const override
+        {
+            ++prompt_lists;
+            return {};
+        }
+    };
+
+    FastMCP app("UntrackedApp", "1.0.0");
+    auto provider = std::make_shared<CountingProvider>();
+    app.add_provider(provider);
+    assert(!app.cached_catalog());
+    auto handler = mcp::make_mcp_handler(app);
+
+    // Each list request walks only its own kind, never a whole snapshot
+    auto tools = handler(request("tools/list", 1));
+    assert(tools["result"]["tools"].size() == 1);
+    assert(provider->tool_lists == 1);
+    assert(provider->resource_lists == 0 && provider->prompt_lists == 0);
+
+    handler(request("prompts/list", 2));
+    assert(provider->prompt_lists == 1);
+    assert(provider->tool_lists == 1 && provider->resource_lists == 0);
+
+    // tools/call looks up its route with one tools listing and nothing else
+    Json call = request("tools/call", 3);
+    call["params"] = Json{{"name", "counted"}, {"arguments", Json::object()}};
+    auto called = handler(call);
+    assert(called.contains("result"));
+    assert(provider->resource_lists == 0 && provider->prompt_lists == 1);
+    assert(!app.find_tool_route("missing"));
+    auto route = app.find_tool_route("counted");
+    assert(route && !route->tool && !route->has_output_schema);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_handler_lists_follow_generation()
+{
+    std::cout << "test_handler_lists_follow_generation..." << std::endl;
+
+    FastMCP app("HandlerApp", "1.0.0");
+    app.tools().register_tool(make_tool("alpha"));
+    auto handler = mcp::make_mcp_handler(app);
+
+    auto init = handler(request("initialize", 1));
+    assert(!init["result"]["capabilities"].contains("prompts"));
+
+    auto list1 = handler(request("tools/list", 2));
+    assert(list1["result"]["tools"].size() == 1);
+    auto list2 = handler(request("tools/list", 3));
+    assert(list2["result"]["tools"] == list1["result"]["tools"]);
+
+    app.tools().register_tool(make_tool("beta"));
+    app.prompt("greet", [](const Json&)
+               { return std::vector<prompts::PromptMessage>{{"user", "hi"}}; });
+
+    auto list3 = handler(request("tools/list", 4));
+    assert(list3["result"]["tools"].size() == 2);
+
+    auto prompts = handler(request("prompts/list", 5));
+    assert(prompts["result"]["prompts"].size() == 1);
+    assert(prompts["result"]["prompts"][0]["name"] == "greet");
+
+    auto init2 = handler(request("initialize", 6));
+    assert(init2["result"]["capabilities"].contains("prompts"));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_proxy_mount_disables_caching()
+{
+    std::cout << "test_proxy_mount_disables_caching..." << std::endl;
+
+    FastMCP parent("Parent", "1.0.0");
+    FastMCP remote("Remote", "1.0.0");
+    remote.tools().register_tool(make_tool("far"));
+    parent.mount(remote, "remote", true);
+
+    assert(!parent.catalog_generation().has_value());
+    assert(catalog_has_tool(*parent.catalog(), "remote_far"));
+
+    remote.tools().register_tool(make_tool("farther"));
+    assert(catalog_has_tool(*parent.catalog(), "remote_farther"));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_tool_routes_resolve_through_mounts()
+{
+    std::cout << "test_tool_routes_resolve_through_mounts..." << std::endl;
+
+    FastMCP root("Root", "1.0.0");
+    FastMCP middle("Middle", "1.0.0");
+    FastMCP leaf("Leaf", "1.0.0");
+    leaf.tools().register_tool(make_tool("deep"));
+    leaf.tools().register_tool(
+        tools::Tool{"typed", Json{{"type", "object"}},
+                    Json{{"type", "object"}, {"x-fastmcp-wrap-result", true}},
+                    [](const Json&) { return Json(7); }});
+    middle.mount(leaf, "leaf");
+    root.mount(middle, "mid", false,
+               std::unordered_map<std::string, std::string>{{"leaf_deep", "renamed"}});
+
+    auto provider = std::make_shared<providers::LocalProvider>();
+    provider->add_tool(make_tool("provided"));
+    root.add_provider(provider);
+
+    auto catalog = root.catalog();
+    const auto* renamed = catalog->find_tool_route("renamed");
+    assert(renamed && renamed->tool == &leaf.tools().get("deep"));
+    assert(!renamed->has_output_schema);
+    const auto* typed = catalog->find_tool_route("mid_leaf_typed");
+    assert(typed && typed->has_output_schema && typed->wrap_result);
+    assert(typed->task_support == TaskSupport::Forbidden);
+    assert(catalog->find_tool_route("provided"));
+    assert(!catalog->find_tool_route("mid_leaf_deep"));
+
+    assert(root.invoke_tool("renamed", Json::object()) == "deep");
+    assert(root.invoke_tool("provided", Json::object()) == "provided");
+    assert(root.invoke_tool("mid_leaf_typed", Json::object()) == 7);
+    // Unlisted alias of an overridden tool still resolves via the mount walk
+    assert(root.invoke_tool("mid_leaf_deep", Json::object()) == "deep");
+
+    bool threw = false;
+    try
+    {
+        root.invoke_tool("missing", Json::object());
+    }
+    catch (const NotFoundError&)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    // Routes follow registrations in the leaf
+    leaf.tools().register_tool(make_tool("late"));
+    assert(root.invoke_tool("mid_leaf_late", Json::object()) == "late");
+    assert(root.catalog()->find_tool_route("mid_leaf_late"));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== FastMCP Catalog Snapshot Tests ===" << std::endl;
+
+    test_snapshot_reused_until_change();
+    test_mounted_child_changes_invalidate_parent();
+    test_provider_changes_invalidate();
+    test_untracked_provider_is_not_cached();
+    test_untracked_lists_walk_one_kind();
+    test_handler_lists_follow_generation();
+    test_proxy_mount_disables_caching();
+    test_tool_routes_resolve_through_mounts();
+
+    std::cout << "\n=== All tests PASSED ===" << std::endl;
+    return 0;
+}
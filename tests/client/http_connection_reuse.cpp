@@ -0,0 +1,219 @@
+// Tests that HttpTransport and SseClientTransport keep their POST connections open
+// across requests and drop a connection once a request on it fails
+#include "fastmcpp/client/transports.hpp"
+#include "fastmcpp/exceptions.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <httplib.h>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using fastmcpp::Json;
+using namespace std::chrono_literals;
+
+namespace
+{
+/// Answers with headers announcing a body, then closes the connection without
+/// sending it, so the client sees a request with no response.
+void abort_response(httplib::Response& res)
+{
+    res.set_content_provider(
+        16, "application/json",
+        [](size_t /*offset*/, size_t /*length*/, httplib::DataSink& /*sink*/) { return false; });
+}
+
+/// Minimal MCP SSE server: GET /sse announces /messages as the endpoint and relays
+/// the responses to POSTed requests. A request for method "drop" is aborted.
+class SseTestServer
+{
+  public:
+    SseTestServer()
+    {
+        server_.Get("/sse",
+                    [this](const httplib::Request&, httplib::Response& res)
+                    {
+                        res.set_chunked_content_provider(
+                            "text/event-stream",
+                            [this, announced = false](size_t, httplib::DataSink& sink) mutable
+                            {
+                                if (!announced)
+                                {
+                                    const std::string endpoint =
+                                        "event: endpoint\ndata: /messages?session_id=s1\n\n";
+                                    sink.write(endpoint.data(), endpoint.size());
+                                    announced = true;
+                                }
+                                std::unique_lock<std::mutex> lock(mutex_);
+                                cv_.wait_for(lock, 50ms,
+                                             [this]() { return stopping_ || !outgoing_.empty(); });
+                                // A comment keeps the client reading, so it notices when
+                                // it is shut down
+                                std::string events = outgoing_.empty() ? ": idle\n\n" : "";
+                                for (; !outgoing_.empty(); outgoing_.pop_front())
+                                    events += "event: message\ndata: " + outgoing_.front() + "\n\n";
+                                sink.write(events.data(), events.size());
+                                return !stopping_;
+                            });
+                    });
+        server_.Post("/messages",
+                     [this](const httplib::Request& req, httplib::Response& res)
+                     {
+                         auto request = Json::parse(req.body);
+                         if (request.value("method", "") == "drop")
+                         {
+                             abort_response(res);
+                             return;
+                         }
+                         Json response = {{"jsonrpc", "2.0"},
+                                          {"id", request["id"]},
+                                          {"result", {{"method", request["method"]}}}};
+                         {
+                             std::lock_guard<std::mutex> lock(mutex_);
+                             outgoing_.push_back(response.dump());
+                         }
+                         cv_.notify_all();
+                         res.status = 202;
+                     });
+
+        port_ = server_.bind_to_any_port("127.0.0.1");
+        assert(port_ > 0);
+        thread_ = std::thread([this]() { server_.listen_after_bind(); });
+        server_.wait_until_ready();
+    }
+
+    ~SseTestServer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        server_.stop();
+        thread_.join();
+    }
+
+    int port() const
+    {
+        return port_;
+    }
+
+  private:
+    httplib::Server server_;
+    int port_{0};
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::string> outgoing_;
+    bool stopping_{false};
+};
+} // namespace
+
+void test_http_transport_reuses_connection()
+{
+    std::cout << "test_http_transport_reuses_connection..." << std::endl;
+
+    httplib::Server server;
+    server.Post(
+        "/sum",
+        [](const httplib::Request& req, httplib::Response& res)
+        {
+            auto args = Json::parse(req.body);
+            res.set_content(Json(args["a"].get<int>() + args["b"].get<int>()).dump(),
+                            "application/json");
+        });
+    server.Post("/drop",
+                [](const httplib::Request&, httplib::Response& res) { abort_response(res); });
+    const int port = server.bind_to_any_port("127.0.0.1");
+    assert(port > 0);
+    std::thread thread([&server]() { server.listen_after_bind(); });
+    server.wait_until_ready();
+
+    {
+        fastmcpp::client::HttpTransport transport("127.0.0.1:" + std::to_string(port));
+        for (int i = 0; i < 3; ++i)
+            assert(transport.request("sum", Json{{"a", i}, {"b", 1}}).get<int>() == i + 1);
+        auto stats = transport.connection_stats();
+        assert(stats.requests == 3);
+        assert(stats.connections == 1);
+        assert(stats.reused() == 2);
+        assert(stats.idle_clients == 1);
+
+        // The failed request's connection is closed rather than parked again
+        bool failed = false;
+        try
+        {
+            transport.request("drop", Json::object());
+        }
+        catch (const fastmcpp::TransportError&)
+        {
+            failed = true;
+        }
+        assert(failed);
+        assert(transport.connection_stats().idle_clients == 0);
+
+        assert(transport.request("sum", Json{{"a", 2}, {"b", 2}}).get<int>() == 4);
+        stats = transport.connection_stats();
+        assert(stats.connections == 2);
+        assert(stats.idle_clients == 1);
+    }
+
+    server.stop();
+    thread.join();
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_sse_transport_reuses_connection()
+{
+    std::cout << "test_sse_transport_reuses_connection..." << std::endl;
+
+    SseTestServer server;
+    fastmcpp::client::SseClientTransport transport("http://127.0.0.1:" +
+                                                   std::to_string(server.port()));
+    for (int i = 0; i < 500 && !transport.has_session(); ++i)
+        std::this_thread::sleep_for(10ms);
+    assert(transport.has_session());
+
+    for (int i = 0; i < 3; ++i)
+        assert(transport.request("ping", Json::object())["method"] == "ping");
+    auto stats = transport.connection_stats();
+    assert(stats.requests == 3);
+    assert(stats.connections == 1);
+    assert(stats.reused() == 2);
+    assert(stats.idle_clients == 1);
+
+    bool failed = false;
+    try
+    {
+        transport.request("drop", Json::object());
+    }
+    catch (const fastmcpp::TransportError&)
+    {
+        failed = true;
+    }
+    assert(failed);
+    assert(transport.connection_stats().idle_clients == 0);
+
+    assert(transport.request("ping", Json::object())["method"] == "ping");
+    stats = transport.connection_stats();
+    assert(stats.connections == 2);
+    assert(stats.idle_clients == 1);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== HTTP Connection Reuse Tests ===" << std::endl;
+
+    test_http_transport_reuses_connection();
+    test_sse_transport_reuses_connection();
+
+    std::cout << "\n=== All tests PASSED ===" << std::endl;
+    return 0;
+}
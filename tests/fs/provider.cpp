@@ -2,26 +2,50 @@
 #include "fastmcpp/providers/filesystem_provider.hpp"
 
 #include <cassert>
+#include <chrono>
 #include <filesystem>
 #include <iostream>
+#include <thread>
 
 using namespace fastmcpp;
 
 namespace
 {
-std::filesystem::path plugin_path_from_exe(const std::filesystem::path& exe_path)
+std::filesystem::path plugin_path_from_exe(const std::filesystem::path& exe_path,
+                                           const std::string& name = "fastmcpp_fs_test_plugin")
 {
     auto dir = exe_path.parent_path();
     if (dir.empty())
         dir = std::filesystem::current_path();
 #if defined(_WIN32)
-    return dir / "fastmcpp_fs_test_plugin.dll";
+    return dir / (name + ".dll");
 #elif defined(__APPLE__)
-    return dir / "libfastmcpp_fs_test_plugin.dylib";
+    return dir / ("lib" + name + ".dylib");
 #else
-    return dir / "libfastmcpp_fs_test_plugin.so";
+    return dir / ("lib" + name + ".so");
 #endif
 }
+
+bool has_tool(providers::FileSystemProvider& provider, const std::string& name)
+{
+    for (const auto& tool : provider.list_tools())
+        if (tool.name() == name)
+            return true;
+    return false;
+}
+
+/// Lists until the tool's presence matches `expected`, as reloading is asynchronous
+bool wait_for_tool(providers::FileSystemProvider& provider, const std::string& name, bool expected)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        if (has_tool(provider, name) == expected)
+            return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    return false;
+}
 } // namespace
 
 void test_filesystem_provider(const std::filesystem::path& exe_path)
@@ -80,10 +104,59 @@ void test_filesystem_provider(const std::filesystem::path& exe_path)
     std::cout << "  PASSED" << std::endl;
 }
 
+void test_filesystem_provider_reload(const std::filesystem::path& exe_path)
+{
+    std::cout << "test_filesystem_provider_reload..." << std::endl;
+    const auto plugin_path = plugin_path_from_exe(exe_path);
+    const auto alt_path = plugin_path_from_exe(exe_path, "fastmcpp_fs_test_plugin_alt");
+    assert(std::filesystem::exists(alt_path));
+    const auto extension = plugin_path.extension();
+
+    const auto dir = std::filesystem::temp_directory_path() / "fastmcpp_fs_reload";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "nested");
+    std::filesystem::copy_file(plugin_path, dir / ("a" + extension.string()));
+
+    providers::FileSystemProvider provider(dir, true);
+    assert(provider.reload_enabled());
+    assert(has_tool(provider, "fs_echo"));
+    assert(!has_tool(provider, "fs_alt"));
+
+    // Unchanged files leave the catalog, and its generation, alone
+    const auto generation = provider.generation();
+    provider.list_tools();
+    provider.list_resources();
+    assert(provider.generation() == generation);
+
+    // A library added in a subdirectory
+    std::filesystem::copy_file(alt_path, dir / "nested" / ("b" + extension.string()));
+    assert(wait_for_tool(provider, "fs_alt", true));
+    assert(has_tool(provider, "fs_echo"));
+    assert(provider.generation() != generation);
+
+    // Components from the remaining libraries still work after a removal
+    std::filesystem::remove(dir / "nested" / ("b" + extension.string()));
+    assert(wait_for_tool(provider, "fs_alt", false));
+    auto echo = provider.get_tool("fs_echo");
+    assert(echo && echo->invoke(Json{{"message", "still"}}) == "still");
+
+    // Replacing a loaded library in place (by rename) swaps its components
+    std::filesystem::copy_file(alt_path, dir / "a.tmp");
+    std::filesystem::rename(dir / "a.tmp", dir / ("a" + extension.string()));
+    assert(wait_for_tool(provider, "fs_alt", true));
+    assert(wait_for_tool(provider, "fs_echo", false));
+    // The replaced build stays loaded for components copied out earlier
+    assert(echo->invoke(Json{{"message", "old"}}) == "old");
+
+    std::filesystem::remove_all(dir);
+    std::cout << "  PASSED" << std::endl;
+}
+
 int main(int argc, char** argv)
 {
     std::filesystem::path exe_path =
         argc > 0 ? std::filesystem::path(argv[0]) : std::filesystem::current_path();
     test_filesystem_provider(exe_path);
+    test_filesystem_provider_reload(exe_path);
     return 0;
 }
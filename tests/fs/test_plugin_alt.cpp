@@ -0,0 +1,14 @@
+// Second plugin build, used to check that reloading picks up changed libraries
+#include "fastmcpp/providers/component_registry.hpp"
+#include "fastmcpp/tools/tool.hpp"
+#include "fastmcpp/types.hpp"
+
+using namespace fastmcpp;
+
+extern "C" FASTMCPP_PROVIDER_API void
+fastmcpp_register_components(fastmcpp::providers::ComponentRegistry& registry)
+{
+    tools::Tool alt_tool{"fs_alt", Json{{"type", "object"}}, Json{{"type", "string"}},
+                         [](const Json&) { return Json("alt"); }};
+    registry.add_tool(std::move(alt_tool));
+}
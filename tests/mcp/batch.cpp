@@ -0,0 +1,215 @@
+// Tests for JSON-RPC batch handling in the MCP handler and Client::call_batch
+#include "fastmcpp/app.hpp"
+#include "fastmcpp/client/client.hpp"
+#include "fastmcpp/mcp/handler.hpp"
+#include "fastmcpp/util/jsonrpc.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace fastmcpp;
+using namespace std::chrono_literals;
+
+namespace
+{
+Json call_request(int id, const std::string& tool, Json arguments = Json::object())
+{
+    return Json{{"jsonrpc", "2.0"},
+                {"id", id},
+                {"method", "tools/call"},
+                {"params", {{"name", tool}, {"arguments", std::move(arguments)}}}};
+}
+
+void add_tools(FastMCP& app)
+{
+    app.tool(
+        "echo", [](const Json& args) { return args; });
+    app.tool("fail", [](const Json&) -> Json { throw std::runtime_error("boom"); });
+}
+
+/// Transport without batch support, used to exercise the sequential fallback.
+class PlainTransport : public client::ITransport
+{
+  public:
+    explicit PlainTransport(client::InProcessMcpTransport::HandlerFn handler)
+        : inner_(std::move(handler))
+    {
+    }
+
+    Json request(const std::string& route, const Json& payload) override
+    {
+        return inner_.request(route, payload);
+    }
+
+  private:
+    client::InProcessMcpTransport inner_;
+};
+} // namespace
+
+void test_handler_answers_batch_in_order()
+{
+    std::cout << "test_handler_answers_batch_in_order..." << std::endl;
+
+    FastMCP app("Batch", "1.0.0");
+    add_tools(app);
+    auto handler = mcp::make_mcp_handler(app);
+
+    Json batch = Json::array();
+    batch.push_back(call_request(1, "echo", {{"x", 1}}));
+    batch.push_back(Json{{"jsonrpc", "2.0"}, {"method", "notifications/initialized"}});
+    batch.push_back(call_request(2, "missing"));
+    batch.push_back(42);
+    batch.push_back(Json{{"jsonrpc", "2.0"}, {"id", 3}, {"method", "tools/list"}});
+
+    auto reply = handler(batch);
+    assert(reply.is_array());
+    // The notification gets no entry; everything else is answered in request order
+    assert(reply.size() == 4);
+    assert(reply[0]["id"] == 1);
+    assert(reply[0].contains("result"));
+    assert(reply[1]["id"] == 2);
+    assert(reply[1].contains("error"));
+    assert(reply[2]["id"].is_null());
+    assert(reply[2]["error"]["code"] == -32600);
+    assert(reply[3]["id"] == 3);
+    assert(reply[3]["result"]["tools"].size() == 2);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_handler_batch_edge_cases()
+{
+    std::cout << "test_handler_batch_edge_cases..." << std::endl;
+
+    FastMCP app("Batch", "1.0.0");
+    add_tools(app);
+    auto handler = mcp::make_mcp_handler(app);
+
+    // An empty batch is a single Invalid Request error
+    auto reply = handler(Json::array());
+    assert(reply.is_object());
+    assert(reply["error"]["code"] == -32600);
+
+    // A batch of notifications produces no reply at all
+    Json notifications = Json::array();
+    notifications.push_back(Json{{"jsonrpc", "2.0"}, {"method", "notifications/initialized"}});
+    assert(handler(notifications).is_null());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_handler_runs_batch_entries_in_parallel()
+{
+    std::cout << "test_handler_runs_batch_entries_in_parallel..." << std::endl;
+
+    FastMCP app("Batch", "1.0.0");
+    std::atomic<int> arrived{0};
+    app.tool("rendezvous",
+             [&arrived](const Json&)
+             {
+                 ++arrived;
+                 auto deadline = std::chrono::steady_clock::now() + 5s;
+                 while (arrived < 2 && std::chrono::steady_clock::now() < deadline)
+                     std::this_thread::sleep_for(1ms);
+                 return Json(arrived.load());
+             });
+    auto handler = mcp::make_mcp_handler(app);
+
+    // Each call waits for the other, so this only finishes quickly when they overlap
+    auto start = std::chrono::steady_clock::now();
+    auto reply =
+        handler(Json::array({call_request(1, "rendezvous"), call_request(2, "rendezvous")}));
+    assert(std::chrono::steady_clock::now() - start < 4s);
+    assert(reply.size() == 2);
+    assert(arrived == 2);
+
+    // Batch helpers come from a bounded pool rather than threads of their own
+    auto& pool = util::jsonrpc::batch_pool();
+    for (int i = 0; i < 100; ++i)
+        handler(Json::array({call_request(1, "rendezvous"), call_request(2, "rendezvous")}));
+    assert(pool.metrics().workers <= pool.max_workers());
+    assert(pool.metrics().completed > 0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_client_call_batch()
+{
+    std::cout << "test_client_call_batch..." << std::endl;
+
+    FastMCP app("Batch", "1.0.0");
+    add_tools(app);
+    std::vector<client::BatchCall> calls{
+        {"tools/call", {{"name", "echo"}, {"arguments", {{"x", 7}}}}},
+        {"tools/call", {{"name", "missing"}, {"arguments", Json::object()}}},
+        {"tools/list", Json::object()},
+    };
+
+    // Batched in one handler call
+    client::Client batched(
+        std::make_unique<client::InProcessMcpTransport>(mcp::make_mcp_handler(app)));
+    auto responses = batched.call_batch(calls);
+    assert(responses.size() == 3);
+    assert(responses[0].contains("result"));
+    assert(responses[1].contains("error"));
+    assert(responses[2]["result"]["tools"].size() == 2);
+
+    // Same shape when the transport cannot batch
+    client::Client sequential(std::make_unique<PlainTransport>(mcp::make_mcp_handler(app)));
+    auto fallback = sequential.call_batch(calls);
+    assert(fallback.size() == 3);
+    assert(fallback[0]["result"] == responses[0]["result"]);
+    assert(fallback[1].contains("error"));
+    assert(fallback[2]["result"]["tools"].size() == 2);
+    for (size_t i = 0; i < fallback.size(); ++i)
+        assert(fallback[i]["id"] == i);
+
+    assert(batched.call_batch({}).empty());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_match_batch_responses()
+{
+    std::cout << "test_match_batch_responses..." << std::endl;
+
+    // Replies out of order, one missing
+    Json reply = Json::array({Json{{"jsonrpc", "2.0"}, {"id", 2}, {"result", "b"}},
+                              Json{{"jsonrpc", "2.0"}, {"id", 1}, {"result", "a"}}});
+    auto matched = client::detail::match_batch_responses(reply, {1, 2, 3});
+    assert(matched[0]["result"] == "a");
+    assert(matched[1]["result"] == "b");
+    assert(matched[2]["id"] == 3);
+    assert(matched[2].contains("error"));
+
+    // A whole-batch rejection applies to every call
+    Json rejected = {{"jsonrpc", "2.0"},
+                     {"id", nullptr},
+                     {"error", {{"code", -32600}, {"message", "Invalid Request"}}}};
+    matched = client::detail::match_batch_responses(rejected, {1, 2});
+    assert(matched[0]["error"]["code"] == -32600);
+    assert(matched[1]["error"]["code"] == -32600);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== JSON-RPC Batch Tests ===" << std::endl;
+
+    test_handler_answers_batch_in_order();
+    test_handler_batch_edge_cases();
+    test_handler_runs_batch_entries_in_parallel();
+    test_client_call_batch();
+    test_match_batch_responses();
+
+    std::cout << "\n=== All tests PASSED ===" << std::endl;
+    return 0;
+}
@@ -133,5 +133,33 @@ int main()
         assert(checked_with);
     }
 
+    // Method dispatch: near-miss names, ping, and malformed envelopes
+    {
+        auto ping = handler(Json{{"jsonrpc", "2.0"}, {"id", 30}, {"method", "ping"}});
+        assert(ping["id"] == 30);
+        assert(ping["result"].is_object() && ping["result"].empty());
+
+        // Same length and hash characters as "tools/list" but a different name
+        auto near = handler(Json{{"jsonrpc", "2.0"}, {"id", 31}, {"method", "tools/lisx"}});
+        assert(near["error"]["code"] == -32601);
+
+        for (const char* method : {"", "p", "tools", "resources/templates/lis"})
+        {
+            auto resp = handler(Json{{"jsonrpc", "2.0"}, {"id", 32}, {"method", method}});
+            assert(resp["error"]["code"] == -32601);
+        }
+
+        auto no_method = handler(Json{{"jsonrpc", "2.0"}, {"id", 33}});
+        assert(no_method["error"]["code"] == -32601);
+        assert(no_method["id"] == 33);
+
+        auto bad_method = handler(Json{{"jsonrpc", "2.0"}, {"id", 34}, {"method", 7}});
+        assert(bad_method["error"]["code"] == -32601);
+
+        // Missing params behave like an empty object
+        auto no_params = handler(Json{{"jsonrpc", "2.0"}, {"id", 35}, {"method", "tools/call"}});
+        assert(no_params["error"]["code"] == -32602);
+    }
+
     return 0;
 }
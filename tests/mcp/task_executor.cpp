@@ -0,0 +1,222 @@
+// Unit tests for the SEP-1686 background task executor
+#include "../wait_helpers.hpp"
+#include "fastmcpp/app.hpp"
+#include "fastmcpp/mcp/handler.hpp"
+#include "fastmcpp/mcp/tasks.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace fastmcpp;
+using namespace fastmcpp::mcp::tasks;
+using namespace std::chrono_literals;
+
+namespace
+{
+/// Holds the executor's only worker until released, so later submissions queue up.
+struct Gate
+{
+    std::atomic<bool> open{false};
+
+    void hold(TaskExecutor& executor)
+    {
+        bool ok = executor.submit("gate", 1000,
+                                  [this]()
+                                  {
+                                      while (!open)
+                                          std::this_thread::sleep_for(1ms);
+                                  });
+        assert(ok);
+        assert(wait_until([&]() { return executor.stats().running == 1; }));
+    }
+};
+
+struct Recorder
+{
+    std::mutex mutex;
+    std::vector<std::string> order;
+
+    std::function<void()> record(std::string label)
+    {
+        return [this, label]()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(label);
+        };
+    }
+};
+} // namespace
+
+void test_round_robin_across_owners()
+{
+    std::cout << "test_round_robin_across_owners..." << std::endl;
+
+    TaskExecutor executor(TaskExecutorOptions{1, 64});
+    Gate gate;
+    gate.hold(executor);
+
+    Recorder recorder;
+    for (int i = 1; i <= 3; ++i)
+        assert(executor.submit("a", 0, recorder.record("a" + std::to_string(i))));
+    for (int i = 1; i <= 2; ++i)
+        assert(executor.submit("b", 0, recorder.record("b" + std::to_string(i))));
+    assert(executor.stats().waiting_owners == 2);
+
+    gate.open = true;
+    assert(wait_until([&]() { return executor.stats().completed == 6; }));
+    std::vector<std::string> expected{"a1", "b1", "a2", "b2", "a3"};
+    assert(recorder.order == expected);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_priority_runs_first()
+{
+    std::cout << "test_priority_runs_first..." << std::endl;
+
+    TaskExecutor executor(TaskExecutorOptions{1, 64});
+    Gate gate;
+    gate.hold(executor);
+
+    Recorder recorder;
+    assert(executor.submit("a", 0, recorder.record("low")));
+    assert(executor.submit("b", -1, recorder.record("lowest")));
+    assert(executor.submit("a", 5, recorder.record("high")));
+
+    gate.open = true;
+    assert(wait_until([&]() { return executor.stats().completed == 4; }));
+    std::vector<std::string> expected{"high", "low", "lowest"};
+    assert(recorder.order == expected);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_bounded_admission_and_stats()
+{
+    std::cout << "test_bounded_admission_and_stats..." << std::endl;
+
+    TaskExecutor executor(TaskExecutorOptions{1, 2});
+    Gate gate;
+    gate.hold(executor);
+
+    assert(executor.submit("a", 0, []() {}));
+    assert(executor.submit("b", 0, []() {}));
+    assert(!executor.submit("c", 0, []() {}));
+
+    auto stats = executor.stats();
+    assert(stats.workers == 1);
+    assert(stats.queue_depth == 2);
+    assert(stats.rejected == 1);
+    assert(stats.submitted == 3);
+
+    std::this_thread::sleep_for(5ms);
+    gate.open = true;
+    assert(wait_until([&]() { return executor.stats().completed == 3; }));
+    stats = executor.stats();
+    assert(stats.queue_depth == 0);
+    assert(stats.running == 0);
+    assert(stats.max_wait >= 5ms);
+    assert(stats.total_wait >= stats.max_wait);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_workers_run_in_parallel()
+{
+    std::cout << "test_workers_run_in_parallel..." << std::endl;
+
+    TaskExecutor executor(TaskExecutorOptions{4, 64});
+    assert(executor.stats().workers == 0); // Started on demand
+    std::atomic<int> started{0};
+    std::atomic<bool> release{false};
+    for (int i = 0; i < 4; ++i)
+        assert(executor.submit("same-owner", 0,
+                               [&]()
+                               {
+                                   ++started;
+                                   while (!release)
+                                       std::this_thread::sleep_for(1ms);
+                               }));
+
+    // All four are in flight at once even though one owner queued them
+    assert(wait_until([&]() { return started == 4; }));
+    assert(executor.stats().running == 4);
+    assert(executor.stats().workers == 4);
+    release = true;
+    assert(wait_until([&]() { return executor.stats().completed == 4; }));
+
+    // Idle workers are reused rather than joined by new ones
+    for (int i = 0; i < 8; ++i)
+        assert(executor.submit(
+            "later", 0, []() {}));
+    assert(wait_until([&]() { return executor.stats().completed == 12; }));
+    assert(executor.stats().workers == 4);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_handler_uses_app_executor()
+{
+    std::cout << "test_handler_uses_app_executor..." << std::endl;
+
+    FastMCP app("TaskApp", "1.0.0");
+    FastMCP::ToolOptions options;
+    options.task_support = TaskSupport::Optional;
+    app.tool("echo", [](const Json& args) { return args; }, options);
+
+    auto executor = std::make_shared<TaskExecutor>(TaskExecutorOptions{2, 0});
+    app.set_task_executor(executor);
+    auto handler = mcp::make_mcp_handler(app);
+
+    Json call = {
+        {"jsonrpc", "2.0"},
+        {"id", 1},
+        {"method", "tools/call"},
+        {"params",
+         {{"name", "echo"},
+          {"arguments", {{"x", 1}}},
+          {"_meta",
+           {{"modelcontextprotocol.io/task", {{"ttl", 60000}}}, {"fastmcp", {{"priority", 3}}}}}}}};
+    auto response = handler(call);
+    std::string task_id =
+        response["result"]["_meta"]["modelcontextprotocol.io/task"]["taskId"].get<std::string>();
+
+    // max_queued == 0 admits nothing, so the task fails instead of waiting forever
+    Json get = {
+        {"jsonrpc", "2.0"}, {"id", 2}, {"method", "tasks/get"}, {"params", {{"taskId", task_id}}}};
+    auto status = handler(get);
+    assert(status["result"]["status"] == "failed");
+    assert(executor->stats().rejected == 1);
+
+    // A roomier executor runs the task
+    app.set_task_executor(std::make_shared<TaskExecutor>(TaskExecutorOptions{2, 8}));
+    auto handler2 = mcp::make_mcp_handler(app);
+    response = handler2(call);
+    task_id =
+        response["result"]["_meta"]["modelcontextprotocol.io/task"]["taskId"].get<std::string>();
+    get["params"]["taskId"] = task_id;
+    assert(wait_until([&]() { return handler2(get)["result"]["status"] == "completed"; }));
+    assert(wait_until([&]() { return app.task_executor()->stats().completed == 1; }));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== Task Executor Tests ===" << std::endl;
+
+    test_round_robin_across_owners();
+    test_priority_runs_first();
+    test_bounded_admission_and_stats();
+    test_workers_run_in_parallel();
+    test_handler_uses_app_executor();
+
+    std::cout << "\n=== All tests PASSED ===" << std::endl;
+    return 0;
+}
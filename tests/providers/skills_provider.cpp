@@ -2,10 +2,13 @@
 
 #include "fastmcpp/app.hpp"
 
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace fastmcpp;
@@ -34,6 +37,83 @@ std::string read_text_data(const resources::ResourceContent& content)
         return *text;
     return {};
 }
+
+bool has_resource(const providers::SkillsDirectoryProvider& provider, const std::string& uri)
+{
+    return provider.get_resource(uri).has_value();
+}
+
+/// Lists until the resource's presence matches `expected`, as reloading is asynchronous
+bool wait_for_resource(const providers::SkillsDirectoryProvider& provider, const std::string& uri,
+                       bool expected)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        if (has_resource(provider, uri) == expected)
+            return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    return false;
+}
+
+void test_directory_reload()
+{
+    const auto root = make_temp_dir("reload");
+    write_text(root / "alpha" / "SKILL.md", "# Alpha\nfirst");
+
+    auto provider = std::make_shared<providers::SkillsDirectoryProvider>(
+        root, true, "SKILL.md", providers::SkillSupportingFiles::Resources);
+    std::atomic<int> notifications{0};
+    provider->set_notification_callback(
+        [&notifications](const std::string& method, const Json&)
+        {
+            assert(method == "notifications/resources/list_changed");
+            ++notifications;
+        });
+    assert(has_resource(*provider, "skill://alpha/SKILL.md"));
+
+    // Unchanged trees keep the listing, and its generation, as they are
+    const auto generation = provider->generation();
+    assert(generation.has_value());
+    (void)provider->list_resources();
+    assert(provider->generation() == generation);
+
+    // Providers over the same root share its index: no rescan, same listing
+    providers::SkillsDirectoryProvider twin(root, true, "SKILL.md",
+                                            providers::SkillSupportingFiles::Resources);
+    assert(twin.list_resources().size() == provider->list_resources().size());
+
+    // A new skill, and a new file in an existing skill, appear incrementally
+    write_text(root / "beta" / "SKILL.md", "# Beta\nsecond");
+    assert(wait_for_resource(*provider, "skill://beta/SKILL.md", true));
+    write_text(root / "alpha" / "notes.txt", "notes");
+    assert(wait_for_resource(*provider, "skill://alpha/notes.txt", true));
+    assert(wait_for_resource(twin, "skill://alpha/notes.txt", true));
+    assert(provider->generation() != generation);
+    assert(notifications > 0);
+
+    // Edited descriptions are picked up; resources copied out earlier still read
+    auto alpha_manifest = provider->get_resource("skill://alpha/_manifest");
+    assert(alpha_manifest.has_value());
+    write_text(root / "alpha" / "SKILL.md", "# Alpha edited\nfirst");
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (*provider->get_resource("skill://alpha/SKILL.md")->description != "Alpha edited" &&
+           std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assert(*provider->get_resource("skill://alpha/SKILL.md")->description == "Alpha edited");
+    assert(read_text_data(alpha_manifest->provider(Json::object())).find("notes.txt") !=
+           std::string::npos);
+
+    // Removed skills disappear
+    const int before_removal = notifications;
+    std::filesystem::remove_all(root / "beta");
+    assert(wait_for_resource(*provider, "skill://beta/SKILL.md", false));
+    assert(notifications > before_removal);
+
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+}
 } // namespace
 
 int main()
@@ -86,6 +166,35 @@ int main()
     }
     assert(found_expected_hash);
 
+    // Cached hashes and descriptions follow edits to the files
+    const auto guide_path = skill / "notes" / "guide.txt";
+    write_text(guide_path, "GUIDE");
+    std::filesystem::last_write_time(guide_path, std::filesystem::last_write_time(guide_path) +
+                                                     std::chrono::seconds(1));
+    write_text(skill / "notes" / "extra.bin", std::string(100000, 'x'));
+    manifest_json =
+        Json::parse(read_text_data(app.read_resource("skill://pdf-processing/_manifest")));
+    assert(manifest_json["files"].size() == 3);
+    for (const auto& entry : manifest_json["files"])
+    {
+        if (entry.value("path", "") == "notes/guide.txt")
+            assert(entry.value("hash", "") ==
+                   "sha256:865e00469ca53ed369ee10f7763c4868c9def359d2b9fd1315a9c57d78c0b086");
+        if (entry.value("path", "") == "notes/extra.bin")
+            assert(entry.value("size", 0) == 100000);
+    }
+    write_text(guide_path, "guide");
+    std::filesystem::remove(skill / "notes" / "extra.bin");
+
+    write_text(skill / "SKILL.md", "# PDF Processing\nEdited description.");
+    assert(*provider->list_resources()[0].description == "PDF Processing");
+    write_text(skill / "SKILL.md", "---\n"
+                                   "description: \"Frontmatter PDF skill\"\n"
+                                   "version: \"1.0.0\"\n"
+                                   "---\n\n"
+                                   "# PDF Processing\nRead PDF files.");
+    assert(*provider->list_resources()[0].description == "Frontmatter PDF skill");
+
     auto templates = app.list_all_templates();
     assert(templates.size() == 1);
     auto guide = app.read_resource("skill://pdf-processing/notes/guide.txt");
@@ -156,6 +265,8 @@ int main()
     (void)copilot_provider.list_resources();
     (void)opencode_provider.list_resources();
 
+    test_directory_reload();
+
     std::error_code ec;
     std::filesystem::remove_all(root, ec);
     std::filesystem::remove_all(root_a, ec);
@@ -3,8 +3,14 @@
 #include "fastmcpp/providers/transforms/search/bm25.hpp"
 #include "fastmcpp/providers/transforms/search/regex.hpp"
 
+#include <atomic>
 #include <cassert>
 #include <iostream>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace fastmcpp;
 
@@ -136,6 +142,100 @@ void test_regex_search_invalid_pattern()
     std::cout << " OK\n";
 }
 
+void test_regex_required_literals()
+{
+    std::cout << "test_regex_required_literals..." << std::flush;
+
+    using providers::transforms::search::detail::RequiredLiterals;
+    using Literals = std::vector<std::string>;
+
+    assert((RequiredLiterals::of("Read_File") == Literals{"read_file"}));
+    assert((RequiredLiterals::of("read.*file") == Literals{"read", "file"}));
+    assert((RequiredLiterals::of("^get_\\w+_users?$") == Literals{"get_", "_user"}));
+    assert((RequiredLiterals::of("(fetch|load)_data") == Literals{"_data"}));
+    assert((RequiredLiterals::of("fetch|load").empty()));
+    assert((RequiredLiterals::of("(?:abc)+[xyz]{2}def") == Literals{"abc", "def"}));
+    assert((RequiredLiterals::of("(abc)?def") == Literals{"def"}));
+    assert((RequiredLiterals::of("ab{0,2}cde") == Literals{"cde"}));
+    assert((RequiredLiterals::of("a\\.b\\x41cd") == Literals{"a.b"}));
+    assert((RequiredLiterals::of("(?!xyz)abc") == Literals{"abc"}));
+
+    std::cout << " OK\n";
+}
+
+void test_regex_prefilter_matches_full_scan()
+{
+    std::cout << "test_regex_prefilter_matches_full_scan..." << std::flush;
+
+    using namespace providers::transforms::search;
+
+    std::vector<tools::Tool> catalog = {make_tool("read_file", "Read a file from disk"),
+                                        make_tool("write_file", "Write a FILE to disk"),
+                                        make_tool("fetch_data", "Fetch data over HTTP"),
+                                        make_tool("load_data", "Load cached data"),
+                                        make_tool("get_users", "List all users"),
+                                        make_tool("get_user", "Get one user by id"),
+                                        make_tool("a.b", "Dotted name"),
+                                        make_tool("axb", "Undotted name")};
+
+    RegexSearchTransform::Options opts;
+    opts.max_results = 100;
+    RegexSearchTransform transform(opts);
+
+    const std::string patterns[] = {"file",       "FILE",        "read.*disk", "(fetch|load)_data",
+                                    "fetch|load", "get_\\w+s?$", "user(s)?",   "a\\.b",
+                                    "a.b",        "^get",        "da+ta",      "(?:over )+HTTP",
+                                    "\\bdisk\\b", "x{0,1}name",  "nomatch"};
+    for (const auto& pattern : patterns)
+    {
+        std::regex regex(pattern, std::regex_constants::icase);
+        std::vector<std::string> expected;
+        for (const auto& tool : catalog)
+            if (std::regex_search(extract_searchable_text(tool), regex))
+                expected.push_back(tool.name());
+
+        std::vector<std::string> actual;
+        for (const auto& tool : transform.do_search(catalog, pattern))
+            actual.push_back(tool.name());
+        assert(actual == expected);
+    }
+
+    std::cout << " OK\n";
+}
+
+void test_regex_custom_compiler()
+{
+    std::cout << "test_regex_custom_compiler..." << std::flush;
+
+    using namespace providers::transforms::search;
+
+    // A stand-in for an alternative engine: matches names starting with the pattern
+    std::atomic<int> compiled{0};
+    PatternCompiler compiler = [&](const std::string& pattern) -> PatternMatcher
+    {
+        ++compiled;
+        if (pattern == "(")
+            throw std::runtime_error("bad pattern");
+        auto prefix = pattern.substr(1);
+        return [prefix](const std::string& text) { return text.rfind(prefix, 0) == 0; };
+    };
+    RegexSearchTransform transform({}, compiler);
+
+    std::vector<tools::Tool> catalog = {make_tool("alpha", "First"),
+                                        make_tool("beta", "Second alpha")};
+    auto results = transform.do_search(catalog, "^alpha");
+    assert(results.size() == 1 && results[0].name() == "alpha");
+
+    // Compiled patterns are cached; literal patterns never reach the engine
+    transform.do_search(catalog, "^alpha");
+    assert(compiled == 1);
+    assert(transform.do_search(catalog, "alpha").size() == 2);
+    assert(compiled == 1);
+    assert(transform.do_search(catalog, "(").empty());
+
+    std::cout << " OK\n";
+}
+
 void test_regex_transform_list_tools()
 {
     std::cout << "test_regex_transform_list_tools..." << std::flush;
@@ -240,6 +340,105 @@ void test_bm25_search_empty_query()
     std::cout << " OK\n";
 }
 
+void test_bm25_index_ranking()
+{
+    std::cout << "test_bm25_index_ranking..." << std::flush;
+
+    using namespace providers::transforms::search;
+
+    detail::BM25Index index;
+    index.build({"alpha beta", "beta beta gamma", "delta", "alpha beta", "gamma gamma gamma"});
+    assert(index.size() == 5);
+
+    // Higher term frequency ranks first; equal scores keep document order
+    auto beta = index.query("beta", 10);
+    assert((beta == std::vector<int>{1, 0, 3}));
+    assert((index.query("beta", 2) == std::vector<int>{1, 0}));
+    assert((index.query("gamma", 1) == std::vector<int>{4}));
+    assert(index.query("missing", 10).empty());
+    assert(index.query("beta", 0).empty());
+
+    // Rare terms outweigh common ones
+    auto mixed = index.query("alpha delta", 10);
+    assert(mixed.front() == 2);
+
+    std::cout << " OK\n";
+}
+
+void test_bm25_reindexes_only_on_change()
+{
+    std::cout << "test_bm25_reindexes_only_on_change..." << std::flush;
+
+    using namespace providers::transforms::search;
+
+    BM25SearchTransform transform;
+    std::vector<tools::Tool> catalog = {make_tool("file_reader", "Read files"),
+                                        make_tool("web_fetcher", "Fetch web pages")};
+
+    assert(transform.do_search(catalog, "files")[0].name() == "file_reader");
+    assert(transform.index_generation() == 1);
+
+    // Copies of the same tools are the same catalog
+    auto copy = catalog;
+    assert(transform.do_search(copy, "web")[0].name() == "web_fetcher");
+    assert(transform.index_generation() == 1);
+
+    // A changed description is picked up
+    copy[1].set_description("Download files over HTTP");
+    auto results = transform.do_search(copy, "download");
+    assert(results.size() == 1 && results[0].name() == "web_fetcher");
+    assert(transform.index_generation() == 2);
+
+    // So is a new tool
+    copy.push_back(make_tool("db_query", "Query database tables"));
+    assert(transform.do_search(copy, "database")[0].name() == "db_query");
+    assert(transform.index_generation() == 3);
+
+    std::cout << " OK\n";
+}
+
+void test_bm25_concurrent_search()
+{
+    std::cout << "test_bm25_concurrent_search..." << std::flush;
+
+    using namespace providers::transforms::search;
+
+    BM25SearchTransform transform;
+    std::vector<tools::Tool> small;
+    std::vector<tools::Tool> large;
+    for (int i = 0; i < 200; ++i)
+    {
+        auto tool = make_tool("tool_" + std::to_string(i), "Handles item" + std::to_string(i));
+        if (i < 50)
+            small.push_back(tool);
+        large.push_back(tool);
+    }
+
+    // Sessions with different catalogs race to re-index while others search
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                for (int i = 0; i < 200; ++i)
+                {
+                    const auto& catalog = (t + i) % 2 ? large : small;
+                    int target = i % 50;
+                    auto results = transform.do_search(catalog, "item" + std::to_string(target));
+                    if (results.empty() || results[0].name() != "tool_" + std::to_string(target))
+                        ++failures;
+                }
+            });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    assert(failures == 0);
+
+    std::cout << " OK\n";
+}
+
 void test_extract_searchable_text()
 {
     std::cout << "test_extract_searchable_text..." << std::flush;
@@ -268,11 +467,17 @@ int main()
     test_regex_search_max_results();
     test_regex_search_invalid_pattern();
     test_regex_transform_list_tools();
+    test_regex_required_literals();
+    test_regex_prefilter_matches_full_scan();
+    test_regex_custom_compiler();
 
     // BM25SearchTransform tests
     test_bm25_search_basic();
     test_bm25_search_relevance();
     test_bm25_search_empty_query();
+    test_bm25_index_ranking();
+    test_bm25_reindexes_only_on_change();
+    test_bm25_concurrent_search();
 
     // Utility tests
     test_extract_searchable_text();
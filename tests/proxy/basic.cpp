@@ -5,8 +5,11 @@
 #include "fastmcpp/proxy.hpp"
 
 #include <cassert>
+#include <chrono>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <thread>
 
 using namespace fastmcpp;
 
@@ -36,6 +39,43 @@ class MockTransport : public client::ITransport
     HandlerFn handler_;
 };
 
+// Mock transport that counts requests per method and can push server notifications
+class CountingTransport : public MockTransport, public client::INotificationTransport
+{
+  public:
+    struct Counts
+    {
+        std::map<std::string, int> requests;
+        std::function<void(const Json&)> notify;
+        int callbacks_set{0};
+    };
+
+    CountingTransport(HandlerFn handler, std::shared_ptr<Counts> counts)
+        : MockTransport(std::move(handler)), counts_(std::move(counts))
+    {
+    }
+
+    Json request(const std::string& route, const Json& payload) override
+    {
+        ++counts_->requests[route];
+        return MockTransport::request(route, payload);
+    }
+
+    void set_notification_callback(std::function<void(const Json&)> callback) override
+    {
+        counts_->notify = std::move(callback);
+        ++counts_->callbacks_set;
+    }
+
+    std::function<void(const Json&)> notification_callback() const override
+    {
+        return counts_->notify;
+    }
+
+  private:
+    std::shared_ptr<Counts> counts_;
+};
+
 // Helper: create a simple backend server with tools
 std::function<Json(const Json&)> create_backend_handler()
 {
@@ -344,6 +384,140 @@ void test_proxy_backend_unavailable()
     std::cout << "  PASSED" << std::endl;
 }
 
+void test_proxy_reuses_clients()
+{
+    std::cout << "test_proxy_reuses_clients..." << std::endl;
+
+    int factory_calls = 0;
+    auto factory = create_backend_factory();
+    ProxyApp proxy(
+        [&]()
+        {
+            ++factory_calls;
+            return factory();
+        },
+        "TestProxy", "1.0.0");
+
+    for (int i = 0; i < 3; ++i)
+    {
+        auto result = proxy.invoke_tool("backend_add", Json{{"a", i}, {"b", 1}});
+        assert(!result.isError);
+    }
+    (void)proxy.read_resource("file://backend_readme.txt");
+    (void)proxy.get_prompt("backend_greeting", Json::object());
+    (void)proxy.list_all_prompts();
+    assert(factory_calls == 1);
+
+    auto stats = proxy.cache_stats();
+    assert(stats.clients_created == 1);
+    assert(stats.idle_clients == 1);
+
+    // Errors reported by the backend keep the client
+    bool threw = false;
+    try
+    {
+        proxy.invoke_tool("missing_tool", Json::object());
+    }
+    catch (const fastmcpp::Error&)
+    {
+        threw = true;
+    }
+    assert(threw);
+    assert(proxy.cache_stats().idle_clients == 1);
+
+    // Without pooling every request asks the factory again
+    proxy.set_max_idle_clients(0);
+    assert(proxy.cache_stats().idle_clients == 0);
+    proxy.invoke_tool("backend_add", Json{{"a", 1}, {"b", 1}});
+    proxy.invoke_tool("backend_add", Json{{"a", 1}, {"b", 1}});
+    assert(factory_calls == 3);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_proxy_chains_notification_handler()
+{
+    std::cout << "test_proxy_chains_notification_handler..." << std::endl;
+
+    auto counts = std::make_shared<CountingTransport::Counts>();
+    client::Client base(std::make_unique<CountingTransport>(create_backend_handler(), counts));
+    int user_notifications = 0;
+    base.set_notification_handler([&user_notifications](const Json&) { ++user_notifications; });
+
+    // Every request builds a new client on the one shared transport
+    ProxyApp proxy([&base]() { return base.new_client(); }, "TestProxy", "1.0.0");
+    proxy.set_max_idle_clients(0);
+    proxy.list_all_tools();
+    proxy.invoke_tool("backend_add", Json{{"a", 1}, {"b", 2}});
+    proxy.invoke_tool("backend_add", Json{{"a", 3}, {"b", 4}});
+
+    // The proxy hooked the transport once and kept the user's handler in the chain
+    assert(counts->callbacks_set == 2);
+    counts->notify(Json{{"jsonrpc", "2.0"}, {"method", "notifications/tools/list_changed"}});
+    assert(user_notifications == 1);
+    assert(proxy.cache_stats().invalidations == 1);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_proxy_catalog_cache()
+{
+    std::cout << "test_proxy_catalog_cache..." << std::endl;
+
+    auto counts = std::make_shared<CountingTransport::Counts>();
+    auto handler = create_backend_handler();
+    ProxyApp proxy([=]()
+                   { return client::Client(std::make_unique<CountingTransport>(handler, counts)); },
+                   "TestProxy", "1.0.0");
+
+    assert(proxy.list_all_tools().size() == 2);
+    assert(proxy.list_all_tools().size() == 2);
+    assert(proxy.list_all_resources().size() == 1);
+    assert(proxy.list_all_resources().size() == 1);
+    assert(counts->requests["tools/list"] == 1);
+    assert(counts->requests["resources/list"] == 1);
+    auto stats = proxy.cache_stats();
+    assert(stats.hits == 2);
+    assert(stats.misses == 2);
+
+    // Local registrations show up without touching the cache
+    tools::Tool local_tool{"local_only", Json{{"type", "object"}}, Json(),
+                           [](const Json&) { return "local"; }};
+    proxy.local_tools().register_tool(local_tool);
+    assert(proxy.list_all_tools().size() == 3);
+    assert(counts->requests["tools/list"] == 1);
+
+    // A list_changed notification from the backend drops only the matching list
+    assert(counts->notify);
+    counts->notify(Json{{"jsonrpc", "2.0"}, {"method", "notifications/tools/list_changed"}});
+    proxy.list_all_tools();
+    proxy.list_all_resources();
+    assert(counts->requests["tools/list"] == 2);
+    assert(counts->requests["resources/list"] == 1);
+    assert(proxy.cache_stats().invalidations == 1);
+
+    assert(proxy.handle_list_changed("notifications/resources/list_changed"));
+    assert(!proxy.handle_list_changed("notifications/message"));
+    proxy.list_all_resources();
+    assert(counts->requests["resources/list"] == 2);
+
+    // Entries expire after the TTL, and a zero TTL disables caching
+    proxy.set_catalog_ttl(std::chrono::milliseconds(20));
+    proxy.list_all_tools();
+    proxy.list_all_tools();
+    assert(counts->requests["tools/list"] == 3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    proxy.list_all_tools();
+    assert(counts->requests["tools/list"] == 4);
+
+    proxy.set_catalog_ttl(std::chrono::milliseconds(0));
+    proxy.list_all_tools();
+    proxy.list_all_tools();
+    assert(counts->requests["tools/list"] == 6);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
 // =========================================================================
 // create_proxy() factory function tests
 // =========================================================================
@@ -541,6 +715,9 @@ int main()
     test_proxy_mcp_handler();
     test_proxy_resource_annotations();
     test_proxy_backend_unavailable();
+    test_proxy_reuses_clients();
+    test_proxy_catalog_cache();
+    test_proxy_chains_notification_handler();
 
     std::cout << "\n=== create_proxy() Factory Tests ===" << std::endl;
 
@@ -0,0 +1,258 @@
+// Unit tests for streamed resource content and incremental base64 encoding
+#include "fastmcpp/exceptions.hpp"
+#include "fastmcpp/providers/skills_provider.hpp"
+#include "fastmcpp/resources/resource.hpp"
+#include "fastmcpp/util/base64.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace fastmcpp;
+using namespace fastmcpp::resources;
+
+namespace
+{
+std::filesystem::path make_temp_dir(const std::string& name)
+{
+    auto base = std::filesystem::temp_directory_path() / ("fastmcpp_content_stream_" + name);
+    std::error_code ec;
+    std::filesystem::remove_all(base, ec);
+    std::filesystem::create_directories(base);
+    return base;
+}
+
+std::string random_bytes(size_t size, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::string bytes(size, '\0');
+    for (auto& byte : bytes)
+        byte = static_cast<char>(rng() & 0xFF);
+    return bytes;
+}
+
+void write_file(const std::filesystem::path& path, const std::string& bytes)
+{
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+std::string b64(const std::string& bytes)
+{
+    return util::base64::encode(bytes.data(), bytes.size());
+}
+} // namespace
+
+void test_base64_vectors()
+{
+    std::cout << "test_base64_vectors..." << std::endl;
+    // RFC 4648 section 10
+    assert(b64("") == "");
+    assert(b64("f") == "Zg==");
+    assert(b64("fo") == "Zm8=");
+    assert(b64("foo") == "Zm9v");
+    assert(b64("foob") == "Zm9vYg==");
+    assert(b64("fooba") == "Zm9vYmE=");
+    assert(b64("foobar") == "Zm9vYmFy");
+    assert(b64(std::string("\xff\xfe\x00", 3)) == "//4A");
+    assert(util::base64::encoded_size(0) == 0);
+    assert(util::base64::encoded_size(4) == 8);
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_base64_incremental_matches_one_shot()
+{
+    std::cout << "test_base64_incremental_matches_one_shot..." << std::endl;
+    const auto bytes = random_bytes(200 * 1024 + 7, 1);
+    const auto expected = b64(bytes);
+
+    for (size_t piece : {size_t{1}, size_t{2}, size_t{5}, size_t{4096}, size_t{65537}})
+    {
+        std::string out;
+        size_t largest_block = 0;
+        util::base64::Encoder encoder(
+            [&](const char* data, size_t size)
+            {
+                out.append(data, size);
+                largest_block = std::max(largest_block, size);
+            });
+        for (size_t pos = 0; pos < bytes.size(); pos += piece)
+            encoder.update(bytes.data() + pos, std::min(piece, bytes.size() - pos));
+        encoder.finish();
+        assert(out == expected);
+        assert(largest_block <= util::base64::Encoder::kBlockSize);
+    }
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_file_stream_ranges()
+{
+    std::cout << "test_file_stream_ranges..." << std::endl;
+    const auto dir = make_temp_dir("ranges");
+    // Larger than one mapping window, so reads span several
+    const auto bytes = random_bytes(9 * 1024 * 1024 + 123, 2);
+    write_file(dir / "data.bin", bytes);
+
+    auto whole = ContentStream::from_file(dir / "data.bin");
+    assert(!whole.is_text());
+    assert(whole.size() && *whole.size() == bytes.size());
+    size_t chunks = 0;
+    size_t largest_chunk = 0;
+    std::string streamed;
+    whole.write_to(
+        [&](const char* data, size_t size)
+        {
+            ++chunks;
+            largest_chunk = std::max(largest_chunk, size);
+            streamed.append(data, size);
+        });
+    assert(streamed == bytes);
+    assert(chunks > 1 && largest_chunk < bytes.size());
+    // Streams are re-readable
+    assert(whole.read_all() == bytes);
+
+    // Mapped streams produce the same bytes
+    assert(ContentStream::from_mapped_file(dir / "data.bin").read_all() == bytes);
+    assert(ContentStream::from_mapped_file(dir / "data.bin", false, 4097, 5 * 1024 * 1024)
+               .read_all() == bytes.substr(4097, 5 * 1024 * 1024));
+
+    // Offsets need not be page aligned
+    auto middle = ContentStream::from_file(dir / "data.bin", false, 4097, 5 * 1024 * 1024);
+    assert(*middle.size() == 5 * 1024 * 1024);
+    assert(middle.read_all() == bytes.substr(4097, 5 * 1024 * 1024));
+
+    auto tail = ContentStream::from_file(dir / "data.bin", false, bytes.size() - 10, 1000);
+    assert(*tail.size() == 10);
+    assert(tail.read_all() == bytes.substr(bytes.size() - 10));
+
+    auto past_end = ContentStream::from_file(dir / "data.bin", false, bytes.size() + 1);
+    assert(*past_end.size() == 0);
+    assert(past_end.read_all().empty());
+
+    write_file(dir / "empty.bin", "");
+    assert(ContentStream::from_file(dir / "empty.bin").read_all().empty());
+
+    bool threw = false;
+    try
+    {
+        ContentStream::from_file(dir / "missing.bin");
+    }
+    catch (const NotFoundError&)
+    {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_file_stream_truncated_while_read()
+{
+    std::cout << "test_file_stream_truncated_while_read..." << std::endl;
+    const auto dir = make_temp_dir("truncated");
+    const auto bytes = random_bytes(2 * 1024 * 1024, 5);
+    write_file(dir / "data.bin", bytes);
+
+    // An editor rewriting the file mid-read just ends the stream early
+    auto stream = ContentStream::from_file(dir / "data.bin");
+    std::string streamed;
+    stream.write_to(
+        [&](const char* data, size_t size)
+        {
+            if (streamed.empty())
+                std::filesystem::resize_file(dir / "data.bin", 100);
+            streamed.append(data, size);
+        });
+    assert(streamed.size() < bytes.size());
+    assert(streamed == bytes.substr(0, streamed.size()));
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_content_to_json()
+{
+    std::cout << "test_content_to_json..." << std::endl;
+    const auto dir = make_temp_dir("json");
+    const auto bytes = random_bytes(100 * 1024 + 1, 3);
+    write_file(dir / "data.bin", bytes);
+    write_file(dir / "notes.txt", "streamed text");
+
+    ResourceContent text{"mem://text", "text/plain", std::string("hello")};
+    auto json = content_to_json(text);
+    assert(json["uri"] == "mem://text");
+    assert(json["mimeType"] == "text/plain");
+    assert(json["text"] == "hello");
+    assert(!json.contains("blob"));
+
+    ResourceContent binary{"mem://bin", std::nullopt,
+                           std::vector<uint8_t>(bytes.begin(), bytes.end())};
+    json = content_to_json(binary);
+    assert(!json.contains("mimeType"));
+    assert(json["blob"] == b64(bytes));
+
+    ResourceContent streamed{"file://data.bin", "application/octet-stream",
+                             ContentStream::from_file(dir / "data.bin")};
+    json = content_to_json(streamed);
+    assert(json["blob"] == b64(bytes));
+    assert(!json.contains("text"));
+
+    ResourceContent streamed_text{"file://notes.txt", "text/plain",
+                                  ContentStream::from_file(dir / "notes.txt", true)};
+    json = content_to_json(streamed_text);
+    assert(json["text"] == "streamed text");
+
+    // Producers of unknown length work too
+    ResourceContent generated{"gen://abc", std::nullopt,
+                              ContentStream(
+                                  [](const ContentStream::ChunkSink& sink)
+                                  {
+                                      sink("fo", 2);
+                                      sink("ob", 2);
+                                      sink("ar", 2);
+                                  })};
+    assert(content_to_json(generated)["blob"] == "Zm9vYmFy");
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_skill_binary_files_stream()
+{
+    std::cout << "test_skill_binary_files_stream..." << std::endl;
+    const auto skill = make_temp_dir("skill") / "images";
+    write_file(skill / "SKILL.md", "# Images\nSample images.");
+    const auto bytes = random_bytes(300 * 1024, 4);
+    write_file(skill / "assets" / "logo.png", bytes);
+
+    providers::SkillProvider provider(skill, "SKILL.md",
+                                      providers::SkillSupportingFiles::Resources);
+    auto resource = provider.get_resource("skill://images/assets/logo.png");
+    assert(resource);
+    auto content = resource->provider(Json::object());
+    auto* stream = std::get_if<ContentStream>(&content.data);
+    assert(stream && !stream->is_text());
+    assert(stream->read_all() == bytes);
+    assert(content_to_json(content)["blob"] == b64(bytes));
+
+    auto main = provider.get_resource("skill://images/SKILL.md");
+    assert(main);
+    auto main_content = main->provider(Json::object());
+    assert(std::get<std::string>(main_content.data) == "# Images\nSample images.");
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main()
+{
+    std::cout << "Content stream tests" << std::endl;
+    std::cout << "====================" << std::endl;
+    test_base64_vectors();
+    test_base64_incremental_matches_one_shot();
+    test_file_stream_ranges();
+    test_file_stream_truncated_while_read();
+    test_content_to_json();
+    test_skill_binary_files_stream();
+    std::cout << "\nAll content stream tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,195 @@
+// Unit tests for UriTemplateRouter
+#include "fastmcpp/exceptions.hpp"
+#include "fastmcpp/resources/manager.hpp"
+#include "fastmcpp/resources/uri_router.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+using namespace fastmcpp;
+using namespace fastmcpp::resources;
+
+namespace
+{
+ResourceTemplate make_template(const std::string& uri_template, Json parameters = Json::object())
+{
+    ResourceTemplate templ;
+    templ.uri_template = uri_template;
+    templ.name = uri_template;
+    templ.parameters = std::move(parameters);
+    templ.parse();
+    return templ;
+}
+
+/// First template whose build_regex_pattern() regex matches, with its path captures
+std::optional<std::pair<size_t, std::vector<std::string>>>
+regex_reference(const std::vector<std::string>& templates, const std::string& uri)
+{
+    for (size_t i = 0; i < templates.size(); ++i)
+    {
+        std::regex regex(build_regex_pattern(templates[i]));
+        std::smatch match;
+        if (!std::regex_match(uri, match, regex))
+            continue;
+        std::vector<std::string> captures;
+        for (size_t g = 1; g < match.size(); ++g)
+            captures.push_back(match[g].str());
+        return std::make_pair(i, captures);
+    }
+    return std::nullopt;
+}
+} // namespace
+
+void test_matches_regex_semantics()
+{
+    std::cout << "test_matches_regex_semantics..." << std::endl;
+
+    const std::vector<std::string> templates = {
+        "weather://{city}/current",
+        "weather://{city}/forecast/{days}",
+        "weather://london/current", // Shadowed by the first template
+        "files://{path*}",
+        "files://docs/{name}.md",
+        "data://{a}-{b}.json",
+        "data://{a}.{ext}",
+        "repo://{owner}/{repo}/blob/{path*}",
+        "repo://{owner}/{repo}",
+        "search://items{?q,limit}",
+        "mixed://{x}{y}",
+        "lit://a.b(c)",
+    };
+    const std::vector<std::string> uris = {
+        "weather://paris/current",
+        "weather://london/current",
+        "weather://paris/forecast/3",
+        "weather://paris/forecast/",
+        "weather:///current",
+        "files://docs/readme.md",
+        "files://a/b/c.txt",
+        "files://",
+        "data://x-y.json",
+        "data://x-y-z.json",
+        "data://report.v2.json",
+        "repo://me/proj/blob/src/main.cpp",
+        "repo://me/proj",
+        "repo://me/proj/extra",
+        "search://items",
+        "search://items?q=x&limit=3",
+        "search://items?",
+        "search://itemsx",
+        "mixed://abc",
+        "lit://a.b(c)",
+        "lit://axb(c)",
+        "unknown://x",
+        "",
+    };
+
+    UriTemplateRouter router;
+    for (const auto& t : templates)
+        router.add(make_template(t));
+    assert(router.size() == templates.size());
+
+    for (const auto& uri : uris)
+    {
+        auto expected = regex_reference(templates, uri);
+        auto actual = router.match(uri);
+        assert(expected.has_value() == actual.has_value());
+        if (!expected)
+            continue;
+        assert(actual->index == expected->first);
+
+        // Path captures line up with the regex groups (no query group precedes them)
+        auto templ = make_template(templates[actual->index]);
+        size_t group = 0;
+        for (const auto& param : templ.parsed_params)
+        {
+            if (param.is_query)
+                continue;
+            assert(actual->params.at(param.name) == expected->second[group]);
+            ++group;
+        }
+        // The per-template matcher agrees with the router
+        auto single = templ.match(uri);
+        assert(single && *single == actual->params);
+    }
+}
+
+void test_query_and_typed_params()
+{
+    std::cout << "test_query_and_typed_params..." << std::endl;
+
+    Json schema = {{"type", "object"},
+                   {"properties",
+                    {{"id", {{"type", "integer"}}},
+                     {"verbose", {{"type", "boolean"}}},
+                     {"limit", {{"type", "integer"}}}}}};
+    UriTemplateRouter router;
+    router.add(make_template("items://{id}{?verbose,limit}", schema));
+    router.add(make_template("users://{user-id}/name"));
+
+    auto match = router.match("items://42?verbose=yes&limit=10&other=1");
+    assert(match && match->index == 0);
+    assert(match->params.size() == 3);
+    auto typed = router.typed_params(*match);
+    assert(typed["id"] == 42);
+    assert(typed["verbose"] == true);
+    assert(typed["limit"] == 10);
+
+    // Hyphenated names are exposed with underscores; values are URL-decoded
+    match = router.match("users://a%20b/name");
+    assert(match && match->index == 1);
+    assert(match->params.at("user_id") == "a b");
+
+    match = router.match("items://abc");
+    assert(match);
+    bool threw = false;
+    try
+    {
+        router.typed_params(*match);
+    }
+    catch (const ValidationError&)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+void test_many_templates()
+{
+    std::cout << "test_many_templates..." << std::endl;
+
+    ResourceManager manager;
+    for (int i = 0; i < 2000; ++i)
+    {
+        auto templ = make_template("svc" + std::to_string(i) + "://{tenant}/items/{id}");
+        templ.provider = [i](const Json& params)
+        {
+            return ResourceContent{"", std::nullopt,
+                                   std::to_string(i) + ":" + params["tenant"].get<std::string>() +
+                                       ":" + params["id"].get<std::string>()};
+        };
+        manager.register_template(std::move(templ));
+    }
+
+    auto content = manager.read("svc1234://acme/items/7");
+    assert(std::get<std::string>(content.data) == "1234:acme:7");
+    auto matched = manager.match_template("svc12://acme/items/7");
+    assert(matched && matched->first->uri_template == "svc12://{tenant}/items/{id}");
+    assert(!manager.match_template("svc2000://acme/items/7"));
+    assert(!manager.match_template("svc1://acme/items"));
+}
+
+int main()
+{
+    std::cout << "=== UriTemplateRouter Tests ===" << std::endl;
+
+    test_matches_regex_semantics();
+    test_query_and_typed_params();
+    test_many_templates();
+
+    std::cout << "\n=== All tests PASSED ===" << std::endl;
+    return 0;
+}
@@ -2,6 +2,8 @@
 
 #include <cassert>
 #include <iostream>
+#include <string>
+#include <vector>
 
 using namespace fastmcpp;
 
@@ -275,6 +277,109 @@ void test_deeply_nested_object()
     std::cout << "  [PASS]\n";
 }
 
+// ============================================================================
+// Compiled validator
+// ============================================================================
+
+/// Error message of a validation, or "" if it passed.
+template <typename Validate>
+std::string outcome(Validate&& validate)
+{
+    try
+    {
+        validate();
+        return "";
+    }
+    catch (const ValidationError& e)
+    {
+        return e.what();
+    }
+}
+
+void test_compiled_matches_interpreter()
+{
+    std::cout << "test_compiled_matches_interpreter...\n";
+    std::vector<Json> schemas = {
+        Json::object(),
+        {{"type", "string"}},
+        {{"type", "integer"}},
+        {{"type", "unknown"}},
+        {{"type", "null"}},
+        {{"properties", {{"a", {{"type", "string"}}}}}},
+        {{"properties", {{"x", {{"type", "null"}}}}}},
+        {{"type", "object"}, {"properties", {{"a", {{"type", "null"}}}}}},
+        {{"type", "object"},
+         {"required", Json::array({"b", "a"})},
+         {"properties",
+          {{"a", {{"type", "integer"}}},
+           {"b", {{"type", "number"}}},
+           {"c", {{"type", "boolean"}}},
+           {"d", {{"description", "untyped"}}},
+           {"e", {{"type", "array"}}},
+           {"f", {{"type", "object"}, {"properties", {{"x", {{"type", "string"}}}}}}}}}}};
+    std::vector<Json> instances = {
+        Json::object(),
+        "text",
+        7,
+        3.5,
+        nullptr,
+        Json::array({1}),
+        {{"a", 1}, {"b", 2.5}},
+        {{"a", 1.5}, {"b", 2}},
+        {{"a", 1}},
+        {{"a", nullptr}},
+        {{"x", 5}},
+        {{"x", nullptr}},
+        {{"a", 1}, {"b", 2}, {"c", "no"}, {"d", nullptr}},
+        {{"a", 1}, {"b", 2}, {"e", Json::object()}, {"f", {{"x", 1}}}},
+        {{"a", 1}, {"b", 2}, {"z1", 0}, {"z2", 0}, {"z3", 0}, {"z4", 0}, {"z5", 0}, {"c", 1}},
+    };
+
+    for (const auto& schema : schemas)
+    {
+        util::schema::CompiledSchema compiled(schema);
+        for (const auto& instance : instances)
+        {
+            auto expected = outcome([&]() { util::schema::validate(schema, instance); });
+            auto actual = outcome([&]() { compiled.validate(instance); });
+            assert(expected == actual);
+        }
+    }
+    std::cout << "  [PASS]\n";
+}
+
+void test_compiled_type_lists_and_refs()
+{
+    std::cout << "test_compiled_type_lists_and_refs...\n";
+    Json schema = {{"$ref", "#/$defs/Result"},
+                   {"$defs",
+                    {{"Result",
+                      {{"type", "object"},
+                       {"required", Json::array({"id"})},
+                       {"properties",
+                        {{"id", {{"$ref", "#/$defs/Id"}}},
+                         {"note", {{"type", Json::array({"string", "null"})}}},
+                         {"loop", {{"$ref", "#/$defs/Loop"}}}}}}},
+                     {"Id", {{"type", "integer"}}},
+                     {"Loop", {{"$ref", "#/$defs/Loop"}}}}}};
+    util::schema::CompiledSchema compiled(schema);
+
+    compiled.validate(Json{{"id", 1}, {"note", nullptr}, {"loop", "anything"}});
+    compiled.validate(Json{{"id", 1}, {"note", "text"}});
+    assert(outcome([&]() { compiled.validate(Json{{"id", "1"}}); }) == "type mismatch for: id");
+    assert(outcome(
+               [&]()
+               {
+                   compiled.validate(Json{{"id", 1}, {"note", 2}});
+               }) == "type mismatch for: note");
+    assert(outcome([&]() { compiled.validate(Json{{"note", "x"}}); }) == "missing required: id");
+    assert(outcome([&]() { compiled.validate(Json::array()); }) == "root type mismatch");
+
+    // A default-constructed validator accepts anything
+    util::schema::CompiledSchema().validate(Json("whatever"));
+    std::cout << "  [PASS]\n";
+}
+
 int main()
 {
     std::cout << "=== JSON Schema Validation Tests ===\n";
@@ -293,7 +398,9 @@ int main()
     test_null_value();
     test_extra_properties();
     test_deeply_nested_object();
+    test_compiled_matches_interpreter();
+    test_compiled_type_lists_and_refs();
 
-    std::cout << "\n[OK] All schema validation tests passed! (15 tests)\n";
+    std::cout << "\n[OK] All schema validation tests passed! (17 tests)\n";
     return 0;
 }
@@ -0,0 +1,174 @@
+// Unit tests for the sharded SessionRegistry
+#include "../wait_helpers.hpp"
+#include "fastmcpp/server/session_registry.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace fastmcpp::server;
+using namespace fastmcpp::util;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct Session
+{
+    int value{0};
+};
+} // namespace
+
+void test_insert_find_erase()
+{
+    std::cout << "test_insert_find_erase..." << std::endl;
+
+    SessionRegistry<Session> registry(3);
+    auto a = std::make_shared<Session>(Session{1});
+    assert(registry.insert("a", a));
+    assert(!registry.insert("a", std::make_shared<Session>()));
+    assert(registry.insert("b", std::make_shared<Session>(Session{2})));
+    assert(registry.insert("c", std::make_shared<Session>(Session{3})));
+    assert(registry.full());
+    assert(!registry.insert("d", std::make_shared<Session>()));
+    assert(registry.size() == 3);
+
+    assert(registry.find("a") == a);
+    assert(registry.find("b")->value == 2);
+    assert(!registry.find("d"));
+
+    assert(registry.erase("a") == a);
+    assert(!registry.erase("a"));
+    assert(!registry.erase_if_same("b", a));
+    assert(registry.erase_if_same("c", registry.find("c")));
+    assert(registry.size() == 1);
+    assert(registry.snapshot().size() == 1);
+
+    // Lowering the capacity refuses new sessions but keeps existing ones
+    registry.set_capacity(1);
+    assert(registry.full());
+    assert(registry.find("b"));
+    registry.clear();
+    assert(registry.size() == 0);
+    assert(registry.insert("e", std::make_shared<Session>()));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_idle_sessions_are_evicted()
+{
+    std::cout << "test_idle_sessions_are_evicted..." << std::endl;
+
+    SessionRegistry<Session> registry;
+    TimerWheel wheel(5ms);
+    std::mutex mutex;
+    std::vector<std::string> evicted;
+    assert(registry.insert("before", std::make_shared<Session>()));
+    registry.enable_idle_eviction(wheel, 60ms,
+                                  [&](const std::string& id, const std::shared_ptr<Session>& s)
+                                  {
+                                      assert(s);
+                                      std::lock_guard<std::mutex> lock(mutex);
+                                      evicted.push_back(id);
+                                  });
+    assert(registry.insert("idle", std::make_shared<Session>()));
+    assert(registry.insert("busy", std::make_shared<Session>()));
+    assert(registry.insert("deleted", std::make_shared<Session>()));
+    assert(registry.erase("deleted"));
+
+    // Keep one session in use well past the timeout
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < 200ms)
+    {
+        assert(registry.find("busy"));
+        std::this_thread::sleep_for(10ms);
+    }
+
+    assert(!registry.find("idle"));
+    assert(!registry.find("before"));
+    assert(registry.find("busy"));
+    assert(registry.size() == 1);
+    assert(registry.evicted() == 2);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        assert(evicted.size() == 2);
+    }
+
+    // Once idle, the busy session goes too; nothing is left armed afterwards
+    assert(wait_until([&]() { return registry.size() == 0; }));
+    assert(wait_until([&]() { return wheel.pending() == 0; }));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_disable_idle_eviction()
+{
+    std::cout << "test_disable_idle_eviction..." << std::endl;
+
+    SessionRegistry<Session> registry;
+    TimerWheel wheel(5ms);
+    registry.enable_idle_eviction(wheel, 20ms);
+    assert(registry.insert("a", std::make_shared<Session>()));
+    assert(wheel.pending() == 1);
+    registry.disable_idle_eviction();
+    assert(wheel.pending() == 0);
+    std::this_thread::sleep_for(50ms);
+    assert(registry.find("a"));
+    assert(registry.evicted() == 0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_concurrent_access()
+{
+    std::cout << "test_concurrent_access..." << std::endl;
+
+    SessionRegistry<Session> registry(10000);
+    for (int i = 0; i < 64; ++i)
+        assert(registry.insert("s" + std::to_string(i), std::make_shared<Session>(Session{i})));
+
+    std::atomic<int> found{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                for (int i = 0; i < 2000; ++i)
+                {
+                    auto id = "s" + std::to_string(i % 64);
+                    if (auto s = registry.find(id); s && s->value == i % 64)
+                        ++found;
+                    // Writers churn their own keys alongside the readers
+                    auto own = "t" + std::to_string(t) + "-" + std::to_string(i);
+                    assert(registry.insert(own, std::make_shared<Session>()));
+                    assert(registry.erase(own));
+                }
+            });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    assert(found == 4 * 2000);
+    assert(registry.size() == 64);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== SessionRegistry Tests ===" << std::endl;
+
+    test_insert_find_erase();
+    test_idle_sessions_are_evicted();
+    test_disable_idle_eviction();
+    test_concurrent_access();
+
+    std::cout << "\n=== All tests PASSED ===" << std::endl;
+    return 0;
+}
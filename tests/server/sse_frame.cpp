@@ -0,0 +1,59 @@
+// Unit tests for pre-encoded SSE frames
+#include "fastmcpp/server/sse_frame.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <string>
+
+using namespace fastmcpp;
+using namespace fastmcpp::server;
+
+void test_encodes_data_event()
+{
+    std::cout << "test_encodes_data_event..." << std::endl;
+
+    Json message = {{"jsonrpc", "2.0"}, {"method", "notifications/message"}};
+    auto frame = make_sse_frame(message);
+    assert(*frame == "data: " + message.dump() + "\n\n");
+
+    auto named = make_sse_frame(Json(1), "heartbeat");
+    assert(*named == "event: heartbeat\ndata: 1\n\n");
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_payload_stays_on_one_line()
+{
+    std::cout << "test_payload_stays_on_one_line..." << std::endl;
+
+    auto frame = make_sse_frame(Json{{"text", "line one\nline two\r\n"}});
+    // Only the terminating blank line may contain newlines
+    assert(frame->find('\n') == frame->size() - 2);
+    assert(Json::parse(frame->substr(6))["text"] == "line one\nline two\r\n");
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_copies_share_bytes()
+{
+    std::cout << "test_copies_share_bytes..." << std::endl;
+
+    auto frame = make_sse_frame(Json{{"big", std::string(4096, 'x')}});
+    SseFrame copy = frame;
+    assert(copy->data() == frame->data());
+    assert(frame.use_count() == 2);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== SSE Frame Tests ===" << std::endl;
+
+    test_encodes_data_event();
+    test_payload_stays_on_one_line();
+    test_copies_share_bytes();
+
+    std::cout << "\n=== All tests PASSED ===" << std::endl;
+    return 0;
+}
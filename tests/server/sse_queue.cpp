@@ -0,0 +1,250 @@
+// Unit tests for SseStreamQueue byte limits and slow-consumer policies
+#include "fastmcpp/server/sse_queue.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace fastmcpp;
+using namespace fastmcpp::server;
+using namespace std::chrono_literals;
+
+namespace
+{
+Json response(int id)
+{
+    return Json{{"jsonrpc", "2.0"}, {"id", id}, {"result", Json::object()}};
+}
+
+Json progress(const std::string& token, int value)
+{
+    return Json{{"jsonrpc", "2.0"},
+                {"method", "notifications/progress"},
+                {"params", {{"progressToken", token}, {"progress", value}}}};
+}
+
+Json log_message(const std::string& text)
+{
+    return Json{{"jsonrpc", "2.0"},
+                {"method", "notifications/message"},
+                {"params", {{"level", "info"}, {"data", text}}}};
+}
+
+/// Payload of the next frame, parsed back from its SSE encoding.
+Json pop_json(SseStreamQueue& queue)
+{
+    auto entry = queue.pop();
+    assert(entry);
+    const auto& frame = *entry->frame;
+    auto start = frame.find("data: ") + 6;
+    return Json::parse(frame.substr(start, frame.size() - start - 2));
+}
+
+size_t frame_size(const Json& message)
+{
+    return make_sse_frame(message)->size();
+}
+} // namespace
+
+void test_responses_overtake_notifications()
+{
+    std::cout << "test_responses_overtake_notifications..." << std::endl;
+
+    SseStreamQueue queue;
+    assert(queue.push(log_message("first")));
+    assert(queue.push(log_message("second")));
+    assert(queue.push(response(7)));
+
+    assert(pop_json(queue)["id"] == 7);
+    assert(pop_json(queue)["params"]["data"] == "first");
+    assert(pop_json(queue)["params"]["data"] == "second");
+
+    auto stats = queue.stats();
+    assert(stats.sent_frames == 3);
+    assert(stats.queued_frames == 0);
+    assert(stats.queued_bytes == 0);
+    assert(stats.peak_bytes > 0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_coalesce_replaces_and_drops_notifications()
+{
+    std::cout << "test_coalesce_replaces_and_drops_notifications..." << std::endl;
+
+    SseQueueOptions options;
+    options.max_bytes = 3 * frame_size(log_message("xxxx"));
+    SseStreamQueue queue(options);
+
+    // Progress for one token keeps only the newest value, in place
+    assert(queue.push(progress("a", 1)));
+    assert(queue.push(log_message("xxxx")));
+    assert(queue.push(progress("a", 2)));
+    assert(queue.stats().coalesced == 1);
+    assert(queue.stats().queued_frames == 2);
+
+    // Over the limit the oldest notifications go first; responses always stay
+    assert(queue.push(log_message("yyyy")));
+    assert(queue.push(response(1)));
+    assert(queue.push(response(2)));
+    auto stats = queue.stats();
+    assert(stats.dropped >= 1);
+    assert(stats.queued_bytes <= options.max_bytes);
+    assert(!queue.closed());
+
+    assert(pop_json(queue)["id"] == 1);
+    assert(pop_json(queue)["id"] == 2);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_responses_alone_overflowing_disconnect()
+{
+    std::cout << "test_responses_alone_overflowing_disconnect..." << std::endl;
+
+    SseQueueOptions options;
+    options.max_bytes = frame_size(response(1)) + 1;
+    SseStreamQueue queue(options);
+
+    // An empty queue takes one frame of any size
+    assert(queue.push(Json{{"id", 1}, {"result", std::string(1000, 'x')}}));
+    assert(!queue.push(response(2)));
+    assert(queue.closed());
+    assert(queue.stats().disconnected);
+    assert(!queue.pop());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_disconnect_policy()
+{
+    std::cout << "test_disconnect_policy..." << std::endl;
+
+    SseQueueOptions options;
+    options.max_bytes = frame_size(progress("a", 1)) + 1;
+    options.policy = SlowConsumerPolicy::Disconnect;
+    SseStreamQueue queue(options);
+
+    assert(queue.push(progress("a", 1)));
+    // No coalescing under this policy: the second progress event does not fit
+    assert(!queue.push(progress("a", 2)));
+    assert(queue.stats().disconnected);
+    assert(queue.stats().coalesced == 0);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_block_policy_waits_for_room()
+{
+    std::cout << "test_block_policy_waits_for_room..." << std::endl;
+
+    SseQueueOptions options;
+    options.max_bytes = frame_size(response(1)) + 1;
+    options.policy = SlowConsumerPolicy::Block;
+    options.block_timeout = 5s;
+    SseStreamQueue queue(options);
+
+    assert(queue.push(response(1)));
+    std::atomic<bool> pushed{false};
+    std::thread producer(
+        [&]()
+        {
+            assert(queue.push(response(2)));
+            pushed = true;
+        });
+    std::this_thread::sleep_for(30ms);
+    assert(!pushed);
+
+    assert(pop_json(queue)["id"] == 1);
+    producer.join();
+    assert(pushed);
+    assert(pop_json(queue)["id"] == 2);
+
+    // A consumer that never catches up is dropped after the timeout
+    options.block_timeout = 20ms;
+    SseStreamQueue stuck(options);
+    assert(stuck.push(response(1)));
+    auto start = std::chrono::steady_clock::now();
+    assert(!stuck.push(response(2)));
+    assert(std::chrono::steady_clock::now() - start >= 20ms);
+    assert(stuck.stats().disconnected);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_broadcast_skips_stalled_stream()
+{
+    std::cout << "test_broadcast_skips_stalled_stream..." << std::endl;
+
+    SseQueueOptions options;
+    options.max_bytes = frame_size(log_message("xxxx")) + 1;
+    options.policy = SlowConsumerPolicy::Block;
+    options.block_timeout = 5s;
+    SseStreamQueue stalled(options);
+    SseStreamQueue healthy(options);
+    assert(stalled.push(log_message("xxxx")));
+
+    // Broadcast as the server does: one frame for every stream, no waiting
+    auto broadcast = [&](const Json& message)
+    {
+        auto entry = SseStreamQueue::classify(message, make_sse_frame(message));
+        for (auto* queue : {&stalled, &healthy})
+            queue->try_push(entry);
+    };
+    auto start = std::chrono::steady_clock::now();
+    broadcast(log_message("yyyy"));
+    assert(std::chrono::steady_clock::now() - start < 1s);
+    assert(pop_json(healthy)["params"]["data"] == "yyyy");
+    assert(stalled.stats().dropped == 1);
+    assert(!stalled.closed());
+
+    // A frame that must not be lost disconnects the stalled stream instead
+    broadcast(response(1));
+    assert(std::chrono::steady_clock::now() - start < 1s);
+    assert(pop_json(healthy)["id"] == 1);
+    assert(stalled.stats().disconnected);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_heartbeats_and_close()
+{
+    std::cout << "test_heartbeats_and_close..." << std::endl;
+
+    SseStreamQueue queue;
+    SseStreamQueue::Entry heartbeat{
+        make_sse_frame(Json(1), "heartbeat"), SseStreamQueue::Kind::Heartbeat, {}};
+    assert(queue.push(heartbeat));
+    assert(queue.push(heartbeat));
+    assert(queue.stats().queued_frames == 1);
+    assert(queue.pop()->kind == SseStreamQueue::Kind::Heartbeat);
+
+    // close() wakes a waiting writer
+    std::thread writer([&]() { assert(!queue.pop()); });
+    std::this_thread::sleep_for(10ms);
+    queue.close();
+    writer.join();
+    assert(!queue.push(response(1)));
+    assert(!queue.stats().disconnected);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== SSE Stream Queue Tests ===" << std::endl;
+
+    test_responses_overtake_notifications();
+    test_coalesce_replaces_and_drops_notifications();
+    test_responses_alone_overflowing_disconnect();
+    test_disconnect_policy();
+    test_block_policy_waits_for_room();
+    test_broadcast_skips_stalled_stream();
+    test_heartbeats_and_close();
+
+    std::cout << "\n=== All tests PASSED ===" << std::endl;
+    return 0;
+}
@@ -2,11 +2,13 @@
 #include "fastmcpp/server/sse_server.hpp"
 #include "fastmcpp/util/json.hpp"
 
+#include <atomic>
 #include <httplib.h>
 #include <iostream>
 #include <regex>
 #include <string>
 #include <thread>
+#include <vector>
 
 using fastmcpp::Json;
 using fastmcpp::server::Server;
@@ -207,16 +209,70 @@ int main()
         std::cout << "  [PASS] POST with invalid session_id rejected with 404\n";
     }
 
+    sse_server.stop();
+
     // Test 4: Connection limit should prevent DoS
     {
-        std::cout << "Test: connection limit (max 100) prevents DoS...\n";
-        // This test would require creating 100+ concurrent connections
-        // For now, just verify the mechanism exists (already tested above)
-        std::cout
-            << "  [SKIP] Connection limit test requires 100+ connections (tested in code review)\n";
-    }
+        std::cout << "Test: connection limit prevents DoS...\n";
 
-    sse_server.stop();
+        SseServerWrapper limited(handler, "127.0.0.1", 0, "/sse", "/messages");
+        limited.set_max_connections(2);
+        limited.set_heartbeat_interval(std::chrono::milliseconds(100));
+        if (!limited.start())
+        {
+            std::cerr << "Failed to start limited SSE server\n";
+            return 1;
+        }
+        const int limited_port = limited.port();
+
+        // Hold two streams open; heartbeats let the readers notice the release flag
+        std::atomic<bool> release{false};
+        std::atomic<int> opened{0};
+        std::vector<std::thread> holders;
+        for (int i = 0; i < 2; ++i)
+        {
+            holders.emplace_back(
+                [&, limited_port]()
+                {
+                    httplib::Client client("127.0.0.1", limited_port);
+                    client.set_read_timeout(std::chrono::seconds(5));
+                    bool counted = false;
+                    client.Get(
+                        "/sse",
+                        [&](const char*, size_t)
+                        {
+                            if (!counted)
+                            {
+                                counted = true;
+                                ++opened;
+                            }
+                            return !release.load();
+                        });
+                });
+        }
+
+        // The readiness probe's stream is reaped by its first heartbeat
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while ((opened < 2 || limited.connection_count() > 2) &&
+               std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        httplib::Client client("127.0.0.1", limited_port);
+        client.set_read_timeout(std::chrono::seconds(5));
+        auto res = client.Get("/sse");
+        release = true;
+        for (auto& holder : holders)
+            holder.join();
+        limited.stop();
+
+        if (opened != 2 || !res || res->status != 503)
+        {
+            std::cerr << "  [FAIL] Expected 503 beyond 2 connections, got: "
+                      << (res ? std::to_string(res->status) : "no response") << "\n";
+            return 1;
+        }
+        std::cout << "  [PASS] Third SSE stream rejected with 503\n";
+    }
 
     std::cout << "\n[OK] All SSE session security tests passed!\n";
     return 0;
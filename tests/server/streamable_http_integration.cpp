@@ -15,11 +15,13 @@
 #include "fastmcpp/tools/manager.hpp"
 #include "fastmcpp/util/json.hpp"
 
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <httplib.h>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 using namespace fastmcpp;
 
@@ -97,6 +99,13 @@ void test_basic_request_response()
         assert(content[0]["type"] == "text" && "Content should be text");
         assert(content[0]["text"] == "Hello, World!" && "Echo should return input");
 
+        // The three requests share a keep-alive connection
+        auto stats = transport.connection_stats();
+        assert(stats.requests == 3);
+        assert(stats.connections < stats.requests && "Connection should be reused");
+        assert(stats.reused() >= 1);
+        assert(stats.idle_clients == 1);
+
         std::cout << "PASSED\n";
     }
     catch (const std::exception& e)
@@ -586,6 +595,207 @@ void test_notification_handling()
     server.stop();
 }
 
+void test_tool_call_streams_notifications()
+{
+    std::cout << "  test_tool_call_streams_notifications... " << std::flush;
+
+    const int port = 18357;
+    const std::string host = "127.0.0.1";
+
+    // A handler whose tool reports progress and logs through the session while it runs
+    server::StreamableHttpServerWrapper* server_ptr = nullptr;
+    auto handler = [&server_ptr](const Json& request) -> Json
+    {
+        const std::string method = request.value("method", "");
+        if (method == "initialize")
+            return Json{{"jsonrpc", "2.0"},
+                        {"id", request["id"]},
+                        {"result", {{"serverInfo", {{"name", "progress"}, {"version", "1.0"}}}}}};
+
+        const auto& meta = request["params"]["_meta"];
+        auto session = server_ptr->get_session(meta["session_id"].get<std::string>());
+        assert(session);
+        if (meta.contains("progressToken"))
+            session->send_progress(meta["progressToken"].get<std::string>(), 1, 2, "halfway");
+        session->send_notification("notifications/message", {{"level", "info"}, {"data", "log"}});
+        // No stream asked for this token, so it has nowhere to go
+        session->send_progress("finished-request", 1, 2);
+        return Json{{"jsonrpc", "2.0"},
+                    {"id", request["id"]},
+                    {"result", {{"content", Json::array({{{"type", "text"}, {"text", "done"}}})}}}};
+    };
+
+    server::StreamableHttpServerWrapper server(handler, host, port, "/mcp");
+    server_ptr = &server;
+    bool started = server.start();
+    assert(started && "Server failed to start");
+
+    try
+    {
+        httplib::Client cli(host, port);
+        cli.set_connection_timeout(5, 0);
+        cli.set_read_timeout(5, 0);
+
+        Json init_request = {{"jsonrpc", "2.0"}, {"id", 1}, {"method", "initialize"}};
+        auto init_res = cli.Post("/mcp", init_request.dump(), "application/json");
+        assert(init_res && init_res->status == 200);
+        assert(init_res->get_header_value("Content-Type").find("application/json") == 0);
+        std::string session_id = init_res->get_header_value("Mcp-Session-Id");
+
+        Json call = {{"jsonrpc", "2.0"},
+                     {"id", 2},
+                     {"method", "tools/call"},
+                     {"params", {{"name", "work"}, {"_meta", {{"progressToken", "tok-1"}}}}}};
+
+        // Accepting SSE: notifications come first on the same response, then the result
+        httplib::Headers sse_headers = {{"Mcp-Session-Id", session_id},
+                                        {"Accept", "application/json, text/event-stream"}};
+        auto res = cli.Post("/mcp", sse_headers, call.dump(), "application/json");
+        assert(res && res->status == 200);
+        assert(res->get_header_value("Content-Type").find("text/event-stream") == 0);
+        assert(res->get_header_value("Mcp-Session-Id") == session_id);
+
+        std::vector<Json> events;
+        size_t pos = 0;
+        while ((pos = res->body.find("data: ", pos)) != std::string::npos)
+        {
+            auto end = res->body.find('\n', pos);
+            events.push_back(util::json::parse(res->body.substr(pos + 6, end - pos - 6)));
+            pos = end;
+        }
+        assert(events.size() == 3);
+        assert(events[0]["method"] == "notifications/progress");
+        assert(events[0]["params"]["progressToken"] == "tok-1");
+        assert(events[1]["method"] == "notifications/message");
+        assert(events[2]["id"] == 2);
+        assert(events[2]["result"]["content"][0]["text"] == "done");
+
+        // JSON-only clients get the plain response
+        httplib::Headers json_headers = {{"Mcp-Session-Id", session_id}};
+        auto json_res = cli.Post("/mcp", json_headers, call.dump(), "application/json");
+        assert(json_res && json_res->status == 200);
+        assert(json_res->get_header_value("Content-Type").find("application/json") == 0);
+        assert(util::json::parse(json_res->body)["id"] == 2);
+
+        server.set_sse_responses(false);
+        auto off_res = cli.Post("/mcp", sse_headers, call.dump(), "application/json");
+        assert(off_res && off_res->get_header_value("Content-Type").find("application/json") == 0);
+        server.set_sse_responses(true);
+
+        // The client transport hands streamed notifications to its callback
+        client::StreamableHttpTransport transport("http://" + host + ":" + std::to_string(port));
+        std::vector<Json> received;
+        transport.set_notification_callback([&](const Json& n) { received.push_back(n); });
+        transport.request("initialize", Json::object());
+        auto result = transport.request(
+            "tools/call", {{"name", "work"}, {"_meta", {{"progressToken", "tok-2"}}}});
+        assert(result["content"][0]["text"] == "done");
+        assert(received.size() == 2);
+        assert(received[0]["params"]["progressToken"] == "tok-2");
+
+        std::cout << "PASSED\n";
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << "FAILED: " << e.what() << "\n";
+        server.stop();
+        throw;
+    }
+
+    server.stop();
+}
+
+void test_concurrent_calls_keep_their_own_messages()
+{
+    std::cout << "  test_concurrent_calls_keep_their_own_messages... " << std::flush;
+
+    const int port = 18358;
+    const std::string host = "127.0.0.1";
+
+    // Call "a" logs only after "b" has opened its stream, and "b" only after "a"
+    // has logged, so routing by recency would put a's log on b's stream
+    std::atomic<bool> b_started{false};
+    std::atomic<bool> a_logged{false};
+    auto wait_for = [](const std::atomic<bool>& flag)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!flag && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    };
+    server::StreamableHttpServerWrapper* server_ptr = nullptr;
+    auto handler = [&](const Json& request) -> Json
+    {
+        if (request.value("method", "") == "initialize")
+            return Json{{"jsonrpc", "2.0"}, {"id", request["id"]}, {"result", Json::object()}};
+
+        auto session =
+            server_ptr->get_session(request["params"]["_meta"]["session_id"].get<std::string>());
+        const std::string name = request["params"]["name"];
+        if (name == "a")
+        {
+            wait_for(b_started);
+            session->send_notification("notifications/message", {{"data", "from-a"}});
+            a_logged = true;
+        }
+        else
+        {
+            b_started = true;
+            wait_for(a_logged);
+            session->send_notification("notifications/message", {{"data", "from-b"}});
+        }
+        return Json{{"jsonrpc", "2.0"}, {"id", request["id"]}, {"result", Json::object()}};
+    };
+
+    server::StreamableHttpServerWrapper server(handler, host, port, "/mcp");
+    server_ptr = &server;
+    bool started = server.start();
+    assert(started && "Server failed to start");
+
+    try
+    {
+        httplib::Client init_cli(host, port);
+        Json init_request = {{"jsonrpc", "2.0"}, {"id", 1}, {"method", "initialize"}};
+        auto init_res = init_cli.Post("/mcp", init_request.dump(), "application/json");
+        assert(init_res && init_res->status == 200);
+        std::string session_id = init_res->get_header_value("Mcp-Session-Id");
+
+        auto call = [&](int id, const std::string& name)
+        {
+            httplib::Client cli(host, port);
+            cli.set_read_timeout(10, 0);
+            httplib::Headers headers = {{"Mcp-Session-Id", session_id},
+                                        {"Accept", "application/json, text/event-stream"}};
+            Json request = {{"jsonrpc", "2.0"},
+                            {"id", id},
+                            {"method", "tools/call"},
+                            {"params", {{"name", name}}}};
+            auto res = cli.Post("/mcp", headers, request.dump(), "application/json");
+            assert(res && res->status == 200);
+            return res->body;
+        };
+
+        std::string a_body;
+        std::thread a_thread([&]() { a_body = call(2, "a"); });
+        std::string b_body = call(3, "b");
+        a_thread.join();
+
+        assert(a_body.find("from-a") != std::string::npos);
+        assert(a_body.find("from-b") == std::string::npos);
+        assert(b_body.find("from-b") != std::string::npos);
+        assert(b_body.find("from-a") == std::string::npos);
+
+        std::cout << "PASSED\n";
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << "FAILED: " << e.what() << "\n";
+        server.stop();
+        throw;
+    }
+
+    server.stop();
+}
+
 int main()
 {
     std::cout << "Streamable HTTP Integration Tests\n";
@@ -601,6 +811,8 @@ int main()
         test_invalid_tool_maps_to_invalid_params_error_code();
         test_default_timeout_allows_slow_tool();
         test_notification_handling();
+        test_tool_call_streams_notifications();
+        test_concurrent_calls_keep_their_own_messages();
 
         std::cout << "\nAll tests passed!\n";
         return 0;
@@ -477,6 +477,54 @@ void test_tool_closure_capture()
     std::cout << "  [PASS] Closure capture works correctly\n";
 }
 
+void test_tool_schemas_derived_once()
+{
+    std::cout << "Test 26: Tool schemas derived once and shared...\n";
+
+    Json input_schema = {
+        {"type", "object"},
+        {"$defs", {{"Name", {{"type", "string"}}}}},
+        {"properties", {{"name", {{"$ref", "#/$defs/Name"}}}, {"ctx", {{"type", "object"}}}}},
+        {"required", Json::array({"name", "ctx"})}};
+    Json output_schema = {{"type", "object"}, {"properties", {{"ok", {{"type", "boolean"}}}}}};
+
+    tools::Tool tool{"greet", input_schema, output_schema, [](const Json&) { return Json{}; },
+                     std::vector<std::string>{"ctx"}};
+
+    // Excluded arguments are pruned once, at construction
+    const auto& listed = tool.input_schema();
+    assert(!listed["properties"].contains("ctx"));
+    assert(listed["required"] == Json::array({"name"}));
+    assert(&tool.input_schema() == &listed);
+
+    // Refs are inlined in the dereferenced form only
+    assert(listed["properties"]["name"].contains("$ref"));
+    const auto& deref = tool.dereferenced_input_schema();
+    assert(deref["properties"]["name"]["type"] == "string");
+    assert(!deref["properties"].contains("ctx"));
+
+    // Without refs the dereferenced form is the same object
+    assert(&tool.dereferenced_output_schema() == &tool.output_schema());
+
+    // Object-shaped output schemas are listed as is; others are wrapped once
+    assert(&tool.mcp_output_schema() == &tool.output_schema());
+    tools::Tool counter{"count", Json::object(), Json{{"type", "integer"}},
+                        [](const Json&) { return Json(1); }};
+    const auto& wrapped = counter.mcp_output_schema();
+    assert(wrapped["properties"]["result"]["type"] == "integer");
+    assert(wrapped["x-fastmcp-wrap-result"] == true);
+    assert(&counter.mcp_output_schema() == &wrapped);
+    assert(&counter.mcp_dereferenced_output_schema() == &wrapped);
+
+    // Copies share the derived schemas instead of copying them
+    tools::Tool copy = tool;
+    assert(&copy.input_schema() == &tool.input_schema());
+    assert(&copy.dereferenced_input_schema() == &tool.dereferenced_input_schema());
+    assert(&copy.mcp_output_schema() == &tool.mcp_output_schema());
+
+    std::cout << "  [PASS] Schemas derived once and shared between copies\n";
+}
+
 int main()
 {
     std::cout << "Running tool edge case tests...\n\n";
@@ -499,7 +547,8 @@ int main()
         test_tool_exception_types();
         test_tool_stateful_lambda();
         test_tool_closure_capture();
-        std::cout << "\n[OK] All tool edge case tests passed! (17 tests)\n";
+        test_tool_schemas_derived_once();
+        std::cout << "\n[OK] All tool edge case tests passed! (18 tests)\n";
         return 0;
     }
     catch (const std::exception& e)
@@ -1,11 +1,15 @@
 /// @file test_tool_timeout.cpp
 /// @brief Tests for tool execution timeouts
 
+#include "../wait_helpers.hpp"
+#include "fastmcpp/tools/execution_pool.hpp"
 #include "fastmcpp/tools/manager.hpp"
 #include "fastmcpp/tools/tool.hpp"
 
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <functional>
 #include <iostream>
 #include <thread>
 
@@ -101,6 +105,160 @@ void test_manager_timeout_toggle()
     std::cout << "PASSED\n";
 }
 
+void test_pool_reuses_workers()
+{
+    std::cout << "  test_pool_reuses_workers... " << std::flush;
+
+    auto pool = std::make_shared<ExecutionPool>(2);
+    Tool add("add", Json::object(), Json::object(),
+             [](const Json& in) { return Json(in["a"].get<int>() + 1); });
+    add.set_timeout(5s).set_execution_pool(pool);
+
+    for (int i = 0; i < 50; ++i)
+        assert(add.invoke(Json{{"a", i}}) == i + 1);
+
+    // Counters settle just after the result is handed back
+    assert(wait_until([&]() { return pool->metrics().completed == 50; }));
+    auto metrics = pool->metrics();
+    assert(metrics.workers >= 1 && metrics.workers <= 2);
+    assert(metrics.timed_out == 0);
+    assert(metrics.orphaned == 0);
+    std::cout << "PASSED\n";
+}
+
+void test_timeout_cancels_token()
+{
+    std::cout << "  test_timeout_cancels_token... " << std::flush;
+
+    auto pool = std::make_shared<ExecutionPool>(1);
+    std::atomic<bool> saw_cancel{false};
+    Tool cooperative("cooperative", Json::object(), Json::object(),
+                     [&saw_cancel](const Json&) -> Json
+                     {
+                         const auto& token = current_cancellation_token();
+                         while (!token.is_cancelled())
+                             std::this_thread::sleep_for(1ms);
+                         saw_cancel = true;
+                         return Json{{"ok", false}};
+                     });
+    cooperative.set_timeout(20ms).set_execution_pool(pool);
+
+    bool threw = false;
+    try
+    {
+        cooperative.invoke(Json::object());
+    }
+    catch (const ToolTimeoutError&)
+    {
+        threw = true;
+    }
+    assert(threw);
+    assert(wait_until([&]() { return saw_cancel.load(); }));
+    assert(wait_until([&]() { return pool->metrics().orphaned == 0; }));
+
+    auto metrics = pool->metrics();
+    assert(metrics.timed_out == 1);
+    assert(metrics.completed == 1);
+    assert(metrics.workers == 1);
+    // The worker is free again for the next call
+    assert(!current_cancellation_token().is_cancelled());
+    std::cout << "PASSED\n";
+}
+
+void test_queued_call_dropped_on_timeout()
+{
+    std::cout << "  test_queued_call_dropped_on_timeout... " << std::flush;
+
+    // No replacement workers, so an orphan really holds the only one
+    auto pool = std::make_shared<ExecutionPool>(1, 0);
+    std::atomic<bool> release{false};
+    std::atomic<int> blocker_runs{0};
+    std::atomic<int> queued_runs{0};
+
+    auto blocker = [&](const Json&) -> Json
+    {
+        ++blocker_runs;
+        while (!release)
+            std::this_thread::sleep_for(1ms);
+        return Json();
+    };
+    auto queued = [&](const Json&) -> Json
+    {
+        ++queued_runs;
+        return Json();
+    };
+
+    assert(!pool->run_for(blocker, Json::object(), 20ms).has_value());
+    assert(pool->metrics().orphaned == 1);
+
+    // The only worker is held by the orphan, so this call never leaves the queue
+    assert(!pool->run_for(queued, Json::object(), 20ms).has_value());
+    auto metrics = pool->metrics();
+    assert(metrics.queue_depth == 0);
+    assert(metrics.timed_out == 2);
+    assert(metrics.workers == 1);
+
+    release = true;
+    assert(wait_until([&]() { return pool->metrics().orphaned == 0; }));
+    assert(pool->run_for(queued, Json::object(), 5s).has_value());
+    assert(blocker_runs == 1);
+    assert(queued_runs == 1);
+    assert(wait_until([&]() { return pool->metrics().completed == 2; }));
+    std::cout << "PASSED\n";
+}
+
+void test_uncooperative_calls_do_not_starve_pool()
+{
+    std::cout << "  test_uncooperative_calls_do_not_starve_pool... " << std::flush;
+
+    auto pool = std::make_shared<ExecutionPool>(2);
+    std::atomic<bool> release{false};
+    auto hung = [&](const Json&) -> Json
+    {
+        // Ignores its cancellation token
+        while (!release)
+            std::this_thread::sleep_for(1ms);
+        return Json();
+    };
+    for (size_t i = 0; i < pool->max_workers(); ++i)
+        assert(!pool->run_for(hung, Json::object(), 20ms).has_value());
+    assert(pool->metrics().orphaned == 2);
+
+    // Replacement workers still serve unrelated calls
+    auto answer = pool->run_for([](const Json&) { return Json(42); }, Json::object(), 5s);
+    assert(answer && *answer == 42);
+    auto metrics = pool->metrics();
+    assert(metrics.max_orphans == ExecutionPool::default_max_orphans());
+    assert(metrics.workers == 3);
+
+    // Once the orphans return, the extra worker exits
+    release = true;
+    assert(wait_until([&]() { return pool->metrics().orphaned == 0; }));
+    assert(wait_until([&]() { return pool->metrics().workers == 2; }));
+    std::cout << "PASSED\n";
+}
+
+void test_pool_propagates_exceptions()
+{
+    std::cout << "  test_pool_propagates_exceptions... " << std::flush;
+
+    Tool failing("failing", Json::object(), Json::object(),
+                 [](const Json&) -> Json { throw ValidationError("bad input"); });
+    failing.set_timeout(5s);
+
+    bool threw = false;
+    try
+    {
+        failing.invoke(Json::object());
+    }
+    catch (const ValidationError&)
+    {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "PASSED\n";
+}
+
 int main()
 {
     std::cout << "Tool Timeout Tests\n";
@@ -111,6 +269,11 @@ int main()
         test_tool_timeout_triggers();
         test_tool_timeout_disabled();
         test_manager_timeout_toggle();
+        test_pool_reuses_workers();
+        test_timeout_cancels_token();
+        test_queued_call_dropped_on_timeout();
+        test_uncooperative_calls_do_not_starve_pool();
+        test_pool_propagates_exceptions();
         std::cout << "\nAll tests passed!\n";
         return 0;
     }
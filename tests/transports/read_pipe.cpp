@@ -0,0 +1,114 @@
+// Tests for buffered line reading on subprocess pipes
+#include "../../src/internal/process.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace fastmcpp::process;
+
+namespace
+{
+#ifndef _WIN32
+/// Spawn `sh -c script` and return the process with stdout redirected.
+Process spawn_shell(const std::string& script)
+{
+    Process process;
+    ProcessOptions options;
+    options.redirect_stdin = false;
+    process.spawn("sh", {"-c", script}, options);
+    return process;
+}
+#endif
+} // namespace
+
+#ifndef _WIN32
+void test_lines_split_from_one_chunk()
+{
+    std::cout << "test_lines_split_from_one_chunk..." << std::endl;
+
+    auto process = spawn_shell("printf 'one\\ntwo\\r\\nthree'");
+    auto& out = process.stdout_pipe();
+    assert(out.read_line() == "one\n");
+    // The rest of the chunk is already buffered, so no wait is needed
+    assert(out.buffered() > 0);
+    assert(out.has_data(0));
+    assert(out.read_line_view() == "two\r\n");
+    // A final line without a newline is returned at EOF, then nothing
+    assert(out.read_line() == "three");
+    assert(out.read_line().empty());
+    process.wait();
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_long_line_is_not_truncated()
+{
+    std::cout << "test_long_line_is_not_truncated..." << std::endl;
+
+    // 1 MiB line, far beyond the old 4096-byte cap, followed by a short one
+    auto process = spawn_shell("head -c 1048576 /dev/zero | tr '\\0' 'x'; printf '\\nnext\\n'");
+    auto& out = process.stdout_pipe();
+    auto line = out.read_line();
+    assert(line.size() == 1048576 + 1);
+    assert(line.find_first_not_of('x') == 1048576);
+    assert(out.read_line() == "next\n");
+    process.wait();
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_max_size_splits_lines()
+{
+    std::cout << "test_max_size_splits_lines..." << std::endl;
+
+    auto process = spawn_shell("printf 'abcdefgh\\nij\\n'");
+    auto& out = process.stdout_pipe();
+    assert(out.read_line(3) == "abc");
+    assert(out.read_line(3) == "def");
+    assert(out.read_line(3) == "gh\n");
+    assert(out.read_line(3) == "ij\n");
+
+    // Nothing is left once the last line is consumed
+    char buf[8];
+    assert(out.read(buf, sizeof(buf)) == 0);
+    process.wait();
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_raw_read_after_line()
+{
+    std::cout << "test_raw_read_after_line..." << std::endl;
+
+    auto process = spawn_shell("printf 'head\\nbody'");
+    auto& out = process.stdout_pipe();
+    assert(out.read_line() == "head\n");
+    std::string rest;
+    char buf[2];
+    for (size_t n; (n = out.read(buf, sizeof(buf))) > 0;)
+        rest.append(buf, n);
+    assert(rest == "body");
+    process.wait();
+
+    std::cout << "  PASSED" << std::endl;
+}
+#endif
+
+int main()
+{
+    std::cout << "=== ReadPipe Tests ===" << std::endl;
+
+#ifdef _WIN32
+    std::cout << "Skipped on Windows (uses sh)" << std::endl;
+#else
+    test_lines_split_from_one_chunk();
+    test_long_line_is_not_truncated();
+    test_max_size_splits_lines();
+    test_raw_read_after_line();
+#endif
+
+    std::cout << "\n=== All tests PASSED ===" << std::endl;
+    return 0;
+}
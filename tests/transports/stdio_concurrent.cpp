@@ -0,0 +1,382 @@
+// Tests for StdioServerWrapper's concurrent request mode
+#include "fastmcpp/app.hpp"
+#include "fastmcpp/mcp/handler.hpp"
+#include "fastmcpp/server/stdio_server.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace fastmcpp;
+using namespace std::chrono_literals;
+
+namespace
+{
+/// Tracks how many calls overlap.
+struct Overlap
+{
+    std::atomic<int> active{0};
+    std::atomic<int> peak{0};
+
+    void enter()
+    {
+        int now = ++active;
+        int seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now))
+        {
+        }
+    }
+    void leave()
+    {
+        --active;
+    }
+};
+
+std::string call_line(int id, const std::string& tool)
+{
+    return Json{{"jsonrpc", "2.0"},
+                {"id", id},
+                {"method", "tools/call"},
+                {"params", {{"name", tool}, {"arguments", Json::object()}}}}
+        .dump();
+}
+
+std::string list_line(int id)
+{
+    return Json{{"jsonrpc", "2.0"}, {"id", id}, {"method", "tools/list"}}.dump();
+}
+
+/// Feed `lines` to a server on stdin and return the JSON messages it wrote to stdout.
+std::vector<Json> run_server(server::StdioServerWrapper& server,
+                             const std::vector<std::string>& lines)
+{
+    std::stringstream in;
+    for (const auto& line : lines)
+        in << line << "\n";
+    std::stringstream out;
+
+    auto* old_in = std::cin.rdbuf(in.rdbuf());
+    auto* old_out = std::cout.rdbuf(out.rdbuf());
+    server.run();
+    std::cin.rdbuf(old_in);
+    std::cout.rdbuf(old_out);
+
+    std::vector<Json> messages;
+    std::string line;
+    while (std::getline(out, line))
+        if (!line.empty())
+            messages.push_back(Json::parse(line));
+    return messages;
+}
+
+std::vector<int> response_ids(const std::vector<Json>& messages)
+{
+    std::vector<int> ids;
+    for (const auto& message : messages)
+        if (message.contains("id"))
+            ids.push_back(message["id"].get<int>());
+    return ids;
+}
+} // namespace
+
+void test_serial_mode_preserves_order()
+{
+    std::cout << "test_serial_mode_preserves_order..." << std::endl;
+
+    FastMCP app("Serial", "1.0.0");
+    app.tool(
+        "slow",
+        [](const Json&)
+        {
+            std::this_thread::sleep_for(50ms);
+            return Json("slow");
+        });
+    app.tool("fast", [](const Json&) { return Json("fast"); });
+
+    server::StdioServerWrapper server(mcp::make_mcp_handler(app));
+    auto messages = run_server(server, {call_line(1, "slow"), call_line(2, "fast")});
+    assert((response_ids(messages) == std::vector<int>{1, 2}));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_concurrent_mode_answers_out_of_order()
+{
+    std::cout << "test_concurrent_mode_answers_out_of_order..." << std::endl;
+
+    FastMCP app("Concurrent", "1.0.0");
+    std::atomic<bool> fast_done{false};
+    app.tool("slow",
+             [&fast_done](const Json&)
+             {
+                 auto deadline = std::chrono::steady_clock::now() + 5s;
+                 while (!fast_done && std::chrono::steady_clock::now() < deadline)
+                     std::this_thread::sleep_for(1ms);
+                 return Json("slow");
+             });
+    app.tool("fast",
+             [&fast_done](const Json&)
+             {
+                 fast_done = true;
+                 return Json("fast");
+             });
+
+    server::StdioServerWrapper::Options options;
+    options.workers = 4;
+    server::StdioServerWrapper server(mcp::make_mcp_handler(app), options);
+    auto messages = run_server(server, {call_line(1, "slow"), call_line(2, "fast"), "not json"});
+
+    // The slow call only finishes once the fast one has run next to it
+    auto ids = response_ids(messages);
+    assert(std::find(ids.begin(), ids.end(), 1) != ids.end());
+    assert(std::find(ids.begin(), ids.end(), 2) != ids.end());
+    assert(std::find(ids.begin(), ids.end(), 2) < std::find(ids.begin(), ids.end(), 1));
+
+    // The unparseable line still gets an error response
+    bool saw_parse_error = false;
+    for (const auto& message : messages)
+        if (message.contains("error") && message["error"]["code"] == -32603)
+            saw_parse_error = true;
+    assert(saw_parse_error);
+    assert(!server.running());
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_sequential_tools_do_not_overlap()
+{
+    std::cout << "test_sequential_tools_do_not_overlap..." << std::endl;
+
+    FastMCP app("Sequential", "1.0.0");
+    Overlap seq_overlap;
+    Overlap free_overlap;
+    FastMCP::ToolOptions seq_options;
+    seq_options.sequential = true;
+    app.tool(
+        "seq",
+        [&seq_overlap](const Json&)
+        {
+            seq_overlap.enter();
+            std::this_thread::sleep_for(20ms);
+            seq_overlap.leave();
+            return Json("seq");
+        },
+        seq_options);
+    app.tool("free",
+             [&free_overlap](const Json&)
+             {
+                 free_overlap.enter();
+                 auto deadline = std::chrono::steady_clock::now() + 2s;
+                 while (free_overlap.peak < 2 && std::chrono::steady_clock::now() < deadline)
+                     std::this_thread::sleep_for(1ms);
+                 free_overlap.leave();
+                 return Json("free");
+             });
+
+    server::StdioServerWrapper::Options options;
+    options.workers = 4;
+    server::StdioServerWrapper server(mcp::make_mcp_handler(app), options);
+
+    // The listing advertises "seq" as sequential before any call is dispatched
+    std::vector<std::string> lines{list_line(1)};
+    for (int i = 0; i < 4; ++i)
+        lines.push_back(call_line(10 + i, "seq"));
+    for (int i = 0; i < 2; ++i)
+        lines.push_back(call_line(20 + i, "free"));
+    auto messages = run_server(server, lines);
+
+    assert(response_ids(messages).size() == 7);
+    assert(seq_overlap.peak == 1);
+    assert(free_overlap.peak == 2);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_unlisted_tools_are_serialized()
+{
+    std::cout << "test_unlisted_tools_are_serialized..." << std::endl;
+
+    FastMCP app("Unlisted", "1.0.0");
+    Overlap overlap;
+    FastMCP::ToolOptions seq_options;
+    seq_options.sequential = true;
+    app.tool(
+        "seq",
+        [&overlap](const Json&)
+        {
+            overlap.enter();
+            std::this_thread::sleep_for(20ms);
+            overlap.leave();
+            return Json("seq");
+        },
+        seq_options);
+
+    server::StdioServerWrapper::Options options;
+    options.workers = 4;
+    server::StdioServerWrapper server(mcp::make_mcp_handler(app), options);
+
+    // No tools/list before the calls: the dispatcher cannot know "seq" is sequential yet
+    std::vector<std::string> lines;
+    for (int i = 0; i < 4; ++i)
+        lines.push_back(call_line(10 + i, "seq"));
+    auto messages = run_server(server, lines);
+
+    assert(response_ids(messages).size() == 4);
+    assert(overlap.peak == 1);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_explicit_predicate_and_in_flight_limit()
+{
+    std::cout << "test_explicit_predicate_and_in_flight_limit..." << std::endl;
+
+    FastMCP app("Limited", "1.0.0");
+    Overlap overlap;
+    auto tracked = [&overlap](const Json&)
+    {
+        overlap.enter();
+        std::this_thread::sleep_for(10ms);
+        overlap.leave();
+        return Json("ok");
+    };
+    app.tool("a", tracked);
+    app.tool("b", tracked);
+
+    // Predicate marks "a" sequential without any tools/list
+    server::StdioServerWrapper::Options options;
+    options.workers = 4;
+    options.is_sequential = [](const std::string& name) { return name == "a"; };
+    server::StdioServerWrapper sequential_server(mcp::make_mcp_handler(app), options);
+    auto messages =
+        run_server(sequential_server, {call_line(1, "a"), call_line(2, "a"), call_line(3, "a")});
+    assert(response_ids(messages).size() == 3);
+    assert(overlap.peak == 1);
+
+    // One request in flight at a time serializes everything
+    options.is_sequential = nullptr;
+    options.max_in_flight = 1;
+    overlap.peak = 0;
+    server::StdioServerWrapper limited_server(mcp::make_mcp_handler(app), options);
+    messages = run_server(limited_server, {call_line(1, "a"), call_line(2, "b"), call_line(3, "a"),
+                                           call_line(4, "b")});
+    assert((response_ids(messages) == std::vector<int>{1, 2, 3, 4}));
+    assert(overlap.peak == 1);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_batches_in_both_modes()
+{
+    std::cout << "test_batches_in_both_modes..." << std::endl;
+
+    FastMCP app("Batch", "1.0.0");
+    app.tool("echo", [](const Json& args) { return args; });
+    auto batch_line =
+        Json::array({Json::parse(call_line(1, "echo")),
+                     Json{{"jsonrpc", "2.0"}, {"method", "notifications/initialized"}},
+                     Json::parse(call_line(2, "missing")), Json::parse(list_line(3))})
+            .dump();
+    auto notifications_only =
+        Json::array({Json{{"jsonrpc", "2.0"}, {"method", "notifications/initialized"}}}).dump();
+
+    for (size_t workers : {0, 4})
+    {
+        server::StdioServerWrapper::Options options;
+        options.workers = workers;
+        server::StdioServerWrapper server(mcp::make_mcp_handler(app), options);
+        auto messages = run_server(server, {batch_line, notifications_only, "[]", list_line(4)});
+
+        // One array reply for the batch, nothing for the notification-only batch,
+        // a single error for the empty one
+        assert(messages.size() == 3);
+        auto batch_reply = std::find_if(messages.begin(), messages.end(),
+                                        [](const Json& m) { return m.is_array(); });
+        assert(batch_reply != messages.end());
+        assert(batch_reply->size() == 3);
+        assert((*batch_reply)[0]["id"] == 1);
+        assert((*batch_reply)[1]["id"] == 2);
+        assert((*batch_reply)[1].contains("error"));
+        assert((*batch_reply)[2]["id"] == 3);
+
+        bool saw_empty_batch_error = false;
+        for (const auto& message : messages)
+            if (message.is_object() && message.contains("error") &&
+                message["error"]["code"] == -32600)
+                saw_empty_batch_error = true;
+        assert(saw_empty_batch_error);
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_malformed_requests_in_both_modes()
+{
+    std::cout << "test_malformed_requests_in_both_modes..." << std::endl;
+
+    FastMCP app("Malformed", "1.0.0");
+    app.tool("echo", [](const Json&) { return Json("echo"); });
+
+    // Valid JSON that is not a request object, or whose method is not a string
+    const std::vector<std::string> lines{
+        "5", R"({"jsonrpc":"2.0","id":1,"method":5})", R"([{"jsonrpc":"2.0","id":3,"method":5}])",
+        list_line(2)};
+
+    for (size_t workers : {size_t{0}, size_t{4}})
+    {
+        server::StdioServerWrapper::Options options;
+        options.workers = workers;
+        server::StdioServerWrapper server(mcp::make_mcp_handler(app), options);
+        auto messages = run_server(server, lines);
+
+        bool saw_invalid_request = false;
+        bool saw_method_error = false;
+        bool saw_batch = false;
+        bool saw_listing = false;
+        for (const auto& message : messages)
+        {
+            if (message.is_array())
+            {
+                saw_batch = message.size() == 1 && message[0]["id"] == 3 &&
+                            message[0].contains("error");
+                continue;
+            }
+            if (!message.contains("id") && message.contains("error") &&
+                message["error"]["code"] == -32600)
+                saw_invalid_request = true;
+            if (message.value("id", 0) == 1 && message.contains("error"))
+                saw_method_error = true;
+            if (message.value("id", 0) == 2 && message.contains("result"))
+                saw_listing = true;
+        }
+        assert(saw_invalid_request);
+        assert(saw_method_error);
+        assert(saw_batch);
+        assert(saw_listing);
+        assert(!server.running());
+    }
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== Stdio Concurrent Server Tests ===" << std::endl;
+
+    test_serial_mode_preserves_order();
+    test_concurrent_mode_answers_out_of_order();
+    test_sequential_tools_do_not_overlap();
+    test_unlisted_tools_are_serialized();
+    test_explicit_predicate_and_in_flight_limit();
+    test_batches_in_both_modes();
+    test_malformed_requests_in_both_modes();
+
+    std::cout << "\n=== All tests PASSED ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,180 @@
+// Tests for StdioTransport's multiplexed keep-alive mode
+#include "fastmcpp/client/transports.hpp"
+#include "fastmcpp/exceptions.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using fastmcpp::Json;
+using fastmcpp::client::StdioTransport;
+
+#ifndef _WIN32
+namespace
+{
+// Shell helpers: pull the numeric ids out of a request line (keys are dumped sorted)
+const std::string kIds = "ids() { echo \"$1\" | grep -o '\"id\":[0-9]*' | cut -d: -f2; }; ";
+
+std::string reply(const std::string& id_var, const std::string& tag)
+{
+    return "printf '{\"jsonrpc\":\"2.0\",\"id\":%s,\"result\":{\"tag\":\"" + tag + "\"}}\\n' " +
+           id_var + "; ";
+}
+} // namespace
+
+void test_concurrent_requests_answered_out_of_order()
+{
+    std::cout << "test_concurrent_requests_answered_out_of_order..." << std::endl;
+
+    // Waits for two requests, sends a notification, then answers the second first
+    std::string script =
+        kIds + "read a; read b; ia=$(ids \"$a\"); ib=$(ids \"$b\"); " +
+        "printf '{\"jsonrpc\":\"2.0\",\"method\":\"notifications/message\",\"params\":{}}\\n'; " +
+        reply("$ib", "second") + reply("$ia", "first") + "sleep 5";
+    StdioTransport tx{"sh", {"-c", script}};
+
+    std::mutex mutex;
+    std::vector<Json> notifications;
+    tx.set_notification_callback(
+        [&](const Json& message)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            notifications.push_back(message);
+        });
+
+    // Both requests must be in flight at once for the server to answer either
+    auto first = std::async(
+        std::launch::async, [&]() { return tx.request("tools/list", Json::object()); });
+    auto second =
+        std::async(std::launch::async, [&]() { return tx.request("tools/list", Json::object()); });
+    auto a = first.get();
+    auto b = second.get();
+
+    // Each caller gets the response carrying its own id
+    assert(a["result"]["tag"] != b["result"]["tag"]);
+    assert(a["id"] != b["id"]);
+    std::lock_guard<std::mutex> lock(mutex);
+    assert(notifications.size() == 1);
+    assert(notifications[0]["method"] == "notifications/message");
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_batch_over_one_line()
+{
+    std::cout << "test_batch_over_one_line..." << std::endl;
+
+    // Replies to a two-entry batch line with separate lines, in reverse order
+    std::string script = kIds + "read line; set -- $(ids \"$line\"); " + reply("$2", "second") +
+                         reply("$1", "first") + "sleep 5";
+    StdioTransport tx{"sh", {"-c", script}};
+
+    auto responses = tx.request_batch({{"tools/list", Json::object()}, {"ping", Json::object()}});
+    assert(responses.size() == 2);
+    assert(responses[0]["result"]["tag"] == "first");
+    assert(responses[1]["result"]["tag"] == "second");
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_server_request_is_answered()
+{
+    std::cout << "test_server_request_is_answered..." << std::endl;
+
+    // Asks the client for roots, echoes the client's answer back as its result
+    std::string script =
+        kIds + "read req; id=$(ids \"$req\"); " +
+        "printf '{\"id\":900,\"jsonrpc\":\"2.0\",\"method\":\"roots/list\",\"params\":{}}\\n'; " +
+        "read answer; printf '{\"jsonrpc\":\"2.0\",\"id\":%s,\"result\":{\"answer\":%s}}\\n' " +
+        "\"$id\" \"$answer\"; sleep 5";
+    StdioTransport tx{"sh", {"-c", script}};
+    tx.set_server_request_handler(
+        [](const std::string& method, const Json&)
+        {
+            return Json{{"method", method}};
+        });
+
+    auto response = tx.request("tools/list", Json::object());
+    assert(response["result"]["answer"]["id"] == 900);
+    assert(response["result"]["answer"]["result"]["method"] == "roots/list");
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_slow_server_request_does_not_block_responses()
+{
+    std::cout << "test_slow_server_request_does_not_block_responses..." << std::endl;
+
+    // Asks the client for roots and answers the client's request without waiting
+    std::string script =
+        kIds + "read req; id=$(ids \"$req\"); " +
+        "printf '{\"id\":901,\"jsonrpc\":\"2.0\",\"method\":\"roots/list\",\"params\":{}}\\n'; " +
+        reply("$id", "done") + "read answer; sleep 5";
+    std::promise<void> released;
+    auto release = released.get_future().share();
+    std::atomic<bool> handled{false};
+    StdioTransport tx{"sh", {"-c", script}};
+    tx.set_server_request_handler(
+        [release, &handled](const std::string&, const Json&)
+        {
+            release.wait_for(std::chrono::seconds(5));
+            handled = true;
+            return Json::object();
+        });
+
+    // The response arrives while the handler is still blocked
+    auto response = tx.request("tools/list", Json::object());
+    assert(response["result"]["tag"] == "done");
+    assert(!handled);
+    released.set_value();
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_exit_fails_pending_requests()
+{
+    std::cout << "test_exit_fails_pending_requests..." << std::endl;
+
+    StdioTransport tx{"sh", {"-c", "read line; echo gone >&2; exit 3"}};
+    auto start = std::chrono::steady_clock::now();
+    bool caught = false;
+    try
+    {
+        tx.request("tools/list", Json::object());
+    }
+    catch (const fastmcpp::TransportError& e)
+    {
+        caught = true;
+        std::string message = e.what();
+        assert(message.find("code: 3") != std::string::npos);
+    }
+    assert(caught);
+    // Fails as soon as the process exits, not after the response timeout
+    assert(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+
+    std::cout << "  PASSED" << std::endl;
+}
+#endif
+
+int main()
+{
+    std::cout << "=== Stdio Multiplex Tests ===" << std::endl;
+
+#ifdef _WIN32
+    std::cout << "Skipped on Windows (uses sh)" << std::endl;
+#else
+    test_concurrent_requests_answered_out_of_order();
+    test_batch_over_one_line();
+    test_server_request_is_answered();
+    test_slow_server_request_does_not_block_responses();
+    test_exit_fails_pending_requests();
+#endif
+
+    std::cout << "\n=== All tests PASSED ===" << std::endl;
+    return 0;
+}
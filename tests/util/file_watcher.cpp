@@ -0,0 +1,143 @@
+// Unit tests for util::FileWatcher, with inotify (where available) and polling
+#include "fastmcpp/util/file_watcher.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using fastmcpp::util::FileWatcher;
+using namespace std::chrono_literals;
+
+namespace
+{
+std::filesystem::path make_root(const std::string& name)
+{
+    auto root = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+    return root;
+}
+
+/// Waits until `path` itself, or a directory containing it, is reported
+bool saw(FileWatcher& watcher, const std::filesystem::path& path)
+{
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        watcher.wait_for_changes(100ms);
+        for (const auto& changed : watcher.take_changes())
+        {
+            const auto relative = path.lexically_relative(changed);
+            if (!relative.empty() && *relative.begin() != "..")
+                return true;
+        }
+    }
+    return false;
+}
+
+void write_file(const std::filesystem::path& path, const std::string& content)
+{
+    std::ofstream(path, std::ios::binary) << content;
+}
+} // namespace
+
+void test_tree(bool force_polling)
+{
+    std::cout << "test_tree (" << (force_polling ? "polling" : "default") << ")..." << std::endl;
+    const auto root = make_root(force_polling ? "fastmcpp_watch_poll" : "fastmcpp_watch");
+    write_file(root / "existing.txt", "one");
+
+    std::atomic<int> callbacks{0};
+    FileWatcher::Options options;
+    options.force_polling = force_polling;
+    options.poll_interval = 20ms;
+    options.on_change = [&callbacks]() { ++callbacks; };
+    FileWatcher watcher(root, options);
+    assert(!force_polling || !watcher.uses_inotify());
+    assert(!watcher.has_changes());
+
+    write_file(root / "existing.txt", "rewritten");
+    assert(saw(watcher, root / "existing.txt"));
+    assert(!watcher.has_changes());
+    assert(callbacks > 0);
+
+    write_file(root / "added.txt", "new");
+    assert(saw(watcher, root / "added.txt"));
+
+    // Files in a directory created after the watcher started
+    std::filesystem::create_directories(root / "sub" / "deeper");
+    write_file(root / "sub" / "deeper" / "nested.txt", "nested");
+    assert(saw(watcher, root / "sub" / "deeper" / "nested.txt"));
+    std::this_thread::sleep_for(200ms); // Let events from the first write drain
+    watcher.take_changes();
+    write_file(root / "sub" / "deeper" / "nested.txt", "again");
+    assert(saw(watcher, root / "sub" / "deeper" / "nested.txt"));
+
+    std::filesystem::remove(root / "added.txt");
+    assert(saw(watcher, root / "added.txt"));
+
+    std::filesystem::rename(root / "existing.txt", root / "renamed.txt");
+    assert(saw(watcher, root / "renamed.txt"));
+
+    std::filesystem::remove_all(root);
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_renamed_directory()
+{
+    std::cout << "test_renamed_directory..." << std::endl;
+    const auto root = make_root("fastmcpp_watch_rename");
+    std::filesystem::create_directories(root / "a" / "nested");
+    FileWatcher watcher(root);
+
+    std::filesystem::rename(root / "a", root / "b");
+    assert(saw(watcher, root / "b"));
+    std::this_thread::sleep_for(200ms); // Let the rename's events drain
+    watcher.take_changes();
+
+    // The renamed directory and the one below it are both still watched
+    write_file(root / "b" / "x.txt", "x");
+    assert(saw(watcher, root / "b" / "x.txt"));
+    write_file(root / "b" / "nested" / "y.txt", "y");
+    assert(saw(watcher, root / "b" / "nested" / "y.txt"));
+
+    std::filesystem::remove_all(root);
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_single_file()
+{
+    std::cout << "test_single_file..." << std::endl;
+    const auto root = make_root("fastmcpp_watch_file");
+    const auto file = root / "watched.txt";
+    write_file(file, "one");
+    FileWatcher watcher(file);
+
+    write_file(root / "other.txt", "ignored");
+    write_file(root / "replacement.tmp", "two");
+    std::filesystem::rename(root / "replacement.tmp", file);
+    assert(saw(watcher, file));
+    for (const auto& changed : watcher.take_changes())
+        assert(changed == file);
+
+    std::filesystem::remove_all(root);
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main()
+{
+    std::cout << "FileWatcher tests" << std::endl;
+    std::cout << "=================" << std::endl;
+    test_tree(false);
+    test_tree(true);
+    test_renamed_directory();
+    test_single_file();
+    std::cout << "\nAll FileWatcher tests passed!" << std::endl;
+    return 0;
+}
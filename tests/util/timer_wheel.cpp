@@ -0,0 +1,116 @@
+// Unit tests for util::TimerWheel
+#include "../wait_helpers.hpp"
+#include "fastmcpp/util/timer_wheel.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace fastmcpp::util;
+using namespace std::chrono_literals;
+
+void test_fires_in_deadline_order()
+{
+    std::cout << "test_fires_in_deadline_order..." << std::endl;
+
+    TimerWheel wheel(5ms, 8);
+    std::mutex mutex;
+    std::vector<std::string> order;
+    auto record = [&](std::string label)
+    {
+        return [&, label]()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(label);
+        };
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    // 120ms wraps the 8-slot wheel several times, so it shares a slot with earlier laps
+    wheel.schedule(120ms, record("late"));
+    wheel.schedule(40ms, record("middle"));
+    wheel.schedule(10ms, record("early"));
+    assert(wheel.pending() == 3);
+
+    assert(wait_until([&]() { return wheel.pending() == 0; }));
+    assert(std::chrono::steady_clock::now() - start >= 120ms);
+    std::lock_guard<std::mutex> lock(mutex);
+    assert((order == std::vector<std::string>{"early", "middle", "late"}));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_cancel()
+{
+    std::cout << "test_cancel..." << std::endl;
+
+    TimerWheel wheel(5ms);
+    std::atomic<int> fired{0};
+    auto cancelled = wheel.schedule(20ms, [&]() { fired += 100; });
+    wheel.schedule(30ms, [&]() { ++fired; });
+
+    assert(wheel.cancel(cancelled));
+    assert(!wheel.cancel(cancelled));
+    assert(wait_until([&]() { return fired == 1; }));
+    std::this_thread::sleep_for(20ms);
+    assert(fired == 1);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_callbacks_can_reschedule()
+{
+    std::cout << "test_callbacks_can_reschedule..." << std::endl;
+
+    TimerWheel wheel(2ms);
+    std::atomic<int> runs{0};
+    std::function<void()> periodic = [&]()
+    {
+        if (++runs < 5)
+            wheel.schedule(3ms, periodic);
+    };
+    wheel.schedule(0ms, periodic);
+
+    assert(wait_until([&]() { return runs == 5; }));
+    assert(wait_until([&]() { return wheel.pending() == 0; }));
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+void test_pending_timers_do_not_fire_after_destruction()
+{
+    std::cout << "test_pending_timers_do_not_fire_after_destruction..." << std::endl;
+
+    std::atomic<bool> fired{false};
+    {
+        TimerWheel wheel(5ms);
+        wheel.schedule(1h, [&]() { fired = true; });
+        // The wheel idles between ticks and wakes for a new, earlier timer
+        std::this_thread::sleep_for(20ms);
+        std::atomic<bool> quick{false};
+        wheel.schedule(5ms, [&]() { quick = true; });
+        assert(wait_until([&]() { return quick.load(); }));
+    }
+    assert(!fired);
+
+    std::cout << "  PASSED" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== TimerWheel Tests ===" << std::endl;
+
+    test_fires_in_deadline_order();
+    test_cancel();
+    test_callbacks_can_reschedule();
+    test_pending_timers_do_not_fire_after_destruction();
+
+    std::cout << "\n=== All tests PASSED ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,22 @@
+/// @file tests/wait_helpers.hpp
+/// @brief Polling helper shared by tests of background threads
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <thread>
+
+/// Poll `done` every millisecond until it holds.
+/// @return false if it still does not hold after `timeout`
+inline bool wait_until(const std::function<bool()>& done,
+                       std::chrono::milliseconds timeout = std::chrono::seconds(5))
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!done())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}